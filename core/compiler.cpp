@@ -1,6 +1,8 @@
+#include <algorithm>
 #include <iostream>
 #include <memory>
 #include <sstream>
+#include <unordered_map>
 #include <vector>
 
 #include <cuda_runtime.h>
@@ -27,33 +29,39 @@
 namespace torch_tensorrt {
 namespace core {
 
-void AddEngineToGraph(
+c10::intrusive_ptr<runtime::TRTEngine> RegisterEngine(
     torch::jit::script::Module mod,
-    std::shared_ptr<torch::jit::Graph>& g,
     const std::string& serialized_engine,
     runtime::RTDevice& device_info,
     const std::vector<std::string>& input_binding_names,
     const std::vector<std::string>& output_binding_names,
-    std::string engine_id = "",
-    bool fallback = false) {
+    std::string engine_id = "") {
   auto engine_ptr = c10::make_intrusive<runtime::TRTEngine>(
       mod._ivalue()->name() + "_engine_" + engine_id,
       serialized_engine,
       device_info,
       input_binding_names,
       output_binding_names);
-  // Get required metadata about the engine out
-  auto num_io = engine_ptr->num_io;
-  auto name = engine_ptr->name;
 
-  //..
   // Add the engine as an attribute of the module, this will let the engine be
   // serialized and deserialized
   mod.register_attribute(
-      name,
+      engine_ptr->name,
       c10::getCustomClassType<c10::intrusive_ptr<runtime::TRTEngine>>(),
-      c10::IValue(std::move(engine_ptr)),
+      c10::IValue(engine_ptr),
       false);
+  return engine_ptr;
+}
+
+// Appends a call to an engine already registered on mod to g, several graphs may call the same engine
+void AddEngineCallToGraph(
+    torch::jit::script::Module mod,
+    std::shared_ptr<torch::jit::Graph>& g,
+    const c10::intrusive_ptr<runtime::TRTEngine>& engine_ptr,
+    bool fallback = false) {
+  // Get required metadata about the engine out
+  auto num_io = engine_ptr->num_io;
+  auto name = engine_ptr->name;
 
   // Add the module as an input into the graph
   auto self = g->addInput("self_1");
@@ -123,6 +131,34 @@ void AddEngineToGraph(
   return;
 }
 
+void AddEngineToGraph(
+    torch::jit::script::Module mod,
+    std::shared_ptr<torch::jit::Graph>& g,
+    const std::string& serialized_engine,
+    runtime::RTDevice& device_info,
+    const std::vector<std::string>& input_binding_names,
+    const std::vector<std::string>& output_binding_names,
+    std::string engine_id = "",
+    bool fallback = false) {
+  auto engine_ptr =
+      RegisterEngine(mod, serialized_engine, device_info, input_binding_names, output_binding_names, engine_id);
+  AddEngineCallToGraph(mod, g, engine_ptr, fallback);
+}
+
+// Loads the timing cache requested by the user once so all engines built for this compilation share it
+void OpenTimingCache(CompileSpec& cfg) {
+  auto& settings = cfg.convert_info.engine_settings;
+  if (!settings.timing_cache_path.empty() && !settings.timing_cache) {
+    settings.timing_cache = std::make_shared<conversion::TimingCache>(settings.timing_cache_path);
+  }
+}
+
+void PersistTimingCache(CompileSpec& cfg) {
+  if (cfg.convert_info.engine_settings.timing_cache) {
+    cfg.convert_info.engine_settings.timing_cache->Persist();
+  }
+}
+
 bool CheckMethodOperatorSupport(const torch::jit::script::Module& mod, std::string method_name) {
   // Go through Lowering to simplify graph
   auto graph_and_parameters = lowering::Lower(mod, method_name, lowering::LowerInfo());
@@ -152,6 +188,15 @@ partitioning::GraphAndMapping BuildHybridGraph(
 
   partitioning::partition(&partitioning_ctx, expect_full_compilation);
 
+  // Engines built so far keyed by segment fingerprint, so repeated blocks (e.g. transformer layers) share one engine.
+  // The fingerprint compares the full graph text but only hashes of the weights, so each engine keeps the constants it
+  // was built from to confirm a match.
+  struct BuiltEngine {
+    std::vector<at::Tensor> constants;
+    c10::intrusive_ptr<runtime::TRTEngine> engine;
+  };
+  std::unordered_map<std::string, std::vector<BuiltEngine>> engines_by_fingerprint;
+
   for (auto& partitioned_block : partitioning_ctx.partitioned_blocks) {
     partitioning::PartitionedGraph& segmented_blocks = partitioned_block.second;
     int num_torch_segments = 0;
@@ -168,20 +213,31 @@ partitioning::GraphAndMapping BuildHybridGraph(
         // update the input ranges for each segments
         convert_info.inputs = ir::associate_specs_with_inputs(seg_block.g(), inputs, static_params);
 
-        // TODO mapping Inputs Ivalue to flatten one here
-        auto engine = conversion::ConvertBlockToEngine(seg_block.block(), convert_info, static_params);
         auto temp_g = std::make_shared<torch::jit::Graph>();
-        auto device_spec = convert_info.engine_settings.device;
-        auto cuda_device = runtime::RTDevice(device_spec.gpu_id, device_spec.device_type);
-        AddEngineToGraph(
-            new_mod,
-            temp_g,
-            engine,
-            cuda_device,
-            std::vector<std::string>(),
-            std::vector<std::string>(),
-            trt_engine_id.str(),
-            true);
+        std::vector<at::Tensor> constants;
+        auto fingerprint = partitioning::fingerprintSegment(seg_block, inputs, &constants);
+        auto& candidates = engines_by_fingerprint[fingerprint];
+        auto built = std::find_if(candidates.begin(), candidates.end(), [&](const BuiltEngine& b) {
+          return partitioning::sameSegmentConstants(b.constants, constants);
+        });
+        if (built != candidates.end()) {
+          LOG_INFO("Segment is identical to a segment already built, reusing engine " << built->engine->name);
+          AddEngineCallToGraph(new_mod, temp_g, built->engine, true);
+        } else {
+          // TODO mapping Inputs Ivalue to flatten one here
+          auto engine = conversion::ConvertBlockToEngine(seg_block.block(), convert_info, static_params);
+          auto device_spec = convert_info.engine_settings.device;
+          auto cuda_device = runtime::RTDevice(device_spec.gpu_id, device_spec.device_type);
+          auto engine_ptr = RegisterEngine(
+              new_mod,
+              engine,
+              cuda_device,
+              std::vector<std::string>(),
+              std::vector<std::string>(),
+              trt_engine_id.str());
+          AddEngineCallToGraph(new_mod, temp_g, engine_ptr, true);
+          candidates.push_back({std::move(constants), engine_ptr});
+        }
 
         seg_block.update_graph(temp_g);
       } else {
@@ -212,7 +268,13 @@ partitioning::GraphAndMapping BuildHybridGraph(
     }
   }
 
-  return partitioning::stitch(&partitioning_ctx, block);
+  auto graph_and_mapping = partitioning::stitch(&partitioning_ctx, block);
+  // The mapping is only consulted for nested blocks inside stitch, so values it holds may be removed now
+  auto removed_casts = partitioning::EliminateRedundantCasts(graph_and_mapping.first);
+  if (removed_casts > 0) {
+    LOG_INFO("Removed " << removed_casts << " redundant casts between segments");
+  }
+  return graph_and_mapping;
 }
 
 ir::TypeMap MapInputsAndDetermineDTypes(
@@ -321,7 +383,9 @@ std::string ConvertGraphToTRTEngine(const torch::jit::script::Module& mod, std::
     }
   }
 
+  OpenTimingCache(cfg);
   auto engine = conversion::ConvertBlockToEngine(g->block(), cfg.convert_info, static_params);
+  PersistTimingCache(cfg);
 
   return engine;
 }
@@ -337,6 +401,8 @@ torch::jit::Module CompileGraph(const torch::jit::Module& mod, CompileSpec cfg)
   auto device_spec = cfg.convert_info.engine_settings.device;
   auto cuda_device = runtime::RTDevice(device_spec.gpu_id, device_spec.device_type);
 
+  OpenTimingCache(cfg);
+
   for (const torch::jit::Method& method : mod.get_methods()) {
     if (method.name().compare("forward") == 0) {
       auto new_g = std::make_shared<torch::jit::Graph>();
@@ -423,6 +489,7 @@ torch::jit::Module CompileGraph(const torch::jit::Module& mod, CompileSpec cfg)
       new_method->setSchema(schema);
     }
   }
+  PersistTimingCache(cfg);
   return new_mod;
 }
 
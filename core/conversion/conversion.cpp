@@ -27,25 +27,33 @@ bool SpecialCaseSupport(const torch::jit::Node* n) {
   return n->kind() == torch::jit::prim::Loop || n->kind() == torch::jit::prim::If;
 }
 
-c10::optional<torch::jit::IValue> EvaluateNode(ConversionCtx* ctx, const torch::jit::Node* n, int level, int limit) {
+// Fills eval_args with the inputs of n, evaluating the inputs which have not been evaluated yet
+void ResolveEvalArgs(
+    ConversionCtx* ctx,
+    const torch::jit::Node* n,
+    evaluators::kwargs& eval_args,
+    int level,
+    int limit) {
   // Check to see if you can just go through and eval all of these AOT (saves
   // the recursion) Also probably a better way to deal with the two error cases;
   TORCHTRT_CHECK(
       level < limit,
       "Failed to evaluate node: " << *n << "Reason: Exceeded evaluation stack limit (limit=" << limit << ")");
 
-  LOG_DEBUG(ctx->logger, "Evaluating " << util::node_info(n));
-  evaluators::kwargs eval_args;
   for (auto eval_in : n->inputs()) {
     if (eval_args.find(eval_in) != eval_args.end()) {
       // No need to evaluate nodes that already have been entered in the
       // args dict
       continue;
     }
-    if (ctx->evaluated_value_map.find(eval_in) != ctx->evaluated_value_map.end()) {
-      eval_args[eval_in] = &(ctx->evaluated_value_map[eval_in]);
-    } else if (ctx->value_tensor_map.find(eval_in) != ctx->value_tensor_map.end()) {
-      eval_args[eval_in] = ctx->value_tensor_map[eval_in];
+    auto ivalue = ctx->evaluated_value_map.find(eval_in);
+    if (ivalue != ctx->evaluated_value_map.end()) {
+      eval_args[eval_in] = &(ivalue->second);
+      continue;
+    }
+    auto tensor = ctx->value_tensor_map.find(eval_in);
+    if (tensor != ctx->value_tensor_map.end()) {
+      eval_args[eval_in] = tensor->second;
     } else if (evaluators::shouldEvalAtConversionTime(eval_in->node())) {
       auto result = EvaluateNode(ctx, eval_in->node(), level++, limit);
       if (result) {
@@ -54,20 +62,23 @@ c10::optional<torch::jit::IValue> EvaluateNode(ConversionCtx* ctx, const torch::
         auto val = result.value();
         if (val.isCustomClass()) {
           auto cont = val.toCustomClass<TensorContainer>();
-          ctx->AssociateValueAndTensor(eval_in, cont->tensor());
-          eval_args[eval_in] = ctx->value_tensor_map[eval_in];
+          eval_args[eval_in] = ctx->AssociateValueAndTensor(eval_in, cont->tensor());
         } else {
-          ctx->AssociateValueAndIValue(eval_in, val);
-          eval_args[eval_in] = &(ctx->evaluated_value_map[eval_in]);
+          eval_args[eval_in] = ctx->AssociateValueAndIValue(eval_in, val);
         }
       }
     } else {
       TORCHTRT_THROW_ERROR(
           "Failed to evaluate node: " << *n << "Reason: Node inputs cannot be evaluated at conversion time\n"
                                       << "File a bug: https://www.github.com/NVIDIA/Torch-TensorRT/issues");
-      return {};
     }
   }
+}
+
+c10::optional<torch::jit::IValue> EvaluateNode(ConversionCtx* ctx, const torch::jit::Node* n, int level, int limit) {
+  LOG_DEBUG(ctx->logger, "Evaluating " << util::node_info(n));
+  evaluators::kwargs eval_args;
+  ResolveEvalArgs(ctx, n, eval_args, level, limit);
   auto eval = evaluators::EvalNode(ctx, n, eval_args);
   return eval;
 }
@@ -236,7 +247,8 @@ void MarkOutputs(ConversionCtx* ctx, at::ArrayRef<const torch::jit::Value*> outp
           // prim::NumToTensor will go to here
           std::string name = std::string("output_") + std::to_string(ctx->num_outputs);
           auto out_tensor = converters::tensor_to_const(ctx, out_ivalue.toTensor(), "");
-          out_tensor->setName(name.c_str());
+          // Pooled constants are shared, give the output its own tensor
+          out_tensor = converters::applyIdentityOp(ctx, out_tensor, name);
           ctx->net->markOutput(*out_tensor);
           LOG_INFO(
               ctx->logger, "Marking Output " << out->debugName() << " named " << name << " in engine (ctx.MarkOutput)");
@@ -252,7 +264,16 @@ void MarkOutputs(ConversionCtx* ctx, at::ArrayRef<const torch::jit::Value*> outp
       std::string name = std::string("output_") + std::to_string(ctx->num_outputs);
 
       // Check if the output tensor is one of the inputs to the network. If so, apply an identity layer to it.
-      for (int64_t i = 0; i < num_inputs; i++) {
+      // The same goes for a tensor already marked as an output, such as a pooled constant returned twice.
+      if (out_tensor->isNetworkOutput()) {
+        LOG_DEBUG(
+            "Tensor " << out_tensor->getName()
+                      << " is already an output of the network. Applying an identity layer and marking this tensor as output");
+        auto id_out_tensor = converters::applyIdentityOp(ctx, out_tensor, name);
+        ctx->net->markOutput(*id_out_tensor);
+        setOutput = true;
+      }
+      for (int64_t i = 0; i < num_inputs && !setOutput; i++) {
         if (out_tensor == ctx->net->getInput(i)) {
           LOG_DEBUG(
               "One of the inputs named "
@@ -289,25 +310,19 @@ void MapIValues(
     c10::ArrayRef<const torch::jit::Value*> out_list,
     int64_t in_offset,
     int64_t out_offset) {
-  std::vector<std::pair<const torch::jit::Value*, const torch::jit::Value*>> input_output_pairs;
-  std::transform(
-      in_list.begin() + in_offset,
-      in_list.end(),
-      out_list.begin() + out_offset,
-      std::back_inserter(input_output_pairs),
-      [](auto in, auto out) { return std::make_pair(in, out); });
-
-  for (auto p : input_output_pairs) {
-    if (ctx->evaluated_value_map.find(p.first) != ctx->evaluated_value_map.end()) {
-      auto input = ctx->evaluated_value_map[p.first];
-      ctx->evaluated_value_map[p.second] = torch::jit::IValue(input);
-    } else if (ctx->value_tensor_map.find(p.first) != ctx->value_tensor_map.end()) {
-      auto input = ctx->value_tensor_map[p.first];
-      ctx->value_tensor_map[p.second] = input;
-    } else {
-      TORCHTRT_THROW_ERROR(
-          "Cannot find Value " << p.first->debugName() << " either evaluated values or tensor maps (MapIValues)");
+  auto in = in_list.begin() + in_offset;
+  auto out = out_list.begin() + out_offset;
+  for (; in != in_list.end() && out != out_list.end(); ++in, ++out) {
+    auto ivalue = ctx->evaluated_value_map.find(*in);
+    if (ivalue != ctx->evaluated_value_map.end()) {
+      ctx->evaluated_value_map.insert_or_assign(*out, ivalue->second);
+      continue;
     }
+    auto tensor = ctx->value_tensor_map.find(*in);
+    TORCHTRT_CHECK(
+        tensor != ctx->value_tensor_map.end(),
+        "Cannot find Value " << (*in)->debugName() << " either evaluated values or tensor maps (MapIValues)");
+    ctx->value_tensor_map.insert_or_assign(*out, tensor->second);
   }
 }
 
@@ -357,51 +372,143 @@ void EvaluateConditionalBlock(ConversionCtx* ctx, const torch::jit::Node* n, boo
   MapIValues(ctx, b->outputs(), n->outputs(), 0, 0);
 }
 
+namespace {
+// One node of a prim::Loop body, resolved once before the first trip
+struct LoopBodyStep {
+  enum class Kind { kLoop, kConditional, kEvaluate };
+  Kind kind;
+  const torch::jit::Node* node;
+  const evaluators::NodeEvaluator* evaluator;
+  // Evaluated values keep their address in ctx->evaluated_value_map from one trip to the next, so once all of the
+  // arguments are evaluated values they are kept for the following trips instead of being looked up again
+  evaluators::kwargs args;
+  bool args_resolved = false;
+};
+
+std::vector<LoopBodyStep> ResolveLoopBody(const torch::jit::Block* body) {
+  std::vector<LoopBodyStep> steps;
+  for (auto bn : body->nodes()) {
+    if (bn->kind() == torch::jit::prim::Loop) {
+      steps.push_back({LoopBodyStep::Kind::kLoop, bn, nullptr});
+    } else if (bn->kind() == torch::jit::prim::If) {
+      steps.push_back({LoopBodyStep::Kind::kConditional, bn, nullptr});
+    } else {
+      TORCHTRT_CHECK(
+          evaluators::shouldEvalAtConversionTime(bn),
+          "Torch-TensorRT.TorchScript currently can only compile loops that are evaluatable at conversion time but node "
+              << *bn << " cannot be evaluated.");
+      steps.push_back({LoopBodyStep::Kind::kEvaluate, bn, &evaluators::getEvaluator(bn)});
+    }
+  }
+  return steps;
+}
+
+void RunLoopBodyStep(ConversionCtx* ctx, LoopBodyStep& step) {
+  switch (step.kind) {
+    case LoopBodyStep::Kind::kLoop:
+      EvaluateLoopBlock(ctx, step.node);
+      return;
+    case LoopBodyStep::Kind::kConditional:
+      EvaluateConditionalBlock(ctx, step.node, true);
+      return;
+    case LoopBodyStep::Kind::kEvaluate:
+      if (!step.args_resolved) {
+        step.args.clear();
+        ResolveEvalArgs(ctx, step.node, step.args, 0, 10);
+        // ITensors are held by value in the arguments, resolve them again on every trip
+        step.args_resolved = evaluators::constTypesOnly(step.args);
+      }
+      auto eval = (*step.evaluator)(ctx, step.node, step.args);
+      if (!eval.value().isTensor()) {
+        LOG_DEBUG(ctx->logger, "(Loop Evaluation) Found the value to be: " << eval.value());
+      } else {
+        LOG_DEBUG(
+            ctx->logger,
+            "(Loop Evaluation) Found the value to be a tensor (shape " << eval.value().toTensor().sizes() << ')');
+      }
+      ctx->AssociateValueAndIValue(step.node->output(0), std::move(eval.value()));
+      return;
+  }
+}
+
+// Flat storage for the values a loop carries from one trip to the next, slot i of each list holding carried value i.
+// Slots point into ctx->evaluated_value_map, so trips copy between them without any lookup.
+struct LoopCarriedSlots {
+  std::vector<torch::jit::IValue*> outputs;
+  std::vector<torch::jit::IValue*> body_inputs;
+  std::vector<torch::jit::IValue*> body_outputs;
+};
+
+// Slots of values[offset:], false if one of them is not an evaluated value (e.g. a carried ITensor)
+bool ResolveSlots(
+    ConversionCtx* ctx,
+    c10::ArrayRef<const torch::jit::Value*> values,
+    size_t offset,
+    std::vector<torch::jit::IValue*>& slots) {
+  slots.clear();
+  for (size_t i = offset; i < values.size(); i++) {
+    auto ivalue = ctx->evaluated_value_map.find(values[i]);
+    if (ivalue == ctx->evaluated_value_map.end()) {
+      return false;
+    }
+    slots.push_back(&ivalue->second);
+  }
+  return true;
+}
+} // namespace
+
 // TODO: With functionalization pass we may be able to make this into a regular
 // evaluator later
 void EvaluateLoopBlock(ConversionCtx* ctx, const torch::jit::Node* n) {
-  auto max_trip_count = ctx->evaluated_value_map[n->input(0)];
-  auto start_cond = ctx->evaluated_value_map[n->input(1)];
-  ctx->evaluated_value_map[n->blocks()[0]->inputs()[0]] = torch::jit::IValue(0);
-  auto trip_count = ctx->evaluated_value_map[n->blocks()[0]->inputs()[0]];
+  auto body = n->blocks()[0];
+  auto max_trip_count = ctx->evaluated_value_map[n->input(0)].toInt();
+  auto cond = ctx->evaluated_value_map[n->input(1)].toBool();
+  // Updated in place so the body sees the index of the current trip
+  auto& trip_count = ctx->evaluated_value_map[body->inputs()[0]];
+  trip_count = torch::jit::IValue(0);
 
   MapIValues(ctx, n->inputs(), n->outputs(), 2, 0);
 
   LOG_DEBUG(ctx->logger, "(Loop Evaluation) Evaluating loop " << *n);
-  LOG_DEBUG(ctx->logger, "(Loop Evaluation) Max Trip Count: " << max_trip_count.toInt());
-  LOG_DEBUG(ctx->logger, "(Loop Evaluation) Start Condition: " << start_cond.toBool());
+  LOG_DEBUG(ctx->logger, "(Loop Evaluation) Max Trip Count: " << max_trip_count);
+  LOG_DEBUG(ctx->logger, "(Loop Evaluation) Start Condition: " << cond);
   LOG_DEBUG(ctx->logger, "(Loop Evaluation) Current Trip Count: " << trip_count.toInt());
 
-  while (start_cond.toBool() && trip_count.toInt() < max_trip_count.toInt()) {
-    MapIValues(ctx, n->outputs(), n->blocks()[0]->inputs(), 0, 1);
-    for (auto bn : n->blocks()[0]->nodes()) {
-      if (bn->kind() == torch::jit::prim::Loop) {
-        EvaluateLoopBlock(ctx, bn);
-      } else if (bn->kind() == torch::jit::prim::If) {
-        EvaluateConditionalBlock(ctx, bn, true);
-      } else {
-        TORCHTRT_CHECK(
-            evaluators::shouldEvalAtConversionTime(bn),
-            "Torch-TensorRT.TorchScript currently can only compile loops that are evaluatable at conversion time but node "
-                << *bn << " cannot be evaluated.");
-        auto eval = EvaluateNode(ctx, bn);
-        if (!eval.value().isTensor()) {
-          LOG_DEBUG(ctx->logger, "(Loop Evaluation) Found the value to be: " << eval.value());
-        } else {
-          LOG_DEBUG(
-              ctx->logger,
-              "(Loop Evaluation) Found the value to be a tensor (shape " << eval.value().toTensor().sizes() << ')');
-        }
-        ctx->AssociateValueAndIValue(bn->output(0), eval.value());
+  auto steps = ResolveLoopBody(body);
+  LoopCarriedSlots slots;
+  bool use_slots = false;
+  torch::jit::IValue* cond_slot = nullptr;
+
+  for (int64_t trip = 0; cond && trip < max_trip_count;) {
+    if (use_slots) {
+      for (size_t i = 0; i < slots.outputs.size(); i++) {
+        *slots.body_inputs[i] = *slots.outputs[i];
       }
+    } else {
+      MapIValues(ctx, n->outputs(), body->inputs(), 0, 1);
+    }
+
+    for (auto& step : steps) {
+      RunLoopBodyStep(ctx, step);
+    }
+
+    if (use_slots) {
+      for (size_t i = 0; i < slots.outputs.size(); i++) {
+        *slots.outputs[i] = *slots.body_outputs[i];
+      }
+    } else {
+      MapIValues(ctx, body->outputs(), n->outputs(), 1, 0);
+      // After the first trip every carried value has its entry, loops carrying only evaluated values switch to slots
+      use_slots = ResolveSlots(ctx, n->outputs(), 0, slots.outputs) &&
+          ResolveSlots(ctx, body->inputs(), 1, slots.body_inputs) &&
+          ResolveSlots(ctx, body->outputs(), 1, slots.body_outputs);
+      cond_slot = &ctx->evaluated_value_map[body->outputs()[0]];
     }
 
-    MapIValues(ctx, n->blocks()[0]->outputs(), n->outputs(), 1, 0);
-    start_cond = ctx->evaluated_value_map[n->blocks()[0]->outputs()[0]];
-    auto new_trip_count = torch::jit::IValue(trip_count.toInt() + 1);
-    trip_count.swap(new_trip_count);
-    LOG_DEBUG(ctx->logger, "(Loop Evaluation) Condition: " << start_cond.toBool());
-    LOG_DEBUG(ctx->logger, "(Loop Evaluation) Current Trip Count: " << trip_count.toInt());
+    cond = cond_slot->toBool();
+    trip_count = torch::jit::IValue(++trip);
+    LOG_DEBUG(ctx->logger, "(Loop Evaluation) Condition: " << cond);
+    LOG_DEBUG(ctx->logger, "(Loop Evaluation) Current Trip Count: " << trip);
   }
 }
 
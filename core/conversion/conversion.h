@@ -24,6 +24,13 @@ std::string ConvertBlockToEngine(
     ConversionInfo build_info,
     ir::StaticParams& static_params);
 
+// Adds the layers of an already lowered block to the network of ctx without building an engine
+void ConvertBlockToNetDef(
+    ConversionCtx* ctx,
+    const torch::jit::Block* b,
+    ConversionInfo& build_info,
+    ir::StaticParams& static_params);
+
 bool OpSupported(const torch::jit::Node* n);
 
 bool InputIsCollection(const torch::jit::Block* b);
@@ -38,6 +45,9 @@ c10::optional<torch::jit::IValue> EvaluateNode(
     int level = 0,
     int limit = 10);
 
+// Runs a prim::Loop whose body is evaluatable at conversion time and records its results as the loop outputs
+void EvaluateLoopBlock(ConversionCtx* ctx, const torch::jit::Node* n);
+
 } // namespace conversion
 } // namespace core
 } // namespace torch_tensorrt
@@ -1,7 +1,11 @@
 #include "core/conversion/conversionctx/ConversionCtx.h"
 #include <iostream>
+#include <limits>
 #include <sstream>
 #include <utility>
+#if defined(__linux__) || defined(__gnu_linux__)
+#include <sys/resource.h>
+#endif
 
 namespace torch_tensorrt {
 namespace core {
@@ -16,6 +20,7 @@ std::ostream& operator<<(std::ostream& os, const BuilderSettings& s) {
        }
     os << "\n    TF32 Floating Point Computation Enabled: " << !s.disable_tf32             \
        << "\n    Truncate Long and Double: " << s.truncate_long_and_double                 \
+       << "\n    Narrow Layer Weights: " << s.narrow_weights                               \
        << "\n    Make Refittable Engine: " << s.refit                                      \
        << "\n    Debuggable Engine: " << s.debug                                           \
        << "\n    GPU ID: " << s.device.gpu_id                                              \
@@ -24,7 +29,8 @@ std::ostream& operator<<(std::ostream& os, const BuilderSettings& s) {
        << "\n    Max Workspace Size: " << s.workspace_size                                 \
        << "\n    DLA SRAM Size: " << s.dla_sram_size                                       \
        << "\n    DLA Local DRAM Size: " << s.dla_local_dram_size                           \
-       << "\n    DLA Global DRAM Size: " << s.dla_global_dram_size;
+       << "\n    DLA Global DRAM Size: " << s.dla_global_dram_size                         \
+       << "\n    Timing Cache: " << (s.timing_cache_path.empty() ? "None" : s.timing_cache_path);
 
     os << "\n    Device Type: " << s.device.device_type                                    \
        << "\n    GPU ID: " << s.device.gpu_id;
@@ -37,6 +43,19 @@ std::ostream& operator<<(std::ostream& os, const BuilderSettings& s) {
 }
 // clang-format on
 
+namespace {
+// Compute capability of the target GPU as major * 10 + minor, e.g. 89 for Ada
+int compute_capability(int64_t gpu_id) {
+  int major = 0;
+  int minor = 0;
+  TORCHTRT_CHECK(
+      cudaDeviceGetAttribute(&major, cudaDevAttrComputeCapabilityMajor, gpu_id) == cudaSuccess &&
+          cudaDeviceGetAttribute(&minor, cudaDevAttrComputeCapabilityMinor, gpu_id) == cudaSuccess,
+      "Unable to query the compute capability of gpu id: " << gpu_id);
+  return major * 10 + minor;
+}
+} // namespace
+
 ConversionCtx::ConversionCtx(BuilderSettings build_settings)
     : settings(build_settings),
       logger(
@@ -63,6 +82,20 @@ ConversionCtx::ConversionCtx(BuilderSettings build_settings)
             builder->platformHasFastFp16(), "Requested inference in FP16 but platform does not support FP16");
         cfg->setFlag(nvinfer1::BuilderFlag::kFP16);
         break;
+      case nvinfer1::DataType::kBF16:
+        TORCHTRT_CHECK(
+            compute_capability(settings.device.gpu_id) >= 80,
+            "Requested inference in BF16 but platform does not support BF16 (requires compute capability 8.0+)");
+        cfg->setFlag(nvinfer1::BuilderFlag::kBF16);
+        break;
+      case nvinfer1::DataType::kFP8:
+        TORCHTRT_CHECK(
+            compute_capability(settings.device.gpu_id) >= 89,
+            "Requested inference in FP8 but platform does not support FP8 (requires compute capability 8.9+)");
+        cfg->setFlag(nvinfer1::BuilderFlag::kFP8);
+        LOG_INFO(
+            "FP8 precision has been enabled, TensorRT only runs layers in FP8 between the Q/DQ nodes of a network quantized to FP8");
+        break;
       case nvinfer1::DataType::kINT8:
         TORCHTRT_CHECK(
             builder->platformHasFastInt8(), "Requested inference in INT8 but platform does not support INT8");
@@ -80,7 +113,8 @@ ConversionCtx::ConversionCtx(BuilderSettings build_settings)
       case nvinfer1::DataType::kBOOL:
       default:
         TORCHTRT_THROW_ERROR(
-            "Requested kernel precision that is unsupported: " << *p << " options are float, half, int8");
+            "Requested kernel precision that is unsupported: " << *p
+                                                               << " options are float, half, bfloat16, int8, fp8");
     }
   }
 
@@ -111,6 +145,10 @@ ConversionCtx::ConversionCtx(BuilderSettings build_settings)
     cfg->setMemoryPoolLimit(nvinfer1::MemoryPoolType::kWORKSPACE, settings.workspace_size);
   }
 
+  if (settings.timing_cache) {
+    timing_cache = settings.timing_cache->Attach(cfg.get());
+  }
+
   cfg->setDefaultDeviceType(settings.device.device_type);
   cfg->setEngineCapability(settings.capability);
 
@@ -120,9 +158,11 @@ ConversionCtx::ConversionCtx(BuilderSettings build_settings)
         static_cast<int>(settings.device.dla_core) < nbDLACores,
         "Configured DLA Core ID: " << settings.device.dla_core
                                    << " not available. Total number of available DLA Cores: " << nbDLACores);
-    TORCHTRT_CHECK(
-        settings.enabled_precisions.find(nvinfer1::DataType::kFLOAT) == settings.enabled_precisions.end(),
-        "DLA supports only fp16 or int8 precision");
+    for (auto p : settings.enabled_precisions) {
+      TORCHTRT_CHECK(
+          p == nvinfer1::DataType::kHALF || p == nvinfer1::DataType::kINT8,
+          "DLA supports only fp16 or int8 precision, found: " << p);
+    }
     cfg->setDLACore(settings.device.dla_core);
     if (settings.dla_sram_size != DLA_SRAM_SIZE) {
       cfg->setMemoryPoolLimit(nvinfer1::MemoryPoolType::kDLA_MANAGED_SRAM, settings.dla_sram_size);
@@ -156,7 +196,7 @@ torch::jit::IValue* ConversionCtx::AssociateValueAndIValue(const torch::jit::Val
 void ConversionCtx::RecordNewITensor(const torch::jit::Value* value, nvinfer1::ITensor* tensor) {
   value_tensor_map[value] = tensor;
   auto ret = seen_itensors.insert(tensor);
-  if (!ret.second) {
+  if (!ret.second && pooled_constants.find(tensor) == pooled_constants.end()) {
     LOG_WARNING(
         "Trying to record the value " << value->debugName() << " with the ITensor " << tensor->getName() << " again.");
   }
@@ -176,10 +216,58 @@ std::string ConversionCtx::SerializeEngine() {
   auto serialized_network = engine->serialize();
   engine->destroy();
 #endif
+  if (timing_cache) {
+    settings.timing_cache->Update(cfg.get(), *timing_cache);
+  }
   auto engine_str = std::string((const char*)serialized_network->data(), serialized_network->size());
+
+  constexpr double kMiB = 1024.0 * 1024.0;
+#if defined(__linux__) || defined(__gnu_linux__)
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  LOG_INFO(
+      "Engine built holding " << builder_resource_bytes / kMiB << " MiB of weights on the host, peak host memory "
+                              << usage.ru_maxrss / 1024.0 << " MiB");
+#else
+  LOG_INFO("Engine built holding " << builder_resource_bytes / kMiB << " MiB of weights on the host");
+#endif
   return engine_str;
 }
 
+at::ScalarType ConversionCtx::ParameterWeightType(at::ScalarType t) const {
+  if (settings.narrow_weights && t == at::kFloat &&
+      enabled_precisions.find(nvinfer1::DataType::kHALF) != enabled_precisions.end() &&
+      enabled_precisions.find(nvinfer1::DataType::kFLOAT) == enabled_precisions.end()) {
+    return at::kHalf;
+  }
+  return t;
+}
+
+at::ScalarType ConversionCtx::ParameterWeightType(at::ScalarType t, const std::vector<at::Tensor>& values) const {
+  auto storage_type = ParameterWeightType(t);
+  if (storage_type == t) {
+    return t;
+  }
+  // Values past the FP16 range would silently become inf
+  for (const auto& v : values) {
+    if (v.numel() > 0 && v.abs().max().item<double>() > std::numeric_limits<at::Half>::max()) {
+      LOG_WARNING(
+          "Layer parameters exceed the range of " << storage_type << ", keeping them in " << t
+                                                  << " instead of narrowing them to the enabled precision");
+      return t;
+    }
+  }
+  return storage_type;
+}
+
+void* ConversionCtx::AllocateBuilderResource(size_t bytes) {
+  void* buf = malloc(bytes);
+  TORCHTRT_CHECK(buf != nullptr || bytes == 0, "Unable to allocate " << bytes << " bytes of host memory for weights");
+  builder_resources.push_back(buf);
+  builder_resource_bytes += bytes;
+  return buf;
+}
+
 bool ConversionCtx::CheckLayerAddition(const torch::jit::Node* n) {
   for (auto out : n->outputs()) {
     auto iter_t = this->value_tensor_map.find(out);
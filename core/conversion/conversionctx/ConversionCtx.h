@@ -9,6 +9,7 @@
 #include "torch/csrc/jit/ir/ir.h"
 
 #include <cuda_runtime.h>
+#include "core/conversion/conversionctx/TimingCache.h"
 #include "core/ir/ir.h"
 #include "core/util/prelude.h"
 
@@ -24,6 +25,9 @@ struct BuilderSettings {
   bool debug = false;
   bool truncate_long_and_double = false;
   bool allow_shape_tensors = false;
+  // Store FP32 layer parameters (convolution kernels, folded batch norm scales) as FP16 when FP16 is enabled and FP32
+  // is not, instead of holding them at full width until TensorRT converts them during the build
+  bool narrow_weights = true;
   ir::Device device;
   nvinfer1::EngineCapability capability = TRT_ENGINE_CAPABILITY_STANDARD;
   nvinfer1::IInt8Calibrator* calibrator = nullptr;
@@ -32,6 +36,9 @@ struct BuilderSettings {
   uint64_t dla_sram_size = DLA_SRAM_SIZE;
   uint64_t dla_local_dram_size = DLA_LOCAL_DRAM_SIZE;
   uint64_t dla_global_dram_size = DLA_GLOBAL_DRAM_SIZE;
+  std::string timing_cache_path = "";
+  // Loaded from timing_cache_path by the compiler and shared by every engine built for one compilation
+  std::shared_ptr<TimingCache> timing_cache;
 
   BuilderSettings() = default;
   BuilderSettings(const BuilderSettings& other) = default;
@@ -45,6 +52,12 @@ struct ConversionCtx {
   void RecordNewITensor(const torch::jit::Value* value, nvinfer1::ITensor* tensor);
   torch::jit::IValue* AssociateValueAndIValue(const torch::jit::Value* value, torch::jit::IValue tensor);
   bool CheckLayerAddition(const torch::jit::Node* n);
+  // Type a layer parameter of type t is stored in according to settings.narrow_weights and the enabled precisions
+  at::ScalarType ParameterWeightType(at::ScalarType t) const;
+  // Same as above, but keeps t if any of values would overflow the narrower type
+  at::ScalarType ParameterWeightType(at::ScalarType t, const std::vector<at::Tensor>& values) const;
+  // Host memory that stays alive until conversion is done, see builder_resources
+  void* AllocateBuilderResource(size_t bytes);
 
   ~ConversionCtx();
 
@@ -54,6 +67,7 @@ struct ConversionCtx {
   std::shared_ptr<nvinfer1::IBuilder> builder;
   std::shared_ptr<nvinfer1::INetworkDefinition> net;
   std::shared_ptr<nvinfer1::IBuilderConfig> cfg;
+  std::shared_ptr<nvinfer1::ITimingCache> timing_cache;
   std::set<nvinfer1::DataType> enabled_precisions;
   BuilderSettings settings;
   util::logging::TorchTRTLogger logger;
@@ -63,6 +77,14 @@ struct ConversionCtx {
   // is constructed from a PyTorch Tensor it allocates the data here to store a
   // copy of the values
   std::vector<void*> builder_resources;
+  // Bytes held in builder_resources, reported once the engine is built
+  size_t builder_resource_bytes = 0;
+
+  // Small constants frozen by converters::tensor_to_const keyed by type, shape and contents, so repeated operands such
+  // as 1.0, 0.5 or -inf share one IConstantLayer instead of adding a layer and a weights copy per use
+  std::unordered_map<std::string, nvinfer1::ITensor*> constant_pool;
+  // Tensors in constant_pool, which may legitimately be recorded for several values
+  std::unordered_set<nvinfer1::ITensor*> pooled_constants;
 
   std::unordered_map<const torch::jit::Value*, nvinfer1::ITensor*> value_tensor_map;
   std::unordered_map<const torch::jit::Value*, torch::jit::IValue> evaluated_value_map;
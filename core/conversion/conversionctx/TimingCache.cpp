@@ -0,0 +1,202 @@
+#include "core/conversion/conversionctx/TimingCache.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <thread>
+#include <utility>
+
+#if defined(_WIN32) || defined(_WIN64)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <process.h>
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+#endif
+
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace conversion {
+
+namespace {
+std::string SerializeTimingCache(nvinfer1::ITimingCache& cache) {
+  auto serialized = make_trt(cache.serialize());
+  TORCHTRT_CHECK(serialized, "Unable to serialize TensorRT timing cache");
+  return std::string(static_cast<const char*>(serialized->data()), serialized->size());
+}
+
+std::string TempPathFor(const std::string& path) {
+#if defined(_WIN32) || defined(_WIN64)
+  auto pid = _getpid();
+#else
+  auto pid = getpid();
+#endif
+  std::stringstream ss;
+  ss << path << ".tmp." << pid << "." << std::hash<std::thread::id>{}(std::this_thread::get_id());
+  return ss.str();
+}
+} // namespace
+
+std::string ReadFileIfExists(const std::string& path) {
+  std::ifstream f(path, std::ios::binary | std::ios::ate);
+  if (!f.good()) {
+    return "";
+  }
+  auto size = f.tellg();
+  f.seekg(0, std::ios::beg);
+  std::string data(static_cast<size_t>(size), '\0');
+  f.read(&data[0], size);
+  TORCHTRT_CHECK(f.good() || f.eof(), "Unable to read " << path);
+  return data;
+}
+
+void WriteFileAtomically(const std::string& path, const std::string& data) {
+  auto tmp_path = TempPathFor(path);
+  {
+    std::ofstream f(tmp_path, std::ios::binary | std::ios::trunc);
+    TORCHTRT_CHECK(f.good(), "Unable to open " << tmp_path << " for writing");
+    f.write(data.data(), data.size());
+    f.flush();
+    if (!f.good()) {
+      f.close();
+      std::remove(tmp_path.c_str());
+      TORCHTRT_THROW_ERROR("Unable to write " << tmp_path);
+    }
+  }
+#if defined(_WIN32) || defined(_WIN64)
+  bool renamed = MoveFileExA(tmp_path.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+  bool renamed = std::rename(tmp_path.c_str(), path.c_str()) == 0;
+#endif
+  if (!renamed) {
+    std::remove(tmp_path.c_str());
+    TORCHTRT_THROW_ERROR("Unable to replace " << path);
+  }
+}
+
+#if defined(_WIN32) || defined(_WIN64)
+FileLock::FileLock(const std::string& path) {
+  auto lock_path = path + ".lock";
+  handle_ = CreateFileA(
+      lock_path.c_str(),
+      GENERIC_READ | GENERIC_WRITE,
+      FILE_SHARE_READ | FILE_SHARE_WRITE,
+      nullptr,
+      OPEN_ALWAYS,
+      FILE_ATTRIBUTE_NORMAL,
+      nullptr);
+  TORCHTRT_CHECK(handle_ != INVALID_HANDLE_VALUE, "Unable to open lock file " << lock_path);
+  OVERLAPPED overlapped = {};
+  if (!LockFileEx(handle_, LOCKFILE_EXCLUSIVE_LOCK, 0, MAXDWORD, MAXDWORD, &overlapped)) {
+    CloseHandle(handle_);
+    TORCHTRT_THROW_ERROR("Unable to lock " << lock_path);
+  }
+}
+
+FileLock::~FileLock() {
+  OVERLAPPED overlapped = {};
+  UnlockFileEx(handle_, 0, MAXDWORD, MAXDWORD, &overlapped);
+  CloseHandle(handle_);
+}
+#else
+FileLock::FileLock(const std::string& path) {
+  auto lock_path = path + ".lock";
+  fd_ = open(lock_path.c_str(), O_RDWR | O_CREAT, 0644);
+  TORCHTRT_CHECK(fd_ >= 0, "Unable to open lock file " << lock_path);
+  int res;
+  do {
+    res = flock(fd_, LOCK_EX);
+  } while (res != 0 && errno == EINTR);
+  if (res != 0) {
+    close(fd_);
+    TORCHTRT_THROW_ERROR("Unable to lock " << lock_path);
+  }
+}
+
+FileLock::~FileLock() {
+  flock(fd_, LOCK_UN);
+  close(fd_);
+}
+#endif
+
+TimingCache::TimingCache(std::string path) : path_(std::move(path)) {
+  blob_ = ReadFileIfExists(path_);
+  if (blob_.empty()) {
+    LOG_INFO("No timing cache found at " << path_ << ", a new one will be created");
+  } else {
+    LOG_INFO("Loaded timing cache from " << path_ << " (" << blob_.size() << " bytes)");
+  }
+}
+
+std::shared_ptr<nvinfer1::ITimingCache> TimingCache::Attach(nvinfer1::IBuilderConfig* cfg) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::shared_ptr<nvinfer1::ITimingCache> cache;
+  if (!blob_.empty()) {
+    cache = make_trt(cfg->createTimingCache(blob_.data(), blob_.size()));
+    if (!cache || !cfg->setTimingCache(*cache, /*ignoreMismatch=*/false)) {
+      LOG_WARNING(
+          "Timing cache " << path_
+                          << " is corrupt or was created for a different device or TensorRT version, starting from an empty cache");
+      blob_.clear();
+      cache.reset();
+    }
+  }
+  if (!cache) {
+    cache = make_trt(cfg->createTimingCache(nullptr, 0));
+    TORCHTRT_CHECK(cache, "Unable to create TensorRT timing cache");
+    TORCHTRT_CHECK(cfg->setTimingCache(*cache, /*ignoreMismatch=*/false), "Unable to attach timing cache to builder");
+  }
+  return cache;
+}
+
+void TimingCache::Update(nvinfer1::IBuilderConfig* cfg, nvinfer1::ITimingCache& cache) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  // Another build may have updated the blob since this cache was attached, keep its entries too
+  if (!blob_.empty()) {
+    auto current = make_trt(cfg->createTimingCache(blob_.data(), blob_.size()));
+    if (current) {
+      cache.combine(*current, /*ignoreMismatch=*/false);
+    }
+  }
+  blob_ = SerializeTimingCache(cache);
+  dirty_ = true;
+}
+
+void TimingCache::Persist() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!dirty_) {
+    return;
+  }
+
+  FileLock file_lock(path_);
+  auto on_disk = ReadFileIfExists(path_);
+  if (!on_disk.empty() && on_disk != blob_) {
+    // Another compilation wrote the file since it was loaded, merge its entries in rather than dropping them
+    auto builder = make_trt(nvinfer1::createInferBuilder(util::logging::get_logger()));
+    auto cfg = make_trt(builder->createBuilderConfig());
+    auto merged = make_trt(cfg->createTimingCache(blob_.data(), blob_.size()));
+    auto theirs = make_trt(cfg->createTimingCache(on_disk.data(), on_disk.size()));
+    TORCHTRT_CHECK(merged, "Unable to deserialize in memory timing cache");
+    if (theirs && merged->combine(*theirs, /*ignoreMismatch=*/false)) {
+      blob_ = SerializeTimingCache(*merged);
+    } else {
+      LOG_WARNING("Unable to merge with the timing cache at " << path_ << ", overwriting it");
+    }
+  }
+
+  WriteFileAtomically(path_, blob_);
+  dirty_ = false;
+  LOG_INFO("Saved timing cache to " << path_ << " (" << blob_.size() << " bytes)");
+}
+
+} // namespace conversion
+} // namespace core
+} // namespace torch_tensorrt
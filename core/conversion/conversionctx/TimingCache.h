@@ -0,0 +1,65 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "NvInfer.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace conversion {
+
+// Returns the contents of path, or an empty string if the file does not exist
+std::string ReadFileIfExists(const std::string& path);
+
+// Writes data to a temporary file next to path and renames it over path so readers never see a partial file
+void WriteFileAtomically(const std::string& path, const std::string& data);
+
+// Exclusive advisory lock on path + ".lock", held for the lifetime of the object. Serializes read-merge-write cycles
+// of processes sharing a file on one host.
+class FileLock {
+ public:
+  explicit FileLock(const std::string& path);
+  ~FileLock();
+  FileLock(const FileLock&) = delete;
+  FileLock& operator=(const FileLock&) = delete;
+
+ private:
+#if defined(_WIN32) || defined(_WIN64)
+  void* handle_;
+#else
+  int fd_;
+#endif
+};
+
+// TensorRT timing cache shared by every engine built during one compilation. The file is read once when the
+// compilation starts, each engine build starts from and adds to the in memory copy, and the result is merged with
+// whatever is on disk at the end so concurrent compilations only ever add entries.
+class TimingCache {
+ public:
+  explicit TimingCache(std::string path);
+
+  // Creates a timing cache from the current contents and sets it on cfg. The returned cache has to outlive the build.
+  std::shared_ptr<nvinfer1::ITimingCache> Attach(nvinfer1::IBuilderConfig* cfg);
+
+  // Takes over the entries of a cache returned by Attach once the build using cfg has finished
+  void Update(nvinfer1::IBuilderConfig* cfg, nvinfer1::ITimingCache& cache);
+
+  // Merges the in memory cache into the file. Does nothing if no engine has been built since the last call.
+  void Persist();
+
+  const std::string& path() const {
+    return path_;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::string path_;
+  std::string blob_;
+  bool dirty_ = false;
+};
+
+} // namespace conversion
+} // namespace core
+} // namespace torch_tensorrt
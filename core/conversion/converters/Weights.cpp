@@ -19,11 +19,10 @@ Weights::Weights(ConversionCtx* ctx, float val) {
   this->num_output_maps = 1;
 
   this->data.type = nvinfer1::DataType::kFLOAT;
-  float* buf = reinterpret_cast<float*>(malloc(1 * sizeof(float)));
+  float* buf = reinterpret_cast<float*>(ctx->AllocateBuilderResource(1 * sizeof(float)));
   buf[0] = val;
   this->data.values = buf;
   this->data.count = 1;
-  ctx->builder_resources.push_back(buf);
 
   this->shape.nbDims = 0;
   this->kernel_shape.nbDims = 0;
@@ -34,17 +33,18 @@ Weights::Weights(ConversionCtx* ctx, int32_t val) {
   this->num_output_maps = 1;
 
   this->data.type = nvinfer1::DataType::kINT32;
-  int32_t* buf = reinterpret_cast<int32_t*>(malloc(1 * sizeof(int32_t)));
+  int32_t* buf = reinterpret_cast<int32_t*>(ctx->AllocateBuilderResource(1 * sizeof(int32_t)));
   buf[0] = val;
   this->data.values = buf;
   this->data.count = 1;
-  ctx->builder_resources.push_back(buf);
 
   this->shape.nbDims = 0;
   this->kernel_shape.nbDims = 0;
 }
 
-Weights::Weights(ConversionCtx* ctx, at::Tensor t) {
+Weights::Weights(ConversionCtx* ctx, at::Tensor t) : Weights(ctx, t, t.scalar_type()) {}
+
+Weights::Weights(ConversionCtx* ctx, at::Tensor t, at::ScalarType storage_type) {
   if (t.sizes().size() > nvinfer1::Dims::MAX_DIMS) {
     TORCHTRT_THROW_ERROR(
         "The tensor requested to be converted to nvinfer1::Weights exceeds the max number of dimensions for TensorRT");
@@ -71,41 +71,32 @@ Weights::Weights(ConversionCtx* ctx, at::Tensor t) {
     this->kernel_shape.nbDims = 1;
     this->kernel_shape.d[0] = 1;
   }
-  auto t_cpu = t.to(at::kCPU);
-  t_cpu = t_cpu.contiguous();
+  // A single conversion moves the tensor to the host and casts it, a no-op for host tensors already stored that way
+  auto t_cpu = t.to(at::kCPU, storage_type).contiguous();
   auto dtype_optional = util::optScalarTypeToTRTDataType(t_cpu.scalar_type());
   if (!dtype_optional) {
     TORCHTRT_THROW_ERROR(
         "The tensor requested to be converted to nvinfer1::Weights is of an unsupported type: "
-        << dtype_optional.value());
+        << t_cpu.scalar_type());
   }
 
   // Store the data in the conversion context so it remains until building is
   // complete
-
   void* buf = nullptr;
-
-  if (dtype_optional.value() == nvinfer1::DataType::kFLOAT) {
-    buf = malloc(t_cpu.numel() * sizeof(float));
-    memcpy(buf, t_cpu.data_ptr(), t_cpu.numel() * sizeof(float));
-  } else if (dtype_optional.value() == nvinfer1::DataType::kHALF) {
-    buf = malloc(t_cpu.numel() * (sizeof(float) / 2));
-    memcpy(buf, t_cpu.data_ptr(), t_cpu.numel() * (sizeof(float) / 2));
-  } else if (dtype_optional.value() == nvinfer1::DataType::kINT8) {
-    buf = malloc(t_cpu.numel() * sizeof(char));
-    memcpy(buf, t_cpu.data_ptr(), t_cpu.numel() * sizeof(char));
-  } else if (dtype_optional.value() == nvinfer1::DataType::kINT32) {
-    buf = malloc(t_cpu.numel() * sizeof(int));
-    memcpy(buf, t_cpu.data_ptr(), t_cpu.numel() * sizeof(int));
-  } else if (dtype_optional.value() == nvinfer1::DataType::kBOOL) {
-    buf = malloc(t_cpu.numel() * sizeof(bool));
-    memcpy(buf, t_cpu.data_ptr(), t_cpu.numel() * sizeof(bool));
-  } else {
-    TORCHTRT_THROW_ERROR("Found unsupported data type for tensor to weight conversion");
+  switch (dtype_optional.value()) {
+    case nvinfer1::DataType::kFLOAT:
+    case nvinfer1::DataType::kHALF:
+    case nvinfer1::DataType::kBF16:
+    case nvinfer1::DataType::kINT8:
+    case nvinfer1::DataType::kINT32:
+    case nvinfer1::DataType::kBOOL:
+      buf = ctx->AllocateBuilderResource(t_cpu.nbytes());
+      memcpy(buf, t_cpu.data_ptr(), t_cpu.nbytes());
+      break;
+    default:
+      TORCHTRT_THROW_ERROR("Found unsupported data type for tensor to weight conversion");
   }
 
-  ctx->builder_resources.push_back(buf);
-
   this->data.type = dtype_optional.value();
   this->data.count = t_cpu.numel();
   this->data.values = buf;
@@ -17,6 +17,8 @@ struct Weights {
 
   Weights();
   Weights(ConversionCtx* ctx, at::Tensor t);
+  // Stores t as storage_type, converting it in the same pass that copies it to the host
+  Weights(ConversionCtx* ctx, at::Tensor t, at::ScalarType storage_type);
   Weights(ConversionCtx* ctx, float val);
   Weights(ConversionCtx* ctx, int32_t val);
   friend std::ostream& operator<<(std::ostream& os, const Weights& w);
@@ -181,7 +181,8 @@ nvinfer1::ITensor* add_abs(
 
   // Check if TRT Unary ops support the input type
   bool unary_supported_input = (self->getType() == nvinfer1::DataType::kFLOAT) ||
-      (self->getType() == nvinfer1::DataType::kHALF) || (self->getType() == nvinfer1::DataType::kINT8);
+      (self->getType() == nvinfer1::DataType::kHALF) || (self->getType() == nvinfer1::DataType::kBF16) ||
+      (self->getType() == nvinfer1::DataType::kINT8);
   if (unary_supported_input) {
     absolute_value_layer = ctx->net->addUnary(*self, nvinfer1::UnaryOperation::kABS);
     TORCHTRT_CHECK(absolute_value_layer, "Unable to create abs layer from node: " << *n);
@@ -240,7 +241,33 @@ nvinfer1::ITensor* castITensor(
   }
 }
 
+namespace {
+// Constants up to this many elements are pooled. Larger ones are layer parameters, which rarely repeat and would be
+// costly to key on.
+const int64_t kMaxPooledConstantElements = 64;
+
+// Type, shape and bytes of t. The key holds the contents themselves, so a hash collision can never merge two
+// different constants.
+std::string constant_pool_key(const at::Tensor& t) {
+  auto contents = t.to(at::kCPU).contiguous();
+  std::ostringstream key;
+  key << contents.scalar_type() << contents.sizes() << ':';
+  key.write(static_cast<const char*>(contents.data_ptr()), contents.nbytes());
+  return key.str();
+}
+} // namespace
+
 nvinfer1::ITensor* tensor_to_const(ConversionCtx* ctx, at::Tensor t, const std::string& name) {
+  std::string pool_key;
+  if (t.numel() <= kMaxPooledConstantElements) {
+    pool_key = constant_pool_key(t);
+    auto pooled = ctx->constant_pool.find(pool_key);
+    if (pooled != ctx->constant_pool.end()) {
+      LOG_DEBUG(ctx->logger, "Reusing pooled constant " << pooled->second->getName());
+      return pooled->second;
+    }
+  }
+
   bool post_freeze_cast = false;
   nvinfer1::DataType post_freeze_cast_type = nvinfer1::DataType::kFLOAT;
   // Other "unsupported weights types" can be added to this check here
@@ -287,6 +314,10 @@ nvinfer1::ITensor* tensor_to_const(ConversionCtx* ctx, at::Tensor t, const std::
     out = castITensor(ctx, out, post_freeze_cast_type);
   }
 
+  if (!pool_key.empty()) {
+    ctx->constant_pool[pool_key] = out;
+    ctx->pooled_constants.insert(out);
+  }
   return out;
 }
 
@@ -509,6 +540,54 @@ nvinfer1::ITensor* add_expand(ConversionCtx* ctx, nvinfer1::ITensor* in, nvinfer
   return slice_layer->getOutput(0);
 }
 
+std::vector<PackedRNNWeights> packRNNWeights(
+    const std::vector<at::Tensor>& params,
+    bool has_biases,
+    int64_t num_layers,
+    bool bidirectional,
+    bool gru) {
+  int64_t num_directions = bidirectional ? 2 : 1;
+  int64_t params_per_direction = has_biases ? 4 : 2;
+  int64_t gates = gru ? 3 : 4;
+  TORCHTRT_CHECK(
+      (int64_t)params.size() == num_layers * num_directions * params_per_direction,
+      "Expected " << num_layers * num_directions * params_per_direction << " RNN parameters but got "
+                  << params.size() << " (projections are not supported)");
+
+  std::vector<PackedRNNWeights> packed;
+  for (int64_t i = 0; i < num_layers * num_directions; i++) {
+    auto w_ih = params[i * params_per_direction];
+    auto w_hh = params[i * params_per_direction + 1];
+    auto hidden = w_hh.size(1);
+    TORCHTRT_CHECK(
+        w_ih.dim() == 2 && w_hh.dim() == 2 && w_ih.size(0) == gates * hidden && w_hh.size(0) == gates * hidden,
+        "Unexpected RNN weight shapes " << w_ih.sizes() << " and " << w_hh.sizes() << " for " << gates
+                                        << " gates of hidden size " << hidden);
+
+    PackedRNNWeights p;
+    p.w_ih = w_ih.t().contiguous();
+    p.w_hh = w_hh.t().contiguous();
+    if (has_biases) {
+      auto b_ih = params[i * params_per_direction + 2];
+      auto b_hh = params[i * params_per_direction + 3];
+      if (gru) {
+        // r and z take both biases directly, n only sees b_hn through r * (W_hn h + b_hn)
+        p.bias = at::cat({b_ih.slice(0, 0, 2 * hidden) + b_hh.slice(0, 0, 2 * hidden), b_ih.slice(0, 2 * hidden)});
+        p.hidden_bias_n = b_hh.slice(0, 2 * hidden).contiguous();
+      } else {
+        p.bias = b_ih + b_hh;
+      }
+    } else {
+      p.bias = at::zeros({gates * hidden}, w_ih.options());
+      if (gru) {
+        p.hidden_bias_n = at::zeros({hidden}, w_ih.options());
+      }
+    }
+    packed.push_back(p);
+  }
+  return packed;
+}
+
 } // namespace converters
 } // namespace conversion
 } // namespace core
@@ -65,7 +65,8 @@ nvinfer1::ITensor* castITensor(
 // Get the shape of the input tensor and cast it to INT32 type
 nvinfer1::ITensor* getShapeOutput(ConversionCtx* ctx, nvinfer1::ITensor* input_tensor, const std::string& name = "");
 
-// Freeze an at::Tensor in a IConstant layer
+// Freeze an at::Tensor in a IConstant layer. Small constants are pooled in ctx, freezing the same values again returns
+// the same ITensor (and ignores name), so callers must not modify the returned tensor
 nvinfer1::ITensor* tensor_to_const(ConversionCtx* ctx, at::Tensor t, const std::string& name = std::string());
 
 nvinfer1::ITensor* clamp(
@@ -103,6 +104,26 @@ nvinfer1::DataType promote_types(nvinfer1::DataType type_a, nvinfer1::DataType t
 
 nvinfer1::ITensor* add_expand(ConversionCtx* ctx, nvinfer1::ITensor* in, nvinfer1::Dims expandedDims);
 
+// Weights of one direction of one layer of aten::lstm / aten::gru, laid out once for the sequence converters
+struct PackedRNNWeights {
+  // [input_size, gates * hidden] and [hidden, gates * hidden], already transposed for a plain matrix multiply
+  at::Tensor w_ih;
+  at::Tensor w_hh;
+  // [gates * hidden], b_ih + b_hh for every gate whose recurrent bias can be applied with the input projection
+  at::Tensor bias;
+  // [hidden], the GRU recurrent bias of the new gate, which is scaled by the reset gate. Undefined for LSTM
+  at::Tensor hidden_bias_n;
+};
+
+// Packs the flat params list of aten::lstm / aten::gru (w_ih, w_hh[, b_ih, b_hh] per layer and direction) into one
+// entry per layer and direction, ordered like the layers of the hidden state (layer * num_directions + direction)
+std::vector<PackedRNNWeights> packRNNWeights(
+    const std::vector<at::Tensor>& params,
+    bool has_biases,
+    int64_t num_layers,
+    bool bidirectional,
+    bool gru);
+
 } // namespace converters
 } // namespace conversion
 } // namespace core
@@ -188,6 +188,34 @@ auto acthardtanh TORCHTRT_UNUSED =
 
                new_layer->setName(util::node_info(n).c_str());
 
+               auto out_tensor = ctx->AssociateValueAndTensor(n->outputs()[0], new_layer->getOutput(0));
+               LOG_DEBUG("Output shape: " << out_tensor->getDimensions());
+               return true;
+             }})
+        .pattern(
+            {"aten::gelu(Tensor self, *, str approximate='none') -> Tensor",
+             [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
+               auto in = args[0].ITensorOrFreeze(ctx);
+               auto approximate = args[1].unwrapToString("none");
+
+               nvinfer1::ActivationType act_type;
+               if (approximate == "none") {
+                 act_type = nvinfer1::ActivationType::kGELU_ERF;
+               } else if (approximate == "tanh") {
+                 act_type = nvinfer1::ActivationType::kGELU_TANH;
+               } else {
+                 TORCHTRT_THROW_ERROR("Unsupported approximate mode '" << approximate << "' for aten::gelu: " << *n);
+               }
+
+               if (in->getType() != nvinfer1::DataType::kFLOAT && in->getType() != nvinfer1::DataType::kHALF &&
+                   in->getType() != nvinfer1::DataType::kBF16) {
+                 in = castITensor(ctx, in, nvinfer1::DataType::kFLOAT, util::node_info(n) + "_cast");
+               }
+
+               auto new_layer = ctx->net->addActivation(*in, act_type);
+               TORCHTRT_CHECK(new_layer, "Unable to create layer for aten::gelu");
+               new_layer->setName(util::node_info(n).c_str());
+
                auto out_tensor = ctx->AssociateValueAndTensor(n->outputs()[0], new_layer->getOutput(0));
                LOG_DEBUG("Output shape: " << out_tensor->getDimensions());
                return true;
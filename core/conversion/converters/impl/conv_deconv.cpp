@@ -114,9 +114,14 @@ bool add_conv_deconv(ConversionCtx* ctx, const torch::jit::Node* n, args& args)
   }
 
   // Get bias tensor or initialize it to zeros.
+  // Deconvolutions with output padding add the bias through a constant layer, where it has to match the input type
   Weights bias;
   if (args[2].IValue()->isTensor()) {
-    bias = Weights(ctx, args[2].unwrapToTensor());
+    auto bias_tensor = args[2].unwrapToTensor();
+    bias = Weights(
+        ctx,
+        bias_tensor,
+        transposed ? bias_tensor.scalar_type() : ctx->ParameterWeightType(bias_tensor.scalar_type(), {bias_tensor}));
   } else {
     bias = Weights();
   }
@@ -213,7 +218,8 @@ bool add_conv_deconv(ConversionCtx* ctx, const torch::jit::Node* n, args& args)
     return true;
   }
 
-  auto w = Weights(ctx, args[1].unwrapToTensor());
+  auto kernel = args[1].unwrapToTensor();
+  auto w = Weights(ctx, kernel, ctx->ParameterWeightType(kernel.scalar_type(), {kernel}));
   // TODO: Remove this when conv3d with kernel size=1 bug is fixed.
   // Github issue: https://github.com/pytorch/TensorRT/issues/1445
   bool is_kernel_size_one = true;
@@ -6,6 +6,7 @@
 #include "torch/torch.h"
 
 #include <ATen/ATen.h>
+#include <algorithm>
 #include <vector>
 
 namespace torch_tensorrt {
@@ -15,6 +16,74 @@ namespace converters {
 namespace impl {
 namespace {
 
+// Inclusive prefix sum over a static extent in ceil(log2(n)) steps: each step adds the running result shifted by
+// 1, 2, 4, ... elements along dim, with zeros shifted in. Every step is a fill mode slice and an add, so the whole scan
+// stays parallel and can be fused, unlike a loop with one iteration per element.
+nvinfer1::ITensor* cumsum_scan(ConversionCtx* ctx, const torch::jit::Node* n, nvinfer1::ITensor* in, int dim) {
+  auto dims = in->getDimensions();
+  auto extent = dims.d[dim];
+  bool dynamic_shape = std::find(dims.d, dims.d + dims.nbDims, -1) != dims.d + dims.nbDims;
+  nvinfer1::ITensor* shape = dynamic_shape ? getShapeOutput(ctx, in, util::node_info(n) + "_shape") : nullptr;
+
+  auto out = in;
+  for (int64_t offset = 1; offset < extent; offset *= 2) {
+    std::vector<int64_t> start(dims.nbDims, 0);
+    std::vector<int64_t> stride(dims.nbDims, 1);
+    start[dim] = -offset;
+    auto shift_layer = ctx->net->addSlice(*out, util::toDims(start), dims, util::toDims(stride));
+    TORCHTRT_CHECK(shift_layer, "Unable to create slice layer from node: " << *n);
+    shift_layer->setMode(nvinfer1::SampleMode::kFILL);
+    if (dynamic_shape) {
+      shift_layer->setInput(2, *shape);
+    }
+    shift_layer->setName((util::node_info(n) + "_shift_" + std::to_string(offset)).c_str());
+
+    auto sum_layer = ctx->net->addElementWise(*out, *shift_layer->getOutput(0), nvinfer1::ElementWiseOperation::kSUM);
+    TORCHTRT_CHECK(sum_layer, "Unable to create sum layer from node: " << *n);
+    sum_layer->setName((util::node_info(n) + "_scan_" + std::to_string(offset)).c_str());
+    out = sum_layer->getOutput(0);
+  }
+
+  if (out == in) {
+    // A single element along dim is its own prefix sum
+    auto identity_layer = ctx->net->addIdentity(*in);
+    TORCHTRT_CHECK(identity_layer, "Unable to create identity layer from node: " << *n);
+    identity_layer->setName(util::node_info(n).c_str());
+    out = identity_layer->getOutput(0);
+  }
+  return out;
+}
+
+// Prefix sum over a dynamic extent, scanning through each slice across the summation axis and adding it to the
+// running sum
+nvinfer1::ITensor* cumsum_loop(ConversionCtx* ctx, nvinfer1::ITensor* in, int dim) {
+  auto loop = ctx->net->addLoop();
+  nvinfer1::ITensor* inpShape = getShapeOutput(ctx, in);
+  torch::Tensor dimValue = torch::tensor(dim, torch::kInt32);
+  nvinfer1::ITensor* axis = tensor_to_const(ctx, dimValue);
+  nvinfer1::ITensor* tripLimit = ctx->net->addGather(*inpShape, *axis, 0)->getOutput(0);
+
+  loop->addTripLimit(*tripLimit, nvinfer1::TripLimit::kCOUNT);
+
+  auto iterator = loop->addIterator(*in, dim, false);
+  auto data = iterator->getOutput(0);
+  auto newDims = data->getDimensions();
+
+  torch::Tensor zeroValue =
+      at::full(util::toVec(newDims), 0, torch_tensorrt::core::util::TRTDataTypeToScalarType(in->getType()));
+  auto zeroTensor = tensor_to_const(ctx, zeroValue);
+  auto runningSum = loop->addRecurrence(*zeroTensor);
+  auto runningSumTensor = runningSum->getOutput(0);
+
+  auto curSum = ctx->net->addElementWise(*data, *runningSumTensor, nvinfer1::ElementWiseOperation::kSUM);
+  runningSum->setInput(1, *curSum->getOutput(0));
+
+  nvinfer1::ILoopOutputLayer* loopOut =
+      loop->addLoopOutput(*curSum->getOutput(0), nvinfer1::LoopOutput::kCONCATENATE, dim);
+  loopOut->setInput(1, *tripLimit);
+  return loopOut->getOutput(0);
+}
+
 auto cumsum_registrations TORCHTRT_UNUSED = RegisterNodeConversionPatterns().pattern(
     {"aten::cumsum(Tensor self, int dim, *, int? dtype=None) -> (Tensor)",
      [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
@@ -29,39 +98,14 @@ auto cumsum_registrations TORCHTRT_UNUSED = RegisterNodeConversionPatterns().pat
          dim += input_dims.nbDims;
        }
 
-       // Scan through each slice across summation axis and add it to the running sum
-       auto loop = ctx->net->addLoop();
-       nvinfer1::ITensor* tripLimit = NULL;
+       nvinfer1::ITensor* out = nullptr;
        if (input_dims.d[dim] > 0) {
-         torch::Tensor axis = torch::tensor(input_dims.d[dim], torch::kInt32);
-         tripLimit = tensor_to_const(ctx, axis);
+         out = cumsum_scan(ctx, n, in, dim);
        } else {
-         nvinfer1::ITensor* inpShape = getShapeOutput(ctx, in);
-         torch::Tensor dimValue = torch::tensor(dim, torch::kInt32);
-         nvinfer1::ITensor* axis = tensor_to_const(ctx, dimValue);
-         tripLimit = ctx->net->addGather(*inpShape, *axis, 0)->getOutput(0);
+         out = cumsum_loop(ctx, in, dim);
        }
 
-       loop->addTripLimit(*tripLimit, nvinfer1::TripLimit::kCOUNT);
-
-       auto iterator = loop->addIterator(*in, dim, false);
-       auto data = iterator->getOutput(0);
-       auto newDims = data->getDimensions();
-
-       torch::Tensor zeroValue =
-           at::full(util::toVec(newDims), 0, torch_tensorrt::core::util::TRTDataTypeToScalarType(in->getType()));
-       auto zeroTensor = tensor_to_const(ctx, zeroValue);
-       auto runningSum = loop->addRecurrence(*zeroTensor);
-       auto runningSumTensor = runningSum->getOutput(0);
-
-       auto curSum = ctx->net->addElementWise(*data, *runningSumTensor, nvinfer1::ElementWiseOperation::kSUM);
-       runningSum->setInput(1, *curSum->getOutput(0));
-
-       nvinfer1::ILoopOutputLayer* loopOut =
-           loop->addLoopOutput(*curSum->getOutput(0), nvinfer1::LoopOutput::kCONCATENATE, dim);
-       loopOut->setInput(1, *tripLimit);
-
-       auto layer_output = ctx->AssociateValueAndTensor(n->outputs()[0], loopOut->getOutput(0));
+       auto layer_output = ctx->AssociateValueAndTensor(n->outputs()[0], out);
 
        LOG_DEBUG("Output tensor shape: " << layer_output->getDimensions());
        return true;
@@ -9,35 +9,198 @@ namespace converters {
 namespace impl {
 namespace {
 
-auto linear_registrations TORCHTRT_UNUSED = RegisterNodeConversionPatterns().pattern(
-    {"trt::attn_bias_from_attn_mask(Tensor attn_mask) -> Tensor",
-     [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
-       // Converter for internal op used in unpack_scaled_dot_product_attention
-       // We don't have visibility to check types during lowering and can't introduce conditionals so do type specific
-       // specialization here
-       auto in = args[0].ITensorOrFreeze(ctx);
-       auto out = in;
-       if (in->getType() == nvinfer1::DataType::kBOOL) {
-         auto not_layer = ctx->net->addUnary(*in, nvinfer1::UnaryOperation::kNOT);
-         TORCHTRT_CHECK(not_layer, "Unable to create not layer for attn_bias_from_attn_mask");
-         not_layer->setName((util::node_info(n) + "_not").c_str());
-         auto neg_inf = torch::tensor(-std::numeric_limits<float>::infinity());
-         auto neg_inf_itensor = tensor_to_const(ctx, neg_inf);
-         auto prod_layer = add_elementwise(
-             ctx,
-             nvinfer1::ElementWiseOperation::kPROD,
-             not_layer->getOutput(0),
-             neg_inf_itensor,
-             util::node_info(n) + "_mul");
-         auto add_layer = add_elementwise(
-             ctx, nvinfer1::ElementWiseOperation::kSUM, prod_layer->getOutput(0), in, util::node_info(n) + "_add");
-         out = add_layer->getOutput(0);
-       }
-       auto out_tensor = ctx->AssociateValueAndTensor(n->outputs()[0], out);
-       LOG_DEBUG("Output tensor shape: " << out_tensor->getDimensions());
-       LOG_DEBUG("Output tensor type: " << out_tensor->getType());
-       return true;
-     }});
+// Elements [begin, end) of a shape tensor
+nvinfer1::ITensor* shape_slice(
+    ConversionCtx* ctx,
+    nvinfer1::ITensor* shape,
+    int32_t begin,
+    int32_t end,
+    const std::string& name) {
+  std::vector<int32_t> indices;
+  for (int32_t i = begin; i < end; i++) {
+    indices.push_back(i);
+  }
+  auto gather_layer = ctx->net->addGather(*shape, *tensor_to_const(ctx, torch::tensor(indices, torch::kInt32)), 0);
+  TORCHTRT_CHECK(gather_layer, "Unable to create gather layer for " << name);
+  gather_layer->setName(name.c_str());
+  return gather_layer->getOutput(0);
+}
+
+nvinfer1::ITensor* concat_shapes(
+    ConversionCtx* ctx,
+    std::vector<nvinfer1::ITensor*> parts,
+    const std::string& name) {
+  auto concat_layer = ctx->net->addConcatenation(parts.data(), parts.size());
+  TORCHTRT_CHECK(concat_layer, "Unable to create concatenation layer for " << name);
+  concat_layer->setAxis(0);
+  concat_layer->setName(name.c_str());
+  return concat_layer->getOutput(0);
+}
+
+// 0, 1, ..., n - 1 as an INT32 tensor of shape (n), n being a one element shape tensor
+nvinfer1::ITensor* iota(ConversionCtx* ctx, nvinfer1::ITensor* n, const std::string& name) {
+  auto fill_layer = ctx->net->addFill(
+      util::toDims(std::vector<int64_t>{1}), nvinfer1::FillOperation::kLINSPACE, nvinfer1::DataType::kINT32);
+  TORCHTRT_CHECK(fill_layer, "Unable to create fill layer for " << name);
+  fill_layer->setInput(0, *n);
+  fill_layer->setAlpha(0);
+  fill_layer->setBeta(1);
+  fill_layer->setName(name.c_str());
+  return fill_layer->getOutput(0);
+}
+
+nvinfer1::ITensor* reshape(
+    ConversionCtx* ctx,
+    nvinfer1::ITensor* in,
+    std::vector<int64_t> shape,
+    const std::string& name) {
+  auto shuffle_layer = ctx->net->addShuffle(*in);
+  TORCHTRT_CHECK(shuffle_layer, "Unable to create shuffle layer for " << name);
+  shuffle_layer->setReshapeDimensions(util::toDims(shape));
+  shuffle_layer->setName(name.c_str());
+  return shuffle_layer->getOutput(0);
+}
+
+auto internal_registrations TORCHTRT_UNUSED =
+    RegisterNodeConversionPatterns()
+        .pattern(
+            {"trt::attn_bias_from_attn_mask(Tensor attn_mask, Tensor query) -> Tensor",
+             [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
+               // Converter for internal op used in unpack_scaled_dot_product_attention
+               // We don't have visibility to check types during lowering and can't introduce conditionals so do type
+               // specific specialization here
+               auto in = args[0].ITensorOrFreeze(ctx);
+               auto out = in;
+               if (in->getType() == nvinfer1::DataType::kBOOL) {
+                 // Select 0 where the mask allows attention and -inf elsewhere. Scaling the inverted mask by -inf
+                 // instead would produce NaN (0 * -inf) at every position taking part in attention.
+                 std::vector<int64_t> broadcast_shape(in->getDimensions().nbDims, 1);
+                 auto zero = tensor_to_const(ctx, torch::zeros(broadcast_shape, torch::kFloat));
+                 auto neg_inf =
+                     tensor_to_const(ctx, torch::full(broadcast_shape, -std::numeric_limits<float>::infinity()));
+                 auto select_layer = ctx->net->addSelect(*in, *zero, *neg_inf);
+                 TORCHTRT_CHECK(select_layer, "Unable to create select layer for attn_bias_from_attn_mask");
+                 select_layer->setName((util::node_info(n) + "_select").c_str());
+                 // The bias is added to the attention weights, so it has to match the type of the query
+                 auto bias_type = args[1].ITensorOrFreeze(ctx)->getType();
+                 if (bias_type != nvinfer1::DataType::kHALF && bias_type != nvinfer1::DataType::kBF16) {
+                   bias_type = nvinfer1::DataType::kFLOAT;
+                 }
+                 out = castITensor(ctx, select_layer->getOutput(0), bias_type, util::node_info(n));
+               }
+               auto out_tensor = ctx->AssociateValueAndTensor(n->outputs()[0], out);
+               LOG_DEBUG("Output tensor shape: " << out_tensor->getDimensions());
+               LOG_DEBUG("Output tensor type: " << out_tensor->getType());
+               return true;
+             }})
+        .pattern(
+            {"trt::causal_attn_bias(Tensor query, Tensor key) -> Tensor",
+             [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
+               // Builds the (L, S) triangular bias from two iotas instead of freezing an L x S constant, so it also
+               // follows dynamic sequence lengths
+               auto query = args[0].ITensorOrFreeze(ctx);
+               auto key = args[1].ITensorOrFreeze(ctx);
+               auto name = util::node_info(n);
+               auto q_rank = query->getDimensions().nbDims;
+               auto k_rank = key->getDimensions().nbDims;
+               TORCHTRT_CHECK(q_rank >= 2 && k_rank >= 2, "Expected query and key of rank 2 or more for " << *n);
+
+               auto q_len = shape_slice(ctx, getShapeOutput(ctx, query), q_rank - 2, q_rank - 1, name + "_query_len");
+               auto k_len = shape_slice(ctx, getShapeOutput(ctx, key), k_rank - 2, k_rank - 1, name + "_key_len");
+               auto rows = reshape(ctx, iota(ctx, q_len, name + "_rows"), {-1, 1}, name + "_rows_reshape");
+               auto cols = reshape(ctx, iota(ctx, k_len, name + "_cols"), {1, -1}, name + "_cols_reshape");
+
+               // Keys past the query position are hidden
+               auto hidden_layer = ctx->net->addElementWise(*cols, *rows, nvinfer1::ElementWiseOperation::kGREATER);
+               TORCHTRT_CHECK(hidden_layer, "Unable to create greater layer from node: " << *n);
+               hidden_layer->setName((name + "_hidden").c_str());
+
+               auto bias_type = query->getType();
+               if (bias_type != nvinfer1::DataType::kHALF && bias_type != nvinfer1::DataType::kBF16) {
+                 bias_type = nvinfer1::DataType::kFLOAT;
+               }
+               auto zero = tensor_to_const(ctx, torch::zeros({1, 1}, torch::kFloat));
+               auto neg_inf = tensor_to_const(ctx, torch::full({1, 1}, -std::numeric_limits<float>::infinity()));
+               auto select_layer = ctx->net->addSelect(*hidden_layer->getOutput(0), *neg_inf, *zero);
+               TORCHTRT_CHECK(select_layer, "Unable to create select layer from node: " << *n);
+               select_layer->setName((name + "_select").c_str());
+               auto bias = castITensor(ctx, select_layer->getOutput(0), bias_type, name);
+
+               auto out_tensor = ctx->AssociateValueAndTensor(n->outputs()[0], bias);
+               LOG_DEBUG("Output tensor shape: " << out_tensor->getDimensions());
+               return true;
+             }})
+        .pattern(
+            {"trt::repeat_kv_heads(Tensor kv, Tensor query) -> Tensor",
+             [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
+               // (..., H_kv, S, E) -> (..., H_kv, 1, S, E) -> broadcast to (..., H_kv, G, S, E) -> (..., H_q, S, E)
+               // with G = H_q / H_kv, all shapes taken from shape tensors so batch and sequence may be dynamic
+               auto kv = args[0].ITensorOrFreeze(ctx);
+               auto query = args[1].ITensorOrFreeze(ctx);
+               auto name = util::node_info(n);
+               auto kv_dims = kv->getDimensions();
+               auto q_dims = query->getDimensions();
+               auto rank = kv_dims.nbDims;
+               TORCHTRT_CHECK(
+                   rank >= 3 && q_dims.nbDims == rank,
+                   "Expected query and key / value of the same rank >= 3 for " << *n);
+               auto head_dim = rank - 3;
+
+               auto q_heads = q_dims.d[head_dim];
+               auto kv_heads = kv_dims.d[head_dim];
+               if (q_heads != -1 && kv_heads != -1) {
+                 TORCHTRT_CHECK(
+                     q_heads % kv_heads == 0,
+                     "Number of query heads (" << q_heads << ") must be a multiple of the number of key / value heads ("
+                                               << kv_heads << ") for " << *n);
+                 if (q_heads == kv_heads) {
+                   auto out_tensor = ctx->AssociateValueAndTensor(n->outputs()[0], kv);
+                   LOG_DEBUG("Output tensor shape: " << out_tensor->getDimensions());
+                   return true;
+                 }
+               }
+
+               auto kv_shape = getShapeOutput(ctx, kv, name + "_kv_shape");
+               auto q_shape = getShapeOutput(ctx, query, name + "_query_shape");
+               auto leading = shape_slice(ctx, kv_shape, 0, head_dim + 1, name + "_leading");
+               auto trailing = shape_slice(ctx, kv_shape, head_dim + 1, rank, name + "_trailing");
+               auto q_heads_t = shape_slice(ctx, q_shape, head_dim, head_dim + 1, name + "_q_heads");
+               auto kv_heads_t = shape_slice(ctx, kv_shape, head_dim, head_dim + 1, name + "_kv_heads");
+               auto groups_layer =
+                   ctx->net->addElementWise(*q_heads_t, *kv_heads_t, nvinfer1::ElementWiseOperation::kFLOOR_DIV);
+               TORCHTRT_CHECK(groups_layer, "Unable to create floor div layer from node: " << *n);
+               groups_layer->setName((name + "_groups").c_str());
+               auto one = tensor_to_const(ctx, torch::tensor({1}, torch::kInt32));
+
+               auto unsqueeze_layer = ctx->net->addShuffle(*kv);
+               TORCHTRT_CHECK(unsqueeze_layer, "Unable to create shuffle layer from node: " << *n);
+               unsqueeze_layer->setInput(1, *concat_shapes(ctx, {leading, one, trailing}, name + "_unsqueeze_shape"));
+               unsqueeze_layer->setName((name + "_unsqueeze").c_str());
+
+               std::vector<int64_t> start(rank + 1, 0);
+               std::vector<int64_t> stride(rank + 1, 1);
+               stride[head_dim + 1] = 0;
+               auto expanded_shape =
+                   concat_shapes(ctx, {leading, groups_layer->getOutput(0), trailing}, name + "_expanded_shape");
+               auto slice_layer = ctx->net->addSlice(
+                   *unsqueeze_layer->getOutput(0), util::toDims(start), util::toDims(start), util::toDims(stride));
+               TORCHTRT_CHECK(slice_layer, "Unable to create slice layer from node: " << *n);
+               slice_layer->setInput(2, *expanded_shape);
+               slice_layer->setName((name + "_expand").c_str());
+
+               auto collapse_layer = ctx->net->addShuffle(*slice_layer->getOutput(0));
+               TORCHTRT_CHECK(collapse_layer, "Unable to create shuffle layer from node: " << *n);
+               std::vector<nvinfer1::ITensor*> out_shape = {q_heads_t, trailing};
+               if (head_dim > 0) {
+                 out_shape.insert(out_shape.begin(), shape_slice(ctx, kv_shape, 0, head_dim, name + "_batch"));
+               }
+               collapse_layer->setInput(1, *concat_shapes(ctx, out_shape, name + "_out_shape"));
+               collapse_layer->setName((name + "_collapse").c_str());
+
+               auto out_tensor = ctx->AssociateValueAndTensor(n->outputs()[0], collapse_layer->getOutput(0));
+               LOG_DEBUG("Output tensor shape: " << out_tensor->getDimensions());
+               return true;
+             }});
 } // namespace
 } // namespace impl
 } // namespace converters
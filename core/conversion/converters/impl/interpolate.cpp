@@ -18,6 +18,7 @@ void create_plugin(
     ConversionCtx* ctx,
     const torch::jit::Node* n,
     nvinfer1::ITensor* in,
+    const std::string& reason,
     const char* name,
     std::vector<int64_t> in_shape,
     std::vector<int64_t> out_shape,
@@ -26,7 +27,9 @@ void create_plugin(
     std::string mode,
     bool align_corners,
     bool use_scales = false) {
-  LOG_WARNING("Interpolation layer will be run through ATen, not TensorRT. Performance may be lower than expected");
+  LOG_WARNING(
+      "Interpolation layer " << util::node_info(n) << " will be run through ATen, not TensorRT, since " << reason
+                             << ". Performance may be lower than expected");
   nvinfer1::PluginFieldCollection fc;
   std::vector<nvinfer1::PluginField> f;
 
@@ -66,13 +69,58 @@ void create_plugin(
   LOG_DEBUG("Output tensor shape: " << layer_output->getDimensions());
 }
 
+// PyTorch interpolation modes, each of which has an exact IResizeLayer configuration
+enum class ResizeMode {
+  // src = floor(dst * scale)
+  kNEAREST,
+  // src = floor((dst + 0.5) * scale)
+  kNEAREST_EXACT,
+  kLINEAR,
+  kCUBIC,
+};
+
+void set_resize_semantics(nvinfer1::IResizeLayer* resize_layer, ResizeMode mode, bool align_corners) {
+  switch (mode) {
+    case ResizeMode::kNEAREST:
+      resize_layer->setResizeMode(nvinfer1::InterpolationMode::kNEAREST);
+      resize_layer->setCoordinateTransformation(nvinfer1::ResizeCoordinateTransformation::kASYMMETRIC);
+      resize_layer->setNearestRounding(nvinfer1::ResizeRoundMode::kFLOOR);
+      return;
+    case ResizeMode::kNEAREST_EXACT:
+      // floor((dst + 0.5) / s - 0.5 + 0.5) is the half pixel source index rounded half up
+      resize_layer->setResizeMode(nvinfer1::InterpolationMode::kNEAREST);
+      resize_layer->setCoordinateTransformation(nvinfer1::ResizeCoordinateTransformation::kHALF_PIXEL);
+      resize_layer->setNearestRounding(nvinfer1::ResizeRoundMode::kHALF_UP);
+      return;
+    case ResizeMode::kLINEAR:
+    case ResizeMode::kCUBIC:
+      if (mode == ResizeMode::kCUBIC) {
+        // ATen's bicubic kernel uses A = -0.75 and reads clamped border pixels instead of excluding them
+        resize_layer->setResizeMode(nvinfer1::InterpolationMode::kCUBIC);
+        resize_layer->setCubicCoeff(-0.75f);
+        resize_layer->setExcludeOutside(false);
+      } else {
+        resize_layer->setResizeMode(nvinfer1::InterpolationMode::kLINEAR);
+      }
+      if (align_corners) {
+        // ATen samples the first pixel for a single element output instead of dividing by out - 1 = 0
+        resize_layer->setCoordinateTransformation(nvinfer1::ResizeCoordinateTransformation::kALIGN_CORNERS);
+        resize_layer->setSelectorForSinglePixel(nvinfer1::ResizeSelector::kUPPER);
+      } else {
+        resize_layer->setCoordinateTransformation(nvinfer1::ResizeCoordinateTransformation::kHALF_PIXEL);
+        resize_layer->setSelectorForSinglePixel(nvinfer1::ResizeSelector::kFORMULA);
+      }
+      return;
+  }
+}
+
 void resize_layer_size(
     ConversionCtx* ctx,
     const torch::jit::Node* n,
     nvinfer1::ITensor* in,
     std::vector<int64_t> out_shape,
     std::vector<float> scales,
-    nvinfer1::InterpolationMode mode,
+    ResizeMode mode,
     bool align_corners = false) {
   TORCHTRT_CHECK((out_shape.size() > 0) ^ (scales.size() > 0), "only one of out_shape or scales should be defined");
   auto resize_layer = ctx->net->addResize(*in);
@@ -99,28 +147,124 @@ void resize_layer_size(
             ->getOutput(0);
     resize_layer->setInput(1, *target_output_shape);
   } else {
+    // Output sizes are floor(in * scale) and the given scales drive the coordinate mapping, like ATen does when
+    // scale factors are passed. With align_corners both sides map through (in - 1) / (out - 1) instead.
     resize_layer->setScales(scales.data(), scales.size());
-    if (align_corners) {
-      LOG_WARNING("interpolate with align_corners and scale_factor works differently in TensorRT and PyTorch.");
-    }
   }
 
-  resize_layer->setResizeMode(mode);
+  set_resize_semantics(resize_layer, mode, align_corners);
   resize_layer->setName(util::node_info(n).c_str());
 
-  if (align_corners) {
-    resize_layer->setCoordinateTransformation(nvinfer1::ResizeCoordinateTransformation::kALIGN_CORNERS);
+  auto layer_output = ctx->AssociateValueAndTensor(n->outputs()[0], resize_layer->getOutput(0));
+
+  LOG_DEBUG("Output tensor shape: " << layer_output->getDimensions());
+}
+
+// Scales of the schemas taking one optional scale per spatial dimension, only used when all of them are given
+c10::optional<std::vector<double>> unwrap_scales(args& args, size_t begin, size_t count) {
+  std::vector<double> scales;
+  for (size_t i = begin; i < begin + count; i++) {
+    if (args[i].IValue()->isNone()) {
+      return c10::nullopt;
+    }
+    scales.push_back(args[i].IValue()->toDouble());
+  }
+  return scales;
+}
+
+// Scales of the .vec schemas
+c10::optional<std::vector<double>> unwrap_scale_factors(args& args, size_t idx) {
+  if (args[idx].IValue()->isNone()) {
+    return c10::nullopt;
+  }
+  return args[idx].unwrapToDoubleList().vec();
+}
+
+// Output size given to an upsample schema, checked against the number of spatial dimensions it resizes
+std::vector<int64_t> unwrap_output_size(
+    const torch::jit::Node* n,
+    const torch::jit::IValue* output_size,
+    size_t spatial) {
+  TORCHTRT_CHECK(
+      !output_size->isNone(),
+      "Unable to convert node: " << util::node_info(n) << "\nOne of output_size or scales should be defined");
+  auto out_size = output_size->toIntVector();
+  TORCHTRT_CHECK(
+      out_size.size() == spatial,
+      "Unable to convert node: " << util::node_info(n) << "\nInput Tensor and output size dimension mismatch");
+  return out_size;
+}
+
+// Upsampling driven by scales when every spatial dimension has one, otherwise by output_size
+void upsample(
+    ConversionCtx* ctx,
+    const torch::jit::Node* n,
+    nvinfer1::ITensor* in,
+    const torch::jit::IValue* output_size,
+    const c10::optional<std::vector<double>>& scales,
+    size_t spatial,
+    ResizeMode mode,
+    bool align_corners = false) {
+  auto in_shape = util::toVec(in->getDimensions());
+  if (scales) {
+    TORCHTRT_CHECK(
+        scales->size() == spatial,
+        "Unable to convert node: " << util::node_info(n) << "\nNumber of scale factors should match the input size");
+    std::vector<float> padded_scales(in_shape.size(), 1);
+    std::copy(scales->begin(), scales->end(), padded_scales.end() - spatial);
+    resize_layer_size(ctx, n, in, {}, padded_scales, mode, align_corners);
   } else {
-    if (mode == nvinfer1::InterpolationMode::kLINEAR) {
-      resize_layer->setCoordinateTransformation(nvinfer1::ResizeCoordinateTransformation::kHALF_PIXEL);
-    } else {
-      // kASYMMETRIC is the default transformation in TensorRT
-      resize_layer->setCoordinateTransformation(nvinfer1::ResizeCoordinateTransformation::kASYMMETRIC);
+    auto out_size = unwrap_output_size(n, output_size, spatial);
+    auto out_shape = in_shape;
+    std::copy(out_size.begin(), out_size.end(), out_shape.end() - spatial);
+    resize_layer_size(ctx, n, in, out_shape, {}, mode, align_corners);
+  }
+}
+
+// Antialiasing widens the bilinear filter to the downsampling ratio. When no dimension shrinks the filter is the plain
+// bilinear one, including at the borders, so the resize layer is exact. Shrinking has no IResizeLayer equivalent and
+// runs through the Interpolate plugin instead.
+void upsample_bilinear2d_aa(
+    ConversionCtx* ctx,
+    const torch::jit::Node* n,
+    nvinfer1::ITensor* in,
+    const torch::jit::IValue* output_size,
+    const c10::optional<std::vector<double>>& scales,
+    bool align_corners) {
+  auto in_shape = util::toVec(in->getDimensions());
+  TORCHTRT_CHECK(in_shape.size() == 4, "Unable to convert node: " << util::node_info(n) << "\nExpected a 4D input");
+
+  bool downsampling = false;
+  if (scales) {
+    downsampling = std::any_of(scales->begin(), scales->end(), [](double s) { return s < 1.0; });
+  } else {
+    auto out_size = unwrap_output_size(n, output_size, 2);
+    for (size_t i = 0; i < 2; i++) {
+      // A dynamic input dimension may be larger than the requested size
+      auto in_dim = in_shape[2 + i];
+      downsampling |= in_dim == -1 || out_size[i] < in_dim;
     }
   }
-  auto layer_output = ctx->AssociateValueAndTensor(n->outputs()[0], resize_layer->getOutput(0));
 
-  LOG_DEBUG("Output tensor shape: " << layer_output->getDimensions());
+  if (!downsampling) {
+    upsample(ctx, n, in, output_size, scales, 2, ResizeMode::kLINEAR, align_corners);
+    return;
+  }
+
+  TORCHTRT_CHECK(
+      std::find(in_shape.begin(), in_shape.end(), -1) == in_shape.end(),
+      "Unable to convert node: " << util::node_info(n)
+                                 << "\nAntialiased downsampling has no IResizeLayer equivalent and the Interpolate "
+                                    "plugin used in its place requires static input shapes");
+  auto reason = "antialiased downsampling has no IResizeLayer equivalent";
+  if (scales) {
+    create_plugin(ctx, n, in, reason, "bilinear2d_aa", in_shape, {}, {}, *scales, "bilinear_aa", align_corners, true);
+  } else {
+    auto out_size = unwrap_output_size(n, output_size, 2);
+    auto out_shape = in_shape;
+    std::copy(out_size.begin(), out_size.end(), out_shape.end() - 2);
+    create_plugin(ctx, n, in, reason, "bilinear2d_aa", in_shape, out_shape, out_size, {}, "bilinear_aa", align_corners);
+  }
 }
 
 /*
@@ -144,7 +288,7 @@ auto interpolate_registrations TORCHTRT_UNUSED =
                  float scale = args[2].IValue()->toDouble();
                  std::vector<float> padded_scales(in_shape.size(), 1);
                  padded_scales[padded_scales.size() - 1] = scale;
-                 resize_layer_size(ctx, n, in, {}, padded_scales, nvinfer1::InterpolationMode::kNEAREST);
+                 resize_layer_size(ctx, n, in, {}, padded_scales, ResizeMode::kNEAREST);
                } else {
                  // Case 2: user uses output size
                  auto out_size = util::toVec(util::toDims(args[1].unwrapToIntList()));
@@ -153,7 +297,7 @@ auto interpolate_registrations TORCHTRT_UNUSED =
 
                  auto out_shape = in_shape;
                  std::copy(out_size.begin(), out_size.end(), out_shape.begin() + (in_shape.size() - out_size.size()));
-                 resize_layer_size(ctx, n, in, out_shape, {}, nvinfer1::InterpolationMode::kNEAREST);
+                 resize_layer_size(ctx, n, in, out_shape, {}, ResizeMode::kNEAREST);
                }
 
                return true;
@@ -175,7 +319,7 @@ auto interpolate_registrations TORCHTRT_UNUSED =
                  float scale = scale_factors[0];
                  std::vector<float> padded_scales(in_shape.size(), 1);
                  padded_scales[padded_scales.size() - 1] = scale;
-                 resize_layer_size(ctx, n, in, {}, padded_scales, nvinfer1::InterpolationMode::kNEAREST);
+                 resize_layer_size(ctx, n, in, {}, padded_scales, ResizeMode::kNEAREST);
                } else {
                  // Case 2: user uses output size
                  auto out_size = util::toVec(util::toDims(args[1].unwrapToIntList()));
@@ -184,7 +328,7 @@ auto interpolate_registrations TORCHTRT_UNUSED =
 
                  auto out_shape = in_shape;
                  std::copy(out_size.begin(), out_size.end(), out_shape.begin() + (in_shape.size() - out_size.size()));
-                 resize_layer_size(ctx, n, in, out_shape, {}, nvinfer1::InterpolationMode::kNEAREST);
+                 resize_layer_size(ctx, n, in, out_shape, {}, ResizeMode::kNEAREST);
                }
 
                return true;
@@ -206,7 +350,7 @@ auto interpolate_registrations TORCHTRT_UNUSED =
                  std::vector<float> padded_scales(in_shape.size(), 1);
                  padded_scales[padded_scales.size() - 2] = scale_h;
                  padded_scales[padded_scales.size() - 1] = scale_w;
-                 resize_layer_size(ctx, n, in, {}, padded_scales, nvinfer1::InterpolationMode::kNEAREST);
+                 resize_layer_size(ctx, n, in, {}, padded_scales, ResizeMode::kNEAREST);
                } else {
                  // Case 2: user uses output size
                  auto out_size = util::toVec(util::toDims(args[1].unwrapToIntList()));
@@ -215,7 +359,7 @@ auto interpolate_registrations TORCHTRT_UNUSED =
 
                  auto out_shape = in_shape;
                  std::copy(out_size.begin(), out_size.end(), out_shape.begin() + (in_shape.size() - out_size.size()));
-                 resize_layer_size(ctx, n, in, out_shape, {}, nvinfer1::InterpolationMode::kNEAREST);
+                 resize_layer_size(ctx, n, in, out_shape, {}, ResizeMode::kNEAREST);
                }
 
                return true;
@@ -239,7 +383,7 @@ auto interpolate_registrations TORCHTRT_UNUSED =
                  std::vector<float> padded_scales(in_shape.size(), 1);
                  padded_scales[padded_scales.size() - 2] = scale_h;
                  padded_scales[padded_scales.size() - 1] = scale_w;
-                 resize_layer_size(ctx, n, in, {}, padded_scales, nvinfer1::InterpolationMode::kNEAREST);
+                 resize_layer_size(ctx, n, in, {}, padded_scales, ResizeMode::kNEAREST);
                } else {
                  // Case 2: user uses output size
                  auto out_size = util::toVec(util::toDims(args[1].unwrapToIntList()));
@@ -248,7 +392,7 @@ auto interpolate_registrations TORCHTRT_UNUSED =
 
                  auto out_shape = in_shape;
                  std::copy(out_size.begin(), out_size.end(), out_shape.begin() + (in_shape.size() - out_size.size()));
-                 resize_layer_size(ctx, n, in, out_shape, {}, nvinfer1::InterpolationMode::kNEAREST);
+                 resize_layer_size(ctx, n, in, out_shape, {}, ResizeMode::kNEAREST);
                }
 
                return true;
@@ -273,7 +417,7 @@ auto interpolate_registrations TORCHTRT_UNUSED =
                  padded_scales[padded_scales.size() - 3] = scale_d;
                  padded_scales[padded_scales.size() - 2] = scale_h;
                  padded_scales[padded_scales.size() - 1] = scale_w;
-                 resize_layer_size(ctx, n, in, {}, padded_scales, nvinfer1::InterpolationMode::kNEAREST);
+                 resize_layer_size(ctx, n, in, {}, padded_scales, ResizeMode::kNEAREST);
                } else {
                  // Case 2: user uses output size
                  auto out_size = util::toVec(util::toDims(args[1].unwrapToIntList()));
@@ -282,7 +426,7 @@ auto interpolate_registrations TORCHTRT_UNUSED =
 
                  auto out_shape = in_shape;
                  std::copy(out_size.begin(), out_size.end(), out_shape.begin() + (in_shape.size() - out_size.size()));
-                 resize_layer_size(ctx, n, in, out_shape, {}, nvinfer1::InterpolationMode::kNEAREST);
+                 resize_layer_size(ctx, n, in, out_shape, {}, ResizeMode::kNEAREST);
                }
 
                return true;
@@ -309,7 +453,7 @@ auto interpolate_registrations TORCHTRT_UNUSED =
                  padded_scales[padded_scales.size() - 3] = scale_d;
                  padded_scales[padded_scales.size() - 2] = scale_h;
                  padded_scales[padded_scales.size() - 1] = scale_w;
-                 resize_layer_size(ctx, n, in, {}, padded_scales, nvinfer1::InterpolationMode::kNEAREST);
+                 resize_layer_size(ctx, n, in, {}, padded_scales, ResizeMode::kNEAREST);
                } else {
                  // Case 2: user uses output size
                  auto out_size = util::toVec(util::toDims(args[1].unwrapToIntList()));
@@ -318,7 +462,7 @@ auto interpolate_registrations TORCHTRT_UNUSED =
 
                  auto out_shape = in_shape;
                  std::copy(out_size.begin(), out_size.end(), out_shape.begin() + (in_shape.size() - out_size.size()));
-                 resize_layer_size(ctx, n, in, out_shape, {}, nvinfer1::InterpolationMode::kNEAREST);
+                 resize_layer_size(ctx, n, in, out_shape, {}, ResizeMode::kNEAREST);
                }
 
                return true;
@@ -339,7 +483,7 @@ auto interpolate_registrations TORCHTRT_UNUSED =
                  float scale = args[3].IValue()->toDouble();
                  std::vector<float> padded_scales(in_shape.size(), 1);
                  padded_scales[padded_scales.size() - 1] = scale;
-                 resize_layer_size(ctx, n, in, {}, padded_scales, nvinfer1::InterpolationMode::kLINEAR, align_corners);
+                 resize_layer_size(ctx, n, in, {}, padded_scales, ResizeMode::kLINEAR, align_corners);
                } else {
                  // Case 2: user uses output size
                  auto out_size = util::toVec(util::toDims(args[1].unwrapToIntList()));
@@ -348,7 +492,7 @@ auto interpolate_registrations TORCHTRT_UNUSED =
 
                  auto out_shape = in_shape;
                  std::copy(out_size.begin(), out_size.end(), out_shape.begin() + (in_shape.size() - out_size.size()));
-                 resize_layer_size(ctx, n, in, out_shape, {}, nvinfer1::InterpolationMode::kLINEAR, align_corners);
+                 resize_layer_size(ctx, n, in, out_shape, {}, ResizeMode::kLINEAR, align_corners);
                }
 
                return true;
@@ -371,7 +515,7 @@ auto interpolate_registrations TORCHTRT_UNUSED =
                  float scale = scale_factors[0];
                  std::vector<float> padded_scales(in_shape.size(), 1);
                  padded_scales[padded_scales.size() - 1] = scale;
-                 resize_layer_size(ctx, n, in, {}, padded_scales, nvinfer1::InterpolationMode::kLINEAR, align_corners);
+                 resize_layer_size(ctx, n, in, {}, padded_scales, ResizeMode::kLINEAR, align_corners);
                } else {
                  // Case 2: user uses output size
                  auto out_size = util::toVec(util::toDims(args[1].unwrapToIntList()));
@@ -380,7 +524,7 @@ auto interpolate_registrations TORCHTRT_UNUSED =
 
                  auto out_shape = in_shape;
                  std::copy(out_size.begin(), out_size.end(), out_shape.begin() + (in_shape.size() - out_size.size()));
-                 resize_layer_size(ctx, n, in, out_shape, {}, nvinfer1::InterpolationMode::kLINEAR, align_corners);
+                 resize_layer_size(ctx, n, in, out_shape, {}, ResizeMode::kLINEAR, align_corners);
                }
 
                return true;
@@ -403,7 +547,7 @@ auto interpolate_registrations TORCHTRT_UNUSED =
                  std::vector<float> padded_scales(in_shape.size(), 1);
                  padded_scales[padded_scales.size() - 2] = scale_h;
                  padded_scales[padded_scales.size() - 1] = scale_w;
-                 resize_layer_size(ctx, n, in, {}, padded_scales, nvinfer1::InterpolationMode::kLINEAR, align_corners);
+                 resize_layer_size(ctx, n, in, {}, padded_scales, ResizeMode::kLINEAR, align_corners);
                } else {
                  // Case 2: user uses output size
                  auto out_size = util::toVec(util::toDims(args[1].unwrapToIntList()));
@@ -413,7 +557,7 @@ auto interpolate_registrations TORCHTRT_UNUSED =
 
                  auto out_shape = in_shape;
                  std::copy(out_size.begin(), out_size.end(), out_shape.begin() + (in_shape.size() - out_size.size()));
-                 resize_layer_size(ctx, n, in, out_shape, {}, nvinfer1::InterpolationMode::kLINEAR, align_corners);
+                 resize_layer_size(ctx, n, in, out_shape, {}, ResizeMode::kLINEAR, align_corners);
                }
 
                return true;
@@ -438,7 +582,7 @@ auto interpolate_registrations TORCHTRT_UNUSED =
                  std::vector<float> padded_scales(in_shape.size(), 1);
                  padded_scales[padded_scales.size() - 2] = scale_h;
                  padded_scales[padded_scales.size() - 1] = scale_w;
-                 resize_layer_size(ctx, n, in, {}, padded_scales, nvinfer1::InterpolationMode::kLINEAR, align_corners);
+                 resize_layer_size(ctx, n, in, {}, padded_scales, ResizeMode::kLINEAR, align_corners);
                } else {
                  // Case 2: user uses output size
                  auto out_size = util::toVec(util::toDims(args[1].unwrapToIntList()));
@@ -448,7 +592,7 @@ auto interpolate_registrations TORCHTRT_UNUSED =
 
                  auto out_shape = in_shape;
                  std::copy(out_size.begin(), out_size.end(), out_shape.begin() + (in_shape.size() - out_size.size()));
-                 resize_layer_size(ctx, n, in, out_shape, {}, nvinfer1::InterpolationMode::kLINEAR, align_corners);
+                 resize_layer_size(ctx, n, in, out_shape, {}, ResizeMode::kLINEAR, align_corners);
                }
 
                return true;
@@ -473,7 +617,7 @@ auto interpolate_registrations TORCHTRT_UNUSED =
                  padded_scales[padded_scales.size() - 3] = scale_d;
                  padded_scales[padded_scales.size() - 2] = scale_h;
                  padded_scales[padded_scales.size() - 1] = scale_w;
-                 resize_layer_size(ctx, n, in, {}, padded_scales, nvinfer1::InterpolationMode::kLINEAR, align_corners);
+                 resize_layer_size(ctx, n, in, {}, padded_scales, ResizeMode::kLINEAR, align_corners);
                } else {
                  // Case 2: user uses output size
                  auto out_size = util::toVec(util::toDims(args[1].unwrapToIntList()));
@@ -483,7 +627,7 @@ auto interpolate_registrations TORCHTRT_UNUSED =
 
                  auto out_shape = in_shape;
                  std::copy(out_size.begin(), out_size.end(), out_shape.begin() + (in_shape.size() - out_size.size()));
-                 resize_layer_size(ctx, n, in, out_shape, {}, nvinfer1::InterpolationMode::kLINEAR, align_corners);
+                 resize_layer_size(ctx, n, in, out_shape, {}, ResizeMode::kLINEAR, align_corners);
                }
 
                return true;
@@ -510,7 +654,7 @@ auto interpolate_registrations TORCHTRT_UNUSED =
                  padded_scales[padded_scales.size() - 3] = scale_d;
                  padded_scales[padded_scales.size() - 2] = scale_h;
                  padded_scales[padded_scales.size() - 1] = scale_w;
-                 resize_layer_size(ctx, n, in, {}, padded_scales, nvinfer1::InterpolationMode::kLINEAR, align_corners);
+                 resize_layer_size(ctx, n, in, {}, padded_scales, ResizeMode::kLINEAR, align_corners);
                } else {
                  // Case 2: user uses output size
                  auto out_size = util::toVec(util::toDims(args[1].unwrapToIntList()));
@@ -520,11 +664,135 @@ auto interpolate_registrations TORCHTRT_UNUSED =
 
                  auto out_shape = in_shape;
                  std::copy(out_size.begin(), out_size.end(), out_shape.begin() + (in_shape.size() - out_size.size()));
-                 resize_layer_size(ctx, n, in, out_shape, {}, nvinfer1::InterpolationMode::kLINEAR, align_corners);
+                 resize_layer_size(ctx, n, in, out_shape, {}, ResizeMode::kLINEAR, align_corners);
                }
 
                return true;
              }})
+        .pattern(
+            {"aten::_upsample_nearest_exact1d(Tensor self, int[1] output_size, float? scales=None) -> Tensor",
+             [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
+               upsample(
+                   ctx,
+                   n,
+                   args[0].ITensor(),
+                   args[1].IValue(),
+                   unwrap_scales(args, 2, 1),
+                   1,
+                   ResizeMode::kNEAREST_EXACT);
+               return true;
+             }})
+        .pattern(
+            {"aten::_upsample_nearest_exact1d.vec(Tensor input, int[]? output_size, float[]? scale_factors) -> Tensor",
+             [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
+               upsample(
+                   ctx,
+                   n,
+                   args[0].ITensor(),
+                   args[1].IValue(),
+                   unwrap_scale_factors(args, 2),
+                   1,
+                   ResizeMode::kNEAREST_EXACT);
+               return true;
+             }})
+        .pattern(
+            {"aten::_upsample_nearest_exact2d(Tensor self, int[2] output_size, float? scales_h=None, float? scales_w=None) -> Tensor",
+             [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
+               upsample(
+                   ctx,
+                   n,
+                   args[0].ITensor(),
+                   args[1].IValue(),
+                   unwrap_scales(args, 2, 2),
+                   2,
+                   ResizeMode::kNEAREST_EXACT);
+               return true;
+             }})
+        .pattern(
+            {"aten::_upsample_nearest_exact2d.vec(Tensor input, int[]? output_size, float[]? scale_factors) -> Tensor",
+             [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
+               upsample(
+                   ctx,
+                   n,
+                   args[0].ITensor(),
+                   args[1].IValue(),
+                   unwrap_scale_factors(args, 2),
+                   2,
+                   ResizeMode::kNEAREST_EXACT);
+               return true;
+             }})
+        .pattern(
+            {"aten::_upsample_nearest_exact3d(Tensor self, int[3] output_size, float? scales_d=None, float? scales_h=None, float? scales_w=None) -> Tensor",
+             [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
+               upsample(
+                   ctx,
+                   n,
+                   args[0].ITensor(),
+                   args[1].IValue(),
+                   unwrap_scales(args, 2, 3),
+                   3,
+                   ResizeMode::kNEAREST_EXACT);
+               return true;
+             }})
+        .pattern(
+            {"aten::_upsample_nearest_exact3d.vec(Tensor input, int[]? output_size, float[]? scale_factors) -> Tensor",
+             [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
+               upsample(
+                   ctx,
+                   n,
+                   args[0].ITensor(),
+                   args[1].IValue(),
+                   unwrap_scale_factors(args, 2),
+                   3,
+                   ResizeMode::kNEAREST_EXACT);
+               return true;
+             }})
+        .pattern(
+            {"aten::upsample_bicubic2d(Tensor self, int[2] output_size, bool align_corners, float? scales_h=None, float? scales_w=None) -> Tensor",
+             [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
+               bool align_corners = args[2].unwrapToBool();
+               upsample(
+                   ctx,
+                   n,
+                   args[0].ITensor(),
+                   args[1].IValue(),
+                   unwrap_scales(args, 3, 2),
+                   2,
+                   ResizeMode::kCUBIC,
+                   align_corners);
+               return true;
+             }})
+        .pattern(
+            {"aten::upsample_bicubic2d.vec(Tensor input, int[]? output_size, bool align_corners, float[]? scale_factors) -> Tensor",
+             [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
+               bool align_corners = args[2].unwrapToBool();
+               upsample(
+                   ctx,
+                   n,
+                   args[0].ITensor(),
+                   args[1].IValue(),
+                   unwrap_scale_factors(args, 3),
+                   2,
+                   ResizeMode::kCUBIC,
+                   align_corners);
+               return true;
+             }})
+        .pattern(
+            {"aten::_upsample_bilinear2d_aa(Tensor self, int[2] output_size, bool align_corners, float? scales_h=None, float? scales_w=None) -> Tensor",
+             [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
+               bool align_corners = args[2].unwrapToBool();
+               upsample_bilinear2d_aa(
+                   ctx, n, args[0].ITensor(), args[1].IValue(), unwrap_scales(args, 3, 2), align_corners);
+               return true;
+             }})
+        .pattern(
+            {"aten::_upsample_bilinear2d_aa.vec(Tensor input, int[]? output_size, bool align_corners, float[]? scale_factors) -> Tensor",
+             [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
+               bool align_corners = args[2].unwrapToBool();
+               upsample_bilinear2d_aa(
+                   ctx, n, args[0].ITensor(), args[1].IValue(), unwrap_scale_factors(args, 3), align_corners);
+               return true;
+             }})
         .pattern(
             {"aten::grid_sampler(Tensor input, Tensor grid, int interpolation_mode, int padding_mode, bool align_corners) -> Tensor",
              [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
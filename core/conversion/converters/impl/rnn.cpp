@@ -0,0 +1,367 @@
+#include "NvInfer.h"
+#include "core/conversion/converters/converters.h"
+#include "core/conversion/tensorcontainer/TensorContainer.h"
+#include "core/util/prelude.h"
+#include "torch/torch.h"
+
+#include <ATen/ATen.h>
+#include <vector>
+
+namespace torch_tensorrt {
+namespace core {
+namespace conversion {
+namespace converters {
+namespace impl {
+namespace {
+
+// Shared state of one aten::lstm / aten::gru conversion
+struct RNNContext {
+  ConversionCtx* ctx;
+  const torch::jit::Node* n;
+  bool gru;
+  int64_t hidden;
+  // Sequence length as a rank 0 INT32 tensor, used as trip limit and for the concatenated loop outputs
+  nvinfer1::ITensor* seq_len;
+  // Shape of a single gate ([batch, hidden]), only set when the batch size is dynamic
+  nvinfer1::ITensor* gate_shape;
+  int64_t batch;
+};
+
+std::string layer_name(const RNNContext& rnn, const std::string& suffix) {
+  return util::node_info(rnn.n) + "_" + suffix;
+}
+
+nvinfer1::ITensor* elementwise(
+    const RNNContext& rnn,
+    nvinfer1::ElementWiseOperation op,
+    nvinfer1::ITensor* a,
+    nvinfer1::ITensor* b,
+    const std::string& name) {
+  auto layer = rnn.ctx->net->addElementWise(*a, *b, op);
+  TORCHTRT_CHECK(layer, "Unable to create ElementWise layer from node: " << *rnn.n);
+  layer->setName(name.c_str());
+  return layer->getOutput(0);
+}
+
+nvinfer1::ITensor* activation(
+    const RNNContext& rnn,
+    nvinfer1::ITensor* in,
+    nvinfer1::ActivationType type,
+    const std::string& name) {
+  auto layer = rnn.ctx->net->addActivation(*in, type);
+  TORCHTRT_CHECK(layer, "Unable to create activation layer from node: " << *rnn.n);
+  layer->setName(name.c_str());
+  return layer->getOutput(0);
+}
+
+// Gate g of a [batch, gates * hidden] tensor
+nvinfer1::ITensor* gate(const RNNContext& rnn, nvinfer1::ITensor* gates, int64_t g, const std::string& name) {
+  auto slice = rnn.ctx->net->addSlice(
+      *gates,
+      util::toDims(std::vector<int64_t>{0, g * rnn.hidden}),
+      util::toDims(std::vector<int64_t>{rnn.batch, rnn.hidden}),
+      util::toDims(std::vector<int64_t>{1, 1}));
+  TORCHTRT_CHECK(slice, "Unable to create slice layer from node: " << *rnn.n);
+  if (rnn.gate_shape) {
+    slice->setInput(2, *rnn.gate_shape);
+  }
+  slice->setName(name.c_str());
+  return slice->getOutput(0);
+}
+
+// Layer k of a [layers * directions, batch, hidden] state
+nvinfer1::ITensor* state_for(const RNNContext& rnn, nvinfer1::ITensor* state, int64_t k, const std::string& name) {
+  auto index = tensor_to_const(rnn.ctx, torch::tensor(k, torch::kInt32));
+  auto gather = rnn.ctx->net->addGather(*state, *index, 0);
+  TORCHTRT_CHECK(gather, "Unable to create gather layer from node: " << *rnn.n);
+  gather->setName(name.c_str());
+  return gather->getOutput(0);
+}
+
+struct DirectionOutputs {
+  nvinfer1::ITensor* y;
+  nvinfer1::ITensor* h;
+  nvinfer1::ITensor* c;
+};
+
+// Runs one direction of one layer over a [seq, batch, input] sequence. The input projection of every time step is
+// computed by a single matrix multiply before the loop, so each iteration only multiplies the hidden state.
+DirectionOutputs add_direction(
+    const RNNContext& rnn,
+    nvinfer1::ITensor* x,
+    const PackedRNNWeights& w,
+    nvinfer1::ITensor* h0,
+    nvinfer1::ITensor* c0,
+    bool reverse,
+    const std::string& prefix) {
+  auto ctx = rnn.ctx;
+  auto gates = w.w_ih.size(1);
+
+  auto w_ih = tensor_to_const(ctx, w.w_ih.unsqueeze(0), layer_name(rnn, prefix + "_w_ih"));
+  auto proj_mm =
+      ctx->net->addMatrixMultiply(*x, nvinfer1::MatrixOperation::kNONE, *w_ih, nvinfer1::MatrixOperation::kNONE);
+  TORCHTRT_CHECK(proj_mm, "Unable to create matrix multiplication layer from node: " << *rnn.n);
+  proj_mm->setName(layer_name(rnn, prefix + "_input_projection").c_str());
+  auto bias = tensor_to_const(ctx, w.bias.reshape({1, 1, gates}), layer_name(rnn, prefix + "_bias"));
+  auto proj = elementwise(
+      rnn, nvinfer1::ElementWiseOperation::kSUM, proj_mm->getOutput(0), bias, layer_name(rnn, prefix + "_proj_bias"));
+
+  auto loop = ctx->net->addLoop();
+  TORCHTRT_CHECK(loop, "Unable to create loop from node: " << *rnn.n);
+  loop->setName(layer_name(rnn, prefix + "_loop").c_str());
+  loop->addTripLimit(*rnn.seq_len, nvinfer1::TripLimit::kCOUNT);
+  auto x_t = loop->addIterator(*proj, 0, reverse)->getOutput(0);
+
+  auto h_rec = loop->addRecurrence(*h0);
+  auto h = h_rec->getOutput(0);
+  nvinfer1::IRecurrenceLayer* c_rec = nullptr;
+
+  auto w_hh = tensor_to_const(ctx, w.w_hh, layer_name(rnn, prefix + "_w_hh"));
+  auto rec_mm =
+      ctx->net->addMatrixMultiply(*h, nvinfer1::MatrixOperation::kNONE, *w_hh, nvinfer1::MatrixOperation::kNONE);
+  TORCHTRT_CHECK(rec_mm, "Unable to create matrix multiplication layer from node: " << *rnn.n);
+  rec_mm->setName(layer_name(rnn, prefix + "_recurrent_projection").c_str());
+  auto h_proj = rec_mm->getOutput(0);
+
+  nvinfer1::ITensor* h_next = nullptr;
+  nvinfer1::ITensor* c_next = nullptr;
+  if (rnn.gru) {
+    // r = sigmoid(x_r + h_r), z = sigmoid(x_z + h_z), n = tanh(x_n + r * (h_n + b_hn)), h' = n + z * (h - n)
+    auto sum = [&](int64_t g, const std::string& g_name) {
+      return elementwise(
+          rnn,
+          nvinfer1::ElementWiseOperation::kSUM,
+          gate(rnn, x_t, g, layer_name(rnn, prefix + "_x_" + g_name)),
+          gate(rnn, h_proj, g, layer_name(rnn, prefix + "_h_" + g_name)),
+          layer_name(rnn, prefix + "_" + g_name + "_sum"));
+    };
+    auto r = activation(rnn, sum(0, "r"), nvinfer1::ActivationType::kSIGMOID, layer_name(rnn, prefix + "_r"));
+    auto z = activation(rnn, sum(1, "z"), nvinfer1::ActivationType::kSIGMOID, layer_name(rnn, prefix + "_z"));
+
+    auto b_hn = tensor_to_const(ctx, w.hidden_bias_n.reshape({1, rnn.hidden}), layer_name(rnn, prefix + "_b_hn"));
+    auto h_n = elementwise(
+        rnn,
+        nvinfer1::ElementWiseOperation::kSUM,
+        gate(rnn, h_proj, 2, layer_name(rnn, prefix + "_h_n")),
+        b_hn,
+        layer_name(rnn, prefix + "_h_n_bias"));
+    auto reset = elementwise(rnn, nvinfer1::ElementWiseOperation::kPROD, r, h_n, layer_name(rnn, prefix + "_reset"));
+    auto n_in = elementwise(
+        rnn,
+        nvinfer1::ElementWiseOperation::kSUM,
+        gate(rnn, x_t, 2, layer_name(rnn, prefix + "_x_n")),
+        reset,
+        layer_name(rnn, prefix + "_n_sum"));
+    auto n_gate = activation(rnn, n_in, nvinfer1::ActivationType::kTANH, layer_name(rnn, prefix + "_n"));
+
+    auto diff = elementwise(rnn, nvinfer1::ElementWiseOperation::kSUB, h, n_gate, layer_name(rnn, prefix + "_h_sub"));
+    auto update =
+        elementwise(rnn, nvinfer1::ElementWiseOperation::kPROD, z, diff, layer_name(rnn, prefix + "_update"));
+    h_next = elementwise(rnn, nvinfer1::ElementWiseOperation::kSUM, n_gate, update, layer_name(rnn, prefix + "_h"));
+  } else {
+    // i, f, g, o = split(x_t + h W_hh), c' = f * c + i * g, h' = o * tanh(c')
+    c_rec = loop->addRecurrence(*c0);
+    auto c = c_rec->getOutput(0);
+    auto all =
+        elementwise(rnn, nvinfer1::ElementWiseOperation::kSUM, x_t, h_proj, layer_name(rnn, prefix + "_gates"));
+    auto i = activation(
+        rnn,
+        gate(rnn, all, 0, layer_name(rnn, prefix + "_i_slice")),
+        nvinfer1::ActivationType::kSIGMOID,
+        layer_name(rnn, prefix + "_i"));
+    auto f = activation(
+        rnn,
+        gate(rnn, all, 1, layer_name(rnn, prefix + "_f_slice")),
+        nvinfer1::ActivationType::kSIGMOID,
+        layer_name(rnn, prefix + "_f"));
+    auto g = activation(
+        rnn,
+        gate(rnn, all, 2, layer_name(rnn, prefix + "_g_slice")),
+        nvinfer1::ActivationType::kTANH,
+        layer_name(rnn, prefix + "_g"));
+    auto o = activation(
+        rnn,
+        gate(rnn, all, 3, layer_name(rnn, prefix + "_o_slice")),
+        nvinfer1::ActivationType::kSIGMOID,
+        layer_name(rnn, prefix + "_o"));
+
+    auto forget = elementwise(rnn, nvinfer1::ElementWiseOperation::kPROD, f, c, layer_name(rnn, prefix + "_forget"));
+    auto input = elementwise(rnn, nvinfer1::ElementWiseOperation::kPROD, i, g, layer_name(rnn, prefix + "_input"));
+    c_next = elementwise(rnn, nvinfer1::ElementWiseOperation::kSUM, forget, input, layer_name(rnn, prefix + "_c"));
+    auto c_tanh = activation(rnn, c_next, nvinfer1::ActivationType::kTANH, layer_name(rnn, prefix + "_c_tanh"));
+    h_next = elementwise(rnn, nvinfer1::ElementWiseOperation::kPROD, o, c_tanh, layer_name(rnn, prefix + "_h"));
+    c_rec->setInput(1, *c_next);
+  }
+  h_rec->setInput(1, *h_next);
+
+  // Reverse outputs are written back in sequence order so both directions line up for the concatenation
+  auto y_out = loop->addLoopOutput(
+      *h_next, reverse ? nvinfer1::LoopOutput::kREVERSE : nvinfer1::LoopOutput::kCONCATENATE, 0);
+  y_out->setInput(1, *rnn.seq_len);
+  y_out->setName(layer_name(rnn, prefix + "_y").c_str());
+  auto h_out = loop->addLoopOutput(*h_next, nvinfer1::LoopOutput::kLAST_VALUE);
+  h_out->setName(layer_name(rnn, prefix + "_h_n").c_str());
+
+  DirectionOutputs out = {y_out->getOutput(0), h_out->getOutput(0), nullptr};
+  if (c_rec) {
+    auto c_out = loop->addLoopOutput(*c_next, nvinfer1::LoopOutput::kLAST_VALUE);
+    c_out->setName(layer_name(rnn, prefix + "_c_n").c_str());
+    out.c = c_out->getOutput(0);
+  }
+  return out;
+}
+
+nvinfer1::ITensor* concat(
+    const RNNContext& rnn,
+    std::vector<nvinfer1::ITensor*> in,
+    int axis,
+    const std::string& name) {
+  if (in.size() == 1) {
+    return in[0];
+  }
+  auto layer = rnn.ctx->net->addConcatenation(in.data(), in.size());
+  TORCHTRT_CHECK(layer, "Unable to create concatenation layer from node: " << *rnn.n);
+  layer->setAxis(axis);
+  layer->setName(name.c_str());
+  return layer->getOutput(0);
+}
+
+nvinfer1::ITensor* transpose_seq_batch(const RNNContext& rnn, nvinfer1::ITensor* in, const std::string& name) {
+  auto shuffle = rnn.ctx->net->addShuffle(*in);
+  TORCHTRT_CHECK(shuffle, "Unable to create shuffle layer from node: " << *rnn.n);
+  shuffle->setFirstTranspose(nvinfer1::Permutation{{1, 0, 2}});
+  shuffle->setName(name.c_str());
+  return shuffle->getOutput(0);
+}
+
+// Stacks the final [batch, hidden] states of every layer and direction into [layers * directions, batch, hidden]
+nvinfer1::ITensor* stack_states(
+    const RNNContext& rnn,
+    std::vector<nvinfer1::ITensor*> states,
+    const std::string& name) {
+  auto flat = concat(rnn, states, 0, name + "_concat");
+  auto shuffle = rnn.ctx->net->addShuffle(*flat);
+  TORCHTRT_CHECK(shuffle, "Unable to create shuffle layer from node: " << *rnn.n);
+  shuffle->setReshapeDimensions(util::toDims(std::vector<int64_t>{(int64_t)states.size(), -1, rnn.hidden}));
+  shuffle->setName(name.c_str());
+  return shuffle->getOutput(0);
+}
+
+std::vector<at::Tensor> unwrap_params(const torch::jit::Node* n, args& args) {
+  std::vector<at::Tensor> params;
+  for (auto p : args[2].IValue()->toListRef()) {
+    TORCHTRT_CHECK(
+        p.isTensor(), "RNN weights must be constants to be packed at conversion time, got a computed weight in " << *n);
+    params.push_back(p.toTensor());
+  }
+  return params;
+}
+
+nvinfer1::ITensor* unwrap_state(ConversionCtx* ctx, const c10::IValue& state) {
+  if (state.isTensor()) {
+    return tensor_to_const(ctx, state.toTensor());
+  }
+  return state.toCustomClass<TensorContainer>()->tensor();
+}
+
+bool convert_rnn(ConversionCtx* ctx, const torch::jit::Node* n, args& args, bool gru) {
+  auto input = args[0].ITensorOrFreeze(ctx);
+  nvinfer1::ITensor* h0 = nullptr;
+  nvinfer1::ITensor* c0 = nullptr;
+  if (gru) {
+    h0 = args[1].ITensorOrFreeze(ctx);
+  } else {
+    auto hx = args[1].IValue()->toListRef();
+    TORCHTRT_CHECK(hx.size() == 2, "Expected (h0, c0) as the LSTM state of " << *n);
+    h0 = unwrap_state(ctx, hx[0]);
+    c0 = unwrap_state(ctx, hx[1]);
+  }
+  auto has_biases = args[3].unwrapToBool();
+  auto num_layers = args[4].unwrapToInt();
+  auto train = args[6].unwrapToBool();
+  auto bidirectional = args[7].unwrapToBool();
+  auto batch_first = args[8].unwrapToBool();
+  if (train && args[5].unwrapToDouble() > 0) {
+    LOG_WARNING("Dropout between RNN layers is ignored at inference time for " << *n);
+  }
+
+  auto packed = packRNNWeights(unwrap_params(n, args), has_biases, num_layers, bidirectional, gru);
+  int64_t num_directions = bidirectional ? 2 : 1;
+  TORCHTRT_CHECK(input->getDimensions().nbDims == 3, "Expected a 3D input sequence for " << *n);
+
+  RNNContext rnn = {ctx, n, gru, packed[0].w_hh.size(0), nullptr, nullptr, 0};
+  auto x = batch_first ? transpose_seq_batch(rnn, input, layer_name(rnn, "seq_first")) : input;
+  auto x_dims = x->getDimensions();
+  auto x_shape = getShapeOutput(ctx, x, layer_name(rnn, "input_shape"));
+  // The trip limit and the length of the concatenated outputs are rank 0 tensors
+  if (x_dims.d[0] > 0) {
+    rnn.seq_len = tensor_to_const(ctx, torch::tensor(x_dims.d[0], torch::kInt32));
+  } else {
+    auto gather = ctx->net->addGather(*x_shape, *tensor_to_const(ctx, torch::tensor(0, torch::kInt32)), 0);
+    TORCHTRT_CHECK(gather, "Unable to create gather layer from node: " << *n);
+    rnn.seq_len = gather->getOutput(0);
+  }
+
+  rnn.batch = x_dims.d[1];
+  if (rnn.batch < 0) {
+    auto batch = ctx->net->addGather(*x_shape, *tensor_to_const(ctx, torch::tensor({1}, torch::kInt32)), 0);
+    TORCHTRT_CHECK(batch, "Unable to create gather layer from node: " << *n);
+    std::vector<nvinfer1::ITensor*> shape = {
+        batch->getOutput(0), tensor_to_const(ctx, torch::tensor({rnn.hidden}, torch::kInt32))};
+    rnn.gate_shape = concat(rnn, shape, 0, layer_name(rnn, "gate_shape"));
+  }
+
+  std::vector<nvinfer1::ITensor*> h_n;
+  std::vector<nvinfer1::ITensor*> c_n;
+  for (int64_t l = 0; l < num_layers; l++) {
+    std::vector<nvinfer1::ITensor*> ys;
+    for (int64_t d = 0; d < num_directions; d++) {
+      auto k = l * num_directions + d;
+      auto prefix = "l" + std::to_string(l) + (d ? "_reverse" : "");
+      auto out = add_direction(
+          rnn,
+          x,
+          packed[k],
+          state_for(rnn, h0, k, layer_name(rnn, prefix + "_h0")),
+          gru ? nullptr : state_for(rnn, c0, k, layer_name(rnn, prefix + "_c0")),
+          d == 1,
+          prefix);
+      ys.push_back(out.y);
+      h_n.push_back(out.h);
+      if (!gru) {
+        c_n.push_back(out.c);
+      }
+    }
+    x = concat(rnn, ys, 2, layer_name(rnn, "l" + std::to_string(l) + "_output"));
+  }
+
+  auto y = batch_first ? transpose_seq_batch(rnn, x, layer_name(rnn, "batch_first")) : x;
+  auto y_out = ctx->AssociateValueAndTensor(n->outputs()[0], y);
+  auto h_out = ctx->AssociateValueAndTensor(n->outputs()[1], stack_states(rnn, h_n, layer_name(rnn, "h_n")));
+  LOG_DEBUG("Output tensor [output] shape: " << y_out->getDimensions());
+  LOG_DEBUG("Output tensor [h_n] shape: " << h_out->getDimensions());
+  if (!gru) {
+    auto c_out = ctx->AssociateValueAndTensor(n->outputs()[2], stack_states(rnn, c_n, layer_name(rnn, "c_n")));
+    LOG_DEBUG("Output tensor [c_n] shape: " << c_out->getDimensions());
+  }
+  return true;
+}
+
+auto rnn_registrations TORCHTRT_UNUSED =
+    RegisterNodeConversionPatterns()
+        .pattern(
+            {"aten::lstm.input(Tensor input, Tensor[] hx, Tensor[] params, bool has_biases, int num_layers, float dropout, bool train, bool bidirectional, bool batch_first) -> (Tensor, Tensor, Tensor)",
+             [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
+               return convert_rnn(ctx, n, args, /*gru=*/false);
+             }})
+        .pattern(
+            {"aten::gru.input(Tensor input, Tensor hx, Tensor[] params, bool has_biases, int num_layers, float dropout, bool train, bool bidirectional, bool batch_first) -> (Tensor, Tensor)",
+             [](ConversionCtx* ctx, const torch::jit::Node* n, args& args) -> bool {
+               return convert_rnn(ctx, n, args, /*gru=*/true);
+             }});
+} // namespace
+} // namespace impl
+} // namespace converters
+} // namespace conversion
+} // namespace core
+} // namespace torch_tensorrt
@@ -1,3 +1,5 @@
+#include <mutex>
+#include <shared_mutex>
 #include <unordered_map>
 
 #include "ATen/core/List.h"
@@ -17,8 +19,8 @@ namespace evaluators {
 namespace {
 using EvaluatorLUT = std::unordered_map<torch::jit::NodeKind, EvalRegistration>;
 
-bool FindInVec(std::vector<c10::OperatorName>& names, c10::OperatorName target) {
-  for (auto n : names) {
+bool FindInVec(const std::vector<c10::OperatorName>& names, const c10::OperatorName& target) {
+  for (auto& n : names) {
     if (n == target) {
       return true;
     }
@@ -42,18 +44,20 @@ class NodeEvaluatorRegistry {
     evaluator_lut_[node_kind] = std::move(eval_reg);
   }
 
-  NodeEvaluator FindEvaluator(const torch::jit::Node* n) {
+  // Registrations live in the LUT for the lifetime of the program, so the returned pointer stays valid
+  const EvalRegistration* FindEvaluator(const torch::jit::Node* n) {
     auto node_kind = n->kind();
     auto iter = evaluator_lut_.find(node_kind);
     if (iter == evaluator_lut_.end()) {
       return nullptr;
     }
-    auto eval_reg = iter->second;
+    auto& eval_reg = iter->second;
     if (eval_reg.options.use()) {
-      for (auto o : n->outputs()) {
-        if (eval_reg.options.blacklisted_output_types.find(o->type()) !=
-            eval_reg.options.blacklisted_output_types.end()) {
-          return nullptr;
+      if (eval_reg.options.blacklisted_output_kinds.any()) {
+        for (auto o : n->outputs()) {
+          if (eval_reg.options.isBlacklisted(o->type())) {
+            return nullptr;
+          }
         }
       }
 
@@ -63,20 +67,20 @@ class NodeEvaluatorRegistry {
             schema,
             "Evaluator for " << node_kind.toQualString() << " only runs on certain schemas, but schema for target"
                              << " node is not a supported schema variant of " << node_kind.toQualString());
-        if (!FindInVec(eval_reg.options.valid_schemas, schema->operator_name())) {
+        if (!IsValidSchema(node_kind, eval_reg, schema)) {
           return nullptr;
         }
       }
     }
 
-    return eval_reg.evaluator;
+    return &eval_reg;
   }
 
-  NodeEvaluator GetEvaluator(const torch::jit::Node* n) {
-    auto evaluator = FindEvaluator(n);
+  const NodeEvaluator& GetEvaluator(const torch::jit::Node* n) {
+    auto eval_reg = FindEvaluator(n);
     TORCHTRT_CHECK(
-        evaluator, "Requested evaluator for " << n->kind().toQualString() << ", but no such evaluator was found");
-    return evaluator;
+        eval_reg, "Requested evaluator for " << n->kind().toQualString() << ", but no such evaluator was found");
+    return eval_reg->evaluator;
   }
 
   std::vector<std::string> GetRegisteredEvaluatorList() {
@@ -96,8 +100,37 @@ class NodeEvaluatorRegistry {
   }
 
  private:
+  // Schemas are owned by the operator registry and nodes share them, so whether a schema is one of the valid variants
+  // of an evaluator is resolved once per (node kind, schema) instead of comparing operator names for every node.
+  // Conversions can run concurrently, hence the lock.
+  bool IsValidSchema(
+      torch::jit::NodeKind node_kind,
+      const EvalRegistration& eval_reg,
+      const c10::FunctionSchema* schema) {
+    auto key = std::make_pair(node_kind, schema);
+    {
+      std::shared_lock<std::shared_mutex> lock(schema_cache_mutex_);
+      auto cached = schema_cache_.find(key);
+      if (cached != schema_cache_.end()) {
+        return cached->second;
+      }
+    }
+    auto valid = FindInVec(eval_reg.options.valid_schemas, schema->operator_name());
+    std::unique_lock<std::shared_mutex> lock(schema_cache_mutex_);
+    schema_cache_.emplace(key, valid);
+    return valid;
+  }
+
+  struct SchemaKeyHash {
+    size_t operator()(const std::pair<torch::jit::NodeKind, const c10::FunctionSchema*>& key) const {
+      return std::hash<torch::jit::NodeKind>()(key.first) ^ (std::hash<const c10::FunctionSchema*>()(key.second) << 1);
+    }
+  };
+
   EvaluatorLUT evaluator_lut_;
   std::set<std::string> registered_evaluator_schemas_;
+  std::unordered_map<std::pair<torch::jit::NodeKind, const c10::FunctionSchema*>, bool, SchemaKeyHash> schema_cache_;
+  std::shared_mutex schema_cache_mutex_;
 };
 
 NodeEvaluatorRegistry& get_evaluator_registry() {
@@ -114,8 +147,12 @@ std::vector<std::string> getEvaluatorList() {
   return get_evaluator_registry().GetRegisteredEvaluatorList();
 }
 
+const NodeEvaluator& getEvaluator(const torch::jit::Node* n) {
+  return get_evaluator_registry().GetEvaluator(n);
+}
+
 c10::optional<torch::jit::IValue> EvalNode(ConversionCtx* ctx, const torch::jit::Node* n, kwargs& args) {
-  auto evaluator = get_evaluator_registry().GetEvaluator(n);
+  auto& evaluator = get_evaluator_registry().GetEvaluator(n);
   return evaluator(ctx, n, args);
 }
 
@@ -830,7 +830,9 @@ auto aten_registrations TORCHTRT_UNUSED =
                if (tensor_var.isITensor()) {
                  auto tensor = tensor_var.ITensor();
                  auto t = tensor->getType();
-                 return (t == nvinfer1::DataType::kFLOAT || t == nvinfer1::DataType::kHALF);
+                 return (
+                     t == nvinfer1::DataType::kFLOAT || t == nvinfer1::DataType::kHALF ||
+                     t == nvinfer1::DataType::kBF16);
                } else {
                  auto tensor = tensor_var.unwrapToTensor();
                  auto t = tensor.scalar_type();
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <bitset>
 #include <map>
 #include <set>
 #include <string>
@@ -38,16 +39,31 @@ inline bool constTypesOnly(kwargs& args) {
 typedef std::function<c10::optional<torch::jit::IValue>(ConversionCtx*, const torch::jit::Node*, kwargs&)>
     NodeEvaluator;
 
+#define TORCHTRT_COUNT_TYPE_KIND(T) +1
+constexpr size_t kNumTypeKinds = 0 C10_FORALL_TYPES(TORCHTRT_COUNT_TYPE_KIND);
+#undef TORCHTRT_COUNT_TYPE_KIND
+
 struct EvalOptions {
   std::set<c10::TypePtr> blacklisted_output_types;
+  // Kinds of blacklisted_output_types, lets most outputs be cleared without a lookup in the set
+  std::bitset<kNumTypeKinds> blacklisted_output_kinds;
   std::vector<c10::OperatorName> valid_schemas;
   std::vector<std::string> supported_variants;
   EvalOptions() = default;
   EvalOptions& blacklistOutputTypes(std::set<c10::TypePtr> types) {
     use_options = true;
     blacklisted_output_types = types;
+    blacklisted_output_kinds.reset();
+    for (auto& t : blacklisted_output_types) {
+      blacklisted_output_kinds.set(static_cast<size_t>(t->kind()));
+    }
     return *this;
   }
+  // Only the blacklisted types themselves match, not other types of the same kind (e.g. refined tensor types)
+  bool isBlacklisted(const c10::TypePtr& type) const {
+    return blacklisted_output_kinds.test(static_cast<size_t>(type->kind())) &&
+        blacklisted_output_types.find(type) != blacklisted_output_types.end();
+  }
   EvalOptions& validSchemas(std::set<std::string> schemas) {
     std::copy(schemas.begin(), schemas.end(), std::back_inserter(supported_variants));
     use_options = true;
@@ -56,7 +72,7 @@ struct EvalOptions {
     }
     return *this;
   }
-  bool use() {
+  bool use() const {
     return use_options;
   }
 
@@ -76,6 +92,9 @@ struct EvalRegistration {
 };
 
 c10::optional<torch::jit::IValue> EvalNode(ConversionCtx* ctx, const torch::jit::Node* n, kwargs& args);
+// Evaluator EvalNode would run for n, for callers evaluating the same node many times. The reference stays valid for
+// the lifetime of the program.
+const NodeEvaluator& getEvaluator(const torch::jit::Node* n);
 bool shouldEvalAtConversionTime(const torch::jit::Node* n);
 std::vector<std::string> getEvaluatorList();
 void register_node_evaluator(torch::jit::NodeKind node_kind, NodeEvaluator evaluator);
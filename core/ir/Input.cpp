@@ -39,6 +39,14 @@ bool valid_dtype_format_combo(nvinfer1::DataType dtype, nvinfer1::TensorFormat f
         default:
           return false;
       }
+    case nvinfer1::DataType::kBF16: // Supports just Linear (NCHW)
+      switch (format) {
+        case nvinfer1::TensorFormat::kLINEAR:
+          return true;
+        case nvinfer1::TensorFormat::kHWC:
+        default:
+          return false;
+      }
     case nvinfer1::DataType::kFLOAT: // Supports both Linear (NCHW) and channel last (NHWC)
       switch (format) {
         case nvinfer1::TensorFormat::kLINEAR:
@@ -68,12 +76,15 @@ bool valid_input_dtype(nvinfer1::DataType dtype) {
       return true;
     case nvinfer1::DataType::kHALF:
       return true;
+    case nvinfer1::DataType::kBF16:
+      return true;
     case nvinfer1::DataType::kINT8:
       return true;
     case nvinfer1::DataType::kINT32:
       return true;
     case nvinfer1::DataType::kINT64:
       return true;
+    case nvinfer1::DataType::kFP8: // Only produced and consumed inside the network by Q/DQ layers
     default:
       return false;
   }
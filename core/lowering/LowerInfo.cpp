@@ -14,7 +14,8 @@ std::ostream& operator<<(std::ostream& os, const LowerInfo& l) {
   for (auto i : l.forced_fallback_modules) {
     os << "      " << i << std::endl;
   }
-  os << "    ]";
+  os << "    ]" << std::endl;
+  os << "    max_constant_fold_bytes: " << l.max_constant_fold_bytes;
   return os;
 }
 
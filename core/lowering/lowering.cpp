@@ -121,6 +121,7 @@ void LowerGraph(std::shared_ptr<torch::jit::Graph>& g, std::vector<torch::jit::I
   passes::RemoveContiguous(g);
   passes::ViewToReshape(g);
   passes::RemoveDropout(g);
+  passes::FoldBatchNorm(g);
   passes::LinearToAddMM(g);
   passes::Conv1DToConvolution(g);
   passes::ConvTransposed1DToConvolution(g);
@@ -154,6 +155,10 @@ void LowerGraph(std::shared_ptr<torch::jit::Graph>& g, std::vector<torch::jit::I
   passes::RewriteInputsWithParams(g, params);
   passes::ReplaceAtenPad(g);
   passes::ReplaceTileWithRepeat(g);
+  // Weights of QAT models flow through quantize / dequantize nodes and must stay unfolded
+  if (!lower_info.unfreeze_module) {
+    passes::FoldConstantWeightSubgraphs(g, lower_info.max_constant_fold_bytes);
+  }
   LOG_GRAPH(*g);
 }
 
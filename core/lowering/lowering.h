@@ -20,6 +20,9 @@ struct LowerInfo {
   // Whether the originating caller is `convert_method_to_trt_engine` (true) or `compile` (false)
   bool converting_to_trt_engine = false;
 
+  // Upper bound on the size of a single tensor produced by folding constant-only subgraphs of weights
+  int64_t max_constant_fold_bytes = 64 * 1024 * 1024;
+
   ir::Device target_device;
   std::vector<std::string> forced_fallback_modules;
   friend std::ostream& operator<<(std::ostream& os, const LowerInfo& l);
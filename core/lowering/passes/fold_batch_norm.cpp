@@ -0,0 +1,247 @@
+#include "torch/csrc/jit/ir/constants.h"
+#include "torch/csrc/jit/passes/dead_code_elimination.h"
+
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace lowering {
+namespace passes {
+namespace {
+
+enum class FoldTarget { kConvolution, kLinear, kAddMM };
+
+struct FoldCandidate {
+  FoldTarget target;
+  size_t weight_idx;
+  size_t bias_idx;
+  bool transposed = false;
+  int64_t groups = 1;
+};
+
+bool isConstantFalse(torch::jit::Value* v) {
+  auto ival = torch::jit::toIValue(v);
+  return ival.has_value() && ival->isBool() && !ival->toBool();
+}
+
+bool isConstantOne(torch::jit::Value* v) {
+  auto ival = torch::jit::toIValue(v);
+  return ival.has_value() && (ival->isInt() || ival->isDouble()) && ival->toScalar().toDouble() == 1.0;
+}
+
+// Returns the tensor held by a prim::Constant, an undefined tensor for a None constant
+// and nullopt for anything that is not known at lowering time
+c10::optional<at::Tensor> constantTensorOrNone(torch::jit::Value* v) {
+  if (v->node()->kind() != torch::jit::prim::Constant) {
+    return {};
+  }
+  auto ival = torch::jit::toIValue(v);
+  if (!ival.has_value()) {
+    return {};
+  }
+  if (ival->isNone()) {
+    return at::Tensor();
+  }
+  if (ival->isTensor()) {
+    return ival->toTensor();
+  }
+  return {};
+}
+
+// aten::batch_norm normalizes over dim 1, a linear layer produces channels in its last dim,
+// so folding is only valid when the linear output is known to be rank 2
+bool producesRank2(torch::jit::Node* linear) {
+  auto in = linear->inputs()[0];
+  auto in_type = in->type()->cast<c10::TensorType>();
+  if (in_type && in_type->dim().has_value()) {
+    return in_type->dim().value() == 2;
+  }
+  // Classifier heads commonly look like linear(flatten(x, 1, -1))
+  auto producer = in->node();
+  if (producer->kind() == torch::jit::aten::flatten) {
+    auto start = torch::jit::toIValue(producer->inputs()[1]);
+    auto end = torch::jit::toIValue(producer->inputs()[2]);
+    return start.has_value() && end.has_value() && start->isInt() && end->isInt() && start->toInt() == 1 &&
+        end->toInt() == -1;
+  }
+  return false;
+}
+
+c10::optional<FoldCandidate> getFoldCandidate(torch::jit::Node* n) {
+  auto kind = n->kind();
+  if (kind == torch::jit::aten::_convolution) {
+    // aten::_convolution(input, weight, bias, stride, padding, dilation, transposed, output_padding, groups, ...)
+    auto transposed = torch::jit::toIValue(n->inputs()[6]);
+    auto groups = torch::jit::toIValue(n->inputs()[8]);
+    if (!transposed.has_value() || !groups.has_value()) {
+      return {};
+    }
+    return FoldCandidate{FoldTarget::kConvolution, 1, 2, transposed->toBool(), groups->toInt()};
+  }
+
+  bool is_conv = kind == torch::jit::aten::conv1d || kind == torch::jit::aten::conv2d || kind == torch::jit::aten::conv3d;
+  bool is_conv_transpose = kind == torch::jit::aten::conv_transpose1d || kind == torch::jit::aten::conv_transpose2d ||
+      kind == torch::jit::aten::conv_transpose3d;
+  if ((is_conv || is_conv_transpose) && n->inputs().size() >= 7) {
+    // Both aten::conv{1,2,3}d and aten::conv_transpose{1,2,3}d carry groups in position 6
+    auto groups = torch::jit::toIValue(n->inputs()[6]);
+    if (!groups.has_value()) {
+      return {};
+    }
+    return FoldCandidate{FoldTarget::kConvolution, 1, 2, is_conv_transpose, groups->toInt()};
+  }
+
+  if (kind == torch::jit::aten::linear && producesRank2(n)) {
+    return FoldCandidate{FoldTarget::kLinear, 1, 2};
+  }
+
+  if (kind == torch::jit::aten::addmm && isConstantOne(n->inputs()[3]) && isConstantOne(n->inputs()[4])) {
+    // aten::addmm(self, mat1, mat2, beta, alpha) where mat2 is [in, out] and self is the bias
+    return FoldCandidate{FoldTarget::kAddMM, 2, 0};
+  }
+
+  return {};
+}
+
+// Scales each output channel of the weight, computing in fp32 and returning the original dtype
+at::Tensor scaleWeight(const at::Tensor& weight, const at::Tensor& scale, const FoldCandidate& c) {
+  auto w = weight.to(at::kFloat);
+  at::Tensor folded;
+  if (c.target == FoldTarget::kAddMM) {
+    // mat2 is [in, out], output channels run along the last dim
+    folded = w * scale.reshape({1, -1});
+  } else if (c.target == FoldTarget::kConvolution && c.transposed) {
+    // Transposed weights are [in, out / groups, k...] so output channel g * (out / groups) + j
+    // lives in group g, column j
+    auto sizes = w.sizes().vec();
+    auto out_per_group = sizes[1];
+    std::vector<int64_t> grouped_shape = {c.groups, sizes[0] / c.groups, out_per_group};
+    std::vector<int64_t> scale_shape = {c.groups, 1, out_per_group};
+    for (size_t i = 2; i < sizes.size(); i++) {
+      grouped_shape.push_back(sizes[i]);
+      scale_shape.push_back(1);
+    }
+    folded = (w.reshape(grouped_shape) * scale.reshape(scale_shape)).reshape(sizes);
+  } else {
+    // Convolution weights are [out, in / groups, k...] and linear weights are [out, in]
+    std::vector<int64_t> scale_shape(w.dim(), 1);
+    scale_shape[0] = -1;
+    folded = w * scale.reshape(scale_shape);
+  }
+  return folded.to(weight.scalar_type()).contiguous();
+}
+
+int64_t outputChannels(const at::Tensor& weight, const FoldCandidate& c) {
+  switch (c.target) {
+    case FoldTarget::kAddMM:
+      return weight.size(1);
+    case FoldTarget::kConvolution:
+      return c.transposed ? weight.size(1) * c.groups : weight.size(0);
+    case FoldTarget::kLinear:
+    default:
+      return weight.size(0);
+  }
+}
+
+bool tryFold(torch::jit::Node* bn) {
+  // aten::batch_norm(input, weight, bias, running_mean, running_var, training, momentum, eps, cudnn_enabled)
+  auto producer = bn->inputs()[0]->node();
+  if (producer->outputs().size() != 1 || producer->output()->uses().size() != 1) {
+    return false;
+  }
+  if (!isConstantFalse(bn->inputs()[5])) {
+    LOG_GRAPH("Not folding " << util::node_info(bn) << " since it is not in inference mode");
+    return false;
+  }
+
+  auto candidate = getFoldCandidate(producer);
+  if (!candidate) {
+    return false;
+  }
+
+  auto gamma = constantTensorOrNone(bn->inputs()[1]);
+  auto beta = constantTensorOrNone(bn->inputs()[2]);
+  auto mean = constantTensorOrNone(bn->inputs()[3]);
+  auto var = constantTensorOrNone(bn->inputs()[4]);
+  auto eps = torch::jit::toIValue(bn->inputs()[7]);
+  auto weight = constantTensorOrNone(producer->inputs()[candidate->weight_idx]);
+  auto bias = constantTensorOrNone(producer->inputs()[candidate->bias_idx]);
+  if (!gamma || !beta || !mean || !var || !eps || !weight || !bias) {
+    return false;
+  }
+  // Running statistics are required, weights must be real tensors
+  if (!mean->defined() || !var->defined() || !weight->defined() || !eps->isDouble()) {
+    return false;
+  }
+
+  auto channels = outputChannels(*weight, *candidate);
+  if (mean->numel() != channels || var->numel() != channels) {
+    LOG_GRAPH(
+        "Not folding " << util::node_info(bn) << " into " << util::node_info(producer) << ", expected " << channels
+                       << " channels but found " << mean->numel());
+    return false;
+  }
+
+  // Compile-time math is done in fp32 and the folded tensors are stored in the original dtype
+  auto options = at::TensorOptions().dtype(at::kFloat);
+  auto f_gamma = gamma->defined() ? gamma->to(at::kFloat).reshape({-1}) : at::ones({channels}, options);
+  auto f_beta = beta->defined() ? beta->to(at::kFloat).reshape({-1}) : at::zeros({channels}, options);
+  auto f_mean = mean->to(at::kFloat).reshape({-1});
+  auto f_var = var->to(at::kFloat).reshape({-1});
+
+  auto scale = f_gamma / at::sqrt(f_var + eps->toDouble());
+  auto shift = f_beta - f_mean * scale;
+
+  auto folded_weight = scaleWeight(*weight, scale, *candidate);
+  at::Tensor folded_bias;
+  auto bias_dtype = bias->defined() ? bias->scalar_type() : weight->scalar_type();
+  if (bias->defined()) {
+    // addmm's self may be broadcastable to [N, out], scaling along the last dim covers both cases
+    folded_bias = (bias->to(at::kFloat) * scale + shift).to(bias_dtype).contiguous();
+  } else {
+    folded_bias = shift.to(bias_dtype).contiguous();
+  }
+
+  auto g = bn->owningGraph();
+  torch::jit::WithInsertPoint guard(producer);
+  auto weight_const = g->insertConstant(folded_weight);
+  auto bias_const = g->insertConstant(folded_bias);
+  producer->replaceInput(candidate->weight_idx, weight_const);
+  producer->replaceInput(candidate->bias_idx, bias_const);
+
+  LOG_GRAPH("Folded " << util::node_info(bn) << " into " << util::node_info(producer));
+  bn->output()->replaceAllUsesWith(producer->output());
+  return true;
+}
+
+int foldBatchNormInBlock(torch::jit::Block* block) {
+  int num_folded = 0;
+  for (auto it = block->nodes().begin(); it != block->nodes().end(); it++) {
+    auto n = *it;
+    for (auto nested_block : n->blocks()) {
+      num_folded += foldBatchNormInBlock(nested_block);
+    }
+    if (n->kind() == torch::jit::aten::batch_norm && tryFold(n)) {
+      it.destroyCurrent();
+      num_folded++;
+    }
+  }
+  return num_folded;
+}
+
+} // namespace
+
+void FoldBatchNorm(std::shared_ptr<torch::jit::Graph>& graph) {
+  auto num_folded = foldBatchNormInBlock(graph->block());
+  if (num_folded > 0) {
+    // Drop the unfolded weight constants which are no longer referenced
+    torch::jit::EliminateDeadCode(graph);
+  }
+  LOG_DEBUG("Folded " << num_folded << " aten::batch_norm nodes into preceding convolution / linear layers");
+  LOG_GRAPH("Post fold batch norm: " << *graph);
+}
+
+} // namespace passes
+} // namespace lowering
+} // namespace core
+} // namespace torch_tensorrt
@@ -0,0 +1,189 @@
+#include "ATen/ExpandUtils.h"
+#include "c10/util/accumulate.h"
+#include "torch/csrc/jit/ir/constants.h"
+#include "torch/csrc/jit/passes/constant_propagation.h"
+#include "torch/csrc/jit/passes/dead_code_elimination.h"
+
+#include "core/util/prelude.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+namespace torch_tensorrt {
+namespace core {
+namespace lowering {
+namespace passes {
+namespace {
+
+// Layout, dtype and elementwise ops which are commonly applied to weights after freezing.
+// Ops which exist to grow their input (expand, repeat, ...) are intentionally left out. Broadcasting arithmetic can
+// still grow its inputs, so the size of every result is estimated before the node is evaluated.
+const std::unordered_set<c10::Symbol> kFoldableOps = {
+    torch::jit::aten::t,
+    torch::jit::aten::transpose,
+    torch::jit::aten::permute,
+    torch::jit::aten::reshape,
+    torch::jit::aten::view,
+    torch::jit::aten::flatten,
+    torch::jit::aten::squeeze,
+    torch::jit::aten::unsqueeze,
+    torch::jit::aten::contiguous,
+    torch::jit::aten::clone,
+    torch::jit::aten::detach,
+    torch::jit::aten::select,
+    torch::jit::aten::slice,
+    torch::jit::aten::to,
+    torch::jit::aten::type_as,
+    torch::jit::aten::neg,
+    torch::jit::aten::reciprocal,
+    torch::jit::aten::sqrt,
+    torch::jit::aten::rsqrt,
+    torch::jit::aten::pow,
+    torch::jit::aten::add,
+    torch::jit::aten::sub,
+    torch::jit::aten::mul,
+    torch::jit::aten::div,
+};
+
+bool isFoldable(torch::jit::Node* n) {
+  if (!kFoldableOps.count(n->kind()) || n->outputs().size() != 1 || !n->blocks().empty()) {
+    return false;
+  }
+  if (!n->output()->type()->isSubtypeOf(c10::TensorType::get())) {
+    return false;
+  }
+  bool has_tensor_input = false;
+  for (auto in : n->inputs()) {
+    if (in->node()->kind() != torch::jit::prim::Constant) {
+      return false;
+    }
+    // Device casts are left to the runtime so lowering never moves weights between devices
+    if (in->type()->kind() == c10::TypeKind::DeviceObjType) {
+      return false;
+    }
+    has_tensor_input |= in->type()->isSubtypeOf(c10::TensorType::get());
+  }
+  // Pure scalar math is handled by the evaluators
+  return has_tensor_input;
+}
+
+const std::unordered_set<c10::Symbol> kBroadcastingOps = {
+    torch::jit::aten::add,
+    torch::jit::aten::sub,
+    torch::jit::aten::mul,
+    torch::jit::aten::div,
+    torch::jit::aten::pow,
+};
+
+// Upper bound on the size of the result of a foldable node, computed from its constant inputs so an oversized
+// result is never materialized. nullopt if the inputs cannot be combined (the node would fail to evaluate).
+c10::optional<int64_t> estimateResultBytes(torch::jit::Node* n) {
+  std::vector<at::Tensor> tensors;
+  bool has_number_input = false;
+  for (auto in : n->inputs()) {
+    auto ivalue = torch::jit::toIValue(in);
+    if (!ivalue) {
+      continue;
+    }
+    if (ivalue->isTensor()) {
+      tensors.push_back(ivalue->toTensor());
+    } else if (ivalue->isScalar()) {
+      has_number_input = true;
+    }
+  }
+  if (tensors.empty()) {
+    return {};
+  }
+
+  int64_t numel = 0;
+  int64_t element_size = 0;
+  bool floating = false;
+  for (auto& t : tensors) {
+    numel = std::max<int64_t>(numel, t.numel());
+    element_size = std::max<int64_t>(element_size, t.element_size());
+    floating |= t.is_floating_point() || t.is_complex();
+  }
+
+  if (kBroadcastingOps.count(n->kind())) {
+    auto shape = tensors[0].sizes().vec();
+    for (size_t i = 1; i < tensors.size(); i++) {
+      try {
+        shape = at::infer_size(shape, tensors[i].sizes());
+      } catch (const std::exception&) {
+        return {};
+      }
+    }
+    numel = c10::multiply_integers(shape);
+    // Numbers only promote integral tensors, to at most 64 bit (e.g. bool + int -> long)
+    if (has_number_input && !floating) {
+      element_size = std::max<int64_t>(element_size, 8);
+    }
+  } else if (n->kind() == torch::jit::aten::to) {
+    auto schema = n->maybeSchema();
+    auto dtype_idx = schema ? schema->argumentIndexWithName("dtype") : c10::nullopt;
+    if (dtype_idx) {
+      auto dtype = torch::jit::toIValue(n->input(*dtype_idx));
+      if (dtype && dtype->isInt()) {
+        element_size =
+            std::max<int64_t>(element_size, c10::elementSize(static_cast<at::ScalarType>(dtype->toInt())));
+      }
+    }
+  }
+  return numel * element_size;
+}
+
+} // namespace
+
+void FoldConstantWeightSubgraphs(std::shared_ptr<torch::jit::Graph>& graph, int64_t max_folded_bytes) {
+  int num_folded = 0;
+  int64_t folded_bytes = 0;
+  // Nodes are visited in topological order so folding a node turns its users' inputs into constants,
+  // collapsing an entire chain into a single constant in one sweep
+  for (auto it = graph->block()->nodes().begin(); it != graph->block()->nodes().end(); it++) {
+    auto n = *it;
+    if (!isFoldable(n)) {
+      continue;
+    }
+
+    auto estimated_bytes = estimateResultBytes(n);
+    if (!estimated_bytes) {
+      continue;
+    }
+    if (*estimated_bytes > max_folded_bytes) {
+      LOG_GRAPH(
+          "Not folding " << util::node_info(n) << ", result of up to " << *estimated_bytes
+                         << " bytes exceeds the limit of " << max_folded_bytes << " bytes");
+      continue;
+    }
+
+    auto outputs = torch::jit::runNodeIfInputsAreConstant(n);
+    if (!outputs || outputs->size() != 1 || !(*outputs)[0].isTensor()) {
+      continue;
+    }
+
+    auto result = (*outputs)[0].toTensor();
+    auto nbytes = static_cast<int64_t>(result.numel() * result.element_size());
+
+    // Views share storage with their inputs, materialize a dense copy owned only by the new constant
+    result = result.detach().clone(at::MemoryFormat::Contiguous);
+    torch::jit::WithInsertPoint guard(n);
+    auto folded = graph->insertConstant(result);
+    LOG_GRAPH("Folding " << util::node_info(n) << " into constant " << folded->debugName());
+    n->output()->replaceAllUsesWith(folded);
+    it.destroyCurrent();
+
+    num_folded++;
+    folded_bytes += nbytes;
+  }
+
+  if (num_folded > 0) {
+    torch::jit::EliminateDeadCode(graph);
+  }
+  LOG_DEBUG("Folded " << num_folded << " constant-only nodes (" << folded_bytes << " bytes of weights)");
+  LOG_GRAPH("Post fold constant weight subgraphs: " << *graph);
+}
+
+} // namespace passes
+} // namespace lowering
+} // namespace core
+} // namespace torch_tensorrt
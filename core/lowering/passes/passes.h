@@ -18,6 +18,8 @@ void Conv2DToConvolution(std::shared_ptr<torch::jit::Graph>& graph);
 void ConvTransposed2DToConvolution(std::shared_ptr<torch::jit::Graph>& graph);
 void Conv3DToConvolution(std::shared_ptr<torch::jit::Graph>& graph);
 void ConvTransposed3DToConvolution(std::shared_ptr<torch::jit::Graph>& graph);
+void FoldBatchNorm(std::shared_ptr<torch::jit::Graph>& graph);
+void FoldConstantWeightSubgraphs(std::shared_ptr<torch::jit::Graph>& graph, int64_t max_folded_bytes);
 void FuseAddMMBranches(std::shared_ptr<torch::jit::Graph> graph);
 void LinearToAddMM(std::shared_ptr<torch::jit::Graph>& graph);
 void EliminateExceptionsSafe(std::shared_ptr<torch::jit::Graph>& graph);
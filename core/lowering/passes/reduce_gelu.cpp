@@ -1,3 +1,4 @@
+#include <torch/csrc/jit/ir/constants.h>
 #include <torch/csrc/jit/passes/subgraph_rewrite.h>
 #include "core/util/prelude.h"
 
@@ -6,6 +7,22 @@ namespace core {
 namespace lowering {
 namespace passes {
 
+namespace {
+// aten::gelu(Tensor self, *, str approximate) with a constant approximate mode is converted natively to a single
+// GELU activation, only the remaining forms are reduced to pointwise operations here
+bool isConvertibleGelu(const torch::jit::Node* n) {
+  if (n->inputs().size() != 2) {
+    return false;
+  }
+  auto approximate = torch::jit::toIValue(n->input(1));
+  if (!approximate || !approximate->isString()) {
+    return false;
+  }
+  auto mode = approximate->toStringRef();
+  return mode == "none" || mode == "tanh";
+}
+} // namespace
+
 void ReduceGelu(std::shared_ptr<torch::jit::Graph>& graph) {
   std::string gelu_pattern = R"IR(
         graph(%x : Tensor):
@@ -19,28 +36,38 @@ void ReduceGelu(std::shared_ptr<torch::jit::Graph>& graph) {
             %out : Tensor = aten::gelu(%x, %approx)
             return (%out))IR";
 
-  std::string gelu_reduce_pattern = R"IR(
+  // Gelu(x) = 0.5 * x * (1 + erf(x / sqrt(2)))
+  std::string gelu_reduce_erf_pattern = R"IR(
     graph(%x.1 : Tensor):
-        %6 : float = prim::Constant[value=0.044714999999999998]()
-        %5 : float = prim::Constant[value=0.79788456080000003]()
-        %4 : float = prim::Constant[value=1.]()
-        %3 : float = prim::Constant[value=0.5]()
-        %2 : int = prim::Constant[value=1]()
-        %7 : Tensor = aten::mul(%x.1, %3)
-        %8 : Tensor = aten::mul(%x.1, %5)
-        %9 : Tensor = aten::mul(%x.1, %6)
-        %10 : Tensor = aten::mul(%9, %x.1)
-        %11 : Tensor = aten::add(%10, %4, %2)
-        %12 : Tensor = aten::mul(%8, %11)
-        %13 : Tensor = aten::tanh(%12)
-        %14 : Tensor = aten::add(%13, %4, %2)
-        %15 : Tensor = aten::mul(%7, %14)
-        return (%15))IR";
+        %4 : float = prim::Constant[value=0.70710678118654757]()
+        %3 : float = prim::Constant[value=1.]()
+        %2 : float = prim::Constant[value=0.5]()
+        %1 : int = prim::Constant[value=1]()
+        %5 : Tensor = aten::mul(%x.1, %4)
+        %6 : Tensor = aten::erf(%5)
+        %7 : Tensor = aten::add(%6, %3, %1)
+        %8 : Tensor = aten::mul(%x.1, %2)
+        %9 : Tensor = aten::mul(%8, %7)
+        return (%9))IR";
 
-  // This is same as gelu_reduce_pattern except for an additional input %approx.
+  // Same as gelu_reduce_erf_pattern except for an additional input %approx.
   // SubgraphRewriter only works as expected if the number of inputs to gelu_approximate_pattern
-  // and gelu_reduce_multi_input_pattern are same.
-  std::string gelu_reduce_multi_input_pattern = R"IR(
+  // and the replacement pattern are same.
+  std::string gelu_reduce_erf_multi_input_pattern = R"IR(
+    graph(%x.1 : Tensor, %approx):
+        %4 : float = prim::Constant[value=0.70710678118654757]()
+        %3 : float = prim::Constant[value=1.]()
+        %2 : float = prim::Constant[value=0.5]()
+        %1 : int = prim::Constant[value=1]()
+        %5 : Tensor = aten::mul(%x.1, %4)
+        %6 : Tensor = aten::erf(%5)
+        %7 : Tensor = aten::add(%6, %3, %1)
+        %8 : Tensor = aten::mul(%x.1, %2)
+        %9 : Tensor = aten::mul(%8, %7)
+        return (%9))IR";
+
+  // Gelu(x) = 0.5 * x * (1.0 + tanh(x * 0.7978845608 * (1.0 + 0.044715 * x * x)))
+  std::string gelu_reduce_tanh_multi_input_pattern = R"IR(
     graph(%x.1 : Tensor, %approx):
         %6 : float = prim::Constant[value=0.044714999999999998]()
         %5 : float = prim::Constant[value=0.79788456080000003]()
@@ -58,15 +85,36 @@ void ReduceGelu(std::shared_ptr<torch::jit::Graph>& graph) {
         %15 : Tensor = aten::mul(%7, %14)
         return (%15))IR";
 
-  // replace aten::gelu with pointwise operations
+  // The single input schema predates the approximate argument and always computes the exact form
   torch::jit::SubgraphRewriter map_gelu_to_pointwise_ops;
-  map_gelu_to_pointwise_ops.RegisterRewritePattern(gelu_pattern, gelu_reduce_pattern);
+  map_gelu_to_pointwise_ops.RegisterRewritePattern(gelu_pattern, gelu_reduce_erf_pattern);
   map_gelu_to_pointwise_ops.runOnGraph(graph);
 
+  // A constant false approximate flag (the container schema above) also asks for the exact form
+  torch::jit::SubgraphRewriter map_gelu_exact_to_pointwise_ops;
+  map_gelu_exact_to_pointwise_ops.RegisterRewritePattern(gelu_approximate_pattern, gelu_reduce_erf_multi_input_pattern);
+  map_gelu_exact_to_pointwise_ops.runOnGraph(
+      graph, [](const torch::jit::Match& match, const std::unordered_map<std::string, torch::jit::Value*>&) {
+        auto approximate = torch::jit::toIValue(match.anchor->input(1));
+        return approximate && approximate->isBool() && !approximate->toBool();
+      });
+
+  // Anything else the converter cannot resolve keeps the historic tanh approximation
   torch::jit::SubgraphRewriter map_gelu_approximate_to_pointwise_ops;
   map_gelu_approximate_to_pointwise_ops.RegisterRewritePattern(
-      gelu_approximate_pattern, gelu_reduce_multi_input_pattern);
-  map_gelu_approximate_to_pointwise_ops.runOnGraph(graph);
+      gelu_approximate_pattern, gelu_reduce_tanh_multi_input_pattern);
+  map_gelu_approximate_to_pointwise_ops.runOnGraph(
+      graph, [](const torch::jit::Match& match, const std::unordered_map<std::string, torch::jit::Value*>&) {
+        if (isConvertibleGelu(match.anchor)) {
+          return false;
+        }
+        if (!torch::jit::toIValue(match.anchor->input(1))) {
+          LOG_WARNING(
+              "aten::gelu with a non constant approximate mode is reduced to the tanh approximation: "
+              << *match.anchor);
+        }
+        return true;
+      });
 
   LOG_GRAPH("Post lowering of [aten::gelu] -> " << *graph);
 }
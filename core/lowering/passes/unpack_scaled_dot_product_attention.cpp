@@ -1,3 +1,6 @@
+#include <sstream>
+
+#include "torch/csrc/jit/ir/constants.h"
 #include "torch/csrc/jit/ir/subgraph_matcher.h"
 #include "torch/csrc/jit/passes/subgraph_rewrite.h"
 
@@ -9,97 +12,149 @@ namespace core {
 namespace lowering {
 namespace passes {
 
-// https://pytorch.org/docs/stable/generated/torch.nn.functional.scaled_dot_product_attention.html
-void UnpackScaledDotProductAttention(std::shared_ptr<torch::jit::Graph>& graph) {
-  std::string sdpa_pattern = R"IR(
-    graph(%query, %key, %value, %attn_mask, %dropout_p, %is_causal, %scale, %enable_gqa):
-      %out: Tensor = aten::scaled_dot_product_attention(%query, %key, %value, %attn_mask, %dropout_p, %is_causal, %scale, %enable_gqa)
-      return (%out))IR";
+namespace {
+enum class AttnMask { kNone, kExplicit, kCausal };
 
-  std::string unpacked_sdpa_pattern = R"IR(
-    graph(%query, %key, %value, %attn_mask, %dropout_p, %is_causal, %scale, %enable_gqa):
-      %none : NoneType = prim::Constant()
-      %1 : int = prim::Constant[value=-1]()
-      %2 : int = prim::Constant[value=-2]()
-      %3 : int = aten::size(%query, %1)
-      %q_size : Long() = prim::NumToTensor(%3)
-      %sqrt : Tensor = aten::sqrt(%q_size)
-      %scale_factor : Tensor = aten::reciprocal(%sqrt)
-      %key_transpose : Tensor = aten::transpose(%key, %2, %1)
-      %matmul : Tensor = aten::matmul(%query, %key_transpose)
-      %attn_weight : Tensor = aten::mul(%matmul, %scale_factor)
-      %softmax : Tensor = aten::softmax(%attn_weight, %1, %none)
-      %out : Tensor = aten::matmul(%softmax, %value)
-      return(%out))IR";
-
-  std::string unpacked_sdpa_attn_biased_pattern = R"IR(
+// Inputs of aten::scaled_dot_product_attention(query, key, value, attn_mask, dropout_p, is_causal, scale, enable_gqa)
+const size_t kAttnMaskIdx = 3;
+const size_t kIsCausalIdx = 5;
+const size_t kScaleIdx = 6;
+const size_t kEnableGQAIdx = 7;
+
+// Builds the decomposition of attention for one combination of mask, scale and GQA handling. Masks are turned into an
+// additive bias, causal masks are built inside the network by trt::causal_attn_bias and grouped query attention
+// repeats each key / value head for its group of query heads with trt::repeat_kv_heads.
+std::string unpackedSDPA(AttnMask mask, bool explicit_scale, bool gqa) {
+  std::stringstream ir;
+  ir << R"IR(
     graph(%query, %key, %value, %attn_mask, %dropout_p, %is_causal, %scale, %enable_gqa):
       %none : NoneType = prim::Constant()
       %0 : int = prim::Constant[value=1]()
       %1 : int = prim::Constant[value=-1]()
-      %2 : int = prim::Constant[value=-2]()
+      %2 : int = prim::Constant[value=-2]())IR";
+
+  std::string key = "%key";
+  std::string value = "%value";
+  if (gqa) {
+    ir << R"IR(
+      %key_repeated : Tensor = trt::repeat_kv_heads(%key, %query)
+      %value_repeated : Tensor = trt::repeat_kv_heads(%value, %query))IR";
+    key = "%key_repeated";
+    value = "%value_repeated";
+  }
+
+  ir << R"IR(
+      %key_transpose : Tensor = aten::transpose()IR"
+     << key << R"IR(, %2, %1)
+      %matmul : Tensor = aten::matmul(%query, %key_transpose))IR";
+
+  if (explicit_scale) {
+    ir << R"IR(
+      %attn_weight : Tensor = aten::mul(%matmul, %scale))IR";
+  } else {
+    ir << R"IR(
       %3 : int = aten::size(%query, %1)
       %q_size : Long() = prim::NumToTensor(%3)
       %sqrt : Tensor = aten::sqrt(%q_size)
       %scale_factor : Tensor = aten::reciprocal(%sqrt)
-      %key_transpose : Tensor = aten::transpose(%key, %2, %1)
-      %matmul : Tensor = aten::matmul(%query, %key_transpose)
-      %attn_weight : Tensor = aten::mul(%matmul, %scale_factor)
-      %attn_bias : Tensor = trt::attn_bias_from_attn_mask(%attn_mask)
-      %attn_weight_with_bias : Tensor = aten::add(%attn_weight, %attn_bias, %0)
-      %softmax : Tensor = aten::softmax(%attn_weight_with_bias, %1, %none)
-      %out : Tensor = aten::matmul(%softmax, %value)
-      return(%out))IR";
-
-  // rewrite with None attn_mask
-  torch::jit::SubgraphRewriter sdpa_rewriter;
-  sdpa_rewriter.RegisterRewritePattern(sdpa_pattern, unpacked_sdpa_pattern);
-  sdpa_rewriter.runOnGraph(
-      graph, [](const torch::jit::Match& match, const std::unordered_map<std::string, torch::jit::Value*>&) {
-        auto is_causal_node = match.anchor->inputs().at(5)->node();
-        if (is_causal_node->kind() != at::prim::Constant) {
-          LOG_WARNING("Could not unpack scaled_dot_product_attention with non constant is_causal: " << *is_causal_node);
-          return false;
-        }
-        if (is_causal_node->i(at::attr::value) == 1) {
-          LOG_WARNING("Could not unpack scaled_dot_product_attention with is_causal = True: " << *is_causal_node);
-          return false;
-        }
-        auto attn_mask_node = match.anchor->inputs().at(3)->node();
-        if (attn_mask_node->kind() != at::prim::Constant || !attn_mask_node->mustBeNone()) {
-          return false;
-        }
-        auto enable_gqa_node = match.anchor->inputs().at(7)->node();
-        if (enable_gqa_node->kind() != at::prim::Constant) {
-          LOG_WARNING(
-              "Could not unpack scaled_dot_product_attention with non constant enable_gqa: " << *enable_gqa_node);
-          return false;
-        }
-        if (enable_gqa_node->i(at::attr::value) == 1) {
-          LOG_WARNING("Could not unpack scaled_dot_product_attention with enable_gqa = True: " << *enable_gqa_node);
-          return false;
-        }
-        return true;
-      });
-
-  // rewrite with float/bool attn_mask this uses a custom op to implement the divergent behavior between bool and float
-  // masks without a conditional
-  torch::jit::SubgraphRewriter sdpa_attn_mask_rewriter;
-  sdpa_attn_mask_rewriter.RegisterRewritePattern(sdpa_pattern, unpacked_sdpa_attn_biased_pattern);
-  sdpa_attn_mask_rewriter.runOnGraph(
-      graph, [](const torch::jit::Match& match, const std::unordered_map<std::string, torch::jit::Value*>&) {
-        auto is_causal_node = match.anchor->inputs().at(5)->node();
-        if (is_causal_node->kind() != at::prim::Constant || is_causal_node->i(at::attr::value) == 1) {
-          // messages already written in first pass, do not write again
-          return false;
-        }
-        auto enable_gqa_node = match.anchor->inputs().at(7)->node();
-        if (enable_gqa_node->kind() != at::prim::Constant || enable_gqa_node->i(at::attr::value) == 1) {
-          // messages already written in first pass, do not write again
-          return false;
-        }
-        return true;
-      });
+      %attn_weight : Tensor = aten::mul(%matmul, %scale_factor))IR";
+  }
+
+  std::string softmax_in = "%attn_weight";
+  if (mask != AttnMask::kNone) {
+    if (mask == AttnMask::kExplicit) {
+      ir << R"IR(
+      %attn_bias : Tensor = trt::attn_bias_from_attn_mask(%attn_mask, %query))IR";
+    } else {
+      ir << R"IR(
+      %attn_bias : Tensor = trt::causal_attn_bias(%query, %key))IR";
+    }
+    ir << R"IR(
+      %attn_weight_with_bias : Tensor = aten::add(%attn_weight, %attn_bias, %0))IR";
+    softmax_in = "%attn_weight_with_bias";
+  }
+
+  ir << R"IR(
+      %softmax : Tensor = aten::softmax()IR"
+     << softmax_in << R"IR(, %1, %none)
+      %out : Tensor = aten::matmul(%softmax, )IR"
+     << value << R"IR()
+      return (%out))IR";
+  return ir.str();
+}
+
+bool isFloatScale(const torch::jit::Value* scale) {
+  return scale->type()->kind() == c10::TypeKind::FloatType;
+}
+
+void warnUnsupported(torch::jit::Block* b) {
+  for (auto n : b->nodes()) {
+    for (auto sub_b : n->blocks()) {
+      warnUnsupported(sub_b);
+    }
+    if (n->kind() != c10::Symbol::fromQualString("aten::scaled_dot_product_attention") || n->inputs().size() != 8) {
+      continue;
+    }
+    auto is_causal = torch::jit::constant_as<bool>(n->input(kIsCausalIdx));
+    auto enable_gqa = torch::jit::constant_as<bool>(n->input(kEnableGQAIdx));
+    if (!is_causal) {
+      LOG_WARNING("Could not unpack scaled_dot_product_attention with non constant is_causal: " << *n);
+    } else if (!enable_gqa) {
+      LOG_WARNING("Could not unpack scaled_dot_product_attention with non constant enable_gqa: " << *n);
+    } else if (*is_causal && !n->input(kAttnMaskIdx)->mustBeNone()) {
+      LOG_WARNING(
+          "Could not unpack scaled_dot_product_attention with both an attn_mask and is_causal = True: " << *n);
+    } else if (!n->input(kScaleIdx)->mustBeNone() && !isFloatScale(n->input(kScaleIdx))) {
+      LOG_WARNING("Could not unpack scaled_dot_product_attention with an optional scale: " << *n);
+    }
+  }
+}
+} // namespace
+
+// https://pytorch.org/docs/stable/generated/torch.nn.functional.scaled_dot_product_attention.html
+void UnpackScaledDotProductAttention(std::shared_ptr<torch::jit::Graph>& graph) {
+  std::string sdpa_pattern = R"IR(
+    graph(%query, %key, %value, %attn_mask, %dropout_p, %is_causal, %scale, %enable_gqa):
+      %out: Tensor = aten::scaled_dot_product_attention(%query, %key, %value, %attn_mask, %dropout_p, %is_causal, %scale, %enable_gqa)
+      return (%out))IR";
+
+  warnUnsupported(graph->block());
+
+  for (auto mask : {AttnMask::kNone, AttnMask::kExplicit, AttnMask::kCausal}) {
+    for (bool explicit_scale : {false, true}) {
+      for (bool gqa : {false, true}) {
+        torch::jit::SubgraphRewriter sdpa_rewriter;
+        sdpa_rewriter.RegisterRewritePattern(sdpa_pattern, unpackedSDPA(mask, explicit_scale, gqa));
+        sdpa_rewriter.runOnGraph(
+            graph,
+            [mask, explicit_scale, gqa](
+                const torch::jit::Match& match, const std::unordered_map<std::string, torch::jit::Value*>&) {
+              auto inputs = match.anchor->inputs();
+              auto is_causal = torch::jit::constant_as<bool>(inputs[kIsCausalIdx]);
+              auto enable_gqa = torch::jit::constant_as<bool>(inputs[kEnableGQAIdx]);
+              if (!is_causal || !enable_gqa || *enable_gqa != gqa) {
+                return false;
+              }
+
+              auto has_mask = !inputs[kAttnMaskIdx]->mustBeNone();
+              // PyTorch rejects an explicit mask together with is_causal, leave the node to report it
+              if (*is_causal && has_mask) {
+                return false;
+              }
+              auto found_mask = *is_causal ? AttnMask::kCausal : (has_mask ? AttnMask::kExplicit : AttnMask::kNone);
+              if (found_mask != mask) {
+                return false;
+              }
+
+              auto scale = inputs[kScaleIdx];
+              if (explicit_scale) {
+                return isFloatScale(scale);
+              }
+              return scale->mustBeNone();
+            });
+      }
+    }
+  }
   LOG_GRAPH("Post unpack scaled_dot_product_attention: " << *graph);
 }
 
@@ -15,17 +15,54 @@ RegisterOperators trt_placeholder_ops_reg({
         "trt::const(Tensor val) -> Tensor",
         [](Stack& stack) { /*noop*/ },
         aliasAnalysisFromSchema()),
+    /// Additive bias for attn_mask, boolean masks become a bias in the dtype of query
     Operator(
-        "trt::attn_bias_from_attn_mask(Tensor attn_mask) -> Tensor",
+        "trt::attn_bias_from_attn_mask(Tensor attn_mask, Tensor query) -> Tensor",
         [](Stack& stack) {
+          auto query = pop(stack).to<at::Tensor>();
           auto attn_mask = pop(stack).to<at::Tensor>();
           if (attn_mask.scalar_type() == at::kBool) {
-            attn_mask = attn_mask;
-            attn_mask.masked_fill_(attn_mask.logical_not(), -std::numeric_limits<float>::infinity());
+            // True means take part in attention, so masked out positions get -inf
+            attn_mask = at::zeros(attn_mask.sizes(), attn_mask.options().dtype(query.scalar_type()))
+                            .masked_fill_(attn_mask.logical_not(), -std::numeric_limits<float>::infinity());
           }
-          return attn_mask;
+          push(stack, attn_mask);
         },
         c10::AliasAnalysisKind::CONSERVATIVE),
+    /// Additive bias of shape (L, S) hiding the keys after each query position, L and S being the sequence lengths
+    /// of query and key, like is_causal = True in scaled_dot_product_attention
+    Operator(
+        "trt::causal_attn_bias(Tensor query, Tensor key) -> Tensor",
+        [](Stack& stack) {
+          auto key = pop(stack).to<at::Tensor>();
+          auto query = pop(stack).to<at::Tensor>();
+          auto L = query.size(-2);
+          auto S = key.size(-2);
+          auto visible = at::ones({L, S}, query.options().dtype(at::kBool)).tril();
+          auto bias = at::zeros({L, S}, query.options())
+                          .masked_fill_(visible.logical_not(), -std::numeric_limits<float>::infinity());
+          push(stack, bias);
+        },
+        aliasAnalysisFromSchema()),
+    /// Repeats each head of a key or value tensor (..., H_kv, S, E) for the group of query heads (..., H_q, L, E)
+    /// sharing it, like enable_gqa = True in scaled_dot_product_attention
+    Operator(
+        "trt::repeat_kv_heads(Tensor kv, Tensor query) -> Tensor",
+        [](Stack& stack) {
+          auto query = pop(stack).to<at::Tensor>();
+          auto kv = pop(stack).to<at::Tensor>();
+          auto q_heads = query.size(-3);
+          auto kv_heads = kv.size(-3);
+          TORCH_CHECK(
+              q_heads % kv_heads == 0,
+              "Number of query heads (",
+              q_heads,
+              ") must be a multiple of the number of key / value heads (",
+              kv_heads,
+              ")");
+          push(stack, kv.repeat_interleave(q_heads / kv_heads, -3));
+        },
+        aliasAnalysisFromSchema()),
 });
 
 } // namespace jit
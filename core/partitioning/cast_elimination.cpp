@@ -0,0 +1,184 @@
+#include <vector>
+
+#include "torch/csrc/jit/ir/alias_analysis.h"
+#include "torch/csrc/jit/ir/constants.h"
+
+#include "core/partitioning/partitioning.h"
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace partitioning {
+
+namespace {
+// The arguments of a dtype aten::to, either aten::to(Tensor, int, bool, bool, MemoryFormat?) or
+// aten::to(Tensor, Device, int, bool, bool, MemoryFormat?) with constant arguments
+struct CastInfo {
+  torch::jit::Value* self = nullptr;
+  c10::optional<c10::IValue> device;
+  at::ScalarType dtype;
+  bool non_blocking;
+  bool copy;
+  bool keeps_memory_format;
+};
+
+c10::optional<CastInfo> getCastInfo(torch::jit::Node* n) {
+  if (n->kind() != torch::jit::aten::to || n->outputs().size() != 1) {
+    return {};
+  }
+  size_t dtype_idx;
+  if (n->inputs().size() == 6 && n->input(1)->type()->kind() == torch::jit::TypeKind::DeviceObjType) {
+    dtype_idx = 2;
+  } else if (n->inputs().size() == 5 && n->input(1)->type()->isSubtypeOf(c10::IntType::get())) {
+    dtype_idx = 1;
+  } else {
+    return {};
+  }
+
+  auto dtype = torch::jit::constant_as<int64_t>(n->input(dtype_idx));
+  auto non_blocking = torch::jit::constant_as<bool>(n->input(dtype_idx + 1));
+  auto copy = torch::jit::constant_as<bool>(n->input(dtype_idx + 2));
+  auto memory_format = torch::jit::toIValue(n->input(dtype_idx + 3));
+  if (!dtype || !non_blocking || !copy || !memory_format) {
+    return {};
+  }
+
+  CastInfo info;
+  info.self = n->input(0);
+  if (dtype_idx == 2) {
+    info.device = torch::jit::toIValue(n->input(1));
+    if (!info.device) {
+      return {};
+    }
+  }
+  info.dtype = static_cast<at::ScalarType>(*dtype);
+  info.non_blocking = *non_blocking;
+  info.copy = *copy;
+  info.keeps_memory_format = memory_format->isNone();
+  return info;
+}
+
+// Whether every value of narrow survives a round trip through wide, so casting to wide first does not change the result
+// of a following cast to narrow. Limited to integers, floats would round twice.
+bool holdsAllValuesOf(at::ScalarType wide, at::ScalarType narrow) {
+  if (wide == narrow) {
+    return true;
+  }
+  switch (wide) {
+    case at::kLong:
+      return narrow == at::kInt || narrow == at::kShort || narrow == at::kChar || narrow == at::kByte;
+    case at::kInt:
+      return narrow == at::kShort || narrow == at::kChar || narrow == at::kByte;
+    case at::kShort:
+      return narrow == at::kChar || narrow == at::kByte;
+    default:
+      return false;
+  }
+}
+
+bool sameArguments(const CastInfo& a, const CastInfo& b) {
+  return a.self == b.self && a.device.has_value() == b.device.has_value() && (!a.device || *a.device == *b.device) &&
+      a.dtype == b.dtype && a.non_blocking == b.non_blocking && a.copy == b.copy &&
+      a.keeps_memory_format == b.keeps_memory_format;
+}
+
+void collectCasts(torch::jit::Block* b, std::vector<torch::jit::Node*>& casts) {
+  for (auto n : b->nodes()) {
+    if (n->kind() == torch::jit::aten::to) {
+      casts.push_back(n);
+    }
+    for (auto sub_b : n->blocks()) {
+      collectCasts(sub_b, casts);
+    }
+  }
+}
+
+// Whether v is known to hold integers or bools, which casts between integer types truncate the same way in one step as in
+// several. Floats do not, their conversion is only defined for values the target type can hold.
+bool isIntegralTensor(const torch::jit::Value* v) {
+  if (auto type = v->type()->cast<c10::TensorType>()) {
+    if (type->scalarType()) {
+      return c10::isIntegralType(*type->scalarType(), /*includeBool=*/true);
+    }
+  }
+  // Types are often not refined between segments, but the cast producing v says what it holds
+  auto producer = getCastInfo(v->node());
+  return producer && c10::isIntegralType(producer->dtype, /*includeBool=*/true);
+}
+
+// Applies every rewrite found in one walk over the casts, returns the number of casts removed or -1 if there was
+// nothing to do. Rewrites only touch tensors nothing writes to and never add writers, so the alias information
+// computed up front stays valid while moving a read or sharing a result cannot be observed. Nodes are only destroyed
+// once they or a cast after them have been visited, so the collected list never yields a destroyed node.
+int rewritePass(std::shared_ptr<torch::jit::Graph>& g) {
+  std::vector<torch::jit::Node*> casts;
+  collectCasts(g->block(), casts);
+  torch::jit::AliasDb alias_db(g);
+
+  bool changed = false;
+  int removed = 0;
+  for (auto n : casts) {
+    if (!n->hasUses()) {
+      LOG_GRAPH("Removing unused cast " << *n);
+      n->destroy();
+      changed = true;
+      removed++;
+      continue;
+    }
+
+    auto cast = getCastInfo(n);
+    if (!cast || alias_db.hasWriters(n->output()) || alias_db.hasWriters(cast->self)) {
+      continue;
+    }
+
+    // to(to(x, A), B) == to(x, B) if x is integral and A holds every value of B. Without a device argument the outer
+    // cast keeps the device the inner one picked, so then the inner one must not move the tensor either.
+    auto inner = getCastInfo(cast->self->node());
+    if (inner && inner->keeps_memory_format && isIntegralTensor(inner->self) &&
+        holdsAllValuesOf(inner->dtype, cast->dtype) && (cast->device || !inner->device) &&
+        !alias_db.hasWriters(inner->self)) {
+      LOG_GRAPH("Bypassing " << *cast->self->node() << "  for " << *n);
+      n->replaceInput(0, inner->self);
+      changed = true;
+      auto inner_node = cast->self->node();
+      if (!inner_node->hasUses()) {
+        inner_node->destroy();
+        removed++;
+      }
+      continue;
+    }
+
+    // An identical cast that always runs before this one already holds the result
+    for (auto use : cast->self->uses()) {
+      auto other = use.user;
+      if (other == n || use.offset != 0 || !n->isDominatedBy(other)) {
+        continue;
+      }
+      auto other_cast = getCastInfo(other);
+      if (other_cast && sameArguments(*cast, *other_cast) && !alias_db.hasWriters(other->output())) {
+        LOG_GRAPH("Replacing " << *n << "  with the result of " << *other);
+        n->output()->replaceAllUsesWith(other->output());
+        n->destroy();
+        changed = true;
+        removed++;
+        break;
+      }
+    }
+  }
+  return changed ? removed : -1;
+}
+} // namespace
+
+int EliminateRedundantCasts(std::shared_ptr<torch::jit::Graph>& g) {
+  int removed = 0;
+  // Each pass can expose more rewrites (e.g. a cast left unused by a bypass), passes repeat until nothing changes
+  for (int r = rewritePass(g); r >= 0; r = rewritePass(g)) {
+    removed += r;
+  }
+  LOG_GRAPH("After EliminateRedundantCasts: " << *g);
+  return removed;
+}
+
+} // namespace partitioning
+} // namespace core
+} // namespace torch_tensorrt
@@ -0,0 +1,166 @@
+#include <unordered_set>
+
+#include "core/partitioning/costmodel/CostModel.h"
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace partitioning {
+
+namespace {
+const std::unordered_set<c10::Symbol> kHeavyNodeKinds = {
+    c10::Symbol::fromQualString("aten::_convolution"),
+    c10::Symbol::fromQualString("aten::conv1d"),
+    c10::Symbol::fromQualString("aten::conv2d"),
+    c10::Symbol::fromQualString("aten::conv3d"),
+    c10::Symbol::fromQualString("aten::conv_transpose1d"),
+    c10::Symbol::fromQualString("aten::conv_transpose2d"),
+    c10::Symbol::fromQualString("aten::conv_transpose3d"),
+    c10::Symbol::fromQualString("aten::linear"),
+    c10::Symbol::fromQualString("aten::matmul"),
+    c10::Symbol::fromQualString("aten::mm"),
+    c10::Symbol::fromQualString("aten::bmm"),
+    c10::Symbol::fromQualString("aten::addmm"),
+    c10::Symbol::fromQualString("aten::baddbmm"),
+    c10::Symbol::fromQualString("aten::einsum"),
+    c10::Symbol::fromQualString("aten::scaled_dot_product_attention"),
+    c10::Symbol::fromQualString("aten::lstm"),
+    c10::Symbol::fromQualString("aten::gru"),
+};
+
+const std::unordered_set<c10::Symbol> kViewNodeKinds = {
+    c10::Symbol::fromQualString("aten::size"),
+    c10::Symbol::fromQualString("aten::view"),
+    c10::Symbol::fromQualString("aten::reshape"),
+    c10::Symbol::fromQualString("aten::flatten"),
+    c10::Symbol::fromQualString("aten::squeeze"),
+    c10::Symbol::fromQualString("aten::unsqueeze"),
+    c10::Symbol::fromQualString("aten::permute"),
+    c10::Symbol::fromQualString("aten::transpose"),
+    c10::Symbol::fromQualString("aten::t"),
+    c10::Symbol::fromQualString("aten::expand"),
+    c10::Symbol::fromQualString("aten::select"),
+    c10::Symbol::fromQualString("aten::slice"),
+    c10::Symbol::fromQualString("aten::__getitem__"),
+};
+
+double edgeCost(
+    const CostGraph::Edge& e,
+    const std::vector<SegmentedBlock::SegmentedBlockTarget>& targets,
+    const CostModel& model) {
+  auto producer_target = targets[e.producer];
+  auto consumer_target = targets[e.consumer];
+  if (producer_target == SegmentedBlock::kTorch && consumer_target == SegmentedBlock::kTorch) {
+    // PyTorch materializes every intermediate anyway
+    return 0.0;
+  }
+  double cost = model.transferCost(e.tensor);
+  if (producer_target != consumer_target && e.tensor.requires_cast) {
+    cost += model.castCost(e.tensor);
+  }
+  return cost;
+}
+} // namespace
+
+int64_t BoundaryTensor::numel() const {
+  int64_t n = 1;
+  for (auto d : shape) {
+    n *= d;
+  }
+  return n;
+}
+
+int64_t BoundaryTensor::bytes() const {
+  return numel() * static_cast<int64_t>(c10::elementSize(dtype));
+}
+
+double DefaultCostModel::transferCost(const BoundaryTensor& t) const {
+  // The producer writes the tensor out and the consumer reads it back in
+  return params_.boundary_overhead_us + 2.0 * t.bytes() / params_.bandwidth_bytes_per_us;
+}
+
+double DefaultCostModel::castCost(const BoundaryTensor& t) const {
+  return params_.kernel_launch_us + 2.0 * t.bytes() / params_.bandwidth_bytes_per_us;
+}
+
+double DefaultCostModel::engineLaunchCost() const {
+  return params_.engine_launch_us;
+}
+
+double DefaultCostModel::nodeCost(c10::Symbol kind, SegmentedBlock::SegmentedBlockTarget target) const {
+  bool trt = target == SegmentedBlock::kTensorRT;
+  if (kHeavyNodeKinds.count(kind)) {
+    return trt ? params_.trt_heavy_node_us : params_.torch_heavy_node_us;
+  } else if (kind.is_prim() || kViewNodeKinds.count(kind)) {
+    return trt ? params_.trt_view_node_us : params_.torch_view_node_us;
+  } else {
+    return trt ? params_.trt_light_node_us : params_.torch_light_node_us;
+  }
+}
+
+std::ostream& operator<<(std::ostream& os, const CostModelDecision& d) {
+  return os << "Moving TensorRT segment " << d.segment_id << " (" << d.num_nodes
+            << " nodes) to run in torch, estimated cost " << d.cost_before << "us -> " << d.cost_after << "us";
+}
+
+double estimatePartitionCost(
+    const CostGraph& graph,
+    const std::vector<SegmentedBlock::SegmentedBlockTarget>& targets,
+    const CostModel& model) {
+  TORCHTRT_CHECK(
+      targets.size() == graph.segments.size(),
+      "Expected a target for each of the " << graph.segments.size() << " segments, got " << targets.size());
+  double cost = 0.0;
+  for (size_t i = 0; i < graph.segments.size(); i++) {
+    if (targets[i] == SegmentedBlock::kTensorRT) {
+      cost += model.engineLaunchCost();
+    }
+    for (auto kind : graph.segments[i].node_kinds) {
+      cost += model.nodeCost(kind, targets[i]);
+    }
+  }
+  for (auto& e : graph.edges) {
+    if (e.producer == CostGraph::kExternal || e.consumer == CostGraph::kExternal || e.producer == e.consumer) {
+      continue;
+    }
+    cost += edgeCost(e, targets, model);
+  }
+  return cost;
+}
+
+std::vector<CostModelDecision> planCostModelFallback(const CostGraph& graph, const CostModel& model) {
+  std::vector<SegmentedBlock::SegmentedBlockTarget> targets;
+  for (auto& s : graph.segments) {
+    targets.push_back(s.target);
+  }
+
+  std::vector<CostModelDecision> decisions;
+  auto current_cost = estimatePartitionCost(graph, targets, model);
+  while (true) {
+    size_t best = CostGraph::kExternal;
+    double best_cost = current_cost;
+    for (size_t i = 0; i < graph.segments.size(); i++) {
+      if (targets[i] != SegmentedBlock::kTensorRT || graph.segments[i].pinned) {
+        continue;
+      }
+      targets[i] = SegmentedBlock::kTorch;
+      auto cost = estimatePartitionCost(graph, targets, model);
+      targets[i] = SegmentedBlock::kTensorRT;
+      if (cost < best_cost) {
+        best = i;
+        best_cost = cost;
+      }
+    }
+    if (best == CostGraph::kExternal) {
+      break;
+    }
+    targets[best] = SegmentedBlock::kTorch;
+    decisions.push_back({best, graph.segments[best].node_kinds.size(), current_cost, best_cost});
+    current_cost = best_cost;
+  }
+  return decisions;
+}
+
+} // namespace partitioning
+} // namespace core
+} // namespace torch_tensorrt
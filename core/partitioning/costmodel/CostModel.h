@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <vector>
+
+#include "core/partitioning/segmentedblock/SegmentedBlock.h"
+#include "torch/csrc/jit/ir/ir.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace partitioning {
+
+// Description of a tensor crossing a segment boundary, taken from the example values produced by shape analysis
+struct BoundaryTensor {
+  std::vector<int64_t> shape;
+  at::ScalarType dtype = at::kFloat;
+  // Whether stitching has to insert a cast (e.g. Long <-> Int under truncate_long_and_double) when this tensor moves
+  // between a TensorRT engine and PyTorch
+  bool requires_cast = false;
+
+  int64_t numel() const;
+  int64_t bytes() const;
+};
+
+// Estimates, in microseconds, the cost of running a partition. Implementations only need to be consistent with
+// themselves since the partitioner only ever compares alternatives priced by the same model.
+class CostModel {
+ public:
+  virtual ~CostModel() = default;
+  // Cost of materializing a tensor between two engines or between an engine and PyTorch
+  virtual double transferCost(const BoundaryTensor& t) const = 0;
+  // Cost of the cast inserted for a boundary tensor with requires_cast set
+  virtual double castCost(const BoundaryTensor& t) const = 0;
+  // Fixed cost of enqueueing one TensorRT engine
+  virtual double engineLaunchCost() const = 0;
+  // Cost of executing a single node of the given kind in the given target
+  virtual double nodeCost(c10::Symbol kind, SegmentedBlock::SegmentedBlockTarget target) const = 0;
+};
+
+// Bandwidth and launch overhead based model. Node costs are bucketed by kind since shapes of values internal to a
+// segment are not known after shape analysis.
+class DefaultCostModel : public CostModel {
+ public:
+  struct Params {
+    // Effective device memory bandwidth in bytes per microsecond (500 GB/s)
+    double bandwidth_bytes_per_us = 5e5;
+    // Allocation and binding overhead per boundary tensor
+    double boundary_overhead_us = 1.0;
+    double kernel_launch_us = 5.0;
+    double engine_launch_us = 15.0;
+    // Compute heavy ops (convolutions, matmuls, RNNs, attention)
+    double torch_heavy_node_us = 100.0;
+    double trt_heavy_node_us = 40.0;
+    // Everything else runs as one eager kernel in PyTorch but is usually fused by TensorRT
+    double torch_light_node_us = 5.0;
+    double trt_light_node_us = 0.5;
+    // Views, shape arithmetic and prim:: nodes are interpreter overhead in PyTorch and free in TensorRT
+    double torch_view_node_us = 1.0;
+    double trt_view_node_us = 0.0;
+  };
+
+  DefaultCostModel() = default;
+  explicit DefaultCostModel(Params params) : params_(params) {}
+
+  double transferCost(const BoundaryTensor& t) const override;
+  double castCost(const BoundaryTensor& t) const override;
+  double engineLaunchCost() const override;
+  double nodeCost(c10::Symbol kind, SegmentedBlock::SegmentedBlockTarget target) const override;
+
+  const Params& params() const {
+    return params_;
+  }
+
+ private:
+  Params params_;
+};
+
+// Abstract view of a partitioned block that the cost model operates on. Keeping it free of torch::jit::Values lets the
+// planning algorithm be exercised on synthetic graphs.
+struct CostGraph {
+  static constexpr size_t kExternal = std::numeric_limits<size_t>::max();
+
+  struct Segment {
+    SegmentedBlock::SegmentedBlockTarget target;
+    // Segments that must keep their target, e.g. conditionals or blocks the partitioner will not merge
+    bool pinned = false;
+    std::vector<c10::Symbol> node_kinds;
+  };
+
+  // A tensor produced by one segment and consumed by another. Graph inputs and outputs are always materialized
+  // regardless of the partition so they are not tracked.
+  struct Edge {
+    size_t producer;
+    size_t consumer;
+    BoundaryTensor tensor;
+  };
+
+  std::vector<Segment> segments;
+  std::vector<Edge> edges;
+};
+
+struct CostModelDecision {
+  size_t segment_id;
+  size_t num_nodes;
+  // Estimated cost of the block before and after moving the segment to PyTorch
+  double cost_before;
+  double cost_after;
+};
+
+std::ostream& operator<<(std::ostream& os, const CostModelDecision& d);
+
+// Total estimated cost of the block with the given per-segment targets
+double estimatePartitionCost(
+    const CostGraph& graph,
+    const std::vector<SegmentedBlock::SegmentedBlockTarget>& targets,
+    const CostModel& model);
+
+// Greedily moves TensorRT segments to PyTorch while that lowers the estimated end-to-end cost, largest saving first.
+// Moving a segment removes its engine launch and its boundaries with neighbouring PyTorch segments, but adds boundaries
+// with neighbouring TensorRT segments and runs its nodes eagerly. Decisions are returned in the order they were made.
+std::vector<CostModelDecision> planCostModelFallback(const CostGraph& graph, const CostModel& model);
+
+} // namespace partitioning
+} // namespace core
+} // namespace torch_tensorrt
@@ -0,0 +1,166 @@
+#include <cstring>
+#include <sstream>
+#include <unordered_map>
+
+#include "core/partitioning/partitioning.h"
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace partitioning {
+
+namespace {
+typedef std::unordered_map<const torch::jit::Value*, size_t> ValueIds;
+
+// FNV-1a over the tensor's contents so identical weights in different segments hash the same. Only narrows down the
+// candidates, matching fingerprints are confirmed with sameSegmentConstants before an engine is shared. Contiguous CPU
+// tensors are read in place and consumed a word at a time.
+uint64_t hashTensorContents(const at::Tensor& t) {
+  auto c = t.is_cpu() && t.is_contiguous() ? t : t.to(at::kCPU).contiguous();
+  auto data = static_cast<const uint8_t*>(c.data_ptr());
+  auto nbytes = c.nbytes();
+  uint64_t hash = 14695981039346656037ULL;
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= nbytes; i += sizeof(uint64_t)) {
+    uint64_t word;
+    std::memcpy(&word, data + i, sizeof(word));
+    hash ^= word;
+    hash *= 1099511628211ULL;
+  }
+  for (; i < nbytes; i++) {
+    hash ^= data[i];
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+struct FingerprintWriter {
+  std::ostream& os;
+  ValueIds ids;
+  std::vector<at::Tensor>* constants;
+
+  void writeTensor(const at::Tensor& t) {
+    os << "tensor(" << t.scalar_type() << ", " << t.sizes() << ", " << std::hex << hashTensorContents(t) << std::dec
+       << ")";
+    if (constants) {
+      constants->push_back(t);
+    }
+  }
+
+  void writeIValueTensors(const c10::IValue& ival) {
+    if (ival.isTensor()) {
+      writeTensor(ival.toTensor());
+    } else if (ival.isTensorList()) {
+      for (const auto& t : ival.toTensorVector()) {
+        writeTensor(t);
+      }
+    } else if (ival.isList()) {
+      for (const auto& e : ival.toListRef()) {
+        writeIValueTensors(e);
+      }
+    } else if (ival.isTuple()) {
+      for (const auto& e : ival.toTupleRef().elements()) {
+        writeIValueTensors(e);
+      }
+    }
+  }
+
+  size_t newId(const torch::jit::Value* v) {
+    return ids.emplace(v, ids.size()).first->second;
+  }
+
+  size_t valueId(const torch::jit::Value* v) {
+    auto it = ids.find(v);
+    if (it == ids.end()) {
+      // values from outside the segment graph should not exist, but must not alias an in-graph id if they do
+      it = ids.emplace(v, ids.size()).first;
+    }
+    return it->second;
+  }
+
+  void writeBlock(const torch::jit::Block* b) {
+    for (const auto n : b->nodes()) {
+      for (auto out : n->outputs()) {
+        os << "%" << newId(out) << " : " << *out->type() << ", ";
+      }
+      os << "= " << n->kind().toQualString();
+      // printAttributes renders tensors as <Tensor>, their contents are appended separately
+      n->printAttributes(os, /*ignore_subgraph=*/false);
+      for (auto name : n->attributeNames()) {
+        switch (n->kindOf(name)) {
+          case torch::jit::AttributeKind::t:
+            writeTensor(n->t(name));
+            break;
+          case torch::jit::AttributeKind::ts:
+            for (const auto& t : n->ts(name)) {
+              writeTensor(t);
+            }
+            break;
+          case torch::jit::AttributeKind::ival:
+            writeIValueTensors(n->ival(name));
+            break;
+          default:
+            break;
+        }
+      }
+      os << "(";
+      for (auto in : n->inputs()) {
+        os << "%" << valueId(in) << ", ";
+      }
+      os << ")\n";
+      for (auto sub_b : n->blocks()) {
+        os << "block(";
+        for (auto param : sub_b->inputs()) {
+          os << "%" << newId(param) << " : " << *param->type() << ", ";
+        }
+        os << ")\n";
+        writeBlock(sub_b);
+      }
+    }
+    os << "return(";
+    for (auto out : b->outputs()) {
+      os << "%" << valueId(out) << ", ";
+    }
+    os << ")\n";
+  }
+};
+} // namespace
+
+std::string fingerprintSegment(
+    SegmentedBlock& seg_block,
+    const std::vector<ir::Input>& input_specs,
+    std::vector<at::Tensor>* constants) {
+  std::stringstream ss;
+  ss << SegmentedBlock::target_to_str(seg_block.target()) << "\n";
+  for (auto& spec : input_specs) {
+    ss << "spec " << spec << "\n";
+  }
+
+  // Values are numbered in definition order so debug names, which differ between repeated blocks, do not matter
+  FingerprintWriter writer{ss, {}, constants};
+  for (auto in : seg_block.g()->inputs()) {
+    ss << "input %" << writer.newId(in) << " : " << *in->type() << "\n";
+  }
+  writer.writeBlock(seg_block.block());
+  return ss.str();
+}
+
+bool sameSegmentConstants(const std::vector<at::Tensor>& a, const std::vector<at::Tensor>& b) {
+  if (a.size() != b.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < a.size(); i++) {
+    if (a[i].is_same(b[i])) {
+      continue;
+    }
+    if (a[i].scalar_type() != b[i].scalar_type() || a[i].sizes() != b[i].sizes() ||
+        a[i].device() != b[i].device() || !at::equal(a[i], b[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace partitioning
+} // namespace core
+} // namespace torch_tensorrt
@@ -85,6 +85,9 @@ void setExplicitFallbackNodes(PartitioningCtx* ctx, torch::jit::Block* block) {
     } else if (n->hasAttribute(to_compile_sym) && n->i(to_compile_sym) == (int64_t) false) {
       // If the user specifies the module containing this op to run in torch it should run in PyTorch
       ctx->setNodeExecutorDecision(n, NodeExecutorDecision::kMODULE_FALLBACK);
+    } else if (ctx->node_executor_decision_map[n] == NodeExecutorDecision::kCOST_MODEL_FALLBACK) {
+      // The cost model moved this node's segment to torch on a previous pass over the block, keep it there
+      continue;
     } else {
       // Set the rest nodes to TensorRt
       ctx->setNodeExecutorDecision(n, NodeExecutorDecision::kCONVERT);
@@ -564,6 +567,94 @@ void populateInputIValues(PartitioningCtx* ctx) {
   }
 }
 
+CostGraph buildCostGraph(PartitioningCtx* ctx, torch::jit::Block* block) {
+  PartitionedGraph& cur_partitioned_block = ctx->partitioned_blocks[block];
+  CostGraph graph;
+  std::unordered_map<torch::jit::Value*, size_t> producers;
+  for (size_t i = 0; i < cur_partitioned_block.size(); ++i) {
+    auto& seg_block = cur_partitioned_block[i];
+    CostGraph::Segment segment;
+    segment.target = seg_block.target();
+    segment.pinned = seg_block.do_not_merge();
+    for (auto n : seg_block.raw_nodes()) {
+      segment.node_kinds.push_back(n->kind());
+    }
+    graph.segments.push_back(std::move(segment));
+    for (auto output : seg_block.raw_outputs()) {
+      producers[output] = i;
+    }
+  }
+
+  for (size_t i = 0; i < cur_partitioned_block.size(); ++i) {
+    for (auto input : cur_partitioned_block[i].raw_inputs()) {
+      auto producer = producers.find(input);
+      auto example = ctx->opt_input_ivalues_map.find(input);
+      // graph inputs are materialized regardless of the partition, and only tensors are priced
+      if (producer == producers.end() || example == ctx->opt_input_ivalues_map.end() ||
+          !example->second.isTensor()) {
+        continue;
+      }
+      auto t = example->second.toTensor();
+      BoundaryTensor tensor;
+      tensor.shape = t.sizes().vec();
+      tensor.dtype = t.scalar_type();
+      // mirror the casts shape analysis inserts around torch segments
+      tensor.requires_cast = (tensor.dtype == at::kLong && ctx->settings.truncate_long_and_double) ||
+          (tensor.dtype == at::kByte && ctx->settings.cast_int8_inputs);
+      graph.edges.push_back({producer->second, i, tensor});
+    }
+  }
+  return graph;
+}
+
+bool applyCostModel(PartitioningCtx* ctx, torch::jit::Block* block) {
+  auto graph = buildCostGraph(ctx, block);
+  DefaultCostModel default_model;
+  const CostModel& model = ctx->cost_model ? *ctx->cost_model : default_model;
+
+  auto decisions = planCostModelFallback(graph, model);
+  if (decisions.empty()) {
+    LOG_DEBUG("Cost model found no cheaper partition for the block");
+    return false;
+  }
+
+  PartitionedGraph& cur_partitioned_block = ctx->partitioned_blocks[block];
+  for (auto& decision : decisions) {
+    LOG_INFO(decision);
+    for (auto n : cur_partitioned_block[decision.segment_id].raw_nodes()) {
+      ctx->setNodeExecutorDecision(n, NodeExecutorDecision::kCOST_MODEL_FALLBACK);
+    }
+    ctx->cost_model_decisions.push_back(decision);
+  }
+  return true;
+}
+
+void segmentAndAnalyzeBlock(PartitioningCtx* ctx, torch::jit::Block* block) {
+  // segment lowering global graph into blocks
+  segmentGraph(ctx, block);
+
+  // It's possible that some TensorRT blocks have nonTensor inputs/output because they are interleaved by Torch blocks
+  // resolve nonTensor inputs/outputs
+  LOG_DEBUG("Resolving non-tensor inputs for segmented blocks");
+  resolveTRTNonTensorInputs(ctx, block);
+
+  // register input/output torch::jit::Value for segmented graphs
+  LOG_DEBUG("Registering input/output torch::jit::Value for segmented graphs");
+  registerSegmentsOutputs(ctx, block);
+
+  // Incase of dynamic shape inputs, run shape analysis on each segmented block for min/opt/max ranges and register
+  // output shapes for each block accordingly
+  if (isInputDynamic(ctx)) {
+    LOG_DEBUG("Performing shape analysis for segmented blocks using min/opt/max shapes for inputs");
+    runShapeAnalysis(ctx, block, ctx->min_input_ivalues_map, ir::ShapeMode::kMIN);
+    runShapeAnalysis(ctx, block, ctx->opt_input_ivalues_map, ir::ShapeMode::kOPT);
+    runShapeAnalysis(ctx, block, ctx->max_input_ivalues_map, ir::ShapeMode::kMAX);
+  } else {
+    LOG_DEBUG("Performing shape analysis for segmented blocks using static shapes for inputs");
+    runShapeAnalysis(ctx, block, ctx->opt_input_ivalues_map, ir::ShapeMode::kOPT);
+  }
+}
+
 void partition(PartitioningCtx* ctx, bool expect_full_compilation) {
   // If full compilation is expected, overwrite minimum block size
   // Any nonzero block size is valid if full compilation to TRT is desired
@@ -583,28 +674,14 @@ void partition(PartitioningCtx* ctx, bool expect_full_compilation) {
 
   // Go through all the blocks to do the partitioning
   for (torch::jit::Block* block : ctx->original_blocks) {
-    // segment lowering global graph into blocks
-    segmentGraph(ctx, block);
-
-    // It's possible that some TensorRT blocks have nonTensor inputs/output because they are interleaved by Torch blocks
-    // resolve nonTensor inputs/outputs
-    LOG_DEBUG("Resolving non-tensor inputs for segmented blocks");
-    resolveTRTNonTensorInputs(ctx, block);
-
-    // register input/output torch::jit::Value for segmented graphs
-    LOG_DEBUG("Registering input/output torch::jit::Value for segmented graphs");
-    registerSegmentsOutputs(ctx, block);
-
-    // Incase of dynamic shape inputs, run shape analysis on each segmented block for min/opt/max ranges and register
-    // output shapes for each block accordingly
-    if (isInputDynamic(ctx)) {
-      LOG_DEBUG("Performing shape analysis for segmented blocks using min/opt/max shapes for inputs");
-      runShapeAnalysis(ctx, block, ctx->min_input_ivalues_map, ir::ShapeMode::kMIN);
-      runShapeAnalysis(ctx, block, ctx->opt_input_ivalues_map, ir::ShapeMode::kOPT);
-      runShapeAnalysis(ctx, block, ctx->max_input_ivalues_map, ir::ShapeMode::kMAX);
-    } else {
-      LOG_DEBUG("Performing shape analysis for segmented blocks using static shapes for inputs");
-      runShapeAnalysis(ctx, block, ctx->opt_input_ivalues_map, ir::ShapeMode::kOPT);
+    segmentAndAnalyzeBlock(ctx, block);
+
+    // With shapes known, let the cost model move TensorRT segments whose boundaries cost more than they save to torch,
+    // then partition the block again so the affected torch segments are merged
+    if (ctx->settings.use_cost_model && !expect_full_compilation && applyCostModel(ctx, block)) {
+      LOG_DEBUG("Re-partitioning block after cost model fallback");
+      ctx->partitioned_blocks.erase(block);
+      segmentAndAnalyzeBlock(ctx, block);
     }
   }
 }
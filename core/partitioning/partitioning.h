@@ -49,6 +49,29 @@ void segmentGraph(PartitioningCtx* ctx, torch::jit::Block* block);
 
 GraphAndMapping stitch(PartitioningCtx* ctx, torch::jit::Block* block);
 
+// Cleans up the casts stitching leaves between segments (e.g. int32 -> int64 -> int32 across two Torch segments):
+// collapses cast chains whose intermediate type holds every value of the final one, drops casts an identical earlier
+// cast already computed and removes unused casts. Returns the number of aten::to nodes removed.
+int EliminateRedundantCasts(std::shared_ptr<torch::jit::Graph>& g);
+
+// Canonical description of a segment: its target, input specs and graph structure with values renumbered in definition
+// order and weights reduced to content hashes. Since the hashes may collide, segments with equal fingerprints only
+// build identical engines if their constants, which are appended to constants in fingerprint order when it is set, are
+// also the same (see sameSegmentConstants).
+std::string fingerprintSegment(
+    SegmentedBlock& seg_block,
+    const std::vector<ir::Input>& input_specs,
+    std::vector<at::Tensor>* constants = nullptr);
+
+// Whether two segments' constants, as collected by fingerprintSegment, hold the same values
+bool sameSegmentConstants(const std::vector<at::Tensor>& a, const std::vector<at::Tensor>& b);
+
+// Summarizes the segments of an already shape analyzed block for the cost model
+CostGraph buildCostGraph(PartitioningCtx* ctx, torch::jit::Block* block);
+
+// Marks the nodes of TensorRT segments the cost model would rather run in torch, returns whether any were moved
+bool applyCostModel(PartitioningCtx* ctx, torch::jit::Block* block);
+
 void partition(PartitioningCtx* ctx, bool expect_full_compilation = false);
 
 } // namespace partitioning
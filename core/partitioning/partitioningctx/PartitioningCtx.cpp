@@ -93,6 +93,8 @@ std::ostream& operator<<(std::ostream& os, const NodeExecutorDecision& format) {
       return os << "to run torch due owning block not large enough to exceed user specified min_block_size";
     case NodeExecutorDecision::kNON_TENSOR:
       return os << "to run torch due to producing or consuming non-tensor values";
+    case NodeExecutorDecision::kCOST_MODEL_FALLBACK:
+      return os << "to run torch due to the cost model estimating its owning block is cheaper to run in torch";
     case NodeExecutorDecision::kCONVERT:
       return os << "to run in tensorrt";
     case NodeExecutorDecision::kUNKNOWN:
@@ -1,10 +1,12 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "core/partitioning/costmodel/CostModel.h"
 #include "core/partitioning/partitioninginfo/PartitioningInfo.h"
 #include "core/partitioning/segmentedblock/SegmentedBlock.h"
 
@@ -24,6 +26,9 @@ enum NodeExecutorDecision {
   kMIN_BLOCK_FALLBACK,
   /// This node produces/consumes non-tensor inputs
   kNON_TENSOR,
+  /// This node is in a TRT segment the cost model estimated to be
+  /// cheaper to run in Pytorch
+  kCOST_MODEL_FALLBACK,
   /// This node is going to be converted
   kCONVERT,
   /// Sentinel
@@ -57,6 +62,10 @@ struct PartitioningCtx {
   // LUT of the segmented blocks for each blocks in the module
   std::unordered_map<torch::jit::Block*, PartitionedGraph> partitioned_blocks;
   std::unordered_set<std::string> forced_fallback_ops;
+  // model used to price alternative partitions when settings.use_cost_model is set, DefaultCostModel if null
+  std::shared_ptr<CostModel> cost_model;
+  // TRT segments moved to torch by the cost model, in the order the decisions were made
+  std::vector<CostModelDecision> cost_model_decisions;
 
   PartitioningCtx(torch::jit::Block* b, PartitioningInfo info);
   void setNodeExecutorDecision(torch::jit::Node* n, NodeExecutorDecision decision);
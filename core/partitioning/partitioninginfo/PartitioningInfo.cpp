@@ -14,6 +14,7 @@ std::ostream& operator<<(std::ostream& os, const PartitioningInfo& s) {
   if (s.enabled) {
     os << "True";
     os << "\n    \"min_block_size\": " << s.min_block_size \
+       << "\n    \"use_cost_model\": " << s.use_cost_model \
        << "\n    \"torch_executed_operators\": [";
     for (auto i : s.forced_fallback_operators) {
       os <<"\n        " << i << ',';
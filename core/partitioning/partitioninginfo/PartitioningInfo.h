@@ -14,6 +14,7 @@ struct PartitioningInfo {
   ir::CollectionInputSpecMap collection_input_spec_map;
   bool enabled = false;
   uint64_t min_block_size = 1;
+  bool use_cost_model = false;
   std::vector<std::string> forced_fallback_operators;
   bool truncate_long_and_double;
   ir::Device target_device;
@@ -1,4 +1,5 @@
 #include "core/plugins/impl/interpolate_plugin.h"
+#include "core/plugins/impl/serialization.h"
 #include "core/plugins/plugins.h"
 #include "core/util/prelude.h"
 
@@ -30,19 +31,17 @@ InterpolatePlugin::InterpolatePlugin(
     TORCHTRT_ASSERT(mode_ != "adaptive_avg_pool2d", "use_scales is not valid for adaptive_avg_pool2d");
     TORCHTRT_ASSERT(
         scales_.size() != 0, "Attempted to use interpolate plugin without providing scales while use_scales=true");
-    at::Tensor input = at::randint(1, 10, in_shape, {at::kCUDA});
-    at::Tensor output;
-
-    if (mode_ == "linear") {
-      output = at::upsample_linear1d(input, c10::nullopt, align_corners_, scales_[0]);
-    } else if (mode_ == "bilinear") {
-      output = at::upsample_bilinear2d(input, c10::nullopt, align_corners_, scales_);
-      std::cout << output.sizes() << std::endl;
-    } else if (mode_ == "trilinear") {
-      output = at::upsample_trilinear3d(input, c10::nullopt, align_corners_, scales_);
+    TORCHTRT_ASSERT(
+        in_shape_.size() >= scales_.size() + 2,
+        "Interpolate plugin expects one scale per spatial dimension, got " << scales_.size() << " for input of rank "
+                                                                            << in_shape_.size());
+    // Matches ATen's upsample output size computation: floor(input_size * scale) for each spatial dim
+    out_shape_ = in_shape_;
+    auto spatial_offset = in_shape_.size() - scales_.size();
+    for (size_t i = 0; i < scales_.size(); i++) {
+      out_shape_[spatial_offset + i] =
+          static_cast<int64_t>(std::floor(static_cast<double>(in_shape_[spatial_offset + i]) * scales_[i]));
     }
-
-    out_shape_ = output.sizes().vec();
   } else {
     TORCHTRT_ASSERT(
         (size_.size() != 0 && out_shape_.size() != 0),
@@ -51,6 +50,24 @@ InterpolatePlugin::InterpolatePlugin(
 }
 
 InterpolatePlugin::InterpolatePlugin(const char* data, size_t length) {
+  if (serialization::is_legacy_archive(data, length)) {
+    deserializeLegacyArchive(data, length);
+    return;
+  }
+
+  serialization::Reader reader(data, length);
+  reader.read_header();
+  reader.read(in_shape_);
+  reader.read(out_shape_);
+  reader.read(size_);
+  reader.read(scales_);
+  reader.read(mode_);
+  reader.read(align_corners_);
+  reader.read(use_scales_);
+  TORCHTRT_CHECK(reader.ok() && reader.exhausted(), "Serialized Interpolate plugin data is malformed");
+}
+
+void InterpolatePlugin::deserializeLegacyArchive(const char* data, size_t length) {
   std::istringstream data_stream(std::string(data, length));
 
   torch::serialize::InputArchive input_archive;
@@ -166,7 +183,8 @@ nvinfer1::DimsExprs InterpolatePlugin::getOutputDimensions(
 
 nvinfer1::DataType InterpolatePlugin::getOutputDataType(int index, const nvinfer1::DataType* inputTypes, int nbInputs)
     const noexcept {
-  return nvinfer1::DataType::kFLOAT;
+  // Outputs (including the optional indices output of adaptive_max_pool2d) follow the input precision
+  return inputTypes[0];
 }
 
 int InterpolatePlugin::initialize() noexcept {
@@ -174,31 +192,28 @@ int InterpolatePlugin::initialize() noexcept {
 }
 
 void InterpolatePlugin::serialize(void* buffer) const noexcept {
-  std::string data = serializeToString();
-  size_t size = getSerializationSize();
-
-  data.copy((char*)buffer, size);
+  char* cursor = static_cast<char*>(buffer);
+  serialization::write_header(cursor);
+  serialization::write(cursor, in_shape_);
+  serialization::write(cursor, out_shape_);
+  serialization::write(cursor, size_);
+  serialization::write(cursor, scales_);
+  serialization::write(cursor, mode_);
+  serialization::write(cursor, align_corners_);
+  serialization::write(cursor, use_scales_);
 }
 
 std::string InterpolatePlugin::serializeToString() const {
-  torch::serialize::OutputArchive output_archive;
-
-  output_archive.write("in_shape", torch::IValue(in_shape_));
-  output_archive.write("out_shape", torch::IValue(out_shape_));
-  output_archive.write("size", torch::IValue(size_));
-  output_archive.write("scales", torch::IValue(scales_));
-  output_archive.write("mode", torch::IValue(mode_));
-  output_archive.write("align_corners", torch::IValue(align_corners_));
-  output_archive.write("use_scales", torch::IValue(use_scales_));
-
-  std::ostringstream data_str;
-  output_archive.save_to(data_str);
-
-  return data_str.str();
+  std::string data(getSerializationSize(), '\0');
+  serialize(&data[0]);
+  return data;
 }
 
 size_t InterpolatePlugin::getSerializationSize() const noexcept {
-  return serializeToString().size();
+  return serialization::header_size() + serialization::serialized_size(in_shape_) +
+      serialization::serialized_size(out_shape_) + serialization::serialized_size(size_) +
+      serialization::serialized_size(scales_) + serialization::serialized_size(mode_) +
+      serialization::serialized_size(align_corners_) + serialization::serialized_size(use_scales_);
 }
 
 bool InterpolatePlugin::supportsFormatCombination(
@@ -228,11 +243,12 @@ bool InterpolatePlugin::supportsFormatCombination(
   const nvinfer1::PluginTensorDesc& in = inOut[0];
 
   if (pos == 0) {
-    return (in.type == nvinfer1::DataType::kFLOAT) && (in.format == nvinfer1::TensorFormat::kLINEAR);
+    return (in.type == nvinfer1::DataType::kFLOAT || in.type == nvinfer1::DataType::kHALF) &&
+        (in.format == nvinfer1::TensorFormat::kLINEAR);
   }
 
-  // pos == 1, accessing information about output tensor
-  const nvinfer1::PluginTensorDesc& out = inOut[1];
+  // pos >= 1, accessing information about output tensors
+  const nvinfer1::PluginTensorDesc& out = inOut[pos];
 
   return (in.type == out.type) && (in.format == out.format);
 }
@@ -242,7 +258,7 @@ void InterpolatePlugin::configurePlugin(
     int nbInputs,
     const nvinfer1::DynamicPluginTensorDesc* out,
     int nbOutputs) noexcept {
-  dtype_ = nvinfer1::DataType::kFLOAT;
+  dtype_ = in[0].desc.type;
 }
 
 size_t InterpolatePlugin::getWorkspaceSize(
@@ -250,6 +266,11 @@ size_t InterpolatePlugin::getWorkspaceSize(
     int nbInputs,
     const nvinfer1::PluginTensorDesc* outputs,
     int nbOutputs) const noexcept {
+  // Adaptive max pooling produces an index per output element which TensorRT has no use for,
+  // they are written to the workspace so enqueue never has to allocate
+  if (mode_.find("adaptive_max_pool") == 0) {
+    return util::volume(outputs[0].dims) * sizeof(int64_t);
+  }
   return 0;
 }
 
@@ -260,60 +281,82 @@ int InterpolatePlugin::enqueue(
     void* const* outputs,
     void* workspace,
     cudaStream_t stream) noexcept {
-  at::Tensor input =
-      at::from_blob((void*)inputs[0], util::toVec(inputDesc->dims), [](void*) {}, {at::kCUDA}).to(torch::kFloat);
-  at::Tensor output =
-      at::from_blob(outputs[0], util::toVec(outputDesc->dims), [](void*) {}, {at::kCUDA}).to(torch::kFloat);
-
-  at::cuda::CUDAStream torch_stream = at::cuda::getStreamFromPool();
-  at::cuda::CUDAStreamGuard torch_guard(torch_stream);
-
-  cudaEvent_t event;
-  cudaEventCreate(&event);
-  cudaEventRecord(event, stream);
-
-  cudaStreamWaitEvent(torch_stream.stream(), event, 0);
-  at::Tensor out;
-  if (use_scales_) {
-    if (mode_ == "linear") {
-      out = at::upsample_linear1d(input, c10::nullopt, align_corners_, {scales_[0]});
-    } else if (mode_ == "bilinear") {
-      out = at::upsample_bilinear2d(input, c10::nullopt, align_corners_, scales_);
-    } else if (mode_ == "trilinear") {
-      out = at::upsample_trilinear3d(input, c10::nullopt, align_corners_, scales_);
-    }
-  } else {
+  // Tensors are wrapped in place in their TensorRT precision, ATen kernels write straight into the
+  // TensorRT owned output on the TensorRT stream. No events, streams or device memory are created here
+  // so the plugin can be captured in a CUDA graph along with the rest of the engine.
+  auto device = c10::cuda::current_device();
+  auto options = at::TensorOptions().device(at::kCUDA, device).dtype(util::TRTDataTypeToScalarType(inputDesc->type));
+  at::Tensor input = at::from_blob(const_cast<void*>(inputs[0]), util::toVec(inputDesc->dims), [](void*) {}, options);
+  at::Tensor output = at::from_blob(outputs[0], util::toVec(outputDesc->dims), [](void*) {}, options);
+
+  c10::cuda::CUDAStream torch_stream = c10::cuda::getStreamFromExternal(stream, device);
+  c10::cuda::CUDAStreamGuard torch_guard(torch_stream);
+
+  auto out_dims = util::toVec(outputDesc->dims);
+  auto indices = [&]() {
+    return at::from_blob(workspace, out_dims, [](void*) {}, options.dtype(at::kLong));
+  };
+
+  try {
     if (mode_ == "linear") {
-      out = at::upsample_linear1d(input, {size_[0]}, align_corners_);
+      at::upsample_linear1d_out(
+          output,
+          input,
+          {out_dims[2]},
+          align_corners_,
+          use_scales_ ? c10::optional<double>(scales_[0]) : c10::nullopt);
     } else if (mode_ == "bilinear") {
-      out = at::upsample_bilinear2d(input, {size_[0], size_[1]}, align_corners_);
+      at::upsample_bilinear2d_out(
+          output,
+          input,
+          {out_dims[2], out_dims[3]},
+          align_corners_,
+          use_scales_ ? c10::optional<double>(scales_[0]) : c10::nullopt,
+          use_scales_ ? c10::optional<double>(scales_[1]) : c10::nullopt);
+    } else if (mode_ == "bilinear_aa") {
+      at::_upsample_bilinear2d_aa_out(
+          output,
+          input,
+          {out_dims[2], out_dims[3]},
+          align_corners_,
+          use_scales_ ? c10::optional<double>(scales_[0]) : c10::nullopt,
+          use_scales_ ? c10::optional<double>(scales_[1]) : c10::nullopt);
     } else if (mode_ == "trilinear") {
-      out = at::upsample_trilinear3d(input, {size_[0], size_[1], size_[2]}, align_corners_);
+      at::upsample_trilinear3d_out(
+          output,
+          input,
+          {out_dims[2], out_dims[3], out_dims[4]},
+          align_corners_,
+          use_scales_ ? c10::optional<double>(scales_[0]) : c10::nullopt,
+          use_scales_ ? c10::optional<double>(scales_[1]) : c10::nullopt,
+          use_scales_ ? c10::optional<double>(scales_[2]) : c10::nullopt);
     } else if (mode_ == "adaptive_avg_pool1d") {
-      out = at::adaptive_avg_pool1d(input, {size_[0]});
+      // There is no out variant of the 1d pools, run them as 2d pools over views with a unit height
+      auto output_2d = output.unsqueeze(-2);
+      at::adaptive_avg_pool2d_out(output_2d, input.unsqueeze(-2), {1, size_[0]});
     } else if (mode_ == "adaptive_max_pool1d") {
-      out = std::get<0>(at::adaptive_max_pool1d(input, {size_[0]}));
+      auto output_2d = output.unsqueeze(-2);
+      auto indices_2d = indices().unsqueeze(-2);
+      at::adaptive_max_pool2d_out(output_2d, indices_2d, input.unsqueeze(-2), {1, size_[0]});
     } else if (mode_ == "adaptive_avg_pool2d") {
-      out = at::adaptive_avg_pool2d(input, {size_[0], size_[1]});
+      at::adaptive_avg_pool2d_out(output, input, {size_[0], size_[1]});
     } else if (mode_ == "adaptive_max_pool2d") {
-      out = std::get<0>(at::adaptive_max_pool2d(input, {size_[0], size_[1]}));
+      auto indices_out = indices();
+      at::adaptive_max_pool2d_out(output, indices_out, input, {size_[0], size_[1]});
     } else if (mode_ == "adaptive_avg_pool3d") {
-      out = at::adaptive_avg_pool3d(input, {size_[0], size_[1], size_[2]});
+      at::adaptive_avg_pool3d_out(output, input, {size_[0], size_[1], size_[2]});
     } else if (mode_ == "adaptive_max_pool3d") {
-      out = std::get<0>(at::adaptive_max_pool3d(input, {size_[0], size_[1], size_[2]}));
+      auto indices_out = indices();
+      at::adaptive_max_pool3d_out(output, indices_out, input, {size_[0], size_[1], size_[2]});
+    } else {
+      LOG_ERROR("Interpolate plugin does not support mode " << mode_);
+      return 1;
     }
+  } catch (const std::exception& e) {
+    LOG_ERROR("Interpolate plugin failed to execute: " << e.what());
+    return 1;
   }
 
-  output.copy_(out);
-  cudaEvent_t torch_event;
-  cudaEventCreate(&torch_event);
-  cudaEventRecord(torch_event, torch_stream.stream());
-
-  cudaStreamWaitEvent(stream, torch_event, 0);
-
-  cudaEventDestroy(event);
-  cudaEventDestroy(torch_event);
-
   return 0;
 }
 
@@ -389,7 +432,12 @@ nvinfer1::IPluginV2* InterpolatePluginCreator::deserializePlugin(
     const void* serialData,
     size_t serialLength) noexcept {
   name_ = name;
-  return new InterpolatePlugin((const char*)serialData, serialLength);
+  try {
+    return new InterpolatePlugin((const char*)serialData, serialLength);
+  } catch (const std::exception& e) {
+    LOG_ERROR("Unable to deserialize Interpolate plugin: " << e.what());
+    return nullptr;
+  }
 }
 
 const nvinfer1::PluginFieldCollection* InterpolatePluginCreator::getFieldNames() noexcept {
@@ -1,7 +1,8 @@
 #pragma once
 
 #include <ATen/ATen.h>
-#include <ATen/cuda/CUDAEvent.h>
+#include <c10/cuda/CUDAGuard.h>
+#include <c10/cuda/CUDAStream.h>
 #include <cuda_runtime_api.h>
 #include <iostream>
 #include <sstream>
@@ -29,6 +30,8 @@ class InterpolatePlugin : public nvinfer1::IPluginV2DynamicExt {
   bool align_corners_;
   bool use_scales_;
 
+  void deserializeLegacyArchive(const char* data, size_t length);
+
  public:
   InterpolatePlugin(
       std::vector<int64_t> in_shape,
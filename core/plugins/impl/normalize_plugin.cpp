@@ -1,4 +1,5 @@
 #include "core/plugins/impl/normalize_plugin.h"
+#include "core/plugins/impl/serialization.h"
 #include "NvInferPlugin.h"
 #include "NvInferPluginUtils.h"
 #include "core/plugins/plugins.h"
@@ -17,6 +18,20 @@ NormalizePlugin::NormalizePlugin(int32_t order, std::vector<int32_t> axes, int32
     : order_(order), axes_(axes), keep_dims_(keep_dims) {}
 
 NormalizePlugin::NormalizePlugin(const char* data, size_t length) {
+  if (serialization::is_legacy_archive(data, length)) {
+    deserializeLegacyArchive(data, length);
+    return;
+  }
+
+  serialization::Reader reader(data, length);
+  reader.read_header();
+  reader.read(order_);
+  reader.read(axes_);
+  reader.read(keep_dims_);
+  TORCHTRT_CHECK(reader.ok() && reader.exhausted(), "Serialized NormalizePlugin data is malformed");
+}
+
+void NormalizePlugin::deserializeLegacyArchive(const char* data, size_t length) {
   std::istringstream data_stream(std::string(data, length));
 
   torch::serialize::InputArchive input_archive;
@@ -30,9 +45,7 @@ NormalizePlugin::NormalizePlugin(const char* data, size_t length) {
     torch::IValue value;
     input_archive.read("axes", value);
     auto values = value.toIntVector();
-    std::vector<int32_t> doubleVec(values.begin(), values.end());
-    // axes_ = doubleVec;
-    axes_.assign(doubleVec.begin(), doubleVec.end());
+    axes_.assign(values.begin(), values.end());
   }
   {
     torch::IValue value;
@@ -99,7 +112,7 @@ nvinfer1::DimsExprs NormalizePlugin::getOutputDimensions(
 
 nvinfer1::DataType NormalizePlugin::getOutputDataType(int index, const nvinfer1::DataType* inputTypes, int nbInputs)
     const noexcept {
-  return nvinfer1::DataType::kFLOAT;
+  return inputTypes[0];
 }
 
 int NormalizePlugin::initialize() noexcept {
@@ -107,25 +120,22 @@ int NormalizePlugin::initialize() noexcept {
 }
 
 void NormalizePlugin::serialize(void* buffer) const noexcept {
-  std::string data = serializeToString();
-  size_t size = getSerializationSize();
-  data.copy((char*)buffer, size);
+  char* cursor = static_cast<char*>(buffer);
+  serialization::write_header(cursor);
+  serialization::write(cursor, order_);
+  serialization::write(cursor, axes_);
+  serialization::write(cursor, keep_dims_);
 }
 
 std::string NormalizePlugin::serializeToString() const noexcept {
-  torch::serialize::OutputArchive output_archive;
-  std::vector<int64_t> axesVec(axes_.begin(), axes_.end());
-  output_archive.write("order", torch::IValue((int64_t)order_));
-  output_archive.write("axes", torch::IValue(axesVec));
-  output_archive.write("keep_dims", torch::IValue((int64_t)keep_dims_));
-  std::ostringstream data_str;
-  output_archive.save_to(data_str);
-
-  return data_str.str();
+  std::string data(getSerializationSize(), '\0');
+  serialize(&data[0]);
+  return data;
 }
 
 size_t NormalizePlugin::getSerializationSize() const noexcept {
-  return serializeToString().size();
+  return serialization::header_size() + serialization::serialized_size(order_) + serialization::serialized_size(axes_) +
+      serialization::serialized_size(keep_dims_);
 }
 
 bool NormalizePlugin::supportsFormatCombination(
@@ -146,7 +156,8 @@ bool NormalizePlugin::supportsFormatCombination(
   const nvinfer1::PluginTensorDesc& in = inOut[0];
 
   if (pos == 0) {
-    return (in.type == nvinfer1::DataType::kFLOAT) && (in.format == nvinfer1::TensorFormat::kLINEAR);
+    return (in.type == nvinfer1::DataType::kFLOAT || in.type == nvinfer1::DataType::kHALF) &&
+        (in.format == nvinfer1::TensorFormat::kLINEAR);
   }
 
   // pos == 1, accessing information about output tensor
@@ -160,7 +171,7 @@ void NormalizePlugin::configurePlugin(
     int nbInputs,
     const nvinfer1::DynamicPluginTensorDesc* out,
     int nbOutputs) noexcept {
-  dtype_ = nvinfer1::DataType::kFLOAT;
+  dtype_ = in[0].desc.type;
 }
 
 size_t NormalizePlugin::getWorkspaceSize(
@@ -178,31 +189,22 @@ int NormalizePlugin::enqueue(
     void* const* outputs,
     void* workspace,
     cudaStream_t stream) noexcept {
-  at::Tensor input =
-      at::from_blob((void*)inputs[0], util::toVec(inputDesc->dims), [](void*) {}, {at::kCUDA}).to(torch::kFloat);
-  at::Tensor output =
-      at::from_blob(outputs[0], util::toVec(outputDesc->dims), [](void*) {}, {at::kCUDA}).to(torch::kFloat);
-
-  at::cuda::CUDAStream torch_stream = at::cuda::getStreamFromPool();
-  at::cuda::CUDAStreamGuard torch_guard(torch_stream);
-
-  cudaEvent_t event;
-  cudaEventCreate(&event);
-  cudaEventRecord(event, stream);
-
-  cudaStreamWaitEvent(torch_stream.stream(), event, 0);
-
-  std::vector<int64_t> axes_double(axes_.begin(), axes_.end());
-  at::Tensor result = at::norm(input, (int64_t)order_, axes_double, (bool)keep_dims_);
-  output.copy_(result);
-  cudaEvent_t torch_event;
-  cudaEventCreate(&torch_event);
-  cudaEventRecord(torch_event, torch_stream.stream());
-
-  cudaStreamWaitEvent(stream, torch_event, 0);
-
-  cudaEventDestroy(event);
-  cudaEventDestroy(torch_event);
+  // Run directly on the TensorRT stream writing into the TensorRT owned output, see InterpolatePlugin::enqueue
+  auto device = c10::cuda::current_device();
+  auto options = at::TensorOptions().device(at::kCUDA, device).dtype(util::TRTDataTypeToScalarType(inputDesc->type));
+  at::Tensor input = at::from_blob(const_cast<void*>(inputs[0]), util::toVec(inputDesc->dims), [](void*) {}, options);
+  at::Tensor output = at::from_blob(outputs[0], util::toVec(outputDesc->dims), [](void*) {}, options);
+
+  c10::cuda::CUDAStream torch_stream = c10::cuda::getStreamFromExternal(stream, device);
+  c10::cuda::CUDAStreamGuard torch_guard(torch_stream);
+
+  std::vector<int64_t> axes(axes_.begin(), axes_.end());
+  try {
+    at::norm_out(output, input, at::Scalar(static_cast<int64_t>(order_)), axes, static_cast<bool>(keep_dims_));
+  } catch (const std::exception& e) {
+    LOG_ERROR("NormalizePlugin failed to execute: " << e.what());
+    return 1;
+  }
   return 0;
 }
 
@@ -256,8 +258,12 @@ nvinfer1::IPluginV2* NormalizePluginCreator::deserializePlugin(
     const void* serialData,
     size_t serialLength) noexcept {
   name_ = name;
-  auto plugin = new NormalizePlugin((const char*)serialData, serialLength);
-  return plugin;
+  try {
+    return new NormalizePlugin((const char*)serialData, serialLength);
+  } catch (const std::exception& e) {
+    LOG_ERROR("Unable to deserialize NormalizePlugin: " << e.what());
+    return nullptr;
+  }
 }
 
 const nvinfer1::PluginFieldCollection* NormalizePluginCreator::getFieldNames() noexcept {
@@ -1,7 +1,8 @@
 #pragma once
 
 #include <ATen/ATen.h>
-#include <ATen/cuda/CUDAEvent.h>
+#include <c10/cuda/CUDAGuard.h>
+#include <c10/cuda/CUDAStream.h>
 #include <cuda_runtime_api.h>
 #include <iostream>
 #include <sstream>
@@ -26,6 +27,8 @@ class NormalizePlugin : public nvinfer1::IPluginV2DynamicExt {
   std::vector<int32_t> axes_;
   int32_t keep_dims_;
 
+  void deserializeLegacyArchive(const char* data, size_t length);
+
  public:
   NormalizePlugin(int32_t order, std::vector<int32_t> axes, int32_t keep_dims);
 
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace torch_tensorrt {
+namespace core {
+namespace plugins {
+namespace impl {
+namespace serialization {
+
+// Plugin state is stored as a flat byte stream in native byte order (like the TensorRT plan holding it, it is not
+// portable across platforms):
+//   [magic : uint32][format version : uint32][fields...]
+// Trivially copyable fields are stored as raw bytes, vectors and strings are stored as a
+// uint64 element count followed by their elements.
+constexpr uint32_t kMagic = 0x50525454; // "TTRP"
+constexpr uint32_t kFormatVersion = 1;
+
+template <typename T>
+typename std::enable_if<std::is_trivially_copyable<T>::value, size_t>::type serialized_size(const T&) {
+  return sizeof(T);
+}
+
+template <typename T>
+size_t serialized_size(const std::vector<T>& v) {
+  static_assert(std::is_trivially_copyable<T>::value, "Only vectors of POD types can be serialized");
+  return sizeof(uint64_t) + v.size() * sizeof(T);
+}
+
+inline size_t serialized_size(const std::string& s) {
+  return sizeof(uint64_t) + s.size();
+}
+
+inline size_t header_size() {
+  return sizeof(kMagic) + sizeof(kFormatVersion);
+}
+
+template <typename T>
+typename std::enable_if<std::is_trivially_copyable<T>::value>::type write(char*& buffer, const T& v) {
+  std::memcpy(buffer, &v, sizeof(T));
+  buffer += sizeof(T);
+}
+
+template <typename T>
+void write(char*& buffer, const std::vector<T>& v) {
+  write(buffer, static_cast<uint64_t>(v.size()));
+  if (!v.empty()) {
+    std::memcpy(buffer, v.data(), v.size() * sizeof(T));
+    buffer += v.size() * sizeof(T);
+  }
+}
+
+inline void write(char*& buffer, const std::string& s) {
+  write(buffer, static_cast<uint64_t>(s.size()));
+  std::memcpy(buffer, s.data(), s.size());
+  buffer += s.size();
+}
+
+inline void write_header(char*& buffer) {
+  write(buffer, kMagic);
+  write(buffer, kFormatVersion);
+}
+
+// Bounds checked cursor over a serialized plugin, any out of range read marks the reader as failed
+class Reader {
+ public:
+  Reader(const char* data, size_t length) : data_(data), remaining_(length) {}
+
+  template <typename T>
+  typename std::enable_if<std::is_trivially_copyable<T>::value, bool>::type read(T& v) {
+    return copy_out(&v, sizeof(T));
+  }
+
+  template <typename T>
+  bool read(std::vector<T>& v) {
+    uint64_t count = 0;
+    if (!read(count) || count > remaining_ / sizeof(T)) {
+      ok_ = false;
+      return false;
+    }
+    v.resize(count);
+    return copy_out(v.data(), count * sizeof(T));
+  }
+
+  bool read(std::string& s) {
+    uint64_t count = 0;
+    if (!read(count) || count > remaining_) {
+      ok_ = false;
+      return false;
+    }
+    s.assign(data_, count);
+    data_ += count;
+    remaining_ -= count;
+    return true;
+  }
+
+  bool read_header() {
+    uint32_t magic = 0, version = 0;
+    if (!read(magic) || !read(version) || magic != kMagic || version != kFormatVersion) {
+      ok_ = false;
+    }
+    return ok_;
+  }
+
+  bool ok() const {
+    return ok_;
+  }
+
+  bool exhausted() const {
+    return remaining_ == 0;
+  }
+
+ private:
+  bool copy_out(void* dst, size_t nbytes) {
+    if (!ok_ || nbytes > remaining_) {
+      ok_ = false;
+      return false;
+    }
+    if (nbytes > 0) {
+      std::memcpy(dst, data_, nbytes);
+    }
+    data_ += nbytes;
+    remaining_ -= nbytes;
+    return true;
+  }
+
+  const char* data_;
+  size_t remaining_;
+  bool ok_ = true;
+};
+
+// Plugins serialized before the compact format was introduced were written as torch::serialize archives (zip files)
+inline bool is_legacy_archive(const char* data, size_t length) {
+  return length >= 4 && data[0] == 'P' && data[1] == 'K' && data[2] == 0x03 && data[3] == 0x04;
+}
+
+} // namespace serialization
+} // namespace impl
+} // namespace plugins
+} // namespace core
+} // namespace torch_tensorrt
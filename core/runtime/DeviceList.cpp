@@ -1,5 +1,3 @@
-#include "cuda_runtime.h"
-
 #include "core/runtime/runtime.h"
 #include "core/util/prelude.h"
 
@@ -8,14 +6,10 @@ namespace core {
 namespace runtime {
 
 DeviceList::DeviceList() {
-  int num_devices = 0;
-  auto status = cudaGetDeviceCount(&num_devices);
-  if (status != cudaSuccess) {
-    LOG_WARNING("Unable to read CUDA capable devices. Return status: " << status);
-  }
-
-  for (int i = 0; i < num_devices; i++) {
-    device_list[i] = RTDevice(i, nvinfer1::DeviceType::kGPU);
+  auto& query = get_device_query();
+  auto num_devices = query.device_count();
+  for (int64_t i = 0; i < num_devices; i++) {
+    device_list[i] = RTDevice(i, nvinfer1::DeviceType::kGPU, query.properties(i));
   }
 
   // REVIEW: DO WE CARE ABOUT DLA?
@@ -31,11 +25,16 @@ RTDevice DeviceList::find(int device_id) {
   return device_list[device_id];
 }
 
-DeviceList::DeviceMap DeviceList::get_devices() {
+const RTDevice* DeviceList::lookup(int64_t device_id) const {
+  auto it = device_list.find(static_cast<int>(device_id));
+  return it == device_list.end() ? nullptr : &it->second;
+}
+
+const DeviceList::DeviceMap& DeviceList::get_devices() const {
   return device_list;
 }
 
-std::string DeviceList::dump_list() {
+std::string DeviceList::dump_list() const {
   std::stringstream ss;
   for (auto it = device_list.begin(); it != device_list.end(); ++it) {
     ss << "    " << it->second << std::endl;
@@ -0,0 +1,93 @@
+#include "core/runtime/DeviceQuery.h"
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include "cuda_runtime.h"
+
+#include "core/runtime/runtime.h"
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+namespace {
+class CudaDeviceQuery : public DeviceQuery {
+ public:
+  int64_t device_count() override {
+    int num_devices = 0;
+    auto status = cudaGetDeviceCount(&num_devices);
+    if (status != cudaSuccess) {
+      LOG_WARNING("Unable to read CUDA capable devices. Return status: " << status);
+      return 0;
+    }
+    return num_devices;
+  }
+
+  DeviceProperties properties(int64_t device_id) override {
+    cudaDeviceProp device_prop;
+    DeviceProperties props;
+    if (cudaGetDeviceProperties(&device_prop, static_cast<int>(device_id)) == cudaSuccess) {
+      props.major = device_prop.major;
+      props.minor = device_prop.minor;
+      props.name = device_prop.name;
+    }
+    return props;
+  }
+
+  int64_t current_device() override {
+    int device = -1;
+    TORCHTRT_CHECK(
+        (cudaGetDevice(&device) == cudaSuccess), "Unable to get current device (runtime.get_current_device)");
+    return device;
+  }
+
+  bool set_device(int64_t device_id) override {
+    return cudaSetDevice(static_cast<int>(device_id)) == cudaSuccess;
+  }
+};
+
+std::mutex query_mu;
+// Replaced queries are kept alive since other threads may still be using them
+std::vector<std::shared_ptr<DeviceQuery>> installed_queries;
+std::atomic<DeviceQuery*> active_query = {nullptr};
+std::atomic<uint64_t> snapshot_generation = {1};
+
+DeviceQuery* install_default_query() {
+  std::lock_guard<std::mutex> lock(query_mu);
+  if (!active_query.load()) {
+    installed_queries.push_back(std::make_shared<CudaDeviceQuery>());
+    active_query.store(installed_queries.back().get());
+  }
+  return active_query.load();
+}
+} // namespace
+
+DeviceQuery& get_device_query() {
+  auto query = active_query.load(std::memory_order_acquire);
+  if (!query) {
+    query = install_default_query();
+  }
+  return *query;
+}
+
+void set_device_query(std::shared_ptr<DeviceQuery> query) {
+  {
+    std::lock_guard<std::mutex> lock(query_mu);
+    installed_queries.push_back(query);
+    active_query.store(query.get(), std::memory_order_release);
+  }
+  // In this order a thread that sees the new generation also sees the new snapshot
+  reset_available_device_list();
+  snapshot_generation++;
+}
+
+uint64_t get_device_snapshot_generation() {
+  return snapshot_generation.load(std::memory_order_acquire);
+}
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+struct DeviceProperties {
+  int64_t major = -1; // CUDA compute major version
+  int64_t minor = -1; // CUDA compute minor version
+  std::string name;
+};
+
+// Every CUDA device query the runtime makes goes through this interface, so device selection can be tested
+// without GPUs. Implementations must be thread safe.
+class DeviceQuery {
+ public:
+  virtual ~DeviceQuery() = default;
+  virtual int64_t device_count() = 0;
+  // Slow (cudaGetDeviceProperties), only used to take the device snapshot
+  virtual DeviceProperties properties(int64_t device_id) = 0;
+  // Cheap, CUDA keeps the current device per thread
+  virtual int64_t current_device() = 0;
+  virtual bool set_device(int64_t device_id) = 0;
+};
+
+DeviceQuery& get_device_query();
+
+// Replaces the query layer and drops the device snapshot so the next lookup takes a new one. Meant for tests, must
+// not race with engine execution.
+void set_device_query(std::shared_ptr<DeviceQuery> query);
+
+// Bumped whenever the device snapshot is dropped, lets callers cache lookups into it
+uint64_t get_device_snapshot_generation();
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
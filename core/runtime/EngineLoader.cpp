@@ -0,0 +1,161 @@
+#include "core/runtime/EngineLoader.h"
+
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+namespace {
+std::mutex metrics_mu;
+EngineLoadMetrics metrics;
+
+std::atomic<EngineLoadMode> engine_load_mode = {EngineLoadMode::kEAGER};
+std::atomic<int64_t> engine_load_threads = {0};
+
+double elapsed_ms(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+} // namespace
+
+EngineLoadMetrics get_engine_load_metrics() {
+  std::lock_guard<std::mutex> lock(metrics_mu);
+  return metrics;
+}
+
+void reset_engine_load_metrics() {
+  std::lock_guard<std::mutex> lock(metrics_mu);
+  metrics = EngineLoadMetrics();
+}
+
+DeferredLoad::DeferredLoad(std::function<void()> load_fn) : load_fn_(std::move(load_fn)) {
+  std::lock_guard<std::mutex> lock(metrics_mu);
+  metrics.deferred++;
+}
+
+void DeferredLoad::get(bool from_background) {
+  if (done()) {
+    return;
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  std::unique_lock<std::mutex> lock(mu_);
+  if (!attempted_) {
+    attempted_ = true;
+    auto load_start = std::chrono::steady_clock::now();
+    try {
+      load_fn_();
+    } catch (...) {
+      error_ = std::current_exception();
+    }
+    auto load_ms = elapsed_ms(load_start);
+    // The closure may hold the serialized engine, release it now that it is no longer needed
+    load_fn_ = nullptr;
+
+    std::lock_guard<std::mutex> metrics_lock(metrics_mu);
+    if (error_) {
+      metrics.failed++;
+    } else {
+      metrics.loaded++;
+      metrics.loaded_in_background += from_background ? 1 : 0;
+    }
+    metrics.load_ms_total += load_ms;
+    metrics.load_ms_max = std::max(metrics.load_ms_max, load_ms);
+    if (!error_) {
+      done_.store(true, std::memory_order_release);
+    }
+  }
+
+  if (!from_background) {
+    auto wait_ms = elapsed_ms(start);
+    std::lock_guard<std::mutex> metrics_lock(metrics_mu);
+    metrics.wait_ms_total += wait_ms;
+  }
+
+  if (error_) {
+    std::rethrow_exception(error_);
+  }
+}
+
+EngineLoadPool::EngineLoadPool(size_t num_threads) : num_threads_(std::max<size_t>(num_threads, 1)) {}
+
+EngineLoadPool::~EngineLoadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    // Queued engines are left to load on first use
+    stop_ = true;
+    jobs_.clear();
+  }
+  job_cv_.notify_all();
+  for (auto& w : workers_) {
+    w.join();
+  }
+}
+
+void EngineLoadPool::submit(std::function<void()> job) {
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    jobs_.push_back(std::move(job));
+    if (workers_.size() < num_threads_) {
+      workers_.emplace_back(&EngineLoadPool::work, this);
+    }
+  }
+  job_cv_.notify_one();
+}
+
+void EngineLoadPool::wait_idle() {
+  std::unique_lock<std::mutex> lock(mu_);
+  idle_cv_.wait(lock, [this]() { return jobs_.empty() && running_ == 0; });
+}
+
+void EngineLoadPool::work() {
+  std::unique_lock<std::mutex> lock(mu_);
+  while (true) {
+    job_cv_.wait(lock, [this]() { return stop_ || !jobs_.empty(); });
+    if (stop_) {
+      return;
+    }
+    auto job = std::move(jobs_.front());
+    jobs_.pop_front();
+    running_++;
+    lock.unlock();
+    try {
+      job();
+    } catch (const std::exception& e) {
+      // The engine keeps the error and reports it on first use
+      LOG_WARNING("Background engine deserialization failed: " << e.what());
+    }
+    lock.lock();
+    running_--;
+    if (jobs_.empty() && running_ == 0) {
+      idle_cv_.notify_all();
+    }
+  }
+}
+
+EngineLoadPool& EngineLoadPool::global() {
+  auto requested = engine_load_threads.load();
+  static EngineLoadPool pool(
+      requested > 0 ? static_cast<size_t>(requested) : std::min<size_t>(std::thread::hardware_concurrency(), 4));
+  return pool;
+}
+
+EngineLoadMode get_engine_load_mode() {
+  return engine_load_mode.load();
+}
+
+void set_engine_load_mode(EngineLoadMode mode) {
+  engine_load_mode.store(mode);
+}
+
+void set_engine_load_threads(int64_t num_threads) {
+  engine_load_threads.store(num_threads);
+}
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
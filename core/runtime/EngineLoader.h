@@ -0,0 +1,102 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+// How engines are deserialized when a compiled module is loaded
+enum class EngineLoadMode : int64_t {
+  // Deserialize in the engine constructor (module load blocks until every engine is ready)
+  kEAGER = 0,
+  // Keep the serialized engine and deserialize on first execution
+  kLAZY,
+  // Like kLAZY, but engines are also queued on a background pool in load order
+  kBACKGROUND,
+};
+
+// Startup cost of deferred engines since the last reset, times in milliseconds
+struct EngineLoadMetrics {
+  int64_t deferred = 0; // engines whose deserialization was deferred
+  int64_t loaded = 0; // deferred engines that have since been deserialized
+  int64_t failed = 0;
+  int64_t loaded_in_background = 0;
+  double load_ms_total = 0;
+  double load_ms_max = 0;
+  // Time callers outside the background pool spent on engines that were not ready yet, loading or waiting
+  double wait_ms_total = 0;
+};
+
+EngineLoadMetrics get_engine_load_metrics();
+void reset_engine_load_metrics();
+
+// Runs a load function at most once, on whichever thread needs the result first. Every other caller blocks until it
+// has finished. If the load throws, the error is kept and rethrown to every later caller.
+class DeferredLoad {
+ public:
+  explicit DeferredLoad(std::function<void()> load_fn);
+  DeferredLoad(const DeferredLoad&) = delete;
+  DeferredLoad& operator=(const DeferredLoad&) = delete;
+
+  // Runs the load if it has not started yet, otherwise waits for it
+  void get(bool from_background = false);
+
+  bool done() const {
+    return done_.load(std::memory_order_acquire);
+  }
+
+ private:
+  std::mutex mu_;
+  std::function<void()> load_fn_;
+  std::atomic<bool> done_ = {false};
+  bool attempted_ = false;
+  std::exception_ptr error_;
+};
+
+// FIFO pool of worker threads used by EngineLoadMode::kBACKGROUND. Workers are started on the first submission.
+class EngineLoadPool {
+ public:
+  explicit EngineLoadPool(size_t num_threads);
+  ~EngineLoadPool();
+  EngineLoadPool(const EngineLoadPool&) = delete;
+  EngineLoadPool& operator=(const EngineLoadPool&) = delete;
+
+  void submit(std::function<void()> job);
+
+  // Blocks until every submitted job has finished
+  void wait_idle();
+
+  // Process wide pool, sized by set_engine_load_threads
+  static EngineLoadPool& global();
+
+ private:
+  void work();
+
+  size_t num_threads_;
+  std::mutex mu_;
+  std::condition_variable job_cv_;
+  std::condition_variable idle_cv_;
+  std::deque<std::function<void()>> jobs_;
+  std::vector<std::thread> workers_;
+  size_t running_ = 0;
+  bool stop_ = false;
+};
+
+EngineLoadMode get_engine_load_mode();
+void set_engine_load_mode(EngineLoadMode mode);
+
+// Number of threads of the global pool, only takes effect before the first background load
+void set_engine_load_threads(int64_t num_threads);
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
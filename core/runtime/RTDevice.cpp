@@ -1,5 +1,3 @@
-#include "cuda_runtime.h"
-
 #include "core/runtime/runtime.h"
 #include "core/util/prelude.h"
 
@@ -12,30 +10,19 @@ typedef enum { ID_IDX = 0, SM_MAJOR_IDX, SM_MINOR_IDX, DEVICE_TYPE_IDX, DEVICE_N
 RTDevice::RTDevice() : id{-1}, major{-1}, minor{-1}, device_type{nvinfer1::DeviceType::kGPU} {}
 
 RTDevice::RTDevice(int64_t gpu_id, nvinfer1::DeviceType device_type) {
-  RTDevice cuda_device;
-  cudaDeviceProp device_prop;
-
-  // Device ID
-  this->id = gpu_id;
-
-  // Get Device Properties
-  cudaGetDeviceProperties(&device_prop, gpu_id);
-
-  // Compute capability major version
-  this->major = device_prop.major;
-
-  // Compute capability minor version
-  this->minor = device_prop.minor;
-
-  std::string device_name(device_prop.name);
-
-  // Set Device name
-  this->device_name = device_name;
-
-  // Set Device Type
-  this->device_type = device_type;
+  // Only devices missing from the snapshot cost a property query
+  auto known = get_available_device_list().lookup(gpu_id);
+  if (known) {
+    *this = *known;
+    this->device_type = device_type;
+  } else {
+    *this = RTDevice(gpu_id, device_type, get_device_query().properties(gpu_id));
+  }
 }
 
+RTDevice::RTDevice(int64_t gpu_id, nvinfer1::DeviceType device_type, const DeviceProperties& props)
+    : id{gpu_id}, major{props.major}, minor{props.minor}, device_type{device_type}, device_name{props.name} {}
+
 // NOTE: Serialization Format for Device Info:
 // id%major%minor%(enum)device_type%device_name
 
@@ -1,6 +1,7 @@
 #pragma once
 #include <string>
 #include "NvInfer.h"
+#include "core/runtime/DeviceQuery.h"
 
 namespace torch_tensorrt {
 namespace core {
@@ -16,7 +17,9 @@ struct RTDevice {
   std::string device_name;
 
   RTDevice();
+  // Looks the device up in the device snapshot
   RTDevice(int64_t gpu_id, nvinfer1::DeviceType device_type);
+  RTDevice(int64_t gpu_id, nvinfer1::DeviceType device_type, const DeviceProperties& props);
   RTDevice(std::string serialized_device_info);
   ~RTDevice() = default;
   RTDevice(const RTDevice& other) = default;
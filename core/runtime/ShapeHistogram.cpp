@@ -0,0 +1,285 @@
+#include "core/runtime/ShapeHistogram.h"
+
+#include <algorithm>
+#include <sstream>
+#include <tuple>
+#include <utility>
+
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+namespace {
+const std::string kHeader = "# torch_tensorrt shape histogram v1";
+
+std::string shape_to_str(const std::vector<int64_t>& shape) {
+  std::stringstream ss;
+  ss << "(";
+  for (size_t i = 0; i < shape.size(); i++) {
+    ss << (i ? "," : "") << shape[i];
+  }
+  ss << ")";
+  return ss.str();
+}
+
+std::vector<int64_t> shape_from_str(const std::string& str) {
+  TORCHTRT_CHECK(
+      str.size() >= 2 && str.front() == '(' && str.back() == ')', "Malformed shape in shape histogram: " << str);
+  std::vector<int64_t> shape;
+  std::stringstream ss(str.substr(1, str.size() - 2));
+  std::string dim;
+  while (std::getline(ss, dim, ',')) {
+    shape.push_back(std::stoll(dim));
+  }
+  return shape;
+}
+
+int64_t volume(const ShapeHistogram::InputShapes& shapes) {
+  int64_t v = 0;
+  for (auto& s : shapes) {
+    int64_t n = 1;
+    for (auto d : s) {
+      n *= d;
+    }
+    v += n;
+  }
+  return v;
+}
+} // namespace
+
+ShapeHistogram::ShapeHistogram(size_t max_entries) : max_entries_(max_entries) {}
+
+ShapeHistogram::ShapeHistogram(const ShapeHistogram& other) {
+  *this = other;
+}
+
+ShapeHistogram& ShapeHistogram::operator=(const ShapeHistogram& other) {
+  if (this == &other) {
+    return *this;
+  }
+  std::scoped_lock lock(mu_, other.mu_);
+  max_entries_ = other.max_entries_;
+  input_names_ = other.input_names_;
+  input_dtypes_ = other.input_dtypes_;
+  entries_ = other.entries_;
+  total_ = other.total_;
+  dropped_ = other.dropped_;
+  return *this;
+}
+
+void ShapeHistogram::record(const InputShapes& shapes, uint64_t count) {
+  std::lock_guard<std::mutex> lock(mu_);
+  total_ += count;
+  auto it = entries_.find(shapes);
+  if (it != entries_.end()) {
+    it->second += count;
+  } else if (entries_.size() < max_entries_) {
+    entries_.emplace(shapes, count);
+  } else {
+    dropped_ += count;
+  }
+}
+
+void ShapeHistogram::merge(const ShapeHistogram& other) {
+  auto other_entries = other.entries();
+  auto other_dropped = other.dropped();
+  for (auto& e : other_entries) {
+    record(e.first, e.second);
+  }
+  std::lock_guard<std::mutex> lock(mu_);
+  total_ += other_dropped;
+  dropped_ += other_dropped;
+  if (input_names_.empty()) {
+    input_names_ = other.input_names();
+  }
+  if (input_dtypes_.empty()) {
+    input_dtypes_ = other.input_dtypes();
+  }
+}
+
+void ShapeHistogram::reset() {
+  std::lock_guard<std::mutex> lock(mu_);
+  entries_.clear();
+  total_ = 0;
+  dropped_ = 0;
+}
+
+std::map<ShapeHistogram::InputShapes, uint64_t> ShapeHistogram::entries() const {
+  std::lock_guard<std::mutex> lock(mu_);
+  return entries_;
+}
+
+uint64_t ShapeHistogram::total() const {
+  std::lock_guard<std::mutex> lock(mu_);
+  return total_;
+}
+
+uint64_t ShapeHistogram::dropped() const {
+  std::lock_guard<std::mutex> lock(mu_);
+  return dropped_;
+}
+
+void ShapeHistogram::set_input_names(std::vector<std::string> names) {
+  std::lock_guard<std::mutex> lock(mu_);
+  input_names_ = std::move(names);
+}
+
+std::vector<std::string> ShapeHistogram::input_names() const {
+  std::lock_guard<std::mutex> lock(mu_);
+  return input_names_;
+}
+
+void ShapeHistogram::set_input_dtypes(std::vector<std::string> dtypes) {
+  std::lock_guard<std::mutex> lock(mu_);
+  input_dtypes_ = std::move(dtypes);
+}
+
+std::vector<std::string> ShapeHistogram::input_dtypes() const {
+  std::lock_guard<std::mutex> lock(mu_);
+  return input_dtypes_;
+}
+
+std::string ShapeHistogram::serialize() const {
+  std::lock_guard<std::mutex> lock(mu_);
+  std::stringstream ss;
+  ss << kHeader << "\n";
+  ss << "inputs";
+  for (auto& name : input_names_) {
+    ss << " " << name;
+  }
+  ss << "\n";
+  ss << "dtypes";
+  for (auto& dtype : input_dtypes_) {
+    ss << " " << dtype;
+  }
+  ss << "\n";
+  ss << "dropped " << dropped_ << "\n";
+  for (auto& e : entries_) {
+    ss << e.second;
+    for (auto& s : e.first) {
+      ss << " " << shape_to_str(s);
+    }
+    ss << "\n";
+  }
+  return ss.str();
+}
+
+ShapeHistogram ShapeHistogram::deserialize(const std::string& serialized) {
+  std::stringstream ss(serialized);
+  std::string line;
+  TORCHTRT_CHECK(std::getline(ss, line) && line == kHeader, "Not a shape histogram, expected header: " << kHeader);
+
+  ShapeHistogram histogram(SIZE_MAX);
+  while (std::getline(ss, line)) {
+    if (line.empty()) {
+      continue;
+    }
+    std::stringstream fields(line);
+    std::string first;
+    fields >> first;
+    if (first == "inputs" || first == "dtypes") {
+      std::vector<std::string> words;
+      for (std::string word; fields >> word;) {
+        words.push_back(word);
+      }
+      if (first == "inputs") {
+        histogram.set_input_names(std::move(words));
+      } else {
+        histogram.set_input_dtypes(std::move(words));
+      }
+    } else if (first == "dropped") {
+      uint64_t dropped = 0;
+      fields >> dropped;
+      histogram.total_ += dropped;
+      histogram.dropped_ += dropped;
+    } else {
+      InputShapes shapes;
+      for (std::string shape; fields >> shape;) {
+        shapes.push_back(shape_from_str(shape));
+      }
+      histogram.record(shapes, std::stoull(first));
+    }
+  }
+  return histogram;
+}
+
+std::vector<ShapeProfile> ShapeHistogram::recommend_profiles(size_t num_buckets) const {
+  auto all_entries = entries();
+  TORCHTRT_CHECK(!all_entries.empty(), "Cannot recommend shapes from an empty shape histogram");
+
+  // Profiles can only vary dimension sizes, not the number of inputs or their ranks
+  const auto& reference = all_entries.begin()->first;
+  std::vector<std::tuple<int64_t, const InputShapes*, uint64_t>> sorted;
+  uint64_t counted = 0;
+  for (auto& e : all_entries) {
+    TORCHTRT_CHECK(e.first.size() == reference.size(), "Shape histogram mixes calls with different numbers of inputs");
+    for (size_t i = 0; i < reference.size(); i++) {
+      TORCHTRT_CHECK(
+          e.first[i].size() == reference[i].size(),
+          "Input " << i << " was observed with different ranks " << shape_to_str(reference[i]) << " and "
+                   << shape_to_str(e.first[i]));
+    }
+    sorted.emplace_back(volume(e.first), &e.first, e.second);
+    counted += e.second;
+  }
+  std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) {
+    return std::get<0>(a) != std::get<0>(b) ? std::get<0>(a) < std::get<0>(b) : *std::get<1>(a) < *std::get<1>(b);
+  });
+
+  // Cut the volume ordered shapes into contiguous groups carrying roughly equal shares of the calls, leaving at least
+  // one distinct shape for every remaining group
+  size_t remaining_buckets = std::max<size_t>(1, std::min(num_buckets, sorted.size()));
+  uint64_t remaining = counted;
+  std::vector<std::pair<size_t, size_t>> groups;
+  size_t group_start = 0;
+  uint64_t group_count = 0;
+  for (size_t i = 0; i < sorted.size(); i++) {
+    group_count += std::get<2>(sorted[i]);
+    size_t entries_left = sorted.size() - i - 1;
+    if (remaining_buckets > 1 && entries_left >= remaining_buckets - 1 &&
+        (group_count * remaining_buckets >= remaining || entries_left == remaining_buckets - 1)) {
+      groups.emplace_back(group_start, i + 1);
+      remaining -= group_count;
+      remaining_buckets--;
+      group_start = i + 1;
+      group_count = 0;
+    }
+  }
+  groups.emplace_back(group_start, sorted.size());
+
+  std::vector<ShapeProfile> profiles;
+  for (auto& g : groups) {
+    ShapeProfile profile;
+    auto& ranges = profile.inputs;
+    ranges.resize(reference.size());
+    size_t most_frequent = g.first;
+    for (size_t e = g.first; e < g.second; e++) {
+      const auto& shapes = *std::get<1>(sorted[e]);
+      profile.calls += std::get<2>(sorted[e]);
+      for (size_t i = 0; i < shapes.size(); i++) {
+        if (e == g.first) {
+          ranges[i].min = shapes[i];
+          ranges[i].max = shapes[i];
+        }
+        for (size_t d = 0; d < shapes[i].size(); d++) {
+          ranges[i].min[d] = std::min(ranges[i].min[d], shapes[i][d]);
+          ranges[i].max[d] = std::max(ranges[i].max[d], shapes[i][d]);
+        }
+      }
+      if (std::get<2>(sorted[e]) > std::get<2>(sorted[most_frequent])) {
+        most_frequent = e;
+      }
+    }
+    for (size_t i = 0; i < ranges.size(); i++) {
+      ranges[i].opt = (*std::get<1>(sorted[most_frequent]))[i];
+    }
+    profiles.push_back(std::move(profile));
+  }
+  return profiles;
+}
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+// Range of one input over a group of observed calls, in the shape of an ir::Input min/opt/max spec
+struct ShapeRange {
+  std::vector<int64_t> min;
+  std::vector<int64_t> opt;
+  std::vector<int64_t> max;
+};
+
+// One recommended optimization profile, a range per input, and the number of recorded calls it was derived from
+struct ShapeProfile {
+  std::vector<ShapeRange> inputs;
+  uint64_t calls = 0;
+};
+
+// Counts how often each combination of input shapes was seen by an engine so optimization profiles can be derived from
+// real traffic instead of guessed. Only distinct combinations are stored, so memory stays small for the usual handful
+// of batch sizes and sequence lengths. Combinations beyond max_entries are counted as dropped.
+class ShapeHistogram {
+ public:
+  typedef std::vector<std::vector<int64_t>> InputShapes;
+
+  explicit ShapeHistogram(size_t max_entries = 1024);
+  ShapeHistogram(const ShapeHistogram& other);
+  ShapeHistogram& operator=(const ShapeHistogram& other);
+
+  void record(const InputShapes& shapes, uint64_t count = 1);
+  void merge(const ShapeHistogram& other);
+  void reset();
+
+  std::map<InputShapes, uint64_t> entries() const;
+  uint64_t total() const;
+  uint64_t dropped() const;
+
+  // Names and data types (e.g. "Float") of the inputs in recording order, written to the file header so tools can
+  // label recommendations and turn them into input specs
+  void set_input_names(std::vector<std::string> names);
+  std::vector<std::string> input_names() const;
+  void set_input_dtypes(std::vector<std::string> dtypes);
+  std::vector<std::string> input_dtypes() const;
+
+  // Line oriented text format:
+  //   # torch_tensorrt shape histogram v1
+  //   inputs <name>...
+  //   dtypes <dtype>...
+  //   dropped <count>
+  //   <count> (<d0>,<d1>,...) ...
+  std::string serialize() const;
+  static ShapeHistogram deserialize(const std::string& serialized);
+
+  // Splits the observed calls into up to num_buckets groups of similar size, each covering a similar share of the
+  // traffic, and returns one range per input for each group. opt is the most frequent shape of the group, so TensorRT
+  // tunes for the shapes actually served.
+  std::vector<ShapeProfile> recommend_profiles(size_t num_buckets = 1) const;
+
+ private:
+  size_t max_entries_;
+  mutable std::mutex mu_;
+  std::vector<std::string> input_names_;
+  std::vector<std::string> input_dtypes_;
+  std::map<InputShapes, uint64_t> entries_;
+  uint64_t total_ = 0;
+  uint64_t dropped_ = 0;
+};
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
@@ -0,0 +1,101 @@
+#include "core/runtime/SharedDeviceMemory.h"
+
+#include <algorithm>
+
+#include "ATen/ATen.h"
+#include "c10/cuda/CUDAGuard.h"
+
+#include "core/util/prelude.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+struct SharedDeviceMemory::Lease::Buffer {
+  std::mutex mu;
+  at::Tensor storage;
+  // Recorded after each use, the next user waits on it
+  at::cuda::CUDAEvent last_use;
+};
+
+SharedDeviceMemory::Lease::Lease(Buffer* buffer, std::unique_lock<std::mutex> lock, c10::cuda::CUDAStream exec_stream)
+    : buffer_(buffer),
+      lock_(std::move(lock)),
+      exec_stream_(exec_stream),
+      data_(buffer->storage.data_ptr()),
+      size_(buffer->storage.numel()) {
+  buffer_->last_use.block(exec_stream_);
+}
+
+SharedDeviceMemory::Lease::~Lease() {
+  if (!lock_.owns_lock()) {
+    return; // moved from
+  }
+  buffer_->last_use.record(exec_stream_);
+  // Keeps the caching allocator from handing the memory out again before this work is done if the buffer is grown
+  buffer_->storage.record_stream(exec_stream_);
+}
+
+SharedDeviceMemory::~SharedDeviceMemory() = default;
+
+void SharedDeviceMemory::register_engine(int64_t device, int64_t size) {
+  std::lock_guard<std::mutex> lock(mu_);
+  auto& device_size = device_sizes_[device];
+  device_size = std::max(device_size, size);
+}
+
+SharedDeviceMemory::Lease SharedDeviceMemory::acquire(
+    int64_t device,
+    const c10::cuda::CUDAStream& caller_stream,
+    const c10::cuda::CUDAStream& exec_stream,
+    int64_t size) {
+  Lease::Buffer* buffer;
+  int64_t target_size;
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    auto& slot = buffers_[{device, caller_stream.id()}];
+    if (!slot) {
+      slot = std::make_unique<Lease::Buffer>();
+    }
+    buffer = slot.get();
+    target_size = std::max(device_sizes_[device], size);
+  }
+
+  std::unique_lock<std::mutex> buffer_lock(buffer->mu);
+  if (buffer->storage.numel() < target_size) {
+    LOG_DEBUG(
+        "Allocating " << target_size << " bytes of shared TensorRT device memory on device " << device << " for stream "
+                      << caller_stream.id());
+    // The old buffer is still protected by the streams recorded on it, so it can be dropped immediately
+    c10::cuda::CUDAGuard device_guard(static_cast<c10::DeviceIndex>(device));
+    buffer->storage = at::empty({target_size}, at::TensorOptions().dtype(at::kByte).device(at::kCUDA, device));
+  }
+  return Lease(buffer, std::move(buffer_lock), exec_stream);
+}
+
+int64_t SharedDeviceMemory::allocated_bytes() {
+  std::lock_guard<std::mutex> lock(mu_);
+  int64_t total = 0;
+  for (auto& b : buffers_) {
+    std::lock_guard<std::mutex> buffer_lock(b.second->mu);
+    total += b.second->storage.numel();
+  }
+  return total;
+}
+
+void SharedDeviceMemory::release() {
+  std::lock_guard<std::mutex> lock(mu_);
+  for (auto& b : buffers_) {
+    std::lock_guard<std::mutex> buffer_lock(b.second->mu);
+    b.second->storage = at::Tensor();
+  }
+}
+
+SharedDeviceMemory& SharedDeviceMemory::global() {
+  static SharedDeviceMemory memory;
+  return memory;
+}
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
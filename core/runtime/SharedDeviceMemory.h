@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include "ATen/Tensor.h"
+#include "ATen/cuda/CUDAEvent.h"
+#include "c10/cuda/CUDAStream.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace runtime {
+
+// Scratch memory for execution contexts created with ExecutionContextAllocationStrategy::kUSER_MANAGED.
+//
+// Engines called from the same caller stream run one after another, so they share one buffer per device and caller
+// stream sized to the largest engine registered on that device. Different caller streams get different buffers and
+// stay concurrent. Every use is ordered on the GPU after the previous one through an event, so engines enqueued from
+// several threads onto the same caller stream, or on different engine streams, never overlap in the buffer.
+class SharedDeviceMemory {
+ public:
+  // Holds the buffer for one enqueue. The previous user's work has to finish before exec_stream proceeds. Destroying
+  // the lease marks the buffer busy until the work enqueued on exec_stream in between has finished.
+  class Lease {
+   public:
+    Lease(Lease&& other) = default;
+    ~Lease();
+
+    void* data() const {
+      return data_;
+    }
+    int64_t size() const {
+      return size_;
+    }
+
+   private:
+    friend class SharedDeviceMemory;
+    struct Buffer;
+    Lease(Buffer* buffer, std::unique_lock<std::mutex> lock, c10::cuda::CUDAStream exec_stream);
+
+    Buffer* buffer_;
+    std::unique_lock<std::mutex> lock_;
+    c10::cuda::CUDAStream exec_stream_;
+    void* data_;
+    int64_t size_;
+  };
+
+  SharedDeviceMemory() = default;
+  ~SharedDeviceMemory();
+  SharedDeviceMemory(const SharedDeviceMemory&) = delete;
+  SharedDeviceMemory& operator=(const SharedDeviceMemory&) = delete;
+
+  // Grows the size of the buffers for device so that the engine fits without reallocating on first use
+  void register_engine(int64_t device, int64_t size);
+
+  // Reserves at least size bytes of the buffer for (device, caller_stream) for work enqueued on exec_stream
+  Lease acquire(
+      int64_t device,
+      const c10::cuda::CUDAStream& caller_stream,
+      const c10::cuda::CUDAStream& exec_stream,
+      int64_t size);
+
+  // Bytes currently allocated across all buffers
+  int64_t allocated_bytes();
+
+  // Frees every buffer once the work using it has finished
+  void release();
+
+  static SharedDeviceMemory& global();
+
+ private:
+  using BufferKey = std::pair<int64_t, c10::StreamId>;
+
+  std::mutex mu_;
+  std::map<int64_t, int64_t> device_sizes_;
+  std::map<BufferKey, std::unique_ptr<Lease::Buffer>> buffers_;
+};
+
+} // namespace runtime
+} // namespace core
+} // namespace torch_tensorrt
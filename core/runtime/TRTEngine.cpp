@@ -2,6 +2,7 @@
 
 #include <cuda_runtime.h>
 #include "NvInfer.h"
+#include "c10/cuda/CUDAGuard.h"
 #include "c10/cuda/CUDAStream.h"
 #include "torch/csrc/jit/frontend/function_schema_parser.h"
 #include "torch/cuda.h"
@@ -47,7 +48,7 @@ TRTEngine::TRTEngine(
           hardware_compatible,
           serialized_metadata) {}
 
-TRTEngine::TRTEngine(std::vector<std::string> serialized_info)
+TRTEngine::TRTEngine(std::vector<std::string> serialized_info, bool defer_deserialization)
     : TRTEngine(
           serialized_info[NAME_IDX],
           serialized_info[ENGINE_IDX],
@@ -56,7 +57,8 @@ TRTEngine::TRTEngine(std::vector<std::string> serialized_info)
           split(serialized_info[OUTPUT_BINDING_NAMES_IDX], BINDING_DELIM),
           Platform(serialized_info[TARGET_PLATFORM_IDX]),
           static_cast<bool>(std::stoi(serialized_info[HW_COMPATIBLE_IDX])),
-          serialized_info[SERIALIZED_METADATA_IDX]) {}
+          serialized_info[SERIALIZED_METADATA_IDX],
+          defer_deserialization) {}
 
 TRTEngine::TRTEngine(
     const std::string& mod_name,
@@ -66,7 +68,8 @@ TRTEngine::TRTEngine(
     const std::vector<std::string>& _out_binding_names,
     const Platform& target_platform,
     bool hardware_compatible,
-    const std::string& serialized_metadata) {
+    const std::string& serialized_metadata,
+    bool defer_deserialization) {
   TORCHTRT_CHECK(
       is_supported_on_current_platform(target_platform),
       "This engine was not built to run on this platform (built for: " << target_platform << ", current platform: "
@@ -76,23 +79,50 @@ TRTEngine::TRTEngine(
   this->cudagraph_mempool_id = at::cuda::graph_pool_handle();
 
   this->hardware_compatible = hardware_compatible;
+  this->serialized_metadata = serialized_metadata;
+  name = slugify(mod_name);
+
+  if (!defer_deserialization) {
+    deserialize(serialized_engine, cuda_device, _in_binding_names, _out_binding_names);
+    LOG_DEBUG(*this);
+    return;
+  }
+
+  // Until the engine is deserialized device_info is the device it was built for
+  device_info = cuda_device;
+  deferred_load = std::make_unique<DeferredLoad>(
+      [this, serialized_engine, cuda_device, _in_binding_names, _out_binding_names]() {
+        // Deserialization selects the engine's device, the thread that happens to run it keeps its own
+        c10::cuda::CUDAGuard device_guard(static_cast<c10::DeviceIndex>(get_current_device().id));
+        deserialize(serialized_engine, cuda_device, _in_binding_names, _out_binding_names);
+        LOG_DEBUG("Deserialized TensorRT engine " << name);
+      });
+  LOG_DEBUG("Deferred deserialization of TensorRT engine " << name);
+}
+
+void TRTEngine::deserialize(
+    const std::string& serialized_engine,
+    const RTDevice& cuda_device,
+    const std::vector<std::string>& _in_binding_names,
+    const std::vector<std::string>& _out_binding_names) {
   auto most_compatible_device = get_most_compatible_device(cuda_device, RTDevice(), hardware_compatible);
   TORCHTRT_CHECK(most_compatible_device, "No compatible device was found for instantiating TensorRT engine");
 
-  this->serialized_metadata = serialized_metadata;
   device_info = most_compatible_device.value();
   multi_gpu_device_check();
   set_rt_device(device_info);
 
   rt = make_trt(nvinfer1::createInferRuntime(util::logging::get_logger()));
 
-  name = slugify(mod_name);
-
   cuda_engine = make_trt(rt->deserializeCudaEngine(serialized_engine.c_str(), serialized_engine.size()));
   TORCHTRT_CHECK((cuda_engine.get() != nullptr), "Unable to deserialize the TensorRT engine");
 
-  exec_ctx = make_trt(cuda_engine->createExecutionContext());
-  TORCHTRT_CHECK((exec_ctx.get() != nullptr), "Unable to create TensorRT execution context");
+  shared_device_memory = SHARED_DEVICE_MEMORY_MODE;
+  device_memory_size = cuda_engine->getDeviceMemorySizeV2();
+  if (shared_device_memory) {
+    SharedDeviceMemory::global().register_engine(device_info.id, device_memory_size);
+  }
+  create_execution_context();
 
   if (_in_binding_names.size() == 0 && _out_binding_names.size() == 0) {
     uint64_t inputs = 0;
@@ -202,13 +232,29 @@ TRTEngine::TRTEngine(
     num_io = std::make_pair(inputs_size, outputs);
   }
 
+  in_binding_is_shape_tensor.resize(num_io.first);
+  shape_tensor_buffers.resize(num_io.first);
+  for (uint64_t pyt_idx = 0; pyt_idx < num_io.first; pyt_idx++) {
+    in_binding_is_shape_tensor[pyt_idx] = cuda_engine->isShapeInferenceIO(in_binding_names[pyt_idx].c_str());
+  }
+  std::vector<std::string> in_binding_dtypes;
+  for (auto& binding_name : in_binding_names) {
+    in_binding_dtypes.push_back(
+        c10::toString(util::TRTDataTypeToScalarType(cuda_engine->getTensorDataType(binding_name.c_str()))));
+  }
+  shape_histogram.set_input_names(in_binding_names);
+  shape_histogram.set_input_dtypes(std::move(in_binding_dtypes));
+
 #ifndef NDEBUG
-  this->enable_profiling();
+  // Not enable_profiling(), which would wait on the deferred load this may be running in
+  profile_execution = true;
+  trt_engine_profiler = std::make_unique<TRTEngineProfiler>(name);
+  exec_ctx->setProfiler(trt_engine_profiler.get());
 #endif
-  LOG_DEBUG(*this);
 }
 
 TRTEngine::~TRTEngine() {
+  deferred_load.reset();
   trt_engine_profiler.reset();
   exec_ctx.reset();
   cuda_engine.reset();
@@ -216,14 +262,22 @@ TRTEngine::~TRTEngine() {
 }
 
 void TRTEngine::disable_profiling() {
+  ensure_loaded();
   torch::cuda::synchronize(device_info.id);
   profile_execution = false;
   trt_engine_profiler.reset();
-  exec_ctx = make_trt(cuda_engine->createExecutionContext());
-  TORCHTRT_CHECK((exec_ctx.get() != nullptr), "Unable to recreate TensorRT execution context");
+  create_execution_context();
+}
+
+void TRTEngine::create_execution_context() {
+  auto strategy = shared_device_memory ? nvinfer1::ExecutionContextAllocationStrategy::kUSER_MANAGED
+                                       : nvinfer1::ExecutionContextAllocationStrategy::kSTATIC;
+  exec_ctx = make_trt(cuda_engine->createExecutionContext(strategy));
+  TORCHTRT_CHECK((exec_ctx.get() != nullptr), "Unable to create TensorRT execution context");
 }
 
 void TRTEngine::dump_engine_layer_info_to_file(const std::string& path) {
+  ensure_loaded();
   auto inspector = make_trt(cuda_engine->createEngineInspector());
   std::ofstream f(path);
   f << std::string(inspector->getEngineInformation(nvinfer1::LayerInformationFormat::kJSON));
@@ -238,13 +292,34 @@ void TRTEngine::dump_engine_layer_info() {
   return;
 }
 
+void TRTEngine::dump_shape_histogram_to_file(const std::string& path) {
+  std::ofstream f(path);
+  TORCHTRT_CHECK(f.good(), "Unable to open " << path << " to write the shape histogram of " << name);
+  f << shape_histogram.serialize();
+  f.close();
+  return;
+}
+
+void TRTEngine::dump_shape_histogram() {
+  std::string histogram_file =
+      std::filesystem::path{profile_path_prefix + "/" + name + "_shape_histogram.txt"}.string();
+  dump_shape_histogram_to_file(histogram_file);
+  return;
+}
+
+void TRTEngine::reset_shape_histogram() {
+  shape_histogram.reset();
+}
+
 void TRTEngine::enable_profiling() {
+  ensure_loaded();
   profile_execution = true;
   trt_engine_profiler = std::make_unique<TRTEngineProfiler>(name);
   exec_ctx->setProfiler(trt_engine_profiler.get());
 }
 
 std::string TRTEngine::get_engine_layer_info() {
+  ensure_loaded();
   auto inspector = cuda_engine->createEngineInspector();
   return inspector->getEngineInformation(nvinfer1::LayerInformationFormat::kJSON);
 }
@@ -265,6 +340,12 @@ std::string TRTEngine::to_str() const {
   std::stringstream ss;
   ss << "Torch-TensorRT TensorRT Engine:" << std::endl;
   ss << "  Name: " << name << std::endl;
+  if (!is_loaded()) {
+    ss << "  Not yet deserialized" << std::endl;
+    ss << "  Device: " << device_info << std::endl;
+    ss << "  Target Platform: " << target_platform << std::endl;
+    return ss.str();
+  }
   ss << "  Inputs: [" << std::endl;
   for (uint64_t i = 0; i < num_io.first; i++) {
     ss << "    id: " << i << std::endl;
@@ -288,6 +369,7 @@ std::string TRTEngine::to_str() const {
   ss << "  ]" << std::endl;
   ss << "  Device: " << device_info << std::endl;
   ss << "  Hardware Compatibility: " << (hardware_compatible ? "Enabled" : "Disabled") << std::endl;
+  ss << "  Device Memory: " << device_memory_size << " bytes" << (shared_device_memory ? " (shared)" : "") << std::endl;
   ss << "  Target Platform: " << target_platform << std::endl;
   // clang-format on
   return ss.str();
@@ -12,6 +12,8 @@
 #include "c10/cuda/CUDAStream.h"
 #include "torch/custom_class.h"
 
+#include "core/runtime/EngineLoader.h"
+#include "core/runtime/ShapeHistogram.h"
 #include "core/runtime/TRTEngineProfiler.h"
 #include "core/util/prelude.h"
 
@@ -35,8 +37,12 @@ struct TRTEngine : torch::CustomClassHolder {
 
   std::vector<std::string> in_binding_names = {}; // ITO: PYT IDX
   std::vector<std::string> out_binding_names = {}; // ITO: PYT IDX
+  std::vector<bool> in_binding_is_shape_tensor = {}; // ITO: PYT IDX
 
   bool hardware_compatible = false; // Whether the engine was compiled in hardware compatible mode
+  // Whether exec_ctx was created without device memory and takes scratch space from SharedDeviceMemory per enqueue
+  bool shared_device_memory = false;
+  int64_t device_memory_size = 0;
   std::string serialized_metadata; // This is a base64 encoded pkl object used to store metadata such as settings used
                                    // in compilation
   Platform target_platform;
@@ -51,8 +57,10 @@ struct TRTEngine : torch::CustomClassHolder {
       bool hardware_compatible = false,
       const std::string& serialized_metadata = "");
 
-  TRTEngine(std::vector<std::string> serialized_info);
+  TRTEngine(std::vector<std::string> serialized_info, bool defer_deserialization = false);
 
+  // If defer_deserialization is set only the arguments are recorded, the engine is deserialized by the first call to
+  // ensure_loaded
   TRTEngine(
       const std::string& mod_name,
       const std::string& serialized_engine,
@@ -61,7 +69,19 @@ struct TRTEngine : torch::CustomClassHolder {
       const std::vector<std::string>& out_binding_names,
       const Platform& target_platform = get_current_platform(),
       bool hardware_compatible = false,
-      const std::string& serialized_metadata = "");
+      const std::string& serialized_metadata = "",
+      bool defer_deserialization = false);
+
+  // Deserializes the engine if that was deferred, callers on other threads wait until it is ready. Must be called
+  // before touching anything derived from the engine (rt, cuda_engine, exec_ctx, num_io, binding maps).
+  void ensure_loaded(bool from_background = false) {
+    if (deferred_load) {
+      deferred_load->get(from_background);
+    }
+  }
+  bool is_loaded() const {
+    return !deferred_load || deferred_load->done();
+  }
 
   TRTEngine& operator=(const TRTEngine& other);
   std::string to_str() const;
@@ -71,6 +91,10 @@ struct TRTEngine : torch::CustomClassHolder {
   std::string get_engine_layer_info();
   void dump_engine_layer_info_to_file(const std::string& path);
   void dump_engine_layer_info();
+  // Input shapes observed while SHAPE_RECORDING_MODE is on, see ShapeHistogram::serialize for the format
+  void dump_shape_histogram_to_file(const std::string& path);
+  void dump_shape_histogram();
+  void reset_shape_histogram();
   friend std::ostream& operator<<(std::ostream& os, const TRTEngine& engine);
   static const char BINDING_DELIM = '%';
 
@@ -80,8 +104,12 @@ struct TRTEngine : torch::CustomClassHolder {
   at::cuda::CUDAStream caller_stream = c10::cuda::getDefaultCUDAStream();
   std::vector<at::Tensor> input_buffers = {};
   std::vector<at::Tensor> output_buffers = {};
+  // Pinned host copies of shape tensor inputs, TensorRT reads these during enqueue. ITO: PYT IDX
+  std::vector<at::Tensor> shape_tensor_buffers = {};
   std::string shape_key;
   at::cuda::MempoolId_t cudagraph_mempool_id;
+  // Device memory of a shared_device_memory engine in CUDAGraphs mode, where the address is baked into the graph
+  at::Tensor cudagraph_device_memory;
 
   // TODO: Implement a call method
   // c10::List<at::Tensor> Run(c10::List<at::Tensor> inputs);
@@ -100,6 +128,17 @@ struct TRTEngine : torch::CustomClassHolder {
   std::string cuda_graph_debug_path;
   std::mutex mu;
   std::unique_ptr<TRTEngineProfiler> trt_engine_profiler;
+  ShapeHistogram shape_histogram;
+
+ private:
+  void create_execution_context();
+  void deserialize(
+      const std::string& serialized_engine,
+      const RTDevice& cuda_device,
+      const std::vector<std::string>& in_binding_names,
+      const std::vector<std::string>& out_binding_names);
+
+  std::unique_ptr<DeferredLoad> deferred_load;
 };
 
 } // namespace runtime
@@ -94,7 +94,44 @@ bool _cudagraphs_validate_shapes(std::vector<at::Tensor> inputs, c10::intrusive_
   return true;
 }
 
+// Returns host memory holding the values of shape tensor input idx, which TensorRT reads during enqueue. Values are
+// kept in the dtype of the input, which has already been checked against the binding (int32 or int64). The caller must
+// hold compiled_engine->mu until the enqueue is done.
+void* stage_shape_tensor_input(TRTEngine& compiled_engine, size_t idx, const at::Tensor& input) {
+  if (!CUDAGRAPHS_MODE && !input.is_cuda() && input.is_contiguous()) {
+    // Already what TensorRT wants, and inputs outlive the enqueue
+    return input.data_ptr();
+  }
+
+  auto& staged = compiled_engine.shape_tensor_buffers[idx];
+  if (!staged.defined() || staged.numel() != input.numel() || staged.scalar_type() != input.scalar_type()) {
+    staged = at::empty({input.numel()}, at::TensorOptions().dtype(input.scalar_type()).pinned_memory(true));
+  }
+
+  if (input.is_cuda()) {
+    // TensorRT needs the values on the host before enqueue so this wait cannot be avoided, but it only waits for the
+    // caller's stream and copies straight into pinned memory without intermediate tensors
+    staged.copy_(input.reshape({-1}), /*non_blocking=*/true);
+    c10::cuda::getCurrentCUDAStream(input.device().index()).synchronize();
+  } else {
+    // Gathers non contiguous inputs while copying, so no intermediate tensor is allocated
+    staged.copy_(input.reshape({-1}));
+  }
+  return staged.data_ptr();
+}
+
 std::vector<at::Tensor> execute_engine(std::vector<at::Tensor> inputs, c10::intrusive_ptr<TRTEngine> compiled_engine) {
+  // No-op unless the engine was loaded lazily and nothing has deserialized it yet
+  compiled_engine->ensure_loaded();
+
+  if (SHAPE_RECORDING_MODE) {
+    ShapeHistogram::InputShapes shapes;
+    shapes.reserve(inputs.size());
+    for (auto& in : inputs) {
+      shapes.push_back(in.sizes().vec());
+    }
+    compiled_engine->shape_histogram.record(shapes);
+  }
   LOG_DEBUG(
       "Attempting to run engine (ID: " << compiled_engine->name
                                        << "); Hardware Compatible: " << compiled_engine->hardware_compatible);
@@ -121,9 +158,6 @@ std::vector<at::Tensor> execute_engine(std::vector<at::Tensor> inputs, c10::intr
     compiled_engine->cudagraph.reset();
   }
 
-  // this is a buffer to store shape tensor input addresses throughout the runtime scope
-  std::list<std::vector<int64_t>> inputShapeTensorValues;
-
   // Intialize inputs and outputs to be available throughout the succeeding scopes
   std::list<at::Tensor> formatted_inputs(compiled_engine->num_io.first);
   std::vector<at::Tensor> outputs(compiled_engine->num_io.second);
@@ -135,11 +169,13 @@ std::vector<at::Tensor> execute_engine(std::vector<at::Tensor> inputs, c10::intr
           std::make_unique<torch::autograd::profiler::RecordProfile>(compiled_engine->device_profile_path);
     }
 
-    RTDevice curr_device = get_current_device();
-    LOG_DEBUG("Current Device: " << curr_device);
+    const RTDevice& curr_device = get_current_device();
+    // Checked up front since the message would be formatted on every call otherwise
+    if (util::logging::get_logger().get_reportable_log_level() >= util::logging::LogLevel::kDEBUG) {
+      LOG_DEBUG("Current Device: " << curr_device);
+    }
 
-    // Generic Target Device Prefix
-    std::string target_device = "cuda:";
+    torch::Device target_device(torch::kCUDA, static_cast<c10::DeviceIndex>(curr_device.id));
 
     if (is_switch_required(curr_device, compiled_engine->device_info)) {
       // Scan through available CUDA devices and set the CUDA device context correctly
@@ -148,34 +184,38 @@ std::vector<at::Tensor> execute_engine(std::vector<at::Tensor> inputs, c10::intr
       set_rt_device(device);
 
       // Target device is new device
-      target_device += std::to_string(device.id);
+      target_device = torch::Device(torch::kCUDA, static_cast<c10::DeviceIndex>(device.id));
 
-      for (auto& in : inputs) {
-        in = in.to(torch::Device(target_device));
+      for (size_t i = 0; i < inputs.size(); i++) {
+        if (!(compiled_engine->in_binding_is_shape_tensor[i] && !inputs[i].is_cuda())) {
+          inputs[i] = inputs[i].to(target_device);
+        }
       }
-    } else {
-      // Target device is current device
-      target_device += std::to_string(curr_device.id);
     }
 
     // For each input, ensure its current device is the desired target device
     for (size_t i = 0; i < inputs.size(); i++) {
       at::Tensor* in = &inputs[i];
-      std::string current_tensor_device = in->device().str();
 
-      // If current device string does not match target device, display warning and move tensor accordingly
-      if (current_tensor_device != target_device) {
+      // If the input is not on the target device, display warning and move tensor accordingly. Shape tensors are
+      // read on the host, so they may stay there.
+      bool host_shape_tensor = compiled_engine->in_binding_is_shape_tensor[i] && !in->is_cuda();
+      if (!host_shape_tensor && in->device() != target_device) {
         LOG_WARNING(
-            "Input " << i << " of engine " << compiled_engine->name << " was found to be on " << current_tensor_device
+            "Input " << i << " of engine " << compiled_engine->name << " was found to be on " << in->device()
                      << " but should be on " << target_device << ". This tensor is being moved by the runtime but "
                      << "for performance considerations, ensure your inputs are all on GPU "
                      << "and open an issue here (https://github.com/pytorch/TensorRT/issues) if this "
                      << "warning persists.");
-        *in = in->to(torch::Device(target_device));
+        *in = in->to(target_device);
       }
     }
   }
 
+  // nvinfer1::IExecutionContext is not thread safe and we need a mutex for it. Held from input setup on since binding
+  // shapes and addresses, and the staged shape tensor values, are per engine state.
+  std::unique_lock<std::mutex> lock(compiled_engine->mu);
+
   { // Input Setup
     std::unique_ptr<torch::autograd::profiler::RecordProfile> input_profiler_guard;
     if (compiled_engine->profile_execution) {
@@ -185,9 +225,11 @@ std::vector<at::Tensor> execute_engine(std::vector<at::Tensor> inputs, c10::intr
 
     for (size_t i = 0; i < inputs.size(); i++) {
       std::string name = compiled_engine->in_binding_names[i];
+      bool is_shape_tensor = compiled_engine->in_binding_is_shape_tensor[i];
 
       TORCHTRT_CHECK(
-          inputs[i].is_cuda(), "Expected input tensors to have device cuda, found device " << inputs[i].device());
+          is_shape_tensor || inputs[i].is_cuda(),
+          "Expected input tensors to have device cuda, found device " << inputs[i].device());
 
       auto expected_type =
           util::TRTDataTypeToScalarType(compiled_engine->exec_ctx->getEngine().getTensorDataType(name.c_str()));
@@ -199,24 +241,18 @@ std::vector<at::Tensor> execute_engine(std::vector<at::Tensor> inputs, c10::intr
       auto shape = core::util::toVec(dims);
       LOG_DEBUG("Input Name: " << name << " Shape: " << dims);
 
-      if (compiled_engine->cuda_engine->isShapeInferenceIO(name.c_str())) {
-        // Shape tensor inputs are casted to int64 explicitly.
+      if (is_shape_tensor) {
+        // Shape tensor values are read from host memory in the dtype of the binding.
         // Refer to
         // https://github.com/NVIDIA/TensorRT/blob/d2f4ef789a9a6ffdf37b55c3f81b486225f6b380/samples/common/sampleInference.cpp#L435
-        auto input_cpu = inputs[i].clone().contiguous().cpu().to(torch::kInt64);
-        std::vector<int64_t> inputs_cpu_vec(
-            input_cpu.data_ptr<int64_t>(), input_cpu.data_ptr<int64_t>() + input_cpu.numel());
-        inputShapeTensorValues.emplace_back(inputs_cpu_vec);
-        TORCHTRT_CHECK(
-            compiled_engine->exec_ctx->setTensorAddress(name.c_str(), inputShapeTensorValues.back().data()),
-            "Error while setting the tensor address for shape inputs");
+        auto shape_values = stage_shape_tensor_input(*compiled_engine, i, inputs[i]);
 
         if (CUDAGRAPHS_MODE) {
           // @peri044 I dont know if this makes sense since they are supposed to be GPU buffers
-          compiled_engine->input_buffers[i] = input_cpu;
+          compiled_engine->input_buffers[i] = compiled_engine->shape_tensor_buffers[i];
         }
         TORCHTRT_CHECK(
-            compiled_engine->exec_ctx->setTensorAddress(name.c_str(), inputShapeTensorValues.back().data()),
+            compiled_engine->exec_ctx->setTensorAddress(name.c_str(), shape_values),
             "Error while setting the tensor address for shape inputs");
 
       } else {
@@ -309,9 +345,6 @@ std::vector<at::Tensor> execute_engine(std::vector<at::Tensor> inputs, c10::intr
     compiled_engine->engine_stream = compiled_engine->caller_stream;
   }
 
-  // nvinfer1::IExecutionContext::enqueue is not thread safe and we need a mutex for it.
-  std::unique_lock<std::mutex> lock(compiled_engine->mu);
-
   { // Engine Execution (execute on engine stream)
     c10::cuda::CUDAStreamGuard stream_guard(compiled_engine->engine_stream);
 
@@ -326,6 +359,27 @@ std::vector<at::Tensor> execute_engine(std::vector<at::Tensor> inputs, c10::intr
     caller_exec_complete.record(compiled_engine->caller_stream);
     caller_exec_complete.block(compiled_engine->engine_stream);
 
+    // Held until the enqueue below is done, the next engine to use the buffer waits for this one on the GPU
+    c10::optional<SharedDeviceMemory::Lease> device_memory_lease;
+    if (compiled_engine->shared_device_memory) {
+      if (CUDAGRAPHS_MODE) {
+        if (!compiled_engine->cudagraph_device_memory.defined()) {
+          compiled_engine->cudagraph_device_memory = at::empty(
+              {compiled_engine->device_memory_size},
+              at::TensorOptions().dtype(at::kByte).device(at::kCUDA, current_device_id));
+        }
+        compiled_engine->exec_ctx->setDeviceMemoryV2(
+            compiled_engine->cudagraph_device_memory.data_ptr(), compiled_engine->device_memory_size);
+      } else {
+        device_memory_lease.emplace(SharedDeviceMemory::global().acquire(
+            current_device_id,
+            compiled_engine->caller_stream,
+            compiled_engine->engine_stream,
+            compiled_engine->device_memory_size));
+        compiled_engine->exec_ctx->setDeviceMemoryV2(device_memory_lease->data(), device_memory_lease->size());
+      }
+    }
+
     if (!CUDAGRAPHS_MODE) {
       // Direct execution uses the caller buffers directly
       compiled_engine->exec_ctx->enqueueV3(compiled_engine->engine_stream);
@@ -86,8 +86,13 @@ static auto TORCHTRT_UNUSED TRTEngineTSRegistrtion =
         .def("dump_engine_layer_info_to_file", &TRTEngine::dump_engine_layer_info_to_file)
         .def("dump_engine_layer_info", &TRTEngine::dump_engine_layer_info)
         .def("get_engine_layer_info", &TRTEngine::get_engine_layer_info)
+        .def("dump_shape_histogram_to_file", &TRTEngine::dump_shape_histogram_to_file)
+        .def("dump_shape_histogram", &TRTEngine::dump_shape_histogram)
+        .def("reset_shape_histogram", &TRTEngine::reset_shape_histogram)
+        .def("is_loaded", &TRTEngine::is_loaded)
         .def_pickle(
             [](const c10::intrusive_ptr<TRTEngine>& self) -> std::vector<std::string> {
+              self->ensure_loaded();
               // Serialize TensorRT engine
               auto serialized_trt_engine = make_trt(self->cuda_engine->serialize());
 
@@ -114,7 +119,20 @@ static auto TORCHTRT_UNUSED TRTEngineTSRegistrtion =
             [](std::vector<std::string> serialized_info) -> c10::intrusive_ptr<TRTEngine> {
               serialized_info[ENGINE_IDX] = base64_decode(serialized_info[ENGINE_IDX]);
               TRTEngine::verify_serialization_fmt(serialized_info);
-              return c10::make_intrusive<TRTEngine>(serialized_info);
+              auto mode = get_engine_load_mode();
+              auto engine = c10::make_intrusive<TRTEngine>(serialized_info, mode != EngineLoadMode::kEAGER);
+              if (mode == EngineLoadMode::kBACKGROUND) {
+                // Queued in load order, which is roughly execution order. Holding a weak reference lets modules
+                // dropped before their engines are reached skip the work.
+                c10::weak_intrusive_ptr<TRTEngine> weak_engine(engine);
+                EngineLoadPool::global().submit([weak_engine]() {
+                  auto engine = weak_engine.lock();
+                  if (engine) {
+                    engine->ensure_loaded(/*from_background=*/true);
+                  }
+                });
+              }
+              return engine;
             });
 
 TORCH_LIBRARY(tensorrt, m) {
@@ -126,7 +144,40 @@ TORCH_LIBRARY(tensorrt, m) {
   m.def("set_multi_device_safe_mode", [](bool multi_device_safe_mode) -> void {
     MULTI_DEVICE_SAFE_MODE = multi_device_safe_mode;
   });
+  m.def("get_engine_load_mode", []() -> int64_t { return static_cast<int64_t>(get_engine_load_mode()); });
+  m.def("set_engine_load_mode", [](int64_t mode) -> void {
+    TORCHTRT_CHECK(
+        mode >= static_cast<int64_t>(EngineLoadMode::kEAGER) &&
+            mode <= static_cast<int64_t>(EngineLoadMode::kBACKGROUND),
+        "Unknown engine load mode " << mode);
+    set_engine_load_mode(static_cast<EngineLoadMode>(mode));
+  });
+  m.def("set_engine_load_threads", [](int64_t num_threads) -> void { set_engine_load_threads(num_threads); });
+  m.def("wait_for_engine_loads", []() -> void { EngineLoadPool::global().wait_idle(); });
+  m.def("get_engine_load_metrics", []() -> c10::Dict<std::string, double> {
+    auto metrics = get_engine_load_metrics();
+    c10::Dict<std::string, double> d;
+    d.insert("deferred", static_cast<double>(metrics.deferred));
+    d.insert("loaded", static_cast<double>(metrics.loaded));
+    d.insert("failed", static_cast<double>(metrics.failed));
+    d.insert("loaded_in_background", static_cast<double>(metrics.loaded_in_background));
+    d.insert("load_ms_total", metrics.load_ms_total);
+    d.insert("load_ms_max", metrics.load_ms_max);
+    d.insert("wait_ms_total", metrics.wait_ms_total);
+    return d;
+  });
+  m.def("reset_engine_load_metrics", []() -> void { reset_engine_load_metrics(); });
   m.def("get_cudagraphs_mode", []() -> bool { return CUDAGRAPHS_MODE; });
+  m.def("get_shared_device_memory_mode", []() -> bool { return SHARED_DEVICE_MEMORY_MODE; });
+  m.def("set_shared_device_memory_mode", [](bool shared_device_memory_mode) -> void {
+    SHARED_DEVICE_MEMORY_MODE = shared_device_memory_mode;
+  });
+  m.def("get_shared_device_memory_bytes", []() -> int64_t { return SharedDeviceMemory::global().allocated_bytes(); });
+  m.def("release_shared_device_memory", []() -> void { SharedDeviceMemory::global().release(); });
+  m.def("get_shape_recording_mode", []() -> bool { return SHAPE_RECORDING_MODE; });
+  m.def("set_shape_recording_mode", [](bool shape_recording_mode) -> void {
+    SHAPE_RECORDING_MODE = shape_recording_mode;
+  });
   m.def("set_cudagraphs_mode", [](bool cudagraphs_mode) -> void { CUDAGRAPHS_MODE = cudagraphs_mode; });
   m.def("set_logging_level", [](int64_t level) -> void {
     util::logging::get_logger().set_reportable_log_level(util::logging::LogLevel(level));
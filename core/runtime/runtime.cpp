@@ -1,4 +1,5 @@
-#include "cuda_runtime.h"
+#include <atomic>
+#include <vector>
 
 #include "core/runtime/runtime.h"
 #include "core/util/prelude.h"
@@ -9,6 +10,8 @@ namespace runtime {
 
 bool MULTI_DEVICE_SAFE_MODE = false;
 bool CUDAGRAPHS_MODE = false;
+bool SHARED_DEVICE_MEMORY_MODE = false;
+bool SHAPE_RECORDING_MODE = false;
 
 c10::optional<RTDevice> get_most_compatible_device(
     const RTDevice& target_device,
@@ -16,12 +19,7 @@ c10::optional<RTDevice> get_most_compatible_device(
     bool hardware_compatible) {
   LOG_DEBUG("Target Device: " << target_device);
   auto device_options = find_compatible_devices(target_device, hardware_compatible);
-  RTDevice current_device;
-  if (current_device.id == -1) {
-    current_device = get_current_device();
-  } else {
-    current_device = curr_device;
-  }
+  const RTDevice& current_device = curr_device.id == -1 ? get_current_device() : curr_device;
 
   if (device_options.size() == 0) {
     return {};
@@ -66,23 +64,22 @@ c10::optional<RTDevice> get_most_compatible_device(
 }
 
 std::vector<RTDevice> find_compatible_devices(const RTDevice& target_device, bool hardware_compatible) {
-  auto dla_supported = get_dla_supported_SMs();
-  auto device_list = get_available_device_list().get_devices();
+  auto& dla_supported = get_dla_supported_SMs();
+  auto& device_list = get_available_device_list().get_devices();
 
   std::vector<RTDevice> compatible_devices;
 
-  for (auto device : device_list) {
-    auto poss_dev_cc = device.second.getSMCapability();
+  for (auto& device : device_list) {
     if (target_device.device_type == nvinfer1::DeviceType::kDLA) {
-      if (dla_supported.find(poss_dev_cc) != dla_supported.end() &&
-          dla_supported[poss_dev_cc] == target_device.device_name) {
+      auto dla_platform = dla_supported.find(device.second.getSMCapability());
+      if (dla_platform != dla_supported.end() && dla_platform->second == target_device.device_name) {
         compatible_devices.push_back(device.second);
       }
     } else if (target_device.device_type == nvinfer1::DeviceType::kGPU) {
-      auto target_dev_cc = target_device.getSMCapability();
       // If the SM Capabilities match, should be good enough to run
       // If hardware compatibility mode is enabled and the SM is at least 80, device is valid
-      if ((poss_dev_cc == target_dev_cc) || (hardware_compatible && std::stoi(poss_dev_cc) >= 8)) {
+      bool same_sm = device.second.major == target_device.major && device.second.minor == target_device.minor;
+      if (same_sm || (hardware_compatible && device.second.major >= 8)) {
         compatible_devices.push_back(device.second);
       }
     } else {
@@ -96,19 +93,27 @@ std::vector<RTDevice> find_compatible_devices(const RTDevice& target_device, boo
 
 void set_rt_device(RTDevice& cuda_device) {
   TORCHTRT_CHECK(
-      (cudaSetDevice(cuda_device.id) == cudaSuccess), "Unable to set device: " << cuda_device << "as active device");
+      get_device_query().set_device(cuda_device.id), "Unable to set device: " << cuda_device << "as active device");
   LOG_DEBUG("Setting " << cuda_device << " as active device");
 }
 
-RTDevice get_current_device() {
-  int device = -1;
-  TORCHTRT_CHECK(
-      (cudaGetDevice(reinterpret_cast<int*>(&device)) == cudaSuccess),
-      "Unable to get current device (runtime.get_current_device)");
+const RTDevice& get_current_device() {
+  // The current device itself cannot be cached since anything (e.g. torch.cuda.set_device) may change it, but
+  // resolving it against the snapshot can
+  thread_local uint64_t cached_generation = 0;
+  thread_local const RTDevice* cached_device = nullptr;
 
-  int64_t device_id = static_cast<int64_t>(device);
+  auto device_id = get_device_query().current_device();
+  auto generation = get_device_snapshot_generation();
+  if (cached_device && cached_device->id == device_id && cached_generation == generation) {
+    return *cached_device;
+  }
 
-  return RTDevice(device_id, nvinfer1::DeviceType::kGPU);
+  auto device = get_available_device_list().lookup(device_id);
+  TORCHTRT_CHECK(device, "Current device " << device_id << " is not a known CUDA device (runtime.get_current_device)");
+  cached_device = device;
+  cached_generation = generation;
+  return *device;
 }
 
 void multi_gpu_device_check() {
@@ -138,12 +143,47 @@ void set_cudagraphs_mode(bool cudagraphs_mode) {
   CUDAGRAPHS_MODE = cudagraphs_mode;
 }
 
+bool get_shared_device_memory_mode() {
+  return SHARED_DEVICE_MEMORY_MODE;
+}
+
+void set_shared_device_memory_mode(bool shared_device_memory_mode) {
+  SHARED_DEVICE_MEMORY_MODE = shared_device_memory_mode;
+}
+
+bool get_shape_recording_mode() {
+  return SHAPE_RECORDING_MODE;
+}
+
+void set_shape_recording_mode(bool shape_recording_mode) {
+  SHAPE_RECORDING_MODE = shape_recording_mode;
+}
+
 namespace {
-static DeviceList cuda_device_list;
+std::mutex device_list_mu;
+std::shared_ptr<const DeviceList> device_list_snapshot;
+// Replaced snapshots are kept alive since references into them may still be held
+std::vector<std::shared_ptr<const DeviceList>> retired_device_lists;
+} // namespace
+
+const DeviceList& get_available_device_list() {
+  auto snapshot = std::atomic_load(&device_list_snapshot);
+  if (snapshot) {
+    return *snapshot;
+  }
+  std::lock_guard<std::mutex> lock(device_list_mu);
+  if (!device_list_snapshot) {
+    std::atomic_store(&device_list_snapshot, std::shared_ptr<const DeviceList>(std::make_shared<DeviceList>()));
+  }
+  return *device_list_snapshot;
 }
 
-DeviceList get_available_device_list() {
-  return cuda_device_list;
+void reset_available_device_list() {
+  std::lock_guard<std::mutex> lock(device_list_mu);
+  if (device_list_snapshot) {
+    retired_device_lists.push_back(device_list_snapshot);
+  }
+  std::atomic_store(&device_list_snapshot, std::shared_ptr<const DeviceList>());
 }
 
 // SM Compute capability <Compute Capability, Device Name> map
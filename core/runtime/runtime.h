@@ -5,8 +5,11 @@
 #include <utility>
 #include "ATen/core/function_schema.h"
 #include "NvInfer.h"
+#include "core/runtime/EngineLoader.h"
 #include "core/runtime/Platform.h"
 #include "core/runtime/RTDevice.h"
+#include "core/runtime/ShapeHistogram.h"
+#include "core/runtime/SharedDeviceMemory.h"
 #include "core/runtime/TRTEngine.h"
 #include "core/util/prelude.h"
 #include "torch/custom_class.h"
@@ -19,6 +22,8 @@ using EngineID = int64_t;
 const std::string ABI_VERSION = "6";
 extern bool MULTI_DEVICE_SAFE_MODE;
 extern bool CUDAGRAPHS_MODE;
+extern bool SHARED_DEVICE_MEMORY_MODE;
+extern bool SHAPE_RECORDING_MODE;
 
 typedef enum {
   ABI_TARGET_IDX = 0,
@@ -51,27 +56,43 @@ bool get_cudagraphs_mode();
 
 void set_cudagraphs_mode(bool cudagraphs_mode);
 
+bool get_shared_device_memory_mode();
+
+// Only affects engines created afterwards
+void set_shared_device_memory_mode(bool shared_device_memory_mode);
+
+bool get_shape_recording_mode();
+
+// While enabled every engine counts the input shapes it is called with in TRTEngine::shape_histogram
+void set_shape_recording_mode(bool shape_recording_mode);
+
 class DeviceList {
   using DeviceMap = std::unordered_map<int, RTDevice>;
   DeviceMap device_list;
 
  public:
-  // Scans and updates the list of available CUDA devices
+  // Scans the available CUDA devices through the active DeviceQuery
   DeviceList();
 
  public:
   void insert(int device_id, RTDevice cuda_device);
   RTDevice find(int device_id);
-  DeviceMap get_devices();
-  std::string dump_list();
+  // nullptr if there is no such device
+  const RTDevice* lookup(int64_t device_id) const;
+  const DeviceMap& get_devices() const;
+  std::string dump_list() const;
 };
 
-DeviceList get_available_device_list();
+// Snapshot of the devices on the system, taken on first use and never modified afterwards
+const DeviceList& get_available_device_list();
+// Drops the snapshot so the next call to get_available_device_list takes a new one, see set_device_query
+void reset_available_device_list();
 const std::unordered_map<std::string, std::string>& get_dla_supported_SMs();
 
 void set_rt_device(RTDevice& cuda_device);
-// Gets the current active GPU (DLA will not show up through this)
-RTDevice get_current_device();
+// Gets the current active GPU (DLA will not show up through this). The device comes from the snapshot and the
+// lookup is cached per thread, so this costs one cudaGetDevice.
+const RTDevice& get_current_device();
 
 } // namespace runtime
 } // namespace core
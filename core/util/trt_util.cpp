@@ -296,7 +296,8 @@ const std::unordered_map<at::ScalarType, nvinfer1::DataType>& get_at_trt_type_ma
       {at::kChar, nvinfer1::DataType::kINT8},
       {at::kByte, nvinfer1::DataType::kINT8},
       {at::kBool, nvinfer1::DataType::kBOOL},
-      {at::kBFloat16, nvinfer1::DataType::kBF16}};
+      {at::kBFloat16, nvinfer1::DataType::kBF16},
+      {at::kFloat8_e4m3fn, nvinfer1::DataType::kFP8}};
   return at_trt_type_map;
 }
 
@@ -308,7 +309,8 @@ const std::unordered_map<nvinfer1::DataType, at::ScalarType>& get_trt_at_type_ma
       {nvinfer1::DataType::kINT64, at::kLong},
       {nvinfer1::DataType::kINT8, at::kChar},
       {nvinfer1::DataType::kBOOL, at::kBool},
-      {nvinfer1::DataType::kBF16, at::kBFloat16}};
+      {nvinfer1::DataType::kBF16, at::kBFloat16},
+      {nvinfer1::DataType::kFP8, at::kFloat8_e4m3fn}};
   return trt_at_type_map;
 }
 } // namespace
@@ -1,20 +1,52 @@
 #include "fileio.h"
 
+#include <algorithm>
+#include <fstream>
+
 namespace torchtrtc {
 namespace fileio {
 
 std::string read_buf(std::string const& path) {
   std::string buf;
+  // Opened without std::ios::ate, which closes the stream if the seek to the end fails
   std::ifstream stream(path.c_str(), std::ios::binary);
+  if (!stream) {
+    return buf;
+  }
 
-  if (stream) {
-    stream >> std::noskipws;
-    std::copy(std::istream_iterator<char>(stream), std::istream_iterator<char>(), std::back_inserter(buf));
+  stream.seekg(0, std::ios::end);
+  auto size = stream.tellg();
+  if (!stream || size <= 0) {
+    // Not seekable (e.g. a pipe) or no size reported (e.g. /proc files), fall back to draining the stream
+    stream.clear();
+    std::ostringstream ss;
+    ss << stream.rdbuf();
+    return ss.str();
   }
 
+  buf.resize(static_cast<size_t>(size));
+  stream.seekg(0);
+  stream.read(&buf[0], size);
+  buf.resize(static_cast<size_t>(stream.gcount()));
   return buf;
 }
 
+bool write_buf(std::string const& path, std::string const& buf) {
+  std::ofstream stream(path.c_str(), std::ios::binary | std::ios::trunc);
+  // Large chunks go straight to the file without being copied through the stream buffer, bounding each write keeps
+  // the size of a single syscall reasonable for multi GB engines
+  constexpr size_t kChunkSize = 16 << 20;
+  for (size_t offset = 0; stream && offset < buf.size(); offset += kChunkSize) {
+    stream.write(buf.data() + offset, std::min(kChunkSize, buf.size() - offset));
+  }
+  stream.close();
+  if (!stream) {
+    torchtrt::logging::log(torchtrt::logging::Level::kERROR, std::string("Unable to write file ") + path);
+    return false;
+  }
+  return true;
+}
+
 std::string get_cwd() {
   char buff[FILENAME_MAX]; // create string buffer to hold path
   if (getcwd(buff, FILENAME_MAX)) {
@@ -29,7 +29,11 @@
 namespace torchtrtc {
 namespace fileio {
 
+// Contents of the file at path with a single sized read (streamed for pipes and other unseekable files), empty if it
+// cannot be opened
 std::string read_buf(std::string const& path);
+// Writes buf to path in large chunks, false (after logging the error) on failure
+bool write_buf(std::string const& path, std::string const& buf);
 std::string get_cwd();
 std::string real_path(std::string path);
 std::string resolve_path(std::string path);
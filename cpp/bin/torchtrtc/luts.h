@@ -12,6 +12,8 @@ inline at::ScalarType to_torch_dtype(torchtrt::DataType dtype) {
   switch (dtype) {
     case torchtrt::DataType::kHalf:
       return at::kHalf;
+    case torchtrt::DataType::kBFloat16:
+      return at::kBFloat16;
     case torchtrt::DataType::kChar:
       return at::kChar;
     case torchtrt::DataType::kInt:
@@ -28,6 +30,7 @@ const std::unordered_map<nvinfer1::DataType, at::ScalarType>& get_trt_at_type_ma
   static const std::unordered_map<nvinfer1::DataType, at::ScalarType> trt_at_type_map = {
       {nvinfer1::DataType::kFLOAT, at::kFloat},
       {nvinfer1::DataType::kHALF, at::kHalf},
+      {nvinfer1::DataType::kBF16, at::kBFloat16},
       {nvinfer1::DataType::kINT32, at::kInt},
       {nvinfer1::DataType::kINT8, at::kChar},
       {nvinfer1::DataType::kBOOL, at::kBool},
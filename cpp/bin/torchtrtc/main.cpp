@@ -1,6 +1,12 @@
 #include <stdlib.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
 #include <sstream>
+#include <thread>
 
 #include "NvInfer.h"
 #include "third_party/args/args.hpp"
@@ -10,9 +16,12 @@
 #include "torch_tensorrt/ptq.h"
 #include "torch_tensorrt/torch_tensorrt.h"
 
+#include "core/runtime/ShapeHistogram.h"
+
 #include "accuracy.h"
 #include "fileio.h"
 #include "luts.h"
+#include "manifest.h"
 #include "parser_util.h"
 
 #if defined(_WIN32)
@@ -42,6 +51,107 @@ bool unload_library(void* custom_lib) {
   return success;
 }
 
+torchtrtc::manifest::ModelStatus compile_model(const torchtrtc::manifest::ModelSpec& model) {
+  torchtrtc::manifest::ModelStatus status;
+  status.name = model.name;
+  status.input_path = model.input_path;
+  status.output_path = model.output_path;
+  auto start = std::chrono::steady_clock::now();
+  try {
+    auto compile_settings = torchtrtc::manifest::to_compile_spec(model);
+    auto calibrator = torchtrt::ptq::make_int8_cache_calibrator(model.calibration_cache_file);
+    if (!model.calibration_cache_file.empty() &&
+        compile_settings.enabled_precisions.find(torchtrt::DataType::kChar) !=
+            compile_settings.enabled_precisions.end()) {
+      compile_settings.ptq_calibrator = calibrator;
+    }
+    // The current device is per thread, so each worker selects the device of the model it compiles
+    torchtrt::set_device(compile_settings.device.gpu_id);
+
+    auto mod = torch::jit::load(model.input_path);
+    if (model.require_full_compilation && !torchtrt::ts::check_method_operator_support(mod, "forward")) {
+      throw std::runtime_error("Module is not currently supported by Torch-TensorRT");
+    }
+
+    if (model.save_engine) {
+      auto engine = torchtrt::ts::convert_method_to_trt_engine(mod, "forward", compile_settings);
+      if (!torchtrtc::fileio::write_buf(model.output_path, engine)) {
+        throw std::runtime_error("Unable to write engine to " + model.output_path);
+      }
+    } else {
+      auto trt_mod = torchtrt::ts::compile(mod, compile_settings);
+      trt_mod.save(model.output_path);
+    }
+    status.succeeded = true;
+  } catch (const std::exception& e) {
+    status.error = e.what();
+  }
+  status.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  return status;
+}
+
+// Compiles every model of a manifest in this process with up to num_jobs models in flight, so process start up,
+// CUDA / TensorRT initialization and custom library loading are paid once for the whole batch
+int compile_manifest(const std::string& manifest_path, uint64_t num_jobs, const std::string& summary_path) {
+  std::vector<torchtrtc::manifest::ModelSpec> models;
+  try {
+    auto contents = torchtrtc::fileio::read_buf(manifest_path);
+    if (contents.empty()) {
+      throw std::runtime_error("Could not read manifest " + manifest_path);
+    }
+    models = torchtrtc::manifest::parse_manifest(contents, manifest_path.substr(0, manifest_path.find_last_of('/')));
+    // Settings are checked for every model before the first compilation starts
+    for (auto& model : models) {
+      torchtrtc::manifest::to_compile_spec(model);
+    }
+    torchtrtc::manifest::check_concurrent_compilation(models, num_jobs);
+  } catch (const std::exception& e) {
+    torchtrt::logging::log(torchtrt::logging::Level::kERROR, e.what());
+    return 1;
+  }
+
+  std::vector<torchtrtc::manifest::ModelStatus> statuses(models.size());
+  std::atomic<size_t> next_model{0};
+  std::atomic<size_t> finished{0};
+  auto worker = [&]() {
+    for (size_t i = next_model++; i < models.size(); i = next_model++) {
+      statuses[i] = compile_model(models[i]);
+      std::stringstream ss;
+      ss << "[" << ++finished << "/" << models.size() << "] " << models[i].name << ": "
+         << (statuses[i].succeeded ? "compiled" : "failed, " + statuses[i].error);
+      torchtrt::logging::log(
+          statuses[i].succeeded ? torchtrt::logging::Level::kINFO : torchtrt::logging::Level::kERROR, ss.str());
+    }
+  };
+
+  auto num_workers = std::max<uint64_t>(1, std::min<uint64_t>(num_jobs, models.size()));
+  std::vector<std::thread> workers;
+  for (uint64_t w = 0; w < num_workers; w++) {
+    workers.emplace_back(worker);
+  }
+  for (auto& w : workers) {
+    w.join();
+  }
+
+  size_t failed = 0;
+  for (auto& s : statuses) {
+    failed += s.succeeded ? 0 : 1;
+    std::cout << (s.succeeded ? "ok     " : "FAILED ") << std::fixed << std::setprecision(1) << std::setw(8)
+              << s.seconds << "s  " << s.name << std::endl;
+  }
+  std::cout << statuses.size() - failed << " of " << statuses.size() << " models compiled" << std::endl;
+
+  if (!summary_path.empty()) {
+    std::ofstream out(summary_path);
+    out << torchtrtc::manifest::summary_to_json(statuses);
+    if (!out) {
+      torchtrt::logging::log(torchtrt::logging::Level::kERROR, "Could not write summary to " + summary_path);
+      return 1;
+    }
+  }
+  return failed ? 1 : 0;
+}
+
 int main(int argc, char** argv) {
   torchtrt::logging::set_is_colored_output_on(true);
   torchtrt::logging::set_reportable_log_level(torchtrt::logging::Level::kWARNING);
@@ -92,7 +202,7 @@ int main(int argc, char** argv) {
   args::ValueFlagList<std::string> enabled_precisions(
       parser,
       "precision",
-      "(Repeatable) Enabling an operating precision for kernels to use when building the engine (Int8 requires a calibration-cache argument) [ float | float32 | f32 | fp32 | half | float16 | f16 | fp16 | int8 | i8 | char ] (default: float)",
+      "(Repeatable) Enabling an operating precision for kernels to use when building the engine (Int8 requires a calibration-cache argument) [ float | float32 | f32 | fp32 | half | float16 | f16 | fp16 | bfloat16 | bf16 | float8 | fp8 | f8 | int8 | i8 | char ] (default: float)",
       {'p', "enable-precision"});
   args::ValueFlag<std::string> device_type(
       parser,
@@ -116,6 +226,12 @@ int main(int argc, char** argv) {
       "Path to calibration cache file to use for post training quantization",
       {"calibration-cache-file"});
 
+  args::ValueFlag<std::string> timing_cache_file(
+      parser,
+      "file_path",
+      "Path to a TensorRT timing cache to reuse tactic timings from and update, created if it does not exist",
+      {"timing-cache"});
+
   args::ValueFlagList<std::string> torch_executed_ops(
       parser,
       "op_name",
@@ -134,6 +250,12 @@ int main(int argc, char** argv) {
       "Minimum number of contiguous TensorRT supported ops to compile a subgraph to TensorRT",
       {"mbs", "min-block-size"});
 
+  args::Flag partitioning_cost_model(
+      parser,
+      "partitioning-cost-model",
+      "Move TensorRT subgraphs back to PyTorch when the tensors crossing their boundaries are estimated to cost more than converting them saves (partial compilation must be enabled)",
+      {"partitioning-cost-model"});
+
   args::Flag embed_engine(
       parser,
       "embed-engine",
@@ -191,6 +313,27 @@ int main(int argc, char** argv) {
       "(repeatable) Shared object/DLL containing custom converters",
       {"custom-converters"});
 
+  args::ValueFlag<std::string> recommend_shapes(
+      parser,
+      "histogram_file",
+      "Prints input specs derived from a shape histogram dumped by an engine (see TRTEngine.dump_shape_histogram). If input and output paths are given and no input specs, the program is compiled with the recommendation",
+      {"recommend-shapes"});
+  args::ValueFlag<uint64_t> profile_buckets(
+      parser,
+      "num_buckets",
+      "Number of shape ranges --recommend-shapes splits the recorded calls into, e.g. to compile one program per range (defaults to 1)",
+      {"profile-buckets"});
+
+  args::ValueFlag<std::string> manifest(
+      parser,
+      "file_path",
+      "Compile all models listed in a JSON manifest in this process instead of a single module (see README for the format)",
+      {"manifest"});
+  args::ValueFlag<uint64_t> jobs(
+      parser, "num_jobs", "Number of models of a manifest compiled concurrently (defaults to 1)", {'j', "jobs"});
+  args::ValueFlag<std::string> summary(
+      parser, "file_path", "Write a JSON summary of the status of every model of a manifest to this path", {"summary"});
+
   args::Positional<std::string> input_path(parser, "input_file_path", "Path to input TorchScript file");
   args::Positional<std::string> output_path(
       parser, "output_file_path", "Path for compiled TorchScript (or TensorRT engine) file");
@@ -246,6 +389,104 @@ int main(int argc, char** argv) {
     }
   }
 
+  if (manifest) {
+    if (input_path || recommend_shapes) {
+      torchtrt::logging::log(
+          torchtrt::logging::Level::kERROR,
+          "A manifest lists the modules to compile, it cannot be combined with an input path or --recommend-shapes");
+      return 1;
+    }
+    // Compile settings come from the manifest, flags for a single module would otherwise be silently ignored
+    const std::vector<std::pair<const args::Base*, std::string>> module_flags = {
+        {&build_debuggable_engine, "--build-debuggable-engine"},
+        {&allow_gpu_fallback, "--allow-gpu-fallback"},
+        {&require_full_compilation, "--require-full-compilation"},
+        {&check_method_op_support, "--check-method-support"},
+        {&disable_tf32, "--disable-tf32"},
+        {&sparse_weights, "--sparse-weights"},
+        {&enabled_precisions, "--enable-precision"},
+        {&device_type, "--device-type"},
+        {&gpu_id, "--gpu-id"},
+        {&dla_core, "--dla-core"},
+        {&engine_capability, "--engine-capability"},
+        {&calibration_cache_file, "--calibration-cache-file"},
+        {&timing_cache_file, "--timing-cache"},
+        {&torch_executed_ops, "--torch-executed-op"},
+        {&torch_executed_mods, "--torch-executed-mod"},
+        {&min_block_size, "--min-block-size"},
+        {&partitioning_cost_model, "--partitioning-cost-model"},
+        {&embed_engine, "--embed-engine"},
+        {&num_avg_timing_iters, "--num-avg-timing-iters"},
+        {&workspace_size, "--workspace-size"},
+        {&dla_sram_size, "--dla-sram-size"},
+        {&dla_local_dram_size, "--dla-local-dram-size"},
+        {&dla_global_dram_size, "--dla-global-dram-size"},
+        {&atol, "--atol"},
+        {&rtol, "--rtol"},
+        {&no_threshold_check, "--no-threshold-check"},
+        {&truncate_long_and_double, "--truncate-long-double"},
+        {&allow_shape_tensors, "--allow-shape-tensors"},
+        {&save_engine, "--save-engine"},
+        {&profile_buckets, "--profile-buckets"}};
+    std::string given;
+    for (auto& flag : module_flags) {
+      if (*flag.first) {
+        given += (given.empty() ? "" : ", ") + flag.second;
+      }
+    }
+    if (!given.empty()) {
+      torchtrt::logging::log(
+          torchtrt::logging::Level::kERROR,
+          "Compile settings are given per model in a manifest, " + given +
+              " cannot be combined with --manifest; set them in the \"defaults\" of the manifest instead");
+      return 1;
+    }
+    return compile_manifest(
+        torchtrtc::fileio::resolve_path(args::get(manifest)),
+        jobs ? args::get(jobs) : 1,
+        summary ? torchtrtc::fileio::resolve_path(args::get(summary)) : "");
+  }
+
+  std::vector<std::string> recommended_specs;
+  if (recommend_shapes) {
+    std::vector<torchtrt::core::runtime::ShapeProfile> profiles;
+    std::vector<std::string> dtypes;
+    try {
+      auto histogram = torchtrt::core::runtime::ShapeHistogram::deserialize(
+          torchtrtc::fileio::read_buf(torchtrtc::fileio::resolve_path(args::get(recommend_shapes))));
+      profiles = histogram.recommend_profiles(profile_buckets ? args::get(profile_buckets) : 1);
+      dtypes = histogram.input_dtypes();
+      std::cout << "# " << profiles.size() << " profile(s) from " << histogram.total() << " recorded calls ("
+                << histogram.dropped() << " not tracked)" << std::endl;
+    } catch (const std::exception& e) {
+      torchtrt::logging::log(torchtrt::logging::Level::kERROR, e.what());
+      return 1;
+    }
+
+    for (size_t p = 0; p < profiles.size(); p++) {
+      std::cout << "# profile " << p << ": " << profiles[p].calls << " calls" << std::endl;
+      std::vector<std::string> specs;
+      for (size_t i = 0; i < profiles[p].inputs.size(); i++) {
+        auto& range = profiles[p].inputs[i];
+        specs.push_back(torchtrtc::parserutil::format_input_spec(
+            range.min, range.opt, range.max, i < dtypes.size() ? dtypes[i] : ""));
+        std::cout << (i ? " " : "") << "\"" << specs.back() << "\"";
+      }
+      std::cout << std::endl;
+      recommended_specs = specs;
+    }
+
+    if (!input_path) {
+      return 0;
+    }
+    if (profiles.size() > 1 || input_shapes) {
+      torchtrt::logging::log(
+          torchtrt::logging::Level::kERROR,
+          "Compiling with recommended shapes needs a single profile (--profile-buckets=1) and no input specs");
+      return 1;
+    }
+  }
+
   auto real_input_path = torchtrtc::fileio::resolve_path(args::get(input_path));
 
   if (check_method_op_support) {
@@ -305,8 +546,14 @@ int main(int argc, char** argv) {
   }
 
   std::vector<torchtrt::Input> ranges;
-  for (const auto& spec : args::get(input_shapes)) {
-    ranges.push_back(torchtrtc::parserutil::parse_input(spec));
+  auto specs = recommend_shapes ? recommended_specs : args::get(input_shapes);
+  for (const auto& spec : specs) {
+    try {
+      ranges.push_back(torchtrtc::parserutil::parse_input(spec));
+    } catch (const std::exception& e) {
+      torchtrt::logging::log(torchtrt::logging::Level::kERROR, e.what());
+      exit(1);
+    }
     std::stringstream ss;
     ss << "Parsed Input: " << ranges.back();
     torchtrt::logging::log(torchtrt::logging::Level::kDEBUG, ss.str());
@@ -338,6 +585,7 @@ int main(int argc, char** argv) {
   auto calibrator = torchtrt::ptq::make_int8_cache_calibrator(calibration_cache_file_path);
 
   compile_settings.require_full_compilation = require_full_compilation;
+  compile_settings.use_partitioning_cost_model = partitioning_cost_model;
 
   if (torch_executed_ops || torch_executed_mods) {
     if (require_full_compilation) {
@@ -365,6 +613,10 @@ int main(int argc, char** argv) {
         compile_settings.enabled_precisions.insert(torch::kF32);
       } else if (dtype == torchtrt::DataType::kHalf) {
         compile_settings.enabled_precisions.insert(torch::kF16);
+      } else if (dtype == torchtrt::DataType::kBFloat16) {
+        compile_settings.enabled_precisions.insert(torch::kBFloat16);
+      } else if (dtype == torchtrt::DataType::kFloat8) {
+        compile_settings.enabled_precisions.insert(torch::kFloat8_e4m3fn);
       } else if (dtype == torchtrt::DataType::kChar) {
         compile_settings.enabled_precisions.insert(torch::kI8);
         if (calibration_cache_file) {
@@ -376,7 +628,7 @@ int main(int argc, char** argv) {
         }
       } else {
         std::stringstream ss;
-        ss << "Invalid precision given for enabled kernel precision, options are [ float | float32 | f32 | fp32 | half | float16 | f16 | fp16 | char | int8 | i8 ], found: ";
+        ss << "Invalid precision given for enabled kernel precision, options are [ float | float32 | f32 | fp32 | half | float16 | f16 | fp16 | bfloat16 | bf16 | float8 | fp8 | f8 | char | int8 | i8 ], found: ";
         ss << dtype;
         torchtrt::logging::log(torchtrt::logging::Level::kERROR, ss.str());
         std::cerr << std::endl << parser;
@@ -445,6 +697,10 @@ int main(int argc, char** argv) {
     compile_settings.workspace_size = args::get(workspace_size);
   }
 
+  if (timing_cache_file) {
+    compile_settings.timing_cache_path = torchtrtc::fileio::resolve_path(args::get(timing_cache_file));
+  }
+
   if (truncate_long_and_double) {
     compile_settings.truncate_long_and_double = true;
   }
@@ -471,10 +727,7 @@ int main(int argc, char** argv) {
 
   if (save_engine) {
     auto engine = torchtrt::ts::convert_method_to_trt_engine(mod, "forward", compile_settings);
-    std::ofstream out(real_output_path);
-    out << engine;
-    out.close();
-    return 0;
+    return torchtrtc::fileio::write_buf(real_output_path, engine) ? 0 : 1;
   } else {
     auto trt_mod = torchtrt::ts::compile(mod, compile_settings);
 
@@ -0,0 +1,538 @@
+#include "manifest.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+#include "parser_util.h"
+
+namespace torchtrtc {
+namespace manifest {
+namespace {
+
+struct JsonValue {
+  enum class Type { kNull, kBool, kNumber, kString, kArray, kObject };
+  Type type = Type::kNull;
+  bool boolean = false;
+  double number = 0.0;
+  std::string string;
+  std::vector<JsonValue> array;
+  std::vector<std::pair<std::string, JsonValue>> object;
+};
+
+// Recursive descent parser for the JSON subset manifests use (no \u escapes beyond ASCII)
+class JsonParser {
+ public:
+  explicit JsonParser(const std::string& text) : text_(text) {}
+
+  JsonValue parse() {
+    auto value = parse_value();
+    skip_whitespace();
+    if (pos_ != text_.size()) {
+      fail("unexpected trailing characters");
+    }
+    return value;
+  }
+
+ private:
+  [[noreturn]] void fail(const std::string& msg) {
+    throw std::runtime_error("Invalid manifest JSON at offset " + std::to_string(pos_) + ": " + msg);
+  }
+
+  void skip_whitespace() {
+    while (pos_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[pos_]))) {
+      pos_++;
+    }
+  }
+
+  void expect(char c) {
+    skip_whitespace();
+    if (pos_ >= text_.size() || text_[pos_] != c) {
+      fail(std::string("expected '") + c + "'");
+    }
+    pos_++;
+  }
+
+  bool consume(const std::string& literal) {
+    if (text_.compare(pos_, literal.size(), literal) == 0) {
+      pos_ += literal.size();
+      return true;
+    }
+    return false;
+  }
+
+  bool consume_separator() {
+    skip_whitespace();
+    if (pos_ < text_.size() && text_[pos_] == ',') {
+      pos_++;
+      return true;
+    }
+    return false;
+  }
+
+  JsonValue parse_value() {
+    skip_whitespace();
+    if (pos_ >= text_.size()) {
+      fail("unexpected end of input");
+    }
+    JsonValue value;
+    auto c = text_[pos_];
+    if (c == '{') {
+      value.type = JsonValue::Type::kObject;
+      pos_++;
+      skip_whitespace();
+      if (pos_ < text_.size() && text_[pos_] == '}') {
+        pos_++;
+        return value;
+      }
+      while (true) {
+        skip_whitespace();
+        auto key = parse_string();
+        expect(':');
+        value.object.emplace_back(std::move(key), parse_value());
+        if (!consume_separator()) {
+          break;
+        }
+      }
+      expect('}');
+    } else if (c == '[') {
+      value.type = JsonValue::Type::kArray;
+      pos_++;
+      skip_whitespace();
+      if (pos_ < text_.size() && text_[pos_] == ']') {
+        pos_++;
+        return value;
+      }
+      while (true) {
+        value.array.push_back(parse_value());
+        if (!consume_separator()) {
+          break;
+        }
+      }
+      expect(']');
+    } else if (c == '"') {
+      value.type = JsonValue::Type::kString;
+      value.string = parse_string();
+    } else if (consume("true")) {
+      value.type = JsonValue::Type::kBool;
+      value.boolean = true;
+    } else if (consume("false")) {
+      value.type = JsonValue::Type::kBool;
+    } else if (consume("null")) {
+      value.type = JsonValue::Type::kNull;
+    } else {
+      value.type = JsonValue::Type::kNumber;
+      const char* begin = text_.c_str() + pos_;
+      char* end = nullptr;
+      value.number = std::strtod(begin, &end);
+      if (end == begin) {
+        fail("unexpected character");
+      }
+      pos_ += end - begin;
+    }
+    return value;
+  }
+
+  std::string parse_string() {
+    if (pos_ >= text_.size() || text_[pos_] != '"') {
+      fail("expected a string");
+    }
+    pos_++;
+    std::string out;
+    while (pos_ < text_.size() && text_[pos_] != '"') {
+      auto c = text_[pos_++];
+      if (c != '\\') {
+        out += c;
+        continue;
+      }
+      if (pos_ >= text_.size()) {
+        break;
+      }
+      auto esc = text_[pos_++];
+      switch (esc) {
+        case 'n':
+          out += '\n';
+          break;
+        case 't':
+          out += '\t';
+          break;
+        case 'r':
+          out += '\r';
+          break;
+        case 'b':
+          out += '\b';
+          break;
+        case 'f':
+          out += '\f';
+          break;
+        case 'u': {
+          if (pos_ + 4 > text_.size()) {
+            fail("truncated \\u escape");
+          }
+          auto hex = text_.substr(pos_, 4);
+          if (!std::all_of(hex.begin(), hex.end(), [](unsigned char c) { return std::isxdigit(c); })) {
+            fail("invalid \\u escape");
+          }
+          auto code = std::stoul(hex, nullptr, 16);
+          if (code > 0x7f) {
+            fail("only ASCII \\u escapes are supported");
+          }
+          out += static_cast<char>(code);
+          pos_ += 4;
+          break;
+        }
+        default:
+          out += esc;
+      }
+    }
+    if (pos_ >= text_.size()) {
+      fail("unterminated string");
+    }
+    pos_++;
+    return out;
+  }
+
+  const std::string& text_;
+  size_t pos_ = 0;
+};
+
+[[noreturn]] void invalid(const std::string& where, const std::string& msg) {
+  throw std::runtime_error("Invalid manifest entry " + where + ": " + msg);
+}
+
+const std::string& as_string(const JsonValue& v, const std::string& where) {
+  if (v.type != JsonValue::Type::kString) {
+    invalid(where, "expected a string");
+  }
+  return v.string;
+}
+
+bool as_bool(const JsonValue& v, const std::string& where) {
+  if (v.type != JsonValue::Type::kBool) {
+    invalid(where, "expected true or false");
+  }
+  return v.boolean;
+}
+
+uint64_t as_uint(const JsonValue& v, const std::string& where) {
+  if (v.type != JsonValue::Type::kNumber || v.number < 0 || v.number > 9.0e18 ||
+      v.number != static_cast<double>(static_cast<uint64_t>(v.number))) {
+    invalid(where, "expected a non negative integer");
+  }
+  return static_cast<uint64_t>(v.number);
+}
+
+std::vector<std::string> as_string_list(const JsonValue& v, const std::string& where) {
+  if (v.type != JsonValue::Type::kArray) {
+    invalid(where, "expected a list of strings");
+  }
+  std::vector<std::string> out;
+  for (size_t i = 0; i < v.array.size(); i++) {
+    out.push_back(as_string(v.array[i], where + "[" + std::to_string(i) + "]"));
+  }
+  return out;
+}
+
+std::string resolve(const std::string& path, const std::string& base_dir) {
+  if (path.empty() || path.rfind("/", 0) == 0 || base_dir.empty()) {
+    return path;
+  }
+  return base_dir + '/' + path;
+}
+
+// Applies the settings in obj to model, keys naming a model ("name", "input", ...) only being accepted if per_model
+void apply_settings(
+    ModelSpec& model,
+    const JsonValue& obj,
+    const std::string& where,
+    const std::string& base_dir,
+    bool per_model) {
+  if (obj.type != JsonValue::Type::kObject) {
+    invalid(where, "expected an object");
+  }
+  for (auto& entry : obj.object) {
+    auto& key = entry.first;
+    auto& v = entry.second;
+    auto at = where + "." + key;
+    if (per_model && key == "name") {
+      model.name = as_string(v, at);
+    } else if (per_model && key == "input") {
+      model.input_path = resolve(as_string(v, at), base_dir);
+    } else if (per_model && key == "output") {
+      model.output_path = resolve(as_string(v, at), base_dir);
+    } else if (key == "inputs") {
+      model.input_specs = as_string_list(v, at);
+    } else if (key == "enabled_precisions") {
+      model.enabled_precisions = as_string_list(v, at);
+    } else if (key == "device_type") {
+      model.device_type = as_string(v, at);
+    } else if (key == "gpu_id") {
+      model.gpu_id = as_uint(v, at);
+    } else if (key == "dla_core") {
+      model.dla_core = as_uint(v, at);
+    } else if (key == "allow_gpu_fallback") {
+      model.allow_gpu_fallback = as_bool(v, at);
+    } else if (key == "engine_capability") {
+      model.engine_capability = as_string(v, at);
+    } else if (key == "calibration_cache_file") {
+      model.calibration_cache_file = resolve(as_string(v, at), base_dir);
+    } else if (key == "timing_cache") {
+      model.timing_cache_file = resolve(as_string(v, at), base_dir);
+    } else if (key == "torch_executed_ops") {
+      model.torch_executed_ops = as_string_list(v, at);
+    } else if (key == "torch_executed_mods") {
+      model.torch_executed_mods = as_string_list(v, at);
+    } else if (key == "min_block_size") {
+      model.min_block_size = as_uint(v, at);
+    } else if (key == "num_avg_timing_iters") {
+      model.num_avg_timing_iters = as_uint(v, at);
+    } else if (key == "workspace_size") {
+      model.workspace_size = as_uint(v, at);
+    } else if (key == "require_full_compilation") {
+      model.require_full_compilation = as_bool(v, at);
+    } else if (key == "disable_tf32") {
+      model.disable_tf32 = as_bool(v, at);
+    } else if (key == "sparse_weights") {
+      model.sparse_weights = as_bool(v, at);
+    } else if (key == "truncate_long_double") {
+      model.truncate_long_and_double = as_bool(v, at);
+    } else if (key == "partitioning_cost_model") {
+      model.partitioning_cost_model = as_bool(v, at);
+    } else if (key == "allow_shape_tensors") {
+      model.allow_shape_tensors = as_bool(v, at);
+    } else if (key == "build_debuggable_engine") {
+      model.debug = as_bool(v, at);
+    } else if (key == "save_engine") {
+      model.save_engine = as_bool(v, at);
+    } else {
+      invalid(at, "unknown setting");
+    }
+  }
+}
+
+std::string lower(std::string str) {
+  std::transform(str.begin(), str.end(), str.begin(), [](unsigned char c) { return std::tolower(c); });
+  return str;
+}
+
+std::string escape_json(const std::string& str) {
+  std::stringstream ss;
+  for (auto c : str) {
+    switch (c) {
+      case '"':
+        ss << "\\\"";
+        break;
+      case '\\':
+        ss << "\\\\";
+        break;
+      case '\n':
+        ss << "\\n";
+        break;
+      case '\t':
+        ss << "\\t";
+        break;
+      case '\r':
+        ss << "\\r";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          ss << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec;
+        } else {
+          ss << c;
+        }
+    }
+  }
+  return ss.str();
+}
+
+} // namespace
+
+std::vector<ModelSpec> parse_manifest(const std::string& contents, const std::string& base_dir) {
+  auto root = JsonParser(contents).parse();
+  if (root.type != JsonValue::Type::kObject) {
+    invalid("manifest", "expected an object with a \"models\" list");
+  }
+
+  const JsonValue* defaults = nullptr;
+  const JsonValue* models = nullptr;
+  for (auto& entry : root.object) {
+    if (entry.first == "defaults") {
+      defaults = &entry.second;
+    } else if (entry.first == "models") {
+      models = &entry.second;
+    } else {
+      invalid(entry.first, "unknown section, expected \"defaults\" or \"models\"");
+    }
+  }
+  if (!models || models->type != JsonValue::Type::kArray) {
+    invalid("models", "expected a list of models");
+  }
+
+  ModelSpec base;
+  if (defaults) {
+    apply_settings(base, *defaults, "defaults", base_dir, /*per_model=*/false);
+  }
+
+  std::vector<ModelSpec> specs;
+  for (size_t i = 0; i < models->array.size(); i++) {
+    auto where = "models[" + std::to_string(i) + "]";
+    auto model = base;
+    apply_settings(model, models->array[i], where, base_dir, /*per_model=*/true);
+    if (model.input_path.empty() || model.output_path.empty()) {
+      invalid(where, "\"input\" and \"output\" paths are required");
+    }
+    if (model.input_specs.empty()) {
+      invalid(where, "at least one input spec is required in \"inputs\"");
+    }
+    if (model.name.empty()) {
+      model.name = model.input_path.substr(model.input_path.find_last_of('/') + 1);
+    }
+    specs.push_back(std::move(model));
+  }
+
+  // Models compile concurrently, two of them writing the same file would clobber each other
+  for (size_t i = 0; i < specs.size(); i++) {
+    for (size_t j = i + 1; j < specs.size(); j++) {
+      if (specs[i].output_path == specs[j].output_path) {
+        invalid(
+            "models[" + std::to_string(j) + "]",
+            "output path " + specs[j].output_path + " is also used by models[" + std::to_string(i) + "]");
+      }
+    }
+  }
+  return specs;
+}
+
+void check_concurrent_compilation(const std::vector<ModelSpec>& models, uint64_t num_jobs) {
+  if (num_jobs <= 1) {
+    return;
+  }
+  // TensorRT reads a timing cache when a build starts and rewrites it when the build ends, concurrent builds sharing
+  // one would race on the file
+  for (size_t i = 0; i < models.size(); i++) {
+    for (size_t j = i + 1; j < models.size(); j++) {
+      if (!models[i].timing_cache_file.empty() && models[i].timing_cache_file == models[j].timing_cache_file) {
+        throw std::runtime_error(
+            "Timing cache " + models[j].timing_cache_file + " is shared by " + models[i].name + " and " +
+            models[j].name + ", which cannot be compiled concurrently; use --jobs=1 or give each model its own cache");
+      }
+    }
+  }
+}
+
+torchtrt::ts::CompileSpec to_compile_spec(const ModelSpec& model) {
+  std::vector<torchtrt::Input> ranges;
+  for (auto& spec : model.input_specs) {
+    try {
+      ranges.push_back(parserutil::parse_input(spec));
+    } catch (const std::exception& e) {
+      throw std::runtime_error("Invalid input specification " + spec + " for " + model.name + ": " + e.what());
+    }
+  }
+  auto compile_settings = torchtrt::ts::CompileSpec(ranges);
+
+  compile_settings.debug = model.debug;
+  compile_settings.device.allow_gpu_fallback = model.allow_gpu_fallback;
+  compile_settings.disable_tf32 = model.disable_tf32;
+  compile_settings.sparse_weights = model.sparse_weights;
+  compile_settings.require_full_compilation = model.require_full_compilation;
+  compile_settings.use_partitioning_cost_model = model.partitioning_cost_model;
+  compile_settings.truncate_long_and_double = model.truncate_long_and_double;
+  compile_settings.allow_shape_tensors = model.allow_shape_tensors;
+
+  if (!model.torch_executed_ops.empty() || !model.torch_executed_mods.empty()) {
+    if (model.require_full_compilation) {
+      throw std::runtime_error(
+          "Ops or modules to run in torch were provided for " + model.name + " but full compilation was requested");
+    }
+    compile_settings.torch_executed_ops = model.torch_executed_ops;
+    compile_settings.torch_executed_modules = model.torch_executed_mods;
+  }
+  if (model.min_block_size) {
+    compile_settings.min_block_size = model.min_block_size;
+  }
+
+  for (auto& precision : model.enabled_precisions) {
+    auto dtype = parserutil::parse_dtype(precision);
+    if (dtype == torchtrt::DataType::kFloat) {
+      compile_settings.enabled_precisions.insert(torch::kF32);
+    } else if (dtype == torchtrt::DataType::kHalf) {
+      compile_settings.enabled_precisions.insert(torch::kF16);
+    } else if (dtype == torchtrt::DataType::kBFloat16) {
+      compile_settings.enabled_precisions.insert(torch::kBFloat16);
+    } else if (dtype == torchtrt::DataType::kFloat8) {
+      compile_settings.enabled_precisions.insert(torch::kFloat8_e4m3fn);
+    } else if (dtype == torchtrt::DataType::kChar) {
+      compile_settings.enabled_precisions.insert(torch::kI8);
+    } else {
+      throw std::runtime_error("Invalid precision " + precision + " for " + model.name);
+    }
+  }
+
+  compile_settings.device.gpu_id = model.gpu_id;
+  auto device = lower(model.device_type);
+  if (device == "gpu") {
+    compile_settings.device.device_type = torchtrt::Device::DeviceType::kGPU;
+  } else if (device == "dla") {
+    compile_settings.device.device_type = torchtrt::Device::DeviceType::kDLA;
+    compile_settings.device.dla_core = model.dla_core;
+  } else {
+    throw std::runtime_error(
+        "Invalid device type for " + model.name + ", options are [ gpu | dla ] found: " + model.device_type);
+  }
+
+  if (!model.engine_capability.empty()) {
+    auto capability = lower(model.engine_capability);
+    if (capability == "standard") {
+      compile_settings.capability = torchtrt::EngineCapability::kSTANDARD;
+    } else if (capability == "safety") {
+      compile_settings.capability = torchtrt::EngineCapability::kSAFETY;
+    } else if (capability == "dla_standalone") {
+      compile_settings.capability = torchtrt::EngineCapability::kDLA_STANDALONE;
+    } else {
+      throw std::runtime_error(
+          "Invalid engine capability for " + model.name + ", options are [ standard | safety | dla_standalone ]");
+    }
+  }
+
+  if (model.num_avg_timing_iters) {
+    compile_settings.num_avg_timing_iters = model.num_avg_timing_iters;
+  }
+  if (model.workspace_size) {
+    compile_settings.workspace_size = model.workspace_size;
+  }
+  if (!model.timing_cache_file.empty()) {
+    compile_settings.timing_cache_path = model.timing_cache_file;
+  }
+  return compile_settings;
+}
+
+std::string summary_to_json(const std::vector<ModelStatus>& statuses) {
+  size_t succeeded = 0;
+  std::stringstream ss;
+  ss << "{\n  \"models\": [";
+  for (size_t i = 0; i < statuses.size(); i++) {
+    auto& s = statuses[i];
+    succeeded += s.succeeded ? 1 : 0;
+    ss << (i ? "," : "") << "\n    {";
+    ss << "\"name\": \"" << escape_json(s.name) << "\", ";
+    ss << "\"input\": \"" << escape_json(s.input_path) << "\", ";
+    ss << "\"output\": \"" << escape_json(s.output_path) << "\", ";
+    ss << "\"status\": \"" << (s.succeeded ? "ok" : "failed") << "\", ";
+    ss << "\"seconds\": " << std::fixed << std::setprecision(3) << s.seconds;
+    if (!s.succeeded) {
+      ss << ", \"error\": \"" << escape_json(s.error) << "\"";
+    }
+    ss << "}";
+  }
+  ss << (statuses.empty() ? "" : "\n  ") << "],\n";
+  ss << "  \"succeeded\": " << succeeded << ",\n";
+  ss << "  \"failed\": " << statuses.size() - succeeded << "\n}\n";
+  return ss.str();
+}
+
+} // namespace manifest
+} // namespace torchtrtc
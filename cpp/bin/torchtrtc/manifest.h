@@ -0,0 +1,67 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "torch_tensorrt/torch_tensorrt.h"
+
+namespace torchtrtc {
+namespace manifest {
+
+// One module to compile in manifest mode. Fields mirror the command line options of the same name, zero / empty
+// values leave the compiler default in place.
+struct ModelSpec {
+  std::string name;
+  std::string input_path;
+  std::string output_path;
+  std::vector<std::string> input_specs;
+  std::vector<std::string> enabled_precisions;
+  std::string device_type = "gpu";
+  uint64_t gpu_id = 0;
+  uint64_t dla_core = 0;
+  bool allow_gpu_fallback = false;
+  std::string engine_capability;
+  std::string calibration_cache_file;
+  std::string timing_cache_file;
+  std::vector<std::string> torch_executed_ops;
+  std::vector<std::string> torch_executed_mods;
+  uint64_t min_block_size = 0;
+  uint64_t num_avg_timing_iters = 0;
+  uint64_t workspace_size = 0;
+  bool require_full_compilation = false;
+  bool partitioning_cost_model = false;
+  bool disable_tf32 = false;
+  bool sparse_weights = false;
+  bool truncate_long_and_double = false;
+  bool allow_shape_tensors = false;
+  bool debug = false;
+  bool save_engine = false;
+};
+
+// Parses a JSON manifest of the form
+//   {"defaults": {<settings>}, "models": [{"name": ..., "input": ..., "output": ..., "inputs": [...], <settings>}]}
+// where settings of a model override the defaults. Relative paths are resolved against base_dir. Throws
+// std::runtime_error naming the offending entry if the manifest is malformed.
+std::vector<ModelSpec> parse_manifest(const std::string& contents, const std::string& base_dir);
+
+// Throws std::runtime_error if the models cannot be compiled num_jobs at a time, i.e. if they share a timing cache
+void check_concurrent_compilation(const std::vector<ModelSpec>& models, uint64_t num_jobs);
+
+// Compile spec for a model, the PTQ calibrator (which has to outlive compilation) is left to the caller. Throws
+// std::runtime_error for invalid settings.
+torchtrt::ts::CompileSpec to_compile_spec(const ModelSpec& model);
+
+struct ModelStatus {
+  std::string name;
+  std::string input_path;
+  std::string output_path;
+  bool succeeded = false;
+  std::string error;
+  double seconds = 0.0;
+};
+
+// Per model summary of a manifest run as JSON
+std::string summary_to_json(const std::vector<ModelStatus>& statuses);
+
+} // namespace manifest
+} // namespace torchtrtc
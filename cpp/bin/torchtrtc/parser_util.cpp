@@ -1,5 +1,8 @@
 #include "parser_util.h"
 
+#include <stdexcept>
+#include <unordered_map>
+
 namespace torchtrtc {
 namespace parserutil {
 
@@ -26,6 +29,10 @@ torchtrt::DataType parse_dtype(std::string dtype_str) {
     return torchtrt::DataType::kFloat;
   } else if (dtype_str == "half" || dtype_str == "float16" || dtype_str == "f16" || dtype_str == "fp16") {
     return torchtrt::DataType::kHalf;
+  } else if (dtype_str == "bfloat16" || dtype_str == "bf16") {
+    return torchtrt::DataType::kBFloat16;
+  } else if (dtype_str == "float8" || dtype_str == "fp8" || dtype_str == "f8") {
+    return torchtrt::DataType::kFloat8;
   } else if (dtype_str == "char" || dtype_str == "int8" || dtype_str == "i8") {
     return torchtrt::DataType::kChar;
   } else if (dtype_str == "int" || dtype_str == "int32" || dtype_str == "i32") {
@@ -35,7 +42,7 @@ torchtrt::DataType parse_dtype(std::string dtype_str) {
   } else {
     torchtrt::logging::log(
         torchtrt::logging::Level::kERROR,
-        "Invalid precision, options are [ float | float32 | fp32 | f32 | half | float16 | fp16 | f16 | char | int8 | i8 | int | int32 | i32 | bool | b], found: " +
+        "Invalid precision, options are [ float | float32 | fp32 | f32 | half | float16 | fp16 | f16 | bfloat16 | bf16 | float8 | fp8 | f8 | char | int8 | i8 | int | int32 | i32 | bool | b], found: " +
             dtype_str);
     return torchtrt::DataType::kUnknown;
   }
@@ -44,30 +51,30 @@ torchtrt::DataType parse_dtype(std::string dtype_str) {
 std::vector<int64_t> parse_single_dim(std::string shape_str) {
   std::vector<int64_t> shape;
   std::stringstream ss;
+  auto push_dim = [&]() {
+    int64_t dim;
+    if (!(ss >> dim) || !(ss >> std::ws).eof()) {
+      throw std::runtime_error("Invalid dimension in shape " + shape_str);
+    }
+    shape.push_back(dim);
+    ss.str("");
+    ss.clear();
+  };
   for (auto c : shape_str) {
     if (c == '(' || c == ' ') {
       continue;
     } else if (c == ',') {
-      int64_t dim;
-      ss >> dim;
-      shape.push_back(dim);
-      ss.clear();
+      push_dim();
     } else if (c == ')') {
-      int64_t dim;
-      ss >> dim;
-      shape.push_back(dim);
-      ss.clear();
+      push_dim();
       return shape;
     } else {
       ss << c;
     }
   }
 
-  torchtrt::logging::log(
-      torchtrt::logging::Level::kERROR,
+  throw std::runtime_error(
       "Shapes need dimensions delimited by comma in parentheses, \"(N,..,C,H,W)\"\n e.g \"(3,3,200,200)\"");
-  exit(1);
-  return {};
 }
 
 std::vector<std::vector<int64_t>> parse_dynamic_dim(std::string shape_str) {
@@ -89,10 +96,8 @@ std::vector<std::vector<int64_t>> parse_dynamic_dim(std::string shape_str) {
   shape.push_back(range);
 
   if (shape.size() != 3) {
-    torchtrt::logging::log(
-        torchtrt::logging::Level::kERROR,
+    throw std::runtime_error(
         "Dynamic shapes need three sets of dimensions delimited by semi-colons, \"[(MIN_N,..,MIN_C,MIN_H,MIN_W);(OPT_N,..,OPT_C,OPT_H,OPT_W);(MAX_N,..,MAX_C,MAX_H,MAX_W)]\"\n e.g \"[(3,3,100,100);(3,3,200,200);(3,3,300,300)]\"");
-    exit(1);
   }
 
   return shape;
@@ -116,13 +121,11 @@ torchtrt::Input parse_input(std::string spec) {
 
       auto parsed_dtype = parse_dtype(dtype);
       if (parsed_dtype == torchtrt::DataType::kUnknown) {
-        torchtrt::logging::log(torchtrt::logging::Level::kERROR, "Invalid datatype for input specification " + spec);
-        exit(1);
+        throw std::runtime_error("Invalid datatype for input specification " + spec);
       }
       auto parsed_format = parse_tensor_format(format);
       if (parsed_format == torchtrt::TensorFormat::kUnknown) {
-        torchtrt::logging::log(torchtrt::logging::Level::kERROR, "Invalid format for input specification " + spec);
-        exit(1);
+        throw std::runtime_error("Invalid format for input specification " + spec);
       }
       if (shapes.rfind("(", 0) == 0) {
         return torchtrt::Input(parse_single_dim(shapes), parsed_dtype, parsed_format);
@@ -130,8 +133,7 @@ torchtrt::Input parse_input(std::string spec) {
         auto dyn_shapes = parse_dynamic_dim(shapes);
         return torchtrt::Input(dyn_shapes[0], dyn_shapes[1], dyn_shapes[2], parsed_dtype, parsed_format);
       } else {
-        torchtrt::logging::log(torchtrt::logging::Level::kERROR, spec_err_str);
-        exit(1);
+        throw std::runtime_error(spec_err_str);
       }
       // THERE IS NO SPEC FOR FORMAT
     } else {
@@ -140,8 +142,7 @@ torchtrt::Input parse_input(std::string spec) {
 
       auto parsed_dtype = parse_dtype(dtype);
       if (parsed_dtype == torchtrt::DataType::kUnknown) {
-        torchtrt::logging::log(torchtrt::logging::Level::kERROR, "Invalid datatype for input specification " + spec);
-        exit(1);
+        throw std::runtime_error("Invalid datatype for input specification " + spec);
       }
       if (shapes.rfind("(", 0) == 0) {
         return torchtrt::Input(parse_single_dim(shapes), parsed_dtype);
@@ -149,8 +150,7 @@ torchtrt::Input parse_input(std::string spec) {
         auto dyn_shapes = parse_dynamic_dim(shapes);
         return torchtrt::Input(dyn_shapes[0], dyn_shapes[1], dyn_shapes[2], parsed_dtype);
       } else {
-        torchtrt::logging::log(torchtrt::logging::Level::kERROR, spec_err_str);
-        exit(1);
+        throw std::runtime_error(spec_err_str);
       }
     }
     // THERE IS A SPEC FOR FORMAT BUT NOT DTYPE
@@ -160,8 +160,7 @@ torchtrt::Input parse_input(std::string spec) {
 
     auto parsed_format = parse_tensor_format(format);
     if (parsed_format == torchtrt::TensorFormat::kUnknown) {
-      torchtrt::logging::log(torchtrt::logging::Level::kERROR, "Invalid format for input specification " + spec);
-      exit(1);
+      throw std::runtime_error("Invalid format for input specification " + spec);
     }
     if (shapes.rfind("(", 0) == 0) {
       return torchtrt::Input(parse_single_dim(shapes), parsed_format);
@@ -169,8 +168,7 @@ torchtrt::Input parse_input(std::string spec) {
       auto dyn_shapes = parse_dynamic_dim(shapes);
       return torchtrt::Input(dyn_shapes[0], dyn_shapes[1], dyn_shapes[2], parsed_format);
     } else {
-      torchtrt::logging::log(torchtrt::logging::Level::kERROR, spec_err_str);
-      exit(1);
+      throw std::runtime_error(spec_err_str);
     }
     // JUST SHAPE USE DEFAULT DTYPE
   } else {
@@ -180,10 +178,40 @@ torchtrt::Input parse_input(std::string spec) {
       auto dyn_shapes = parse_dynamic_dim(spec);
       return torchtrt::Input(dyn_shapes[0], dyn_shapes[1], dyn_shapes[2]);
     } else {
-      torchtrt::logging::log(torchtrt::logging::Level::kERROR, spec_err_str);
-      exit(1);
+      throw std::runtime_error(spec_err_str);
+    }
+  }
+}
+
+std::string format_input_spec(
+    const std::vector<int64_t>& min,
+    const std::vector<int64_t>& opt,
+    const std::vector<int64_t>& max,
+    const std::string& dtype) {
+  auto dims = [](const std::vector<int64_t>& shape) {
+    std::stringstream ss;
+    ss << "(";
+    for (size_t i = 0; i < shape.size(); i++) {
+      ss << (i ? "," : "") << shape[i];
     }
+    ss << ")";
+    return ss.str();
+  };
+
+  std::string spec;
+  if (min == max) {
+    spec = dims(opt);
+  } else {
+    spec = "[" + dims(min) + ";" + dims(opt) + ";" + dims(max) + "]";
+  }
+
+  const std::unordered_map<std::string, std::string> spec_dtypes = {
+      {"Float", "f32"}, {"Half", "f16"}, {"BFloat16", "bf16"}, {"Int", "i32"}, {"Char", "i8"}, {"Bool", "bool"}};
+  auto spec_dtype = spec_dtypes.find(dtype);
+  if (spec_dtype != spec_dtypes.end()) {
+    spec += "@" + spec_dtype->second;
   }
+  return spec;
 }
 
 } // namespace parserutil
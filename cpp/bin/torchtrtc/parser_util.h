@@ -21,14 +21,22 @@ torchtrt::TensorFormat parse_tensor_format(std::string str);
 // String to data type
 torchtrt::DataType parse_dtype(std::string dtype_str);
 
-// String to a vector of ints which represents a dimension spec
+// String to a vector of ints which represents a dimension spec, throws std::runtime_error if malformed
 std::vector<int64_t> parse_single_dim(std::string shape_str);
 
-// String to a vector of 3 dimension specs specs (each a vector of ints)
+// String to a vector of 3 dimension specs specs (each a vector of ints), throws std::runtime_error if malformed
 std::vector<std::vector<int64_t>> parse_dynamic_dim(std::string shape_str);
 
-// String to a torchtrt::Input
+// String to a torchtrt::Input, throws std::runtime_error describing the expected syntax if malformed
 torchtrt::Input parse_input(std::string input_specs);
 
+// Input spec string accepted by parse_input for a range, a single shape if min and max agree. dtype is a c10 scalar
+// type name as written in shape histograms (e.g. "Float"), left out of the spec if empty or not supported.
+std::string format_input_spec(
+    const std::vector<int64_t>& min,
+    const std::vector<int64_t>& opt,
+    const std::vector<int64_t>& max,
+    const std::string& dtype = "");
+
 } // namespace parserutil
 } // namespace torchtrtc
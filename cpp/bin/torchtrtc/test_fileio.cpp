@@ -0,0 +1,91 @@
+#include <sys/stat.h>
+#include <fstream>
+#include <random>
+#include <string>
+#include <thread>
+
+#include "cpp/bin/torchtrtc/fileio.h"
+#include "gtest/gtest.h"
+
+namespace fileio = torchtrtc::fileio;
+
+namespace {
+std::string temp_file(const std::string& name) {
+  return testing::TempDir() + "/torchtrtc_fileio_" + name;
+}
+
+std::string random_bytes(size_t size) {
+  std::mt19937 gen(0);
+  std::uniform_int_distribution<int> byte(0, 255);
+  std::string data(size, '\0');
+  for (auto& c : data) {
+    c = static_cast<char>(byte(gen));
+  }
+  return data;
+}
+} // namespace
+
+TEST(FileIO, RoundTripsBinaryData) {
+  // Every byte value including whitespace, NUL and line endings has to survive untouched
+  std::string data;
+  for (int i = 0; i < 256; i++) {
+    data += static_cast<char>(i);
+  }
+  data += std::string("\r\n\n \t\0\r", 7);
+  auto path = temp_file("binary");
+
+  ASSERT_TRUE(fileio::write_buf(path, data));
+  ASSERT_EQ(fileio::read_buf(path), data);
+}
+
+TEST(FileIO, RoundTripsEmptyFile) {
+  auto path = temp_file("empty");
+  ASSERT_TRUE(fileio::write_buf(path, ""));
+  ASSERT_EQ(fileio::read_buf(path), "");
+}
+
+TEST(FileIO, OverwritesExistingFile) {
+  auto path = temp_file("overwrite");
+  ASSERT_TRUE(fileio::write_buf(path, std::string(1024, 'a')));
+  ASSERT_TRUE(fileio::write_buf(path, "short"));
+  ASSERT_EQ(fileio::read_buf(path), "short");
+}
+
+TEST(FileIO, RoundTripsLargeFile) {
+  // Spans several write chunks and does not end on a chunk boundary
+  auto data = random_bytes((40 << 20) + 12345);
+  auto path = temp_file("large");
+
+  ASSERT_TRUE(fileio::write_buf(path, data));
+  std::ifstream check(path, std::ios::binary | std::ios::ate);
+  ASSERT_EQ(static_cast<size_t>(check.tellg()), data.size());
+
+  auto read = fileio::read_buf(path);
+  ASSERT_EQ(read.size(), data.size());
+  ASSERT_TRUE(read == data);
+}
+
+TEST(FileIO, ReadsUnseekableFiles) {
+  // Pipes such as --manifest <(gen_manifest) cannot be seeked and are drained instead
+  auto path = temp_file("fifo");
+  ::unlink(path.c_str());
+  ASSERT_EQ(::mkfifo(path.c_str(), 0600), 0);
+  auto data = random_bytes(100000);
+  std::thread writer([&]() {
+    std::ofstream out(path, std::ios::binary);
+    out.write(data.data(), data.size());
+  });
+  auto read = fileio::read_buf(path);
+  writer.join();
+  ::unlink(path.c_str());
+  ASSERT_EQ(read.size(), data.size());
+  ASSERT_TRUE(read == data);
+}
+
+TEST(FileIO, MissingFileReadsAsEmpty) {
+  ASSERT_EQ(fileio::read_buf(temp_file("does_not_exist")), "");
+}
+
+TEST(FileIO, WriteToMissingDirectoryFails) {
+  ASSERT_FALSE(fileio::write_buf(temp_file("no_such_dir/file"), "data"));
+}
@@ -0,0 +1,239 @@
+#include <stdexcept>
+#include <string>
+
+#include "cpp/bin/torchtrtc/manifest.h"
+#include "cpp/bin/torchtrtc/parser_util.h"
+#include "gtest/gtest.h"
+
+namespace manifest = torchtrtc::manifest;
+namespace parserutil = torchtrtc::parserutil;
+
+TEST(ParserUtil, ParsesStaticInputSpec) {
+  auto in = parserutil::parse_input("(1,3,224,224)@f16%NHWC");
+  ASSERT_EQ(in.opt_shape, (std::vector<int64_t>{1, 3, 224, 224}));
+  ASSERT_EQ(in.min_shape, in.opt_shape);
+  ASSERT_EQ(in.max_shape, in.opt_shape);
+  ASSERT_EQ(in.dtype, torchtrt::DataType::kHalf);
+  ASSERT_EQ(in.format, torchtrt::TensorFormat::kChannelsLast);
+}
+
+TEST(ParserUtil, ParsesDynamicInputSpec) {
+  auto in = parserutil::parse_input("[(1,3,100,100); (4,3,200,200); (8,3,300,300)]");
+  ASSERT_EQ(in.min_shape, (std::vector<int64_t>{1, 3, 100, 100}));
+  ASSERT_EQ(in.opt_shape, (std::vector<int64_t>{4, 3, 200, 200}));
+  ASSERT_EQ(in.max_shape, (std::vector<int64_t>{8, 3, 300, 300}));
+}
+
+TEST(ParserUtil, ParsesDtypesCaseInsensitively) {
+  ASSERT_EQ(parserutil::parse_dtype("FP16"), torchtrt::DataType::kHalf);
+  ASSERT_EQ(parserutil::parse_dtype("bf16"), torchtrt::DataType::kBFloat16);
+  ASSERT_EQ(parserutil::parse_dtype("i8"), torchtrt::DataType::kChar);
+  ASSERT_EQ(parserutil::parse_dtype("complex"), torchtrt::DataType::kUnknown);
+}
+
+TEST(ParserUtil, FormattedInputSpecsParseBack) {
+  auto spec = parserutil::format_input_spec({1, 16}, {4, 16}, {8, 16}, "Half");
+  ASSERT_EQ(spec, "[(1,16);(4,16);(8,16)]@f16");
+  auto in = parserutil::parse_input(spec);
+  ASSERT_EQ(in.min_shape, (std::vector<int64_t>{1, 16}));
+  ASSERT_EQ(in.max_shape, (std::vector<int64_t>{8, 16}));
+  ASSERT_EQ(in.dtype, torchtrt::DataType::kHalf);
+}
+
+TEST(ParserUtil, RejectsMalformedInputSpecs) {
+  // Malformed specs are reported to the caller instead of exiting so manifest mode can attribute them to a model
+  EXPECT_THROW(parserutil::parse_input("1,3,224"), std::runtime_error);
+  EXPECT_THROW(parserutil::parse_input("(1,3,224"), std::runtime_error);
+  EXPECT_THROW(parserutil::parse_input("(1,x,224)"), std::runtime_error);
+  EXPECT_THROW(parserutil::parse_input("(1,3,224)@f64"), std::runtime_error);
+  EXPECT_THROW(parserutil::parse_input("(1,3,224)%nchw16"), std::runtime_error);
+  EXPECT_THROW(parserutil::parse_input("[(1,8);(4,8)]"), std::runtime_error);
+  EXPECT_THROW(parserutil::parse_single_dim("1,3"), std::runtime_error);
+}
+
+TEST(Manifest, ParsesModelsOverDefaults) {
+  const auto json = R"JSON(
+    {
+      "defaults": {"enabled_precisions": ["fp16"], "workspace_size": 1073741824, "disable_tf32": true},
+      "models": [
+        {"name": "resnet_bs1", "input": "models/resnet.jit.pt", "output": "/out/resnet_bs1.ts",
+         "inputs": ["(1,3,224,224)"]},
+        {"input": "/models/bert.jit.pt", "output": "bert.engine", "inputs": ["(1,128)@i32", "(1,128)@i32"],
+         "enabled_precisions": ["fp32"], "save_engine": true, "torch_executed_ops": ["aten::gelu"]}
+      ]
+    })JSON";
+
+  auto models = manifest::parse_manifest(json, "/work");
+  ASSERT_EQ(models.size(), 2);
+
+  ASSERT_EQ(models[0].name, "resnet_bs1");
+  ASSERT_EQ(models[0].input_path, "/work/models/resnet.jit.pt");
+  ASSERT_EQ(models[0].output_path, "/out/resnet_bs1.ts");
+  ASSERT_EQ(models[0].enabled_precisions, (std::vector<std::string>{"fp16"}));
+  ASSERT_EQ(models[0].workspace_size, 1073741824);
+  ASSERT_TRUE(models[0].disable_tf32);
+  ASSERT_FALSE(models[0].save_engine);
+
+  // Unnamed models are named after their input file, settings of the model replace the defaults
+  ASSERT_EQ(models[1].name, "bert.jit.pt");
+  ASSERT_EQ(models[1].input_path, "/models/bert.jit.pt");
+  ASSERT_EQ(models[1].output_path, "/work/bert.engine");
+  ASSERT_EQ(models[1].input_specs.size(), 2);
+  ASSERT_EQ(models[1].enabled_precisions, (std::vector<std::string>{"fp32"}));
+  ASSERT_EQ(models[1].workspace_size, 1073741824);
+  ASSERT_TRUE(models[1].save_engine);
+  ASSERT_EQ(models[1].torch_executed_ops, (std::vector<std::string>{"aten::gelu"}));
+}
+
+TEST(Manifest, RejectsMalformedManifests) {
+  // Not JSON
+  EXPECT_THROW(manifest::parse_manifest("{\"models\": [", ""), std::runtime_error);
+  EXPECT_THROW(manifest::parse_manifest("{\"models\": []} trailing", ""), std::runtime_error);
+  // Malformed \u escapes
+  EXPECT_THROW(
+      manifest::parse_manifest(
+          R"JSON({"models": [{"name": "\uzzzz", "input": "a.pt", "output": "a.ts", "inputs": ["(1)"]}]})JSON", ""),
+      std::runtime_error);
+  EXPECT_THROW(
+      manifest::parse_manifest(
+          R"JSON({"models": [{"name": "\u12zz", "input": "a.pt", "output": "a.ts", "inputs": ["(1)"]}]})JSON", ""),
+      std::runtime_error);
+  // No models list
+  EXPECT_THROW(manifest::parse_manifest("{\"defaults\": {}}", ""), std::runtime_error);
+  // Unknown setting
+  EXPECT_THROW(
+      manifest::parse_manifest(
+          R"JSON({"models": [{"input": "a.pt", "output": "a.ts", "inputs": ["(1)"], "precision": "fp16"}]})JSON", ""),
+      std::runtime_error);
+  // Model names are not valid defaults
+  EXPECT_THROW(
+      manifest::parse_manifest(
+          R"JSON({"defaults": {"output": "a.ts"}, "models": [{"input": "a.pt", "output": "a.ts", "inputs": ["(1)"]}]})JSON",
+          ""),
+      std::runtime_error);
+  // Missing output path
+  EXPECT_THROW(
+      manifest::parse_manifest(R"JSON({"models": [{"input": "a.pt", "inputs": ["(1)"]}]})JSON", ""),
+      std::runtime_error);
+  // Missing input specs
+  EXPECT_THROW(
+      manifest::parse_manifest(R"JSON({"models": [{"input": "a.pt", "output": "a.ts"}]})JSON", ""),
+      std::runtime_error);
+  // Wrongly typed setting
+  EXPECT_THROW(
+      manifest::parse_manifest(
+          R"JSON({"models": [{"input": "a.pt", "output": "a.ts", "inputs": ["(1)"], "workspace_size": -1}]})JSON", ""),
+      std::runtime_error);
+  // Two models writing the same file
+  EXPECT_THROW(
+      manifest::parse_manifest(
+          R"JSON({"models": [{"input": "a.pt", "output": "a.ts", "inputs": ["(1)"]},
+                         {"input": "b.pt", "output": "a.ts", "inputs": ["(1)"]}]})JSON",
+          ""),
+      std::runtime_error);
+}
+
+TEST(Manifest, ParsesEscapedStrings) {
+  auto models = manifest::parse_manifest(
+      R"JSON({"models": [{"name": "a \"quoted\"\tname!", "input": "a.pt", "output": "a.ts", "inputs": ["(1)"]}]})JSON",
+      "");
+  ASSERT_EQ(models[0].name, "a \"quoted\"\tname!");
+  ASSERT_EQ(models[0].input_path, "a.pt");
+}
+
+TEST(Manifest, MapsSettingsToCompileSpec) {
+  manifest::ModelSpec model;
+  model.name = "m";
+  model.input_specs = {"[(1,8);(4,8);(16,8)]@f16", "(2,2)"};
+  model.enabled_precisions = {"fp16", "fp32"};
+  model.device_type = "DLA";
+  model.dla_core = 1;
+  model.allow_gpu_fallback = true;
+  model.engine_capability = "dla_standalone";
+  model.workspace_size = 1 << 20;
+  model.num_avg_timing_iters = 4;
+  model.min_block_size = 7;
+  model.torch_executed_ops = {"aten::topk"};
+  model.timing_cache_file = "/tmp/cache.bin";
+  model.truncate_long_and_double = true;
+
+  auto spec = manifest::to_compile_spec(model);
+  ASSERT_EQ(spec.graph_inputs.inputs.size(), 2);
+  ASSERT_EQ(spec.graph_inputs.inputs[0].max_shape, (std::vector<int64_t>{16, 8}));
+  ASSERT_EQ(spec.graph_inputs.inputs[0].dtype, torchtrt::DataType::kHalf);
+  ASSERT_EQ(spec.graph_inputs.inputs[1].opt_shape, (std::vector<int64_t>{2, 2}));
+  ASSERT_EQ(spec.enabled_precisions.size(), 2);
+  ASSERT_EQ(spec.device.device_type, torchtrt::Device::DeviceType::kDLA);
+  ASSERT_EQ(spec.device.dla_core, 1);
+  ASSERT_TRUE(spec.device.allow_gpu_fallback);
+  ASSERT_EQ(spec.capability, torchtrt::EngineCapability::kDLA_STANDALONE);
+  ASSERT_EQ(spec.workspace_size, 1 << 20);
+  ASSERT_EQ(spec.num_avg_timing_iters, 4);
+  ASSERT_EQ(spec.min_block_size, 7);
+  ASSERT_EQ(spec.torch_executed_ops, (std::vector<std::string>{"aten::topk"}));
+  ASSERT_EQ(spec.timing_cache_path, "/tmp/cache.bin");
+  ASSERT_TRUE(spec.truncate_long_and_double);
+}
+
+TEST(Manifest, RejectsInvalidCompileSettings) {
+  manifest::ModelSpec model;
+  model.name = "m";
+  model.input_specs = {"(1,8)"};
+  ASSERT_NO_THROW(manifest::to_compile_spec(model));
+
+  auto bad_precision = model;
+  bad_precision.enabled_precisions = {"fp64"};
+  EXPECT_THROW(manifest::to_compile_spec(bad_precision), std::runtime_error);
+
+  auto bad_device = model;
+  bad_device.device_type = "tpu";
+  EXPECT_THROW(manifest::to_compile_spec(bad_device), std::runtime_error);
+
+  auto bad_capability = model;
+  bad_capability.engine_capability = "fast";
+  EXPECT_THROW(manifest::to_compile_spec(bad_capability), std::runtime_error);
+
+  auto bad_inputs = model;
+  bad_inputs.input_specs = {"(1,8", "[(1,8);(2,8)]"};
+  EXPECT_THROW(manifest::to_compile_spec(bad_inputs), std::runtime_error);
+
+  auto conflicting = model;
+  conflicting.require_full_compilation = true;
+  conflicting.torch_executed_mods = {"Block"};
+  EXPECT_THROW(manifest::to_compile_spec(conflicting), std::runtime_error);
+}
+
+TEST(Manifest, RejectsSharedTimingCachesWhenCompilingConcurrently) {
+  auto models = manifest::parse_manifest(
+      R"JSON({"defaults": {"timing_cache": "cache.bin"},
+              "models": [{"name": "a", "input": "a.pt", "output": "a.ts", "inputs": ["(1)"]},
+                         {"name": "b", "input": "b.pt", "output": "b.ts", "inputs": ["(1)"]}]})JSON",
+      "/work");
+  ASSERT_NO_THROW(manifest::check_concurrent_compilation(models, 1));
+  EXPECT_THROW(manifest::check_concurrent_compilation(models, 2), std::runtime_error);
+
+  models[1].timing_cache_file = "/work/b_cache.bin";
+  ASSERT_NO_THROW(manifest::check_concurrent_compilation(models, 2));
+}
+
+TEST(Manifest, SummarizesModelStatuses) {
+  manifest::ModelStatus ok;
+  ok.name = "a";
+  ok.input_path = "/m/a.pt";
+  ok.output_path = "/o/a.ts";
+  ok.succeeded = true;
+  ok.seconds = 1.5;
+  manifest::ModelStatus failed;
+  failed.name = "b";
+  failed.error = "Unsupported operator \"aten::foo\"\nat line 3";
+
+  auto json = manifest::summary_to_json({ok, failed});
+  ASSERT_NE(
+      json.find("\"name\": \"a\", \"input\": \"/m/a.pt\", \"output\": \"/o/a.ts\", \"status\": \"ok\""),
+      std::string::npos);
+  ASSERT_NE(json.find("\"seconds\": 1.500"), std::string::npos);
+  ASSERT_NE(json.find("\"status\": \"failed\""), std::string::npos);
+  ASSERT_NE(json.find("\"error\": \"Unsupported operator \\\"aten::foo\\\"\\nat line 3\""), std::string::npos);
+  ASSERT_NE(json.find("\"succeeded\": 1"), std::string::npos);
+  ASSERT_NE(json.find("\"failed\": 1"), std::string::npos);
+}
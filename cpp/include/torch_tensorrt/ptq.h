@@ -24,6 +24,29 @@
 namespace torch_tensorrt {
 namespace ptq {
 TORCHTRT_API bool get_batch_impl(void* bindings[], const char* names[], int nbBindings, torch::Tensor& data);
+
+// Reads a calibration cache with one sized read, streaming it instead if the file cannot be seeked (e.g. a pipe).
+// Returns false if the file cannot be opened
+inline bool read_cache_file(const std::string& path, std::vector<char>& cache) {
+  cache.clear();
+  // Opened without std::ios::ate, which closes the stream if the seek to the end fails
+  std::ifstream input(path, std::ios::binary);
+  if (!input.good()) {
+    return false;
+  }
+  input.seekg(0, std::ios::end);
+  auto size = input.tellg();
+  if (!input || size <= 0) {
+    input.clear();
+    cache.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+    return true;
+  }
+  cache.resize(static_cast<size_t>(size));
+  input.seekg(0);
+  input.read(cache.data(), size);
+  cache.resize(static_cast<size_t>(input.gcount()));
+  return true;
+}
 }
 } // namespace torch_tensorrt
 #endif // DOXYGEN_SHOULD_SKIP_THIS
@@ -118,11 +141,7 @@ class Int8Calibrator : Algorithm {
       ss << "Reading Calibration Cache from " << cache_file_path_;
       logging::log(logging::Level::kINFO, ss.str());
 
-      cache_.clear();
-      std::ifstream input(cache_file_path_, std::ios::binary);
-      input >> std::noskipws;
-      if (input.good()) {
-        std::copy(std::istream_iterator<char>(input), std::istream_iterator<char>(), std::back_inserter(cache_));
+      if (read_cache_file(cache_file_path_, cache_)) {
         logging::log(logging::Level::kDEBUG, "Cache read");
       }
       length = cache_.size();
@@ -235,11 +254,7 @@ class Int8CacheCalibrator : Algorithm {
     ss << "Reading Calibration Cache from " << cache_file_path_;
     logging::log(logging::Level::kINFO, ss.str());
 
-    cache_.clear();
-    std::ifstream input(cache_file_path_, std::ios::binary);
-    input >> std::noskipws;
-    if (input.good()) {
-      std::copy(std::istream_iterator<char>(input), std::istream_iterator<char>(), std::back_inserter(cache_));
+    if (read_cache_file(cache_file_path_, cache_)) {
       logging::log(logging::Level::kDEBUG, "Cache read");
     }
     length = cache_.size();
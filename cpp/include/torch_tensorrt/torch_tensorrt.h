@@ -73,7 +73,12 @@ class DataType {
     /// Bool
     kBool,
     /// Sentinel value
-    kUnknown
+    kUnknown,
+    // Types added later follow kUnknown, so the values above stay stable for serialized settings and bindings
+    /// BF16
+    kBFloat16,
+    /// FP8 (E4M3), only valid as an enabled precision for networks with FP8 Q/DQ nodes
+    kFloat8
   };
 
   /**
@@ -818,6 +823,12 @@ struct CompileSpec {
    */
   uint64_t workspace_size = 0;
 
+  /**
+   * Path to a TensorRT timing cache. It is loaded once per compilation, shared by every engine built and merged back
+   * into the file afterwards so later compilations can skip re-timing tactics. Empty disables the cache
+   */
+  std::string timing_cache_path = "";
+
   /**
    * Fast software managed RAM used by DLA to communicate within a layer.
    */
@@ -848,6 +859,12 @@ struct CompileSpec {
    */
   uint64_t min_block_size = 3;
 
+  /**
+   * Use a cost model over the tensors crossing segment boundaries to move TensorRT subgraphs back to PyTorch when
+   * splitting them out is estimated to cost more than it saves
+   */
+  bool use_partitioning_cost_model = false;
+
   /**
    * List of aten operators that must be run in PyTorch. An error will be thrown if this list is not empty but
    * ``require_full_compilation`` is True
@@ -109,6 +109,7 @@ torchtrt::core::CompileSpec to_internal_compile_spec(CompileSpec external, bool
 
   internal.partitioning_info.enabled = !external.require_full_compilation;
   internal.partitioning_info.min_block_size = external.min_block_size;
+  internal.partitioning_info.use_cost_model = external.use_partitioning_cost_model;
   internal.partitioning_info.forced_fallback_operators = std::move(external.torch_executed_ops);
   internal.partitioning_info.truncate_long_and_double = external.truncate_long_and_double;
   internal.lower_info.forced_fallback_modules = std::move(external.torch_executed_modules);
@@ -147,6 +148,7 @@ torchtrt::core::CompileSpec to_internal_compile_spec(CompileSpec external, bool
 
   internal.convert_info.engine_settings.num_avg_timing_iters = external.num_avg_timing_iters;
   internal.convert_info.engine_settings.workspace_size = external.workspace_size;
+  internal.convert_info.engine_settings.timing_cache_path = external.timing_cache_path;
   internal.convert_info.engine_settings.dla_sram_size = external.dla_sram_size;
   internal.convert_info.engine_settings.dla_local_dram_size = external.dla_local_dram_size;
   internal.convert_info.engine_settings.dla_global_dram_size = external.dla_global_dram_size;
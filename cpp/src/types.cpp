@@ -25,6 +25,12 @@ std::ostream& operator<<(std::ostream& os, const DataType& dtype) {
     case DataType::kFloat:
       os << "float";
       break;
+    case DataType::kBFloat16:
+      os << "bfloat16";
+      break;
+    case DataType::kFloat8:
+      os << "float8";
+      break;
     case DataType::kUnknown:
     default:
       os << "unknown";
@@ -81,6 +87,10 @@ nvinfer1::DataType toTRTDataType(DataType value) {
       return nvinfer1::DataType::kINT32;
     case DataType::kBool:
       return nvinfer1::DataType::kBOOL;
+    case DataType::kBFloat16:
+      return nvinfer1::DataType::kBF16;
+    case DataType::kFloat8:
+      return nvinfer1::DataType::kFP8;
     case DataType::kFloat:
     default:
       return nvinfer1::DataType::kFLOAT;
@@ -101,6 +111,10 @@ at::ScalarType toAtenDataType(DataType value) {
       return at::kDouble;
     case DataType::kBool:
       return at::kBool;
+    case DataType::kBFloat16:
+      return at::kBFloat16;
+    case DataType::kFloat8:
+      return at::kFloat8_e4m3fn;
     case DataType::kFloat:
     case DataType::kUnknown:
     default:
@@ -122,7 +136,7 @@ nvinfer1::TensorFormat toTRTTensorFormat(TensorFormat value) {
 DataType::DataType(c10::ScalarType t) {
   TORCHTRT_CHECK(
       t == at::kHalf || t == at::kFloat || t == at::kChar || t == at::kLong || t == at::kDouble || t == at::kInt ||
-          t == at::kBool,
+          t == at::kBool || t == at::kBFloat16 || t == at::kFloat8_e4m3fn,
       "Data type is unsupported (" << t << ")");
   switch (t) {
     case at::kHalf:
@@ -143,6 +157,12 @@ DataType::DataType(c10::ScalarType t) {
     case at::kBool:
       value = DataType::kBool;
       break;
+    case at::kBFloat16:
+      value = DataType::kBFloat16;
+      break;
+    case at::kFloat8_e4m3fn:
+      value = DataType::kFloat8;
+      break;
     case at::kFloat:
     default:
       value = DataType::kFloat;
@@ -258,11 +258,15 @@ class dtype(Enum):
                     return dtype.f64
                 elif t == _C.dtype.bool:
                     return dtype.b
+                elif t == _C.dtype.bfloat16:
+                    return dtype.bf16
+                elif t == _C.dtype.float8:
+                    return dtype.f8
                 elif t == _C.dtype.unknown:
                     return dtype.unknown
                 else:
                     raise TypeError(
-                        f"Provided an unsupported data type as an input data type (support: bool, int32, long, half, float), got: {t}"
+                        f"Provided an unsupported data type as an input data type (support: bool, int32, long, half, float, bfloat16, float8), got: {t}"
                     )
         # else: # commented out for mypy
         raise TypeError(
@@ -446,11 +450,15 @@ class dtype(Enum):
                     return _C.dtype.double
                 elif self == dtype.b:
                     return _C.dtype.bool
+                elif self == dtype.bf16:
+                    return _C.dtype.bfloat16
+                elif self == dtype.f8:
+                    return _C.dtype.float8
                 elif self == dtype.unknown:
                     return _C.dtype.unknown
                 else:
                     raise TypeError(
-                        f"Provided an unsupported data type as an input data type (support: bool, int32, long, half, float), got: {self}"
+                        f"Provided an unsupported data type as an input data type (support: bool, int32, long, half, float, bfloat16, float8), got: {self}"
                     )
         # else: # commented out for mypy
         raise TypeError(
@@ -20,6 +20,10 @@ std::string to_str(DataType value) {
       return "Long";
     case DataType::kDouble:
       return "Double";
+    case DataType::kBFloat16:
+      return "BFloat16";
+    case DataType::kFloat8:
+      return "Float8";
     default:
       return "Unknown data type";
   }
@@ -41,6 +45,10 @@ nvinfer1::DataType toTRTDataType(DataType value) {
       return nvinfer1::DataType::kBOOL;
     case DataType::kFloat:
       return nvinfer1::DataType::kFLOAT;
+    case DataType::kBFloat16:
+      return nvinfer1::DataType::kBF16;
+    case DataType::kFloat8:
+      return nvinfer1::DataType::kFP8;
     case DataType::kUnknown:
       return nvinfer1::DataType::kFLOAT;
     default:
@@ -64,6 +72,10 @@ at::ScalarType toAtenDataType(DataType value) {
       return at::kFloat;
     case DataType::kDouble:
       return at::kDouble;
+    case DataType::kBFloat16:
+      return at::kBFloat16;
+    case DataType::kFloat8:
+      return at::kFloat8_e4m3fn;
     case DataType::kUnknown:
       return at::kFloat;
     default:
@@ -27,7 +27,8 @@ namespace pyapi {
     return static_cast<int64_t>(field_name);                                    \
   }
 
-enum class DataType : int8_t { kLong, kDouble, kFloat, kHalf, kChar, kInt32, kBool, kUnknown };
+// Values appended after kUnknown so the existing ones keep their numbering
+enum class DataType : int8_t { kLong, kDouble, kFloat, kHalf, kChar, kInt32, kBool, kUnknown, kBFloat16, kFloat8 };
 std::string to_str(DataType value);
 nvinfer1::DataType toTRTDataType(DataType value);
 at::ScalarType toAtenDataType(DataType value);
@@ -53,7 +54,7 @@ struct Input : torch::CustomClassHolder {
   ADD_FIELD_GET_SET(tensor_domain, std::vector<double>);
   ADD_FIELD_GET_SET(input_is_dynamic, bool);
   ADD_FIELD_GET_SET(explicit_set_dtype, bool);
-  ADD_ENUM_GET_SET(dtype, DataType, static_cast<int64_t>(DataType::kUnknown));
+  ADD_ENUM_GET_SET(dtype, DataType, static_cast<int64_t>(DataType::kFloat8));
   ADD_ENUM_GET_SET(format, TensorFormat, static_cast<int64_t>(TensorFormat::kContiguous));
 
   core::ir::Input toInternalInput();
@@ -135,7 +136,9 @@ struct CompileSpec : torch::CustomClassHolder {
 
   void setPrecisions(const std::vector<int64_t>& precisions_raw) {
     for (auto p : precisions_raw) {
-      TORCHTRT_CHECK(p >= 0 && p <= static_cast<int64_t>(DataType::kBool), "Invalid enum value for field");
+      TORCHTRT_CHECK(
+          p >= 0 && p <= static_cast<int64_t>(DataType::kFloat8) && p != static_cast<int64_t>(DataType::kUnknown),
+          "Invalid enum value for field");
       enabled_precisions.insert(static_cast<DataType>(p));
     }
   }
@@ -254,6 +254,8 @@ PYBIND11_MODULE(_C, m) {
       .value("double", DataType::kDouble, "64 bit floating point number")
       .value("float64", DataType::kDouble, "64 bit floating point number")
       .value("bool", DataType::kBool, "Boolean value")
+      .value("bfloat16", DataType::kBFloat16, "16 bit brain floating point number")
+      .value("float8", DataType::kFloat8, "8 bit floating point number (E4M3), only valid as an enabled precision")
       .value("unknown", DataType::kUnknown, "Unknown data type")
       .export_values();
 
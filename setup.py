@@ -616,6 +616,7 @@ if not (PY_ONLY or NO_TS):
                 "include/torch_tensorrt/core/partitioning/segmentedblock/*.h",
                 "include/torch_tensorrt/core/partitioning/partitioninginfo/*.h",
                 "include/torch_tensorrt/core/partitioning/partitioningctx/*.h",
+                "include/torch_tensorrt/core/partitioning/costmodel/*.h",
                 "include/torch_tensorrt/core/plugins/*.h",
                 "include/torch_tensorrt/core/plugins/impl/*.h",
                 "include/torch_tensorrt/core/runtime/*.h",
@@ -1,5 +1,6 @@
 #include <string>
 #include "core/compiler.h"
+#include "core/conversion/converters/converters.h"
 #include "core/lowering/passes/passes.h"
 #include "gtest/gtest.h"
 #include "tests/util/util.h"
@@ -260,8 +261,8 @@ TEST(Converters, ATenGELUConvertsCorrectly) {
 
   auto in = at::randint(-5, 5, {5}, {at::kCUDA});
 
-  // Lower aten::gelu to pointwise operators using Fast approximation
-  // Gelu(x) = 0.5 * x * (1.0 + torch.tanh(x * 0.7978845608 * (1.0 + 0.044715 * x * x)))
+  // aten::gelu without an approximate argument has no native conversion, so it is lowered to the exact form
+  // Gelu(x) = 0.5 * x * (1 + erf(x / sqrt(2)))
   torch_tensorrt::core::lowering::passes::ReduceGelu(g);
 
   auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
@@ -271,11 +272,133 @@ TEST(Converters, ATenGELUConvertsCorrectly) {
   params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
   auto trt_results = torch_tensorrt::tests::util::RunGraphEngine(g, params, {in});
 
-  // NOTE: The official tensorrt plugin applies the Gelu activation x * Phi(x), where Phi is the Gaussian cdf,
-  // approximated by: 0.5 * (1 + tanh(sqrt(2 / M_PI) * (x + 0.044715 * x^3))) and the pytorch uses
-  // c10::cuda::compat::normcdf to compute Phi(x). So there's a difference here and therefore the threshold is slightly
-  // higher than other ops. One in ten runs will give you an out of normal threshold result
+  // TensorRT's erf differs slightly from the one pytorch uses, hence the higher threshold than for other ops
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results[0], trt_results[0], 5e-2));
+}
+
+TEST(Converters, ATenGELUTanhConvertsCorrectly) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor):
+        %approx : str = prim::Constant[value="tanh"]()
+        %3 : Tensor = aten::gelu(%0, %approx)
+        return (%3))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, &*g);
+
+  auto in = at::randn({5, 16}, {at::kCUDA}) * 4;
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto jit_results = torch_tensorrt::tests::util::RunGraph(g, params, {in});
+
+  // Kept as aten::gelu and converted to a GELU_TANH activation
+  // Gelu(x) = 0.5 * x * (1 + tanh(sqrt(2 / pi) * (x + 0.044715 * x^3)))
+  torch_tensorrt::core::lowering::passes::ReduceGelu(g);
+
+  in = at::clone(in);
+  params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto trt_results = torch_tensorrt::tests::util::RunGraphEngine(g, params, {in});
 
   ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results[0], trt_results[0], 5e-2));
 }
 #endif
+
+namespace {
+// Converts the single aten::gelu node of the graph on its own and returns the network it was added to
+nvinfer1::INetworkDefinition* convertGelu(
+    torch_tensorrt::core::conversion::ConversionCtx& ctx,
+    std::shared_ptr<torch::jit::Graph>& g) {
+  auto in = ctx.net->addInput("x", nvinfer1::DataType::kFLOAT, torch_tensorrt::core::util::toDims(c10::IntArrayRef{8}));
+  for (auto n : g->nodes()) {
+    if (n->kind() != torch::jit::aten::gelu) {
+      continue;
+    }
+    auto approximate = torch::jit::toIValue(n->input(1)).value();
+    torch_tensorrt::core::conversion::converters::args args = {in, &approximate};
+    auto converter = torch_tensorrt::core::conversion::converters::get_node_converter_for(&n->schema());
+    EXPECT_TRUE(converter(&ctx, n, args));
+  }
+  return ctx.net.get();
+}
+} // namespace
+
+TEST(Converters, ATenGELUExactConvertsToSingleLayer) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor):
+        %approx : str = prim::Constant[value="none"]()
+        %3 : Tensor = aten::gelu(%0, %approx)
+        return (%3))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, &*g);
+  torch_tensorrt::core::lowering::passes::ReduceGelu(g);
+
+  torch_tensorrt::core::conversion::ConversionCtx ctx(torch_tensorrt::core::conversion::BuilderSettings{});
+  auto net = convertGelu(ctx, g);
+  ASSERT_EQ(net->getNbLayers(), 1);
+  auto layer = static_cast<nvinfer1::IActivationLayer*>(net->getLayer(0));
+  ASSERT_EQ(layer->getType(), nvinfer1::LayerType::kACTIVATION);
+  ASSERT_EQ(layer->getActivationType(), nvinfer1::ActivationType::kGELU_ERF);
+}
+
+TEST(Converters, ATenGELUTanhConvertsToSingleLayer) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor):
+        %approx : str = prim::Constant[value="tanh"]()
+        %3 : Tensor = aten::gelu(%0, %approx)
+        return (%3))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, &*g);
+  torch_tensorrt::core::lowering::passes::ReduceGelu(g);
+
+  torch_tensorrt::core::conversion::ConversionCtx ctx(torch_tensorrt::core::conversion::BuilderSettings{});
+  auto net = convertGelu(ctx, g);
+  ASSERT_EQ(net->getNbLayers(), 1);
+  auto layer = static_cast<nvinfer1::IActivationLayer*>(net->getLayer(0));
+  ASSERT_EQ(layer->getType(), nvinfer1::LayerType::kACTIVATION);
+  ASSERT_EQ(layer->getActivationType(), nvinfer1::ActivationType::kGELU_TANH);
+}
+
+TEST(Converters, ATenGELUExactConvertsCorrectly) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor):
+        %approx : str = prim::Constant[value="none"]()
+        %3 : Tensor = aten::gelu(%0, %approx)
+        return (%3))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, &*g);
+
+  auto in = at::randn({4, 64}, {at::kCUDA}) * 4;
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto jit_results = torch_tensorrt::tests::util::RunGraph(g, params, {in});
+
+  torch_tensorrt::core::lowering::passes::ReduceGelu(g);
+  in = at::clone(in);
+  params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto trt_results = torch_tensorrt::tests::util::RunGraphEngine(g, params, {in});
+
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results[0], trt_results[0]));
+}
+
+TEST(Converters, ATenGELUTanhConvertsCorrectly) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor):
+        %approx : str = prim::Constant[value="tanh"]()
+        %3 : Tensor = aten::gelu(%0, %approx)
+        return (%3))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, &*g);
+
+  auto in = at::randn({4, 64}, {at::kCUDA}) * 4;
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto jit_results = torch_tensorrt::tests::util::RunGraph(g, params, {in});
+
+  torch_tensorrt::core::lowering::passes::ReduceGelu(g);
+  in = at::clone(in);
+  params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto trt_results = torch_tensorrt::tests::util::RunGraphEngine(g, params, {in});
+
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results[0], trt_results[0]));
+}
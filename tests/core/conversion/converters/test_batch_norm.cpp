@@ -4,6 +4,17 @@
 #include "tests/util/util.h"
 #include "torch/csrc/jit/ir/irparser.h"
 
+namespace {
+nvinfer1::IScaleLayer* findScaleLayer(torch_tensorrt::core::conversion::ConversionCtx& ctx) {
+  for (int i = 0; i < ctx.net->getNbLayers(); i++) {
+    if (ctx.net->getLayer(i)->getType() == nvinfer1::LayerType::kSCALE) {
+      return static_cast<nvinfer1::IScaleLayer*>(ctx.net->getLayer(i));
+    }
+  }
+  return nullptr;
+}
+} // namespace
+
 TEST(Converters, ATenBatchNormConvertsCorrectly) {
   const auto graph = R"IR(
       graph(%0 : Tensor,
@@ -35,6 +46,86 @@ TEST(Converters, ATenBatchNormConvertsCorrectly) {
   ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results[0], trt_results[0].reshape_as(jit_results[0])));
 }
 
+TEST(Converters, ATenBatchNormFloatWeightsHalfPrecisionConvertsCorrectly) {
+  // FP32 parameters are folded in FP32 and stored as FP16 when FP16 is the only enabled precision
+  const auto graph = R"IR(
+      graph(%0 : Tensor,
+            %1: Float(5, strides=[1]),
+            %2: Float(5, strides=[1]),
+            %3: Float(5, strides=[1]),
+            %4: Float(5, strides=[1])):
+        %5 : bool = prim::Constant[value=0]()
+        %6 : float = prim::Constant[value=1.0000000000000001e-05]()
+        %7 : float = prim::Constant[value=0.10000000000000001]()
+        %8 : Tensor = aten::batch_norm(%0, %1, %2, %3, %4, %5, %6, %7, %5)
+        return (%8))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+
+  auto in = at::randn({1, 5, 5, 5}, {at::kCUDA});
+  auto gamma = at::randn({5}, {at::kCUDA});
+  auto beta = at::randn({5}, {at::kCUDA});
+  auto mean = at::randn({5}, {at::kCUDA});
+  auto var = at::rand({5}, {at::kCUDA}) + 0.5;
+
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {gamma, beta, mean, var});
+  auto jit_results = torch_tensorrt::tests::util::RunGraph(g, params, {in});
+
+  params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {gamma, beta, mean, var});
+  auto trt_results = torch_tensorrt::tests::util::RunGraphEngine(g, params, {in}, nvinfer1::DataType::kHALF);
+
+  auto trt = trt_results[0].reshape_as(jit_results[0]).to(at::kFloat);
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results[0], trt, 2e-2));
+
+  params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {gamma, beta, mean, var});
+  auto half_ctx = torch_tensorrt::tests::util::ConvertGraphToNetwork(g, params, {in}, nvinfer1::DataType::kHALF);
+  params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {gamma, beta, mean, var});
+  auto float_ctx = torch_tensorrt::tests::util::ConvertGraphToNetwork(g, params, {in});
+
+  auto bn = findScaleLayer(*half_ctx);
+  ASSERT_NE(bn, nullptr);
+  ASSERT_EQ(bn->getScale().type, nvinfer1::DataType::kHALF);
+  ASSERT_EQ(bn->getShift().type, nvinfer1::DataType::kHALF);
+  ASSERT_EQ(bn->getPower().type, nvinfer1::DataType::kHALF);
+  ASSERT_LT(half_ctx->builder_resource_bytes, float_ctx->builder_resource_bytes);
+}
+
+TEST(Converters, ATenBatchNormOutOfHalfRangeWeightsKeepFloat) {
+  // A folded scale past the FP16 range would become inf, so all parameters stay FP32
+  const auto graph = R"IR(
+      graph(%0 : Tensor,
+            %1: Float(5, strides=[1]),
+            %2: Float(5, strides=[1]),
+            %3: Float(5, strides=[1]),
+            %4: Float(5, strides=[1])):
+        %5 : bool = prim::Constant[value=0]()
+        %6 : float = prim::Constant[value=1.0000000000000001e-05]()
+        %7 : float = prim::Constant[value=0.10000000000000001]()
+        %8 : Tensor = aten::batch_norm(%0, %1, %2, %3, %4, %5, %6, %7, %5)
+        return (%8))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+
+  auto in = at::randn({1, 5, 5, 5}, {at::kCUDA});
+  auto gamma = at::randn({5}, {at::kCUDA});
+  gamma[2] = 1e6;
+  auto beta = at::randn({5}, {at::kCUDA});
+  auto mean = at::randn({5}, {at::kCUDA});
+  auto var = at::rand({5}, {at::kCUDA}) + 0.5;
+
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {gamma, beta, mean, var});
+  auto ctx = torch_tensorrt::tests::util::ConvertGraphToNetwork(g, params, {in}, nvinfer1::DataType::kHALF);
+
+  auto bn = findScaleLayer(*ctx);
+  ASSERT_NE(bn, nullptr);
+  ASSERT_EQ(bn->getScale().type, nvinfer1::DataType::kFLOAT);
+  ASSERT_EQ(bn->getShift().type, nvinfer1::DataType::kFLOAT);
+  ASSERT_EQ(bn->getPower().type, nvinfer1::DataType::kFLOAT);
+  ASSERT_GT(static_cast<const float*>(bn->getScale().values)[2], 65504.0f);
+}
+
 TEST(Converters, ATenBatchNormAffineFalseConvertsCorrectly) {
   // BatchNorm(ch, affine=False)
   const auto graph = R"IR(
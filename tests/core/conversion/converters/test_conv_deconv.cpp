@@ -10,6 +10,17 @@
 //                    int[] output_padding, int groups, bool benchmark,
 //                    bool deterministic, bool cudnn_enabled) -> (Tensor)
 
+namespace {
+nvinfer1::IConvolutionLayer* findConvolutionLayer(torch_tensorrt::core::conversion::ConversionCtx& ctx) {
+  for (int i = 0; i < ctx.net->getNbLayers(); i++) {
+    if (ctx.net->getLayer(i)->getType() == nvinfer1::LayerType::kCONVOLUTION) {
+      return static_cast<nvinfer1::IConvolutionLayer*>(ctx.net->getLayer(i));
+    }
+  }
+  return nullptr;
+}
+} // namespace
+
 void conv_test_helper(std::string graph_ir) {
   auto g = std::make_shared<torch::jit::Graph>();
   torch::jit::parseIR(graph_ir, g.get());
@@ -167,6 +178,89 @@ TEST(Converters, ATenConv1dWithWeightTensorsConvertsCorrectly) {
   ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results[0], trt_results[0]));
 }
 
+TEST(Converters, ATenConvolutionFloatWeightsHalfPrecisionConvertsCorrectly) {
+  // The FP32 kernel and bias are stored as FP16 when FP16 is the only enabled precision
+  const auto graph = R"IR(
+      graph(%0 : Tensor,
+            %1 : Float(8, 3, 5, 5, strides=[45, 15, 5, 1]),
+            %2 : Float(8)):
+        %3 : int = prim::Constant[value=1]()
+        %4 : int = prim::Constant[value=0]()
+        %5 : int = prim::Constant[value=1]()
+        %6 : int = prim::Constant[value=0]()
+        %7 : bool = prim::Constant[value=0]()
+        %8 : int[] = prim::ListConstruct(%3, %3)
+        %9 : int[] = prim::ListConstruct(%4, %4)
+        %10 : int[] = prim::ListConstruct(%5, %5)
+        %11 : int[] = prim::ListConstruct(%6, %6)
+        %12 : Tensor = aten::_convolution(%0, %1, %2, %8, %9, %10, %7, %11, %3, %7, %7, %7, %7)
+        return (%12))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+
+  auto in = at::randn({1, 3, 10, 10}, {at::kCUDA});
+  auto w = at::randn({8, 3, 5, 5}, {at::kCUDA});
+  auto b = at::randn({8}, {at::kCUDA});
+
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {w, b});
+  auto jit_results = torch_tensorrt::tests::util::RunGraph(g, params, {in});
+
+  params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {w, b});
+  auto trt_results = torch_tensorrt::tests::util::RunGraphEngine(g, params, {in}, nvinfer1::DataType::kHALF);
+
+  auto trt = trt_results[0].reshape(jit_results[0].sizes()).to(at::kFloat);
+
+  ASSERT_TRUE(torch_tensorrt::tests::util::cosineSimEqual(jit_results[0], trt));
+
+  params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {w, b});
+  auto half_ctx = torch_tensorrt::tests::util::ConvertGraphToNetwork(g, params, {in}, nvinfer1::DataType::kHALF);
+  params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {w, b});
+  auto float_ctx = torch_tensorrt::tests::util::ConvertGraphToNetwork(g, params, {in});
+
+  auto conv = findConvolutionLayer(*half_ctx);
+  ASSERT_NE(conv, nullptr);
+  ASSERT_EQ(conv->getKernelWeights().type, nvinfer1::DataType::kHALF);
+  ASSERT_EQ(conv->getBiasWeights().type, nvinfer1::DataType::kHALF);
+  ASSERT_EQ(half_ctx->builder_resource_bytes * 2, float_ctx->builder_resource_bytes);
+}
+
+TEST(Converters, ATenConvolutionOutOfHalfRangeWeightsKeepFloat) {
+  // Only the kernel exceeds the FP16 range, so only the kernel stays FP32
+  const auto graph = R"IR(
+      graph(%0 : Tensor,
+            %1 : Float(8, 3, 5, 5, strides=[45, 15, 5, 1]),
+            %2 : Float(8)):
+        %3 : int = prim::Constant[value=1]()
+        %4 : int = prim::Constant[value=0]()
+        %5 : int = prim::Constant[value=1]()
+        %6 : int = prim::Constant[value=0]()
+        %7 : bool = prim::Constant[value=0]()
+        %8 : int[] = prim::ListConstruct(%3, %3)
+        %9 : int[] = prim::ListConstruct(%4, %4)
+        %10 : int[] = prim::ListConstruct(%5, %5)
+        %11 : int[] = prim::ListConstruct(%6, %6)
+        %12 : Tensor = aten::_convolution(%0, %1, %2, %8, %9, %10, %7, %11, %3, %7, %7, %7, %7)
+        return (%12))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+
+  auto in = at::randn({1, 3, 10, 10}, {at::kCUDA});
+  auto w = at::randn({8, 3, 5, 5}, {at::kCUDA});
+  w[0][0][0][0] = -1e5;
+  auto b = at::randn({8}, {at::kCUDA});
+
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {w, b});
+  auto ctx = torch_tensorrt::tests::util::ConvertGraphToNetwork(g, params, {in}, nvinfer1::DataType::kHALF);
+
+  auto conv = findConvolutionLayer(*ctx);
+  ASSERT_NE(conv, nullptr);
+  ASSERT_EQ(conv->getKernelWeights().type, nvinfer1::DataType::kFLOAT);
+  ASSERT_EQ(static_cast<const float*>(conv->getKernelWeights().values)[0], -1e5f);
+  ASSERT_EQ(conv->getBiasWeights().type, nvinfer1::DataType::kHALF);
+}
+
 TEST(Converters, ATenConvolutionNoBiasConvertsCorrectly) {
   const auto graph = R"IR(
       graph(%0 : Tensor,
@@ -1,9 +1,35 @@
 #include <string>
 #include "core/compiler.h"
+#include "core/conversion/converters/converters.h"
 #include "gtest/gtest.h"
 #include "tests/util/util.h"
 #include "torch/csrc/jit/ir/irparser.h"
 
+namespace {
+const auto cumsum_dim1_graph = R"IR(
+      graph(%0 : Tensor):
+        %1 : int = prim::Constant[value=1]()
+        %2 : None = prim::Constant()
+        %3 : Tensor = aten::cumsum(%0, %1, %2)
+        return (%3))IR";
+
+void run_cumsum_test(at::Tensor in, bool dynamic_batch = false) {
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(cumsum_dim1_graph, &*g);
+
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto jit_results = torch_tensorrt::tests::util::RunGraph(g, params, {in});
+
+  in = at::clone(in);
+  params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto trt_results = dynamic_batch
+      ? torch_tensorrt::tests::util::RunGraphEngineDynamic(g, params, {in}, /*dynamic_batch=*/true)
+      : torch_tensorrt::tests::util::RunGraphEngine(g, params, {in});
+
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results[0], trt_results[0]));
+}
+} // namespace
+
 TEST(Converters, ATenCumsumConvertsCorrectly) {
   const auto graph = R"IR(
       graph(%0 : Tensor):
@@ -91,3 +117,45 @@ TEST(Converters, ATenCumsumNegativeDimConvertsCorrectlyWithDynamicInput) {
 
   ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results[0], trt_results[0]));
 }
+
+TEST(Converters, ATenCumsumStaticExtentConvertsWithoutLoop) {
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(cumsum_dim1_graph, &*g);
+
+  torch_tensorrt::core::conversion::ConversionCtx ctx(torch_tensorrt::core::conversion::BuilderSettings{});
+  auto in = ctx.net->addInput(
+      "x", nvinfer1::DataType::kFLOAT, torch_tensorrt::core::util::toDims(std::vector<int64_t>{2, 100, 4}));
+  for (auto n : g->nodes()) {
+    if (n->kind() != torch::jit::aten::cumsum) {
+      continue;
+    }
+    auto dim = torch::jit::toIValue(n->input(1)).value();
+    auto dtype = torch::jit::toIValue(n->input(2)).value();
+    torch_tensorrt::core::conversion::converters::args args = {in, &dim, &dtype};
+    auto converter = torch_tensorrt::core::conversion::converters::get_node_converter_for(&n->schema());
+    ASSERT_TRUE(converter(&ctx, n, args));
+  }
+
+  // ceil(log2(100)) = 7 shift and add steps
+  ASSERT_EQ(ctx.net->getNbLayers(), 14);
+  for (int32_t i = 0; i < ctx.net->getNbLayers(); i++) {
+    auto type = ctx.net->getLayer(i)->getType();
+    ASSERT_TRUE(type == nvinfer1::LayerType::kSLICE || type == nvinfer1::LayerType::kELEMENTWISE);
+  }
+}
+
+TEST(Converters, ATenCumsumLongStaticExtentConvertsCorrectly) {
+  run_cumsum_test(at::randint(-5, 5, {2, 1000}, {at::kCUDA}));
+}
+
+TEST(Converters, ATenCumsumSingleElementExtentConvertsCorrectly) {
+  run_cumsum_test(at::randint(-5, 5, {2, 1, 4}, {at::kCUDA}));
+}
+
+TEST(Converters, ATenCumsumIntConvertsCorrectly) {
+  run_cumsum_test(at::randint(-5, 5, {2, 37, 4}, {at::kCUDA}).to(at::kInt));
+}
+
+TEST(Converters, ATenCumsumStaticExtentWithDynamicBatchConvertsCorrectly) {
+  run_cumsum_test(at::randint(-5, 5, {4, 37, 4}, {at::kCUDA}), /*dynamic_batch=*/true);
+}
@@ -378,6 +378,112 @@ ATEN_INTERPOLATE_STATIC_ONLY_TEST(
       return (%7))IR",
     std::vector<int64_t>({10, 2, 2, 2, 2}));
 
+ATEN_INTERPOLATE_TESTS(
+    ATenUpsampleNearestExact1dVecScaleFactors,
+    R"IR(
+    graph(%0 : Tensor):
+      %2 : None = prim::Constant()
+      %3 : float = prim::Constant[value=2.5]()
+      %4 : float[] = prim::ListConstruct(%3)
+      %5 : Tensor = aten::_upsample_nearest_exact1d(%0, %2, %4)
+      return (%5))IR",
+    std::vector<int64_t>({10, 2, 4}));
+
+ATEN_INTERPOLATE_TESTS(
+    ATenUpsampleNearestExact2dOutputSize,
+    R"IR(
+    graph(%0 : Tensor):
+      %2 : int = prim::Constant[value=7]()
+      %3 : int[] = prim::ListConstruct(%2, %2)
+      %4 : None = prim::Constant()
+      %5 : Tensor = aten::_upsample_nearest_exact2d(%0, %3, %4, %4)
+      return (%5))IR",
+    std::vector<int64_t>({10, 2, 3, 3}));
+
+ATEN_INTERPOLATE_TESTS(
+    ATenUpsampleNearestExact3dScales,
+    R"IR(
+    graph(%0 : Tensor):
+      %2 : int = prim::Constant[value=6]()
+      %3 : int[] = prim::ListConstruct(%2, %2, %2)
+      %4 : float = prim::Constant[value=3.0]()
+      %5 : Tensor = aten::_upsample_nearest_exact3d(%0, %3, %4, %4, %4)
+      return (%5))IR",
+    std::vector<int64_t>({10, 2, 2, 2, 2}));
+
+ATEN_INTERPOLATE_TESTS(
+    ATenUpsampleBicubic2dOutputSizeWithoutAlignCorners,
+    R"IR(
+    graph(%0 : Tensor):
+      %2 : int = prim::Constant[value=10]()
+      %3 : int[] = prim::ListConstruct(%2, %2)
+      %4 : bool = prim::Constant[value=0]()
+      %5 : None = prim::Constant()
+      %6 : Tensor = aten::upsample_bicubic2d(%0, %3, %4, %5, %5)
+      return (%6))IR",
+    std::vector<int64_t>({10, 2, 4, 4}));
+
+ATEN_INTERPOLATE_TESTS(
+    ATenUpsampleBicubic2dOutputSizeWithAlignCorners,
+    R"IR(
+    graph(%0 : Tensor):
+      %2 : int = prim::Constant[value=10]()
+      %3 : int[] = prim::ListConstruct(%2, %2)
+      %4 : bool = prim::Constant[value=1]()
+      %5 : None = prim::Constant()
+      %6 : Tensor = aten::upsample_bicubic2d(%0, %3, %4, %5, %5)
+      return (%6))IR",
+    std::vector<int64_t>({10, 2, 4, 4}));
+
+ATEN_INTERPOLATE_TESTS(
+    ATenUpsampleBicubic2dVecScaleFactorsWithoutAlignCorners,
+    R"IR(
+    graph(%0 : Tensor):
+      %3 : None = prim::Constant()
+      %4 : bool = prim::Constant[value=0]()
+      %5 : float = prim::Constant[value=2.0]()
+      %6 : float[] = prim::ListConstruct(%5, %5)
+      %7 : Tensor = aten::upsample_bicubic2d(%0, %3, %4, %6)
+      return (%7))IR",
+    std::vector<int64_t>({10, 2, 4, 4}));
+
+// Without shrinking, antialiased bilinear interpolation is plain bilinear interpolation and stays in the resize layer
+ATEN_INTERPOLATE_TESTS(
+    ATenUpsampleBilinear2dAAUpsampling,
+    R"IR(
+    graph(%0 : Tensor):
+      %2 : int = prim::Constant[value=10]()
+      %3 : int[] = prim::ListConstruct(%2, %2)
+      %4 : bool = prim::Constant[value=0]()
+      %5 : None = prim::Constant()
+      %6 : Tensor = aten::_upsample_bilinear2d_aa(%0, %3, %4, %5, %5)
+      return (%6))IR",
+    std::vector<int64_t>({10, 2, 4, 4}));
+
+ATEN_INTERPOLATE_STATIC_ONLY_TEST(
+    ATenUpsampleBilinear2dAADownsampling,
+    R"IR(
+    graph(%0 : Tensor):
+      %2 : int = prim::Constant[value=3]()
+      %3 : int[] = prim::ListConstruct(%2, %2)
+      %4 : bool = prim::Constant[value=0]()
+      %5 : None = prim::Constant()
+      %6 : Tensor = aten::_upsample_bilinear2d_aa(%0, %3, %4, %5, %5)
+      return (%6))IR",
+    std::vector<int64_t>({10, 2, 8, 8}));
+
+ATEN_INTERPOLATE_STATIC_ONLY_TEST(
+    ATenUpsampleBilinear2dAAVecScaleFactorsDownsampling,
+    R"IR(
+    graph(%0 : Tensor):
+      %3 : None = prim::Constant()
+      %4 : bool = prim::Constant[value=0]()
+      %5 : float = prim::Constant[value=0.5]()
+      %6 : float[] = prim::ListConstruct(%5, %5)
+      %7 : Tensor = aten::_upsample_bilinear2d_aa(%0, %3, %4, %6)
+      return (%7))IR",
+    std::vector<int64_t>({10, 2, 8, 8}));
+
 TEST(Converters, GridSampleConvertsCorrectly) {
   const auto graph = R"IR(
         graph(%input : Tensor, %grid : Tensor):
@@ -0,0 +1,183 @@
+#include <sstream>
+#include <string>
+#include "core/compiler.h"
+#include "core/conversion/converters/converter_util.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+namespace {
+// Flat params list in the order aten::lstm / aten::gru expect: w_ih, w_hh[, b_ih, b_hh] per layer and direction
+std::vector<at::Tensor> make_params(
+    int64_t gates,
+    int64_t input_size,
+    int64_t hidden,
+    int64_t num_layers,
+    bool bidirectional,
+    bool has_biases,
+    at::TensorOptions options = {}) {
+  int64_t num_directions = bidirectional ? 2 : 1;
+  std::vector<at::Tensor> params;
+  for (int64_t l = 0; l < num_layers; l++) {
+    auto layer_input = l == 0 ? input_size : hidden * num_directions;
+    for (int64_t d = 0; d < num_directions; d++) {
+      params.push_back(at::randn({gates * hidden, layer_input}, options) * 0.3);
+      params.push_back(at::randn({gates * hidden, hidden}, options) * 0.3);
+      if (has_biases) {
+        params.push_back(at::randn({gates * hidden}, options) * 0.3);
+        params.push_back(at::randn({gates * hidden}, options) * 0.3);
+      }
+    }
+  }
+  return params;
+}
+
+// Graph calling aten::lstm / aten::gru with the weights as static parameters
+std::string rnn_graph(
+    const std::vector<at::Tensor>& params,
+    bool gru,
+    int64_t num_layers,
+    bool bidirectional,
+    bool batch_first,
+    bool has_biases) {
+  std::stringstream ir;
+  ir << "graph(%x : Tensor, %h0 : Tensor" << (gru ? "" : ", %c0 : Tensor");
+  for (size_t i = 0; i < params.size(); i++) {
+    ir << ", %p" << i << " : Float(";
+    for (int64_t d = 0; d < params[i].dim(); d++) {
+      ir << (d ? ", " : "") << params[i].size(d);
+    }
+    ir << ", strides=[";
+    for (int64_t d = 0; d < params[i].dim(); d++) {
+      ir << (d ? ", " : "") << params[i].stride(d);
+    }
+    ir << "])";
+  }
+  ir << "):\n";
+  ir << "  %has_biases : bool = prim::Constant[value=" << has_biases << "]()\n";
+  ir << "  %num_layers : int = prim::Constant[value=" << num_layers << "]()\n";
+  ir << "  %dropout : float = prim::Constant[value=0.]()\n";
+  ir << "  %train : bool = prim::Constant[value=0]()\n";
+  ir << "  %bidirectional : bool = prim::Constant[value=" << bidirectional << "]()\n";
+  ir << "  %batch_first : bool = prim::Constant[value=" << batch_first << "]()\n";
+  ir << "  %params : Tensor[] = prim::ListConstruct(";
+  for (size_t i = 0; i < params.size(); i++) {
+    ir << (i ? ", " : "") << "%p" << i;
+  }
+  ir << ")\n";
+  if (gru) {
+    ir << "  %y : Tensor, %h_n : Tensor = aten::gru(%x, %h0, %params, %has_biases, %num_layers, %dropout, %train, "
+          "%bidirectional, %batch_first)\n";
+    ir << "  return (%y, %h_n)";
+  } else {
+    ir << "  %hx : Tensor[] = prim::ListConstruct(%h0, %c0)\n";
+    ir << "  %y : Tensor, %h_n : Tensor, %c_n : Tensor = aten::lstm(%x, %hx, %params, %has_biases, %num_layers, "
+          "%dropout, %train, %bidirectional, %batch_first)\n";
+    ir << "  return (%y, %h_n, %c_n)";
+  }
+  return ir.str();
+}
+
+void run_rnn_test(bool gru, int64_t num_layers, bool bidirectional, bool batch_first, bool has_biases) {
+  int64_t seq = 7, batch = 3, input_size = 10, hidden = 16;
+  int64_t num_directions = bidirectional ? 2 : 1;
+  auto params = make_params(gru ? 3 : 4, input_size, hidden, num_layers, bidirectional, has_biases, {at::kCUDA});
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(rnn_graph(params, gru, num_layers, bidirectional, batch_first, has_biases), g.get());
+
+  auto x = batch_first ? at::randn({batch, seq, input_size}, {at::kCUDA})
+                       : at::randn({seq, batch, input_size}, {at::kCUDA});
+  auto h0 = at::randn({num_layers * num_directions, batch, hidden}, {at::kCUDA});
+  auto c0 = at::randn({num_layers * num_directions, batch, hidden}, {at::kCUDA});
+  std::vector<at::Tensor> inputs = {x, h0};
+  if (!gru) {
+    inputs.push_back(c0);
+  }
+  std::vector<torch::jit::IValue> static_params(params.begin(), params.end());
+
+  auto jit_params = torch_tensorrt::core::ir::get_static_params(g->inputs(), static_params);
+  auto jit_results = torch_tensorrt::tests::util::RunGraph(g, jit_params, inputs);
+
+  auto trt_params = torch_tensorrt::core::ir::get_static_params(g->inputs(), static_params);
+  auto trt_results = torch_tensorrt::tests::util::RunGraphEngine(g, trt_params, inputs);
+
+  ASSERT_EQ(jit_results.size(), trt_results.size());
+  for (size_t i = 0; i < jit_results.size(); i++) {
+    ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results[i], trt_results[i].reshape_as(jit_results[i])))
+        << "output " << i;
+  }
+}
+} // namespace
+
+TEST(Converters, PackRNNWeightsFoldsLSTMBiases) {
+  auto params = make_params(4, 10, 16, 2, true, true);
+  auto packed = torch_tensorrt::core::conversion::converters::packRNNWeights(params, true, 2, true, false);
+
+  ASSERT_EQ(packed.size(), 4);
+  for (size_t i = 0; i < packed.size(); i++) {
+    auto input_size = i < 2 ? 10 : 32;
+    ASSERT_EQ(packed[i].w_ih.sizes().vec(), (std::vector<int64_t>{input_size, 64}));
+    ASSERT_EQ(packed[i].w_hh.sizes().vec(), (std::vector<int64_t>{16, 64}));
+    ASSERT_TRUE(packed[i].w_ih.is_contiguous());
+    ASSERT_TRUE(at::equal(packed[i].w_ih, params[4 * i].t()));
+    ASSERT_TRUE(at::equal(packed[i].w_hh, params[4 * i + 1].t()));
+    ASSERT_TRUE(at::allclose(packed[i].bias, params[4 * i + 2] + params[4 * i + 3]));
+    ASSERT_FALSE(packed[i].hidden_bias_n.defined());
+  }
+}
+
+TEST(Converters, PackRNNWeightsKeepsGRUNewGateHiddenBias) {
+  auto params = make_params(3, 10, 16, 1, false, true);
+  auto packed = torch_tensorrt::core::conversion::converters::packRNNWeights(params, true, 1, false, true);
+
+  ASSERT_EQ(packed.size(), 1);
+  auto b_ih = params[2];
+  auto b_hh = params[3];
+  ASSERT_TRUE(at::allclose(packed[0].bias.slice(0, 0, 32), b_ih.slice(0, 0, 32) + b_hh.slice(0, 0, 32)));
+  ASSERT_TRUE(at::equal(packed[0].bias.slice(0, 32), b_ih.slice(0, 32)));
+  ASSERT_TRUE(at::equal(packed[0].hidden_bias_n, b_hh.slice(0, 32)));
+}
+
+TEST(Converters, PackRNNWeightsWithoutBiases) {
+  auto params = make_params(3, 10, 16, 1, true, false);
+  auto packed = torch_tensorrt::core::conversion::converters::packRNNWeights(params, false, 1, true, true);
+
+  ASSERT_EQ(packed.size(), 2);
+  for (auto& p : packed) {
+    ASSERT_TRUE(at::equal(p.bias, at::zeros({48})));
+    ASSERT_TRUE(at::equal(p.hidden_bias_n, at::zeros({16})));
+  }
+}
+
+TEST(Converters, PackRNNWeightsRejectsProjections) {
+  // LSTMs with proj_size carry a fifth weight (w_hr) per direction
+  auto params = make_params(4, 10, 16, 1, false, true);
+  params.push_back(at::randn({8, 16}));
+  EXPECT_THROW(
+      torch_tensorrt::core::conversion::converters::packRNNWeights(params, true, 1, false, false), std::exception);
+}
+
+TEST(Converters, ATenLSTMConvertsCorrectly) {
+  run_rnn_test(/*gru=*/false, /*num_layers=*/1, /*bidirectional=*/false, /*batch_first=*/false, /*has_biases=*/true);
+}
+
+TEST(Converters, ATenLSTMMultiLayerBidirectionalBatchFirstConvertsCorrectly) {
+  run_rnn_test(/*gru=*/false, /*num_layers=*/2, /*bidirectional=*/true, /*batch_first=*/true, /*has_biases=*/true);
+}
+
+TEST(Converters, ATenLSTMWithoutBiasConvertsCorrectly) {
+  run_rnn_test(/*gru=*/false, /*num_layers=*/2, /*bidirectional=*/false, /*batch_first=*/false, /*has_biases=*/false);
+}
+
+TEST(Converters, ATenGRUConvertsCorrectly) {
+  run_rnn_test(/*gru=*/true, /*num_layers=*/1, /*bidirectional=*/false, /*batch_first=*/false, /*has_biases=*/true);
+}
+
+TEST(Converters, ATenGRUMultiLayerBidirectionalBatchFirstConvertsCorrectly) {
+  run_rnn_test(/*gru=*/true, /*num_layers=*/2, /*bidirectional=*/true, /*batch_first=*/true, /*has_biases=*/true);
+}
+
+TEST(Converters, ATenGRUWithoutBiasConvertsCorrectly) {
+  run_rnn_test(/*gru=*/true, /*num_layers=*/1, /*bidirectional=*/true, /*batch_first=*/false, /*has_biases=*/false);
+}
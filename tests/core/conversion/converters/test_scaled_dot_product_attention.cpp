@@ -88,3 +88,189 @@ TEST(Converters, ATenScaledDotProductAttnMaskIntConvertsCorrectly) {
 
   ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results[0], trt_results[0]));
 }
+
+TEST(Converters, ATenScaledDotProductAttnMaskBoolConvertsCorrectly) {
+  const auto graph = R"IR(
+      graph(%query : Tensor, %key : Tensor, %value : Tensor, %attn_mask : Tensor):
+        %0 : float = prim::Constant[value=0.]()
+        %false : bool = prim::Constant[value=0]()
+        %scale : NoneType = prim::Constant()
+        %enable_gqa : bool = prim::Constant[value=0]()
+        %3 : Tensor = aten::scaled_dot_product_attention(%query, %key, %value, %attn_mask, %0, %false, %scale, %enable_gqa)
+        return (%3))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, &*g);
+
+  auto query = at::rand({32, 8, 128, 64}, {at::kCUDA});
+  auto key = at::rand({32, 8, 128, 64}, {at::kCUDA});
+  auto value = at::rand({32, 8, 128, 64}, {at::kCUDA});
+  // Keep the diagonal so that no row is fully masked
+  auto diagonal = at::eye(128, {at::kCUDA}).to(at::kBool);
+  auto attn_mask = at::logical_or(at::rand({32, 8, 128, 128}, {at::kCUDA}) > 0.5, diagonal);
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto jit_results = torch_tensorrt::tests::util::RunGraph(g, params, {query, key, value, attn_mask});
+
+  torch_tensorrt::core::lowering::passes::UnpackScaledDotProductAttention(g);
+
+  params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto trt_results = torch_tensorrt::tests::util::RunGraphEngine(g, params, {query, key, value, attn_mask});
+
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results[0], trt_results[0]));
+}
+
+TEST(Converters, ATenScaledDotProductAttnMaskBoolHalfConvertsCorrectly) {
+  // The bias built from a boolean mask has to match FP16 attention weights, in the engine and in torch fallback
+  const auto graph = R"IR(
+      graph(%query : Tensor, %key : Tensor, %value : Tensor, %attn_mask : Tensor):
+        %0 : float = prim::Constant[value=0.]()
+        %false : bool = prim::Constant[value=0]()
+        %scale : NoneType = prim::Constant()
+        %enable_gqa : bool = prim::Constant[value=0]()
+        %3 : Tensor = aten::scaled_dot_product_attention(%query, %key, %value, %attn_mask, %0, %false, %scale, %enable_gqa)
+        return (%3))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, &*g);
+
+  auto query = at::rand({4, 8, 128, 64}, {at::kCUDA}).to(at::kHalf);
+  auto key = at::rand({4, 8, 128, 64}, {at::kCUDA}).to(at::kHalf);
+  auto value = at::rand({4, 8, 128, 64}, {at::kCUDA}).to(at::kHalf);
+  // Keep the diagonal so that no row is fully masked
+  auto diagonal = at::eye(128, {at::kCUDA}).to(at::kBool);
+  auto attn_mask = at::logical_or(at::rand({4, 8, 128, 128}, {at::kCUDA}) > 0.5, diagonal);
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto jit_results = torch_tensorrt::tests::util::RunGraph(g, params, {query, key, value, attn_mask});
+
+  torch_tensorrt::core::lowering::passes::UnpackScaledDotProductAttention(g);
+
+  params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto fallback_results = torch_tensorrt::tests::util::RunGraph(g, params, {query, key, value, attn_mask});
+  ASSERT_EQ(fallback_results[0].scalar_type(), at::kHalf);
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results[0], fallback_results[0], 2e-2));
+
+  params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto trt_results = torch_tensorrt::tests::util::RunGraphEngine(
+      g, params, {query, key, value, attn_mask}, nvinfer1::DataType::kHALF);
+
+  ASSERT_EQ(trt_results[0].scalar_type(), at::kHalf);
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results[0], trt_results[0], 2e-2));
+}
+
+TEST(Converters, ATenScaledDotProductAttnIsCausalConvertsCorrectly) {
+  const auto graph = R"IR(
+      graph(%query : Tensor, %key : Tensor, %value : Tensor):
+        %none : NoneType = prim::Constant()
+        %0 : float = prim::Constant[value=0.]()
+        %true : bool = prim::Constant[value=1]()
+        %scale : NoneType = prim::Constant()
+        %enable_gqa : bool = prim::Constant[value=0]()
+        %3 : Tensor = aten::scaled_dot_product_attention(%query, %key, %value, %none, %0, %true, %scale, %enable_gqa)
+        return (%3))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, &*g);
+
+  auto query = at::rand({32, 8, 128, 64}, {at::kCUDA});
+  auto key = at::rand({32, 8, 128, 64}, {at::kCUDA});
+  auto value = at::rand({32, 8, 128, 64}, {at::kCUDA});
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto jit_results = torch_tensorrt::tests::util::RunGraph(g, params, {query, key, value});
+
+  torch_tensorrt::core::lowering::passes::UnpackScaledDotProductAttention(g);
+  for (auto n : g->nodes()) {
+    ASSERT_NE(n->kind(), c10::Symbol::fromQualString("aten::scaled_dot_product_attention"));
+  }
+
+  params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto trt_results = torch_tensorrt::tests::util::RunGraphEngine(g, params, {query, key, value});
+
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results[0], trt_results[0]));
+}
+
+TEST(Converters, ATenScaledDotProductAttnIsCausalDynamicConvertsCorrectly) {
+  const auto graph = R"IR(
+      graph(%query : Tensor, %key : Tensor, %value : Tensor):
+        %none : NoneType = prim::Constant()
+        %0 : float = prim::Constant[value=0.]()
+        %true : bool = prim::Constant[value=1]()
+        %scale : NoneType = prim::Constant()
+        %enable_gqa : bool = prim::Constant[value=0]()
+        %3 : Tensor = aten::scaled_dot_product_attention(%query, %key, %value, %none, %0, %true, %scale, %enable_gqa)
+        return (%3))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, &*g);
+
+  auto query = at::rand({4, 8, 64, 32}, {at::kCUDA});
+  auto key = at::rand({4, 8, 64, 32}, {at::kCUDA});
+  auto value = at::rand({4, 8, 64, 32}, {at::kCUDA});
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto jit_results = torch_tensorrt::tests::util::RunGraph(g, params, {query, key, value});
+
+  torch_tensorrt::core::lowering::passes::UnpackScaledDotProductAttention(g);
+
+  params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto trt_results = torch_tensorrt::tests::util::RunGraphEngineDynamic(g, params, {query, key, value}, true);
+
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results[0], trt_results[0]));
+}
+
+TEST(Converters, ATenScaledDotProductAttnExplicitScaleConvertsCorrectly) {
+  const auto graph = R"IR(
+      graph(%query : Tensor, %key : Tensor, %value : Tensor):
+        %none : NoneType = prim::Constant()
+        %0 : float = prim::Constant[value=0.]()
+        %false : bool = prim::Constant[value=0]()
+        %scale : float = prim::Constant[value=0.25]()
+        %enable_gqa : bool = prim::Constant[value=0]()
+        %3 : Tensor = aten::scaled_dot_product_attention(%query, %key, %value, %none, %0, %false, %scale, %enable_gqa)
+        return (%3))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, &*g);
+
+  auto query = at::rand({32, 8, 128, 64}, {at::kCUDA});
+  auto key = at::rand({32, 8, 128, 64}, {at::kCUDA});
+  auto value = at::rand({32, 8, 128, 64}, {at::kCUDA});
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto jit_results = torch_tensorrt::tests::util::RunGraph(g, params, {query, key, value});
+
+  torch_tensorrt::core::lowering::passes::UnpackScaledDotProductAttention(g);
+
+  params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto trt_results = torch_tensorrt::tests::util::RunGraphEngine(g, params, {query, key, value});
+
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results[0], trt_results[0]));
+}
+
+TEST(Converters, ATenScaledDotProductAttnGQAConvertsCorrectly) {
+  const auto graph = R"IR(
+      graph(%query : Tensor, %key : Tensor, %value : Tensor):
+        %none : NoneType = prim::Constant()
+        %0 : float = prim::Constant[value=0.]()
+        %true : bool = prim::Constant[value=1]()
+        %scale : NoneType = prim::Constant()
+        %enable_gqa : bool = prim::Constant[value=1]()
+        %3 : Tensor = aten::scaled_dot_product_attention(%query, %key, %value, %none, %0, %true, %scale, %enable_gqa)
+        return (%3))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, &*g);
+
+  auto query = at::rand({4, 8, 128, 64}, {at::kCUDA});
+  auto key = at::rand({4, 2, 128, 64}, {at::kCUDA});
+  auto value = at::rand({4, 2, 128, 64}, {at::kCUDA});
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto jit_results = torch_tensorrt::tests::util::RunGraph(g, params, {query, key, value});
+
+  torch_tensorrt::core::lowering::passes::UnpackScaledDotProductAttention(g);
+  for (auto n : g->nodes()) {
+    ASSERT_NE(n->kind(), c10::Symbol::fromQualString("aten::scaled_dot_product_attention"));
+  }
+
+  params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto trt_results = torch_tensorrt::tests::util::RunGraphEngine(g, params, {query, key, value});
+
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results[0], trt_results[0]));
+}
@@ -1,5 +1,6 @@
 #include <string>
 #include "core/compiler.h"
+#include "core/conversion/evaluators/evaluators.h"
 #include "gtest/gtest.h"
 #include "tests/util/util.h"
 #include "torch/csrc/jit/ir/irparser.h"
@@ -159,4 +160,137 @@ TEST(Evaluators, PrimTupleIndexEvaluatesCorrectly) {
   auto trt_results = torch_tensorrt::tests::util::EvaluateGraph(g->block(), {});
 
   ASSERT_TRUE(jit_results[0] == trt_results[0]);
-}
\ No newline at end of file
+}
+
+TEST(Evaluators, PrimLoopEvaluatesCorrectly) {
+  const auto graph = R"IR(
+      graph(%n : int):
+        %true : bool = prim::Constant[value=1]()
+        %zero : int = prim::Constant[value=0]()
+        %l : int[] = prim::ListConstruct()
+        %sum : int, %list : int[] = prim::Loop(%n, %true, %zero, %l)
+          block0(%i : int, %acc : int, %l.1 : int[]):
+            %acc.1 : int = aten::add(%acc, %i)
+            %sq : int = aten::mul(%i, %i)
+            %l.2 : int[] = aten::append(%l.1, %sq)
+            -> (%true, %acc.1, %l.2)
+        return (%sum, %list))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+
+  auto jit_results = torch_tensorrt::tests::util::EvaluateGraphJIT(g, {500});
+  auto trt_results = torch_tensorrt::tests::util::EvaluateGraph(g->block(), {500});
+
+  ASSERT_TRUE(jit_results[0] == trt_results[0]);
+  ASSERT_EQ(jit_results[1].toIntVector(), trt_results[1].toIntVector());
+}
+
+TEST(Evaluators, PrimLoopStopsOnConditionCorrectly) {
+  const auto graph = R"IR(
+      graph(%n : int):
+        %true : bool = prim::Constant[value=1]()
+        %one : int = prim::Constant[value=1]()
+        %limit : int = prim::Constant[value=1000]()
+        %out : int = prim::Loop(%n, %true, %one)
+          block0(%i : int, %x : int):
+            %two : int = prim::Constant[value=2]()
+            %x.1 : int = aten::mul(%x, %two)
+            %cond : bool = aten::lt(%x.1, %limit)
+            -> (%cond, %x.1)
+        return (%out))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+
+  auto jit_results = torch_tensorrt::tests::util::EvaluateGraphJIT(g, {100});
+  auto trt_results = torch_tensorrt::tests::util::EvaluateGraph(g->block(), {100});
+
+  ASSERT_TRUE(jit_results[0] == trt_results[0]);
+}
+
+TEST(Evaluators, PrimLoopNestedEvaluatesCorrectly) {
+  const auto graph = R"IR(
+      graph(%n : int):
+        %true : bool = prim::Constant[value=1]()
+        %zero : int = prim::Constant[value=0]()
+        %outer : int = prim::Loop(%n, %true, %zero)
+          block0(%i : int, %acc : int):
+            %inner : int = prim::Loop(%i, %true, %acc)
+              block0(%j : int, %acc.1 : int):
+                %prod : int = aten::mul(%i, %j)
+                %acc.2 : int = aten::add(%acc.1, %prod)
+                -> (%true, %acc.2)
+            -> (%true, %inner)
+        return (%outer))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+
+  auto jit_results = torch_tensorrt::tests::util::EvaluateGraphJIT(g, {20});
+  auto trt_results = torch_tensorrt::tests::util::EvaluateGraph(g->block(), {20});
+
+  ASSERT_TRUE(jit_results[0] == trt_results[0]);
+}
+
+namespace {
+namespace evaluators = torch_tensorrt::core::conversion::evaluators;
+
+const auto kBlacklistTestKind = c10::Symbol::fromQualString("trt_test::blacklisted");
+
+auto blacklist_test_registrations = evaluators::RegisterNodeEvaluators().evaluator(
+    {kBlacklistTestKind,
+     [](torch_tensorrt::core::conversion::ConversionCtx*,
+        const torch::jit::Node*,
+        evaluators::kwargs&) -> c10::optional<torch::jit::IValue> { return torch::jit::IValue(1); },
+     evaluators::EvalOptions().blacklistOutputTypes({c10::TensorType::get()})});
+} // namespace
+
+TEST(Evaluators, EvaluatorLookupSkipsBlacklistedOutputTypes) {
+  auto g = std::make_shared<torch::jit::Graph>();
+  auto int_out = g->appendNode(g->create(kBlacklistTestKind, 1));
+  int_out->output()->setType(c10::IntType::get());
+  auto tensor_out = g->appendNode(g->create(kBlacklistTestKind, 1));
+  tensor_out->output()->setType(c10::TensorType::get());
+  // Only the blacklisted type itself matches, refined tensor types are a different type of the same kind
+  auto refined_tensor_out = g->appendNode(g->create(kBlacklistTestKind, 1));
+  refined_tensor_out->output()->setType(c10::TensorType::create(at::rand({2, 3})));
+
+  ASSERT_TRUE(evaluators::shouldEvalAtConversionTime(int_out));
+  ASSERT_FALSE(evaluators::shouldEvalAtConversionTime(tensor_out));
+  ASSERT_TRUE(evaluators::shouldEvalAtConversionTime(refined_tensor_out));
+}
+
+TEST(Evaluators, EvaluatorLookupIsStableAcrossRepeatedSchemas) {
+  const auto graph = R"IR(
+      graph(%x : Tensor, %a : int):
+        %one : int = prim::Constant[value=1]()
+        %b : int = aten::add(%a, %one)
+        %y : Tensor = aten::add(%x, %x, %one)
+        %c : int = aten::add(%b, %one)
+        %z : Tensor = aten::add(%y, %y, %one)
+        return (%c, %z))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+
+  std::vector<torch::jit::Node*> int_adds, tensor_adds;
+  for (auto n : g->nodes()) {
+    if (n->kind() == torch::jit::aten::add) {
+      (n->output()->type()->kind() == c10::TypeKind::IntType ? int_adds : tensor_adds).push_back(n);
+    }
+  }
+  ASSERT_EQ(int_adds.size(), 2);
+  ASSERT_EQ(tensor_adds.size(), 2);
+
+  // The second round of lookups is answered from the schema cache and has to agree with the first
+  for (int round = 0; round < 2; round++) {
+    for (auto n : int_adds) {
+      ASSERT_TRUE(evaluators::shouldEvalAtConversionTime(n));
+    }
+    for (auto n : tensor_adds) {
+      ASSERT_FALSE(evaluators::shouldEvalAtConversionTime(n));
+    }
+  }
+  ASSERT_EQ(&evaluators::getEvaluator(int_adds[0]), &evaluators::getEvaluator(int_adds[1]));
+}
@@ -0,0 +1,120 @@
+#include <limits>
+#include <string>
+#include "core/compiler.h"
+#include "core/conversion/converters/converter_util.h"
+#include "core/conversion/converters/converters.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+#include "torch/torch.h"
+
+namespace conversion = torch_tensorrt::core::conversion;
+namespace converters = torch_tensorrt::core::conversion::converters;
+
+TEST(ConstantPool, IdenticalScalarsShareOneLayer) {
+  conversion::ConversionCtx ctx(conversion::BuilderSettings{});
+
+  auto first = converters::tensor_to_const(&ctx, torch::tensor({0.5f}));
+  auto second = converters::tensor_to_const(&ctx, torch::tensor({0.5f}), "named");
+  auto third = converters::scalar_to_tensor(&ctx, at::Scalar(0.5));
+
+  ASSERT_EQ(first, second);
+  ASSERT_EQ(first, third);
+  ASSERT_EQ(ctx.net->getNbLayers(), 1);
+}
+
+TEST(ConstantPool, KeysOnTypeShapeAndContents) {
+  conversion::ConversionCtx ctx(conversion::BuilderSettings{});
+
+  converters::tensor_to_const(&ctx, torch::tensor({1.0f}));
+  converters::tensor_to_const(&ctx, torch::tensor({1}, torch::kInt32));
+  converters::tensor_to_const(&ctx, torch::tensor({1.0f, 1.0f}));
+  converters::tensor_to_const(&ctx, torch::ones({1, 1}));
+  converters::tensor_to_const(&ctx, torch::tensor({-std::numeric_limits<float>::infinity()}));
+  ASSERT_EQ(ctx.net->getNbLayers(), 5);
+
+  converters::tensor_to_const(&ctx, torch::tensor({1.0f}));
+  converters::tensor_to_const(&ctx, torch::tensor({1}, torch::kInt32));
+  converters::tensor_to_const(&ctx, torch::tensor({1.0f, 1.0f}));
+  converters::tensor_to_const(&ctx, torch::ones({1, 1}));
+  converters::tensor_to_const(&ctx, torch::tensor({-std::numeric_limits<float>::infinity()}));
+  ASSERT_EQ(ctx.net->getNbLayers(), 5);
+}
+
+TEST(ConstantPool, PoolsBoolConstantsAfterTheirCast) {
+  conversion::ConversionCtx ctx(conversion::BuilderSettings{});
+
+  auto first = converters::tensor_to_const(&ctx, torch::tensor({true, false}));
+  auto layers = ctx.net->getNbLayers();
+  auto second = converters::tensor_to_const(&ctx, torch::tensor({true, false}));
+
+  ASSERT_EQ(first, second);
+  ASSERT_EQ(first->getType(), nvinfer1::DataType::kBOOL);
+  ASSERT_EQ(ctx.net->getNbLayers(), layers);
+}
+
+TEST(ConstantPool, LargeConstantsAreNotPooled) {
+  conversion::ConversionCtx ctx(conversion::BuilderSettings{});
+
+  auto weights = torch::randn({256});
+  auto first = converters::tensor_to_const(&ctx, weights);
+  auto second = converters::tensor_to_const(&ctx, weights);
+
+  ASSERT_NE(first, second);
+  ASSERT_EQ(ctx.net->getNbLayers(), 2);
+}
+
+TEST(ConstantPool, RepeatedScalarOperandsConvertToOneConstant) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor):
+        %half : float = prim::Constant[value=0.5]()
+        %1 : Tensor = aten::mul(%0, %half)
+        %2 : Tensor = aten::mul(%1, %half)
+        %3 : Tensor = aten::mul(%2, %half)
+        return (%3))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+
+  conversion::ConversionCtx ctx(conversion::BuilderSettings{});
+  auto in =
+      ctx.net->addInput("x", nvinfer1::DataType::kFLOAT, torch_tensorrt::core::util::toDims(std::vector<int64_t>{8}));
+  auto half = c10::IValue(0.5);
+  for (auto n : g->nodes()) {
+    if (n->kind() != torch::jit::aten::mul) {
+      continue;
+    }
+    converters::args args = {in, &half};
+    auto converter = converters::get_node_converter_for(&n->schema());
+    ASSERT_TRUE(converter(&ctx, n, args));
+    in = ctx.value_tensor_map[n->output()];
+  }
+
+  // One constant shared by the three multiplications
+  ASSERT_EQ(ctx.net->getNbLayers(), 4);
+}
+
+TEST(ConstantPool, RepeatedScalarOperandsConvertCorrectly) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor):
+        %one : int = prim::Constant[value=1]()
+        %half : float = prim::Constant[value=0.5]()
+        %1 : Tensor = aten::mul(%0, %half)
+        %2 : Tensor = aten::add(%1, %half, %one)
+        %3 : Tensor = aten::mul(%2, %half)
+        %4 : Tensor = aten::add(%3, %half, %one)
+        return (%2, %4))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+
+  auto in = at::randn({4, 3, 8}, {at::kCUDA});
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto jit_results = torch_tensorrt::tests::util::RunGraph(g, params, {in});
+  auto trt_results = torch_tensorrt::tests::util::RunGraphEngine(g, params, {in});
+
+  ASSERT_EQ(jit_results.size(), trt_results.size());
+  for (size_t i = 0; i < jit_results.size(); i++) {
+    ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results[i], trt_results[i].reshape_as(jit_results[i])));
+  }
+}
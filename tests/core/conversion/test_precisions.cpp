@@ -0,0 +1,98 @@
+#include <cstring>
+#include <string>
+#include <cuda_runtime.h>
+#include "core/compiler.h"
+#include "core/conversion/converters/Weights.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+#include "torch/torch.h"
+
+namespace conversion = torch_tensorrt::core::conversion;
+namespace ir = torch_tensorrt::core::ir;
+namespace util = torch_tensorrt::core::util;
+
+namespace {
+int computeCapability() {
+  int device = 0;
+  int major = 0;
+  int minor = 0;
+  cudaGetDevice(&device);
+  cudaDeviceGetAttribute(&major, cudaDevAttrComputeCapabilityMajor, device);
+  cudaDeviceGetAttribute(&minor, cudaDevAttrComputeCapabilityMinor, device);
+  return major * 10 + minor;
+}
+} // namespace
+
+TEST(Precisions, BF16AndFP8MapBetweenTorchAndTensorRT) {
+  ASSERT_EQ(util::ScalarTypeToTRTDataType(at::kBFloat16), nvinfer1::DataType::kBF16);
+  ASSERT_EQ(util::TRTDataTypeToScalarType(nvinfer1::DataType::kBF16), at::kBFloat16);
+  ASSERT_EQ(util::ScalarTypeToTRTDataType(at::kFloat8_e4m3fn), nvinfer1::DataType::kFP8);
+  ASSERT_EQ(util::TRTDataTypeToScalarType(nvinfer1::DataType::kFP8), at::kFloat8_e4m3fn);
+}
+
+TEST(Precisions, BF16InputsAreLinearOnly) {
+  auto input = ir::Input({1, 3, 16, 16}, at::kBFloat16);
+  ASSERT_EQ(input.dtype, at::kBFloat16);
+
+  auto range = ir::Input({1, 3, 16, 16}, {4, 3, 16, 16}, {8, 3, 16, 16}, at::kBFloat16);
+  ASSERT_EQ(range.dtype, at::kBFloat16);
+
+  EXPECT_THROW(ir::Input({1, 3, 16, 16}, at::kBFloat16, nvinfer1::TensorFormat::kHWC), std::exception);
+}
+
+TEST(Precisions, FP8IsNotAnInputType) {
+  // TensorRT only produces and consumes FP8 inside the network through Q/DQ layers
+  EXPECT_THROW(ir::Input({1, 3, 16, 16}, at::kFloat8_e4m3fn), std::exception);
+}
+
+TEST(Precisions, BF16WeightsKeepTheirType) {
+  conversion::BuilderSettings settings;
+  settings.enabled_precisions = {nvinfer1::DataType::kFLOAT};
+  conversion::ConversionCtx ctx(settings);
+
+  auto t = at::randn({8, 3, 3, 3}).to(at::kBFloat16);
+  auto w = conversion::converters::Weights(&ctx, t);
+  ASSERT_EQ(w.data.type, nvinfer1::DataType::kBF16);
+  ASSERT_EQ(w.data.count, t.numel());
+  ASSERT_EQ(std::memcmp(w.data.values, t.data_ptr(), t.nbytes()), 0);
+  ASSERT_EQ(ctx.builder_resource_bytes, t.nbytes());
+
+  // Only FP32 layer parameters are narrowed, and only to FP16
+  ASSERT_EQ(ctx.ParameterWeightType(at::kBFloat16), at::kBFloat16);
+}
+
+TEST(Precisions, ParametersPastTheHalfRangeAreNotNarrowed) {
+  conversion::BuilderSettings settings;
+  settings.enabled_precisions = {nvinfer1::DataType::kHALF};
+  conversion::ConversionCtx ctx(settings);
+
+  ASSERT_EQ(ctx.ParameterWeightType(at::kFloat, {at::randn({16})}), at::kHalf);
+  ASSERT_EQ(ctx.ParameterWeightType(at::kFloat, {at::randn({16}), at::full({4}, 65504.0)}), at::kHalf);
+  ASSERT_EQ(ctx.ParameterWeightType(at::kFloat, {at::randn({16}), at::full({4}, -7e4)}), at::kFloat);
+  ASSERT_EQ(ctx.ParameterWeightType(at::kFloat, {at::empty({0})}), at::kHalf);
+}
+
+TEST(Precisions, ConvertsBF16Graph) {
+  if (computeCapability() < 80) {
+    GTEST_SKIP() << "BF16 requires compute capability 8.0+";
+  }
+  const auto graph = R"IR(
+      graph(%0 : Tensor, %1 : Tensor):
+        %2 : Tensor = aten::matmul(%0, %1)
+        %3 : Tensor = aten::relu(%2)
+        return (%3))IR";
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+
+  auto a = at::randn({16, 32}, {at::kCUDA}).to(at::kBFloat16);
+  auto b = at::randn({32, 8}, {at::kCUDA}).to(at::kBFloat16);
+
+  auto params = ir::get_static_params(g->inputs(), {});
+  auto jit_results = torch_tensorrt::tests::util::RunGraph(g, params, {a, b});
+  auto trt_results = torch_tensorrt::tests::util::RunGraphEngine(g, params, {a, b}, nvinfer1::DataType::kBF16);
+
+  ASSERT_EQ(trt_results[0].scalar_type(), at::kBFloat16);
+  ASSERT_TRUE(torch_tensorrt::tests::util::cosineSimEqual(
+      jit_results[0].to(at::kFloat), trt_results[0].reshape_as(jit_results[0]).to(at::kFloat)));
+}
@@ -0,0 +1,101 @@
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+#include "core/compiler.h"
+#include "core/conversion/conversionctx/TimingCache.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+#include "torch/torch.h"
+
+namespace conversion = torch_tensorrt::core::conversion;
+
+namespace {
+std::string tempPath(const std::string& name) {
+  auto path = testing::TempDir() + "/" + name;
+  std::remove(path.c_str());
+  return path;
+}
+
+std::string buildEngine(const std::shared_ptr<conversion::TimingCache>& cache) {
+  const auto graph = R"IR(
+      graph(%0 : Tensor, %1 : Tensor):
+        %2 : Tensor = aten::matmul(%0, %1)
+        %3 : Tensor = aten::relu(%2)
+        return (%3))IR";
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  std::vector<torch_tensorrt::core::ir::Input> specs = {
+      torch_tensorrt::core::ir::Input({16, 32}), torch_tensorrt::core::ir::Input({32, 8})};
+  auto info = conversion::ConversionInfo();
+  info.inputs = torch_tensorrt::core::ir::associate_specs_with_inputs(g, specs, params);
+  info.engine_settings.timing_cache = cache;
+  return conversion::ConvertBlockToEngine(g->block(), info, params);
+}
+} // namespace
+
+TEST(TimingCache, ReadMissingFileIsEmpty) {
+  ASSERT_TRUE(conversion::ReadFileIfExists(tempPath("does_not_exist.cache")).empty());
+}
+
+TEST(TimingCache, WriteFileAtomicallyReplacesContents) {
+  auto path = tempPath("atomic_write.cache");
+  conversion::WriteFileAtomically(path, std::string("first\0with nul", 14));
+  ASSERT_EQ(conversion::ReadFileIfExists(path), std::string("first\0with nul", 14));
+  conversion::WriteFileAtomically(path, "second");
+  ASSERT_EQ(conversion::ReadFileIfExists(path), "second");
+}
+
+TEST(TimingCache, FileLockSerializesReadModifyWrite) {
+  auto path = tempPath("locked_counter.cache");
+  conversion::WriteFileAtomically(path, "0");
+
+  auto increment = [&path]() {
+    for (int i = 0; i < 100; i++) {
+      conversion::FileLock lock(path);
+      auto count = std::stoi(conversion::ReadFileIfExists(path));
+      conversion::WriteFileAtomically(path, std::to_string(count + 1));
+    }
+  };
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back(increment);
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  ASSERT_EQ(conversion::ReadFileIfExists(path), "400");
+}
+
+TEST(TimingCache, CacheIsSharedAcrossBuildsAndPersisted) {
+  auto path = tempPath("shared.cache");
+  auto cache = std::make_shared<conversion::TimingCache>(path);
+
+  // Nothing is written until an engine has been built
+  cache->Persist();
+  ASSERT_TRUE(conversion::ReadFileIfExists(path).empty());
+
+  ASSERT_FALSE(buildEngine(cache).empty());
+  ASSERT_FALSE(buildEngine(cache).empty());
+  cache->Persist();
+  auto saved = conversion::ReadFileIfExists(path);
+  ASSERT_FALSE(saved.empty());
+
+  // A later compilation starts from the saved cache and merges with the file instead of replacing it
+  auto reloaded = std::make_shared<conversion::TimingCache>(path);
+  ASSERT_FALSE(buildEngine(reloaded).empty());
+  reloaded->Persist();
+  ASSERT_GE(conversion::ReadFileIfExists(path).size(), saved.size());
+}
+
+TEST(TimingCache, CorruptCacheIsReplaced) {
+  auto path = tempPath("corrupt.cache");
+  conversion::WriteFileAtomically(path, "not a timing cache");
+  auto cache = std::make_shared<conversion::TimingCache>(path);
+  ASSERT_FALSE(buildEngine(cache).empty());
+  cache->Persist();
+  ASSERT_NE(conversion::ReadFileIfExists(path), "not a timing cache");
+}
@@ -0,0 +1,166 @@
+#include <string>
+#include "core/compiler.h"
+#include "core/lowering/passes/passes.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/constants.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+namespace {
+// Replaces every graph input after the first with a constant, as freezing would
+void freezeParams(std::shared_ptr<torch::jit::Graph>& g, std::vector<at::Tensor> params) {
+  torch::jit::WithInsertPoint guard(g->nodes().front());
+  for (size_t i = 0; i < params.size(); i++) {
+    auto c = g->insertConstant(params[i]);
+    g->inputs()[i + 1]->replaceAllUsesWith(c);
+  }
+  for (size_t i = params.size(); i > 0; i--) {
+    g->eraseInput(i);
+  }
+}
+
+size_t countNodes(std::shared_ptr<torch::jit::Graph>& g, torch::jit::NodeKind kind) {
+  size_t count = 0;
+  for (auto n : g->nodes()) {
+    if (n->kind() == kind) {
+      count++;
+    }
+  }
+  return count;
+}
+
+void checkFoldMatchesReference(
+    const std::string& graph_ir,
+    std::vector<at::Tensor> params,
+    at::Tensor in,
+    torch::jit::NodeKind folded_into) {
+  torch_tensorrt::core::util::logging::get_logger().set_reportable_log_level(
+      torch_tensorrt::core::util::logging::LogLevel::kGRAPH);
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph_ir, g.get());
+  freezeParams(g, params);
+
+  torch_tensorrt::core::ir::StaticParams empty_params;
+  auto ref = g->copy();
+  auto jit_results = torch_tensorrt::tests::util::RunGraph(ref, empty_params, {in});
+
+  torch_tensorrt::core::lowering::passes::FoldBatchNorm(g);
+  ASSERT_EQ(countNodes(g, torch::jit::aten::batch_norm), 0);
+  ASSERT_EQ(countNodes(g, folded_into), 1);
+
+  auto folded_results = torch_tensorrt::tests::util::RunGraph(g, empty_params, {in});
+  ASSERT_TRUE(torch_tensorrt::tests::util::almostEqual(jit_results[0], folded_results[0], 2e-5));
+}
+
+std::vector<at::Tensor> bnParams(int64_t channels) {
+  auto gamma = at::rand({channels}) + 0.5;
+  auto beta = at::randn({channels});
+  auto mean = at::randn({channels});
+  auto var = at::rand({channels}) + 0.1;
+  return {gamma, beta, mean, var};
+}
+} // namespace
+
+TEST(LoweringPasses, FoldBatchNormIntoConv2d) {
+  std::string graph = R"IR(
+    graph(%x, %w, %b, %gamma, %beta, %mean, %var):
+      %s : int[] = prim::Constant[value=[1, 1]]()
+      %p : int[] = prim::Constant[value=[1, 1]]()
+      %g : int = prim::Constant[value=1]()
+      %false : bool = prim::Constant[value=0]()
+      %momentum : float = prim::Constant[value=0.1]()
+      %eps : float = prim::Constant[value=1.0000000000000001e-05]()
+      %conv : Tensor = aten::conv2d(%x, %w, %b, %s, %p, %s, %g)
+      %out : Tensor = aten::batch_norm(%conv, %gamma, %beta, %mean, %var, %false, %momentum, %eps, %false)
+      return (%out))IR";
+
+  std::vector<at::Tensor> params = {at::randn({8, 3, 3, 3}), at::randn({8})};
+  auto bn = bnParams(8);
+  params.insert(params.end(), bn.begin(), bn.end());
+  checkFoldMatchesReference(graph, params, at::randn({2, 3, 10, 10}), torch::jit::aten::conv2d);
+}
+
+TEST(LoweringPasses, FoldBatchNormIntoGroupedConvolutionWithoutBias) {
+  std::string graph = R"IR(
+    graph(%x, %w, %gamma, %beta, %mean, %var):
+      %b : None = prim::Constant()
+      %s : int[] = prim::Constant[value=[1, 1]]()
+      %p : int[] = prim::Constant[value=[0, 0]]()
+      %g : int = prim::Constant[value=4]()
+      %false : bool = prim::Constant[value=0]()
+      %momentum : float = prim::Constant[value=0.1]()
+      %eps : float = prim::Constant[value=1.0000000000000001e-05]()
+      %conv : Tensor = aten::_convolution(%x, %w, %b, %s, %p, %s, %false, %p, %g, %false, %false, %false, %false)
+      %out : Tensor = aten::batch_norm(%conv, %gamma, %beta, %mean, %var, %false, %momentum, %eps, %false)
+      return (%out))IR";
+
+  std::vector<at::Tensor> params = {at::randn({8, 2, 3, 3})};
+  auto bn = bnParams(8);
+  params.insert(params.end(), bn.begin(), bn.end());
+  checkFoldMatchesReference(graph, params, at::randn({2, 8, 10, 10}), torch::jit::aten::_convolution);
+}
+
+TEST(LoweringPasses, FoldBatchNormIntoGroupedTransposedConvolution) {
+  std::string graph = R"IR(
+    graph(%x, %w, %b, %gamma, %beta, %mean, %var):
+      %s : int[] = prim::Constant[value=[2, 2]]()
+      %p : int[] = prim::Constant[value=[1, 1]]()
+      %d : int[] = prim::Constant[value=[1, 1]]()
+      %op : int[] = prim::Constant[value=[0, 0]]()
+      %g : int = prim::Constant[value=2]()
+      %true : bool = prim::Constant[value=1]()
+      %false : bool = prim::Constant[value=0]()
+      %momentum : float = prim::Constant[value=0.1]()
+      %eps : float = prim::Constant[value=1.0000000000000001e-05]()
+      %conv : Tensor = aten::_convolution(%x, %w, %b, %s, %p, %d, %true, %op, %g, %false, %false, %false, %false)
+      %out : Tensor = aten::batch_norm(%conv, %gamma, %beta, %mean, %var, %false, %momentum, %eps, %false)
+      return (%out))IR";
+
+  // in_channels = 4, out_channels = 6, groups = 2 -> weight is [4, 3, 3, 3]
+  std::vector<at::Tensor> params = {at::randn({4, 3, 3, 3}), at::randn({6})};
+  auto bn = bnParams(6);
+  params.insert(params.end(), bn.begin(), bn.end());
+  checkFoldMatchesReference(graph, params, at::randn({2, 4, 7, 7}), torch::jit::aten::_convolution);
+}
+
+TEST(LoweringPasses, FoldBatchNormIntoLinearAfterFlatten) {
+  std::string graph = R"IR(
+    graph(%x, %w, %b, %gamma, %beta, %mean, %var):
+      %1 : int = prim::Constant[value=1]()
+      %neg1 : int = prim::Constant[value=-1]()
+      %false : bool = prim::Constant[value=0]()
+      %momentum : float = prim::Constant[value=0.1]()
+      %eps : float = prim::Constant[value=1.0000000000000001e-05]()
+      %flat : Tensor = aten::flatten(%x, %1, %neg1)
+      %lin : Tensor = aten::linear(%flat, %w, %b)
+      %out : Tensor = aten::batch_norm(%lin, %gamma, %beta, %mean, %var, %false, %momentum, %eps, %false)
+      return (%out))IR";
+
+  std::vector<at::Tensor> params = {at::randn({16, 12}), at::randn({16})};
+  auto bn = bnParams(16);
+  params.insert(params.end(), bn.begin(), bn.end());
+  checkFoldMatchesReference(graph, params, at::randn({5, 3, 4}), torch::jit::aten::linear);
+}
+
+TEST(LoweringPasses, FoldBatchNormSkipsLinearOfUnknownRank) {
+  std::string source_graph = R"IR(
+    graph(%x, %w, %b, %gamma, %beta, %mean, %var):
+      %false : bool = prim::Constant[value=0]()
+      %momentum : float = prim::Constant[value=0.1]()
+      %eps : float = prim::Constant[value=1.0000000000000001e-05]()
+      %lin : Tensor = aten::linear(%x, %w, %b)
+      %out : Tensor = aten::batch_norm(%lin, %gamma, %beta, %mean, %var, %false, %momentum, %eps, %false)
+      return (%out))IR";
+
+  torch_tensorrt::core::util::logging::get_logger().set_reportable_log_level(
+      torch_tensorrt::core::util::logging::LogLevel::kGRAPH);
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(source_graph, g.get());
+  std::vector<at::Tensor> params = {at::randn({4, 4}), at::randn({4})};
+  auto bn = bnParams(4);
+  params.insert(params.end(), bn.begin(), bn.end());
+  freezeParams(g, params);
+
+  torch_tensorrt::core::lowering::passes::FoldBatchNorm(g);
+  ASSERT_EQ(countNodes(g, torch::jit::aten::batch_norm), 1);
+}
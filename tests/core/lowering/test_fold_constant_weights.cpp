@@ -0,0 +1,113 @@
+#include <string>
+#include "core/compiler.h"
+#include "core/lowering/passes/passes.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/constants.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+namespace {
+std::shared_ptr<torch::jit::Graph> parseWithWeight(const std::string& source_graph, at::Tensor weight) {
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(source_graph, g.get());
+  torch::jit::WithInsertPoint guard(g->nodes().front());
+  auto w = g->insertConstant(weight);
+  g->inputs()[1]->replaceAllUsesWith(w);
+  g->eraseInput(1);
+  return g;
+}
+
+size_t countNonConstantNodes(std::shared_ptr<torch::jit::Graph>& g) {
+  size_t count = 0;
+  for (auto n : g->nodes()) {
+    if (n->kind() != torch::jit::prim::Constant) {
+      count++;
+    }
+  }
+  return count;
+}
+} // namespace
+
+TEST(LoweringPasses, FoldConstantWeightChainCorrectly) {
+  std::string source_graph = R"IR(
+    graph(%x, %w):
+      %scale : float = prim::Constant[value=0.5]()
+      %shape : int[] = prim::Constant[value=[4, 6]]()
+      %wt : Tensor = aten::t(%w)
+      %wr : Tensor = aten::reshape(%wt, %shape)
+      %ws : Tensor = aten::mul(%wr, %scale)
+      %out : Tensor = aten::matmul(%x, %ws)
+      return (%out))IR";
+
+  torch_tensorrt::core::util::logging::get_logger().set_reportable_log_level(
+      torch_tensorrt::core::util::logging::LogLevel::kGRAPH);
+  auto weight = at::randn({6, 4});
+  auto g = parseWithWeight(source_graph, weight);
+
+  torch_tensorrt::core::ir::StaticParams empty_params;
+  auto ref = g->copy();
+  auto in = at::randn({3, 4});
+  auto jit_results = torch_tensorrt::tests::util::RunGraph(ref, empty_params, {in});
+
+  torch_tensorrt::core::lowering::passes::FoldConstantWeightSubgraphs(g, 1024 * 1024);
+
+  // Only the matmul should remain, consuming a single folded constant
+  ASSERT_EQ(countNonConstantNodes(g), 1);
+  auto folded_results = torch_tensorrt::tests::util::RunGraph(g, empty_params, {in});
+  ASSERT_TRUE(torch_tensorrt::tests::util::exactlyEqual(jit_results[0], folded_results[0]));
+}
+
+TEST(LoweringPasses, FoldConstantWeightsRespectsSizeCap) {
+  std::string source_graph = R"IR(
+    graph(%x, %w):
+      %wt : Tensor = aten::t(%w)
+      %out : Tensor = aten::matmul(%x, %wt)
+      return (%out))IR";
+
+  torch_tensorrt::core::util::logging::get_logger().set_reportable_log_level(
+      torch_tensorrt::core::util::logging::LogLevel::kGRAPH);
+  auto g = parseWithWeight(source_graph, at::randn({64, 64}));
+
+  // 64 * 64 * 4 bytes is above the cap, nothing should be folded
+  torch_tensorrt::core::lowering::passes::FoldConstantWeightSubgraphs(g, 1024);
+  ASSERT_EQ(countNonConstantNodes(g), 2);
+}
+
+TEST(LoweringPasses, FoldConstantWeightsLeavesActivationsAlone) {
+  std::string source_graph = R"IR(
+    graph(%x, %w):
+      %1 : int = prim::Constant[value=1]()
+      %y : Tensor = aten::add(%x, %w, %1)
+      %out : Tensor = aten::t(%y)
+      return (%out))IR";
+
+  torch_tensorrt::core::util::logging::get_logger().set_reportable_log_level(
+      torch_tensorrt::core::util::logging::LogLevel::kGRAPH);
+  auto g = parseWithWeight(source_graph, at::randn({4, 4}));
+
+  torch_tensorrt::core::lowering::passes::FoldConstantWeightSubgraphs(g, 1024 * 1024);
+  ASSERT_EQ(countNonConstantNodes(g), 2);
+}
+
+TEST(LoweringPasses, FoldConstantWeightsBoundsBroadcastResultsBeforeEvaluating) {
+  std::string source_graph = R"IR(
+    graph(%x, %w):
+      %1 : int = prim::Constant[value=1]()
+      %wt : Tensor = aten::t(%w)
+      %outer : Tensor = aten::add(%w, %wt, %1)
+      %out : Tensor = aten::matmul(%x, %outer)
+      return (%out))IR";
+
+  torch_tensorrt::core::util::logging::get_logger().set_reportable_log_level(
+      torch_tensorrt::core::util::logging::LogLevel::kGRAPH);
+  // [256, 1] + [1, 256] broadcasts two 1 KB weights into a 256 KB result
+  auto g = parseWithWeight(source_graph, at::randn({256, 1}));
+
+  torch_tensorrt::core::lowering::passes::FoldConstantWeightSubgraphs(g, 16 * 1024);
+
+  // The transpose is folded, the broadcasting add is not
+  ASSERT_EQ(countNonConstantNodes(g), 2);
+  for (auto n : g->nodes()) {
+    ASSERT_NE(n->kind(), torch::jit::aten::t);
+  }
+}
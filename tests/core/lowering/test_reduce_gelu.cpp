@@ -13,21 +13,16 @@ TEST(LoweringPasses, ReduceGeluCorrectly) {
         return (%out))IR";
   std::string target_graph = R"IR(
     graph(%x.1 : Tensor):
-        %6 : float = prim::Constant[value=0.044714999999999998]()
-        %5 : float = prim::Constant[value=0.79788456080000003]()
-        %4 : float = prim::Constant[value=1.]()
-        %3 : float = prim::Constant[value=0.5]()
-        %2 : int = prim::Constant[value=1]()
-        %7 : Tensor = aten::mul(%x.1, %3)
-        %8 : Tensor = aten::mul(%x.1, %5)
-        %9 : Tensor = aten::mul(%x.1, %6)
-        %10 : Tensor = aten::mul(%9, %x.1)
-        %11 : Tensor = aten::add(%10, %4, %2)
-        %12 : Tensor = aten::mul(%8, %11)
-        %13 : Tensor = aten::tanh(%12)
-        %14 : Tensor = aten::add(%13, %4, %2)
-        %15 : Tensor = aten::mul(%7, %14)
-        return (%15))IR";
+        %4 : float = prim::Constant[value=0.70710678118654757]()
+        %3 : float = prim::Constant[value=1.]()
+        %2 : float = prim::Constant[value=0.5]()
+        %1 : int = prim::Constant[value=1]()
+        %5 : Tensor = aten::mul(%x.1, %4)
+        %6 : Tensor = aten::erf(%5)
+        %7 : Tensor = aten::add(%6, %3, %1)
+        %8 : Tensor = aten::mul(%x.1, %2)
+        %9 : Tensor = aten::mul(%8, %7)
+        return (%9))IR";
 
   torch_tensorrt::core::util::logging::get_logger().set_reportable_log_level(
       torch_tensorrt::core::util::logging::LogLevel::kGRAPH);
@@ -75,3 +70,44 @@ TEST(LoweringPasses, ReduceGeluApproximateCorrectly) {
 
   ASSERT_TRUE(!torch::jit::findPatternMatches(*tg, *sg).empty());
 }
+
+TEST(LoweringPasses, ReduceGeluExactFlagCorrectly) {
+  std::string source_graph = R"IR(
+    graph(%x):
+        %approx : bool = prim::Constant[value=0]()
+        %out : Tensor = aten::gelu(%x, %approx)
+        return (%out))IR";
+
+  auto sg = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(source_graph, &*sg);
+  torch_tensorrt::core::lowering::passes::ReduceGelu(sg);
+
+  int erf_count = 0;
+  for (auto n : sg->nodes()) {
+    ASSERT_NE(n->kind(), torch::jit::aten::gelu);
+    ASSERT_NE(n->kind(), torch::jit::aten::tanh);
+    erf_count += n->kind() == torch::jit::aten::erf;
+  }
+  ASSERT_EQ(erf_count, 1);
+}
+
+TEST(LoweringPasses, ReduceGeluLeavesConvertibleModes) {
+  for (auto mode : {"none", "tanh"}) {
+    std::string source_graph = std::string(R"IR(
+      graph(%x):
+          %approx : str = prim::Constant[value=")IR") +
+        mode + R"IR("]()
+          %out : Tensor = aten::gelu(%x, %approx)
+          return (%out))IR";
+
+    auto sg = std::make_shared<torch::jit::Graph>();
+    torch::jit::parseIR(source_graph, &*sg);
+    torch_tensorrt::core::lowering::passes::ReduceGelu(sg);
+
+    int gelu_count = 0;
+    for (auto n : sg->nodes()) {
+      gelu_count += n->kind() == torch::jit::aten::gelu;
+    }
+    ASSERT_EQ(gelu_count, 1) << "approximate=" << mode;
+  }
+}
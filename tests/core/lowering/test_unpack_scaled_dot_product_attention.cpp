@@ -0,0 +1,324 @@
+#include <sstream>
+#include <string>
+#include "core/compiler.h"
+#include "core/lowering/passes/passes.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+#include "torch/csrc/jit/ir/subgraph_matcher.h"
+
+namespace {
+enum class AttnMask { kNone, kExplicit, kCausal };
+
+// aten::scaled_dot_product_attention with constant flags, the mask and scale are graph inputs when present
+std::string sdpaGraph(AttnMask mask, bool explicit_scale, bool gqa) {
+  std::stringstream ir;
+  ir << "graph(%query : Tensor, %key : Tensor, %value : Tensor";
+  if (mask == AttnMask::kExplicit) {
+    ir << ", %attn_mask : Tensor";
+  }
+  if (explicit_scale) {
+    ir << ", %scale : float";
+  }
+  ir << "):\n";
+  ir << "  %none : NoneType = prim::Constant()\n";
+  ir << "  %dropout_p : float = prim::Constant[value=0.]()\n";
+  ir << "  %is_causal : bool = prim::Constant[value=" << (mask == AttnMask::kCausal) << "]()\n";
+  ir << "  %enable_gqa : bool = prim::Constant[value=" << gqa << "]()\n";
+  ir << "  %out : Tensor = aten::scaled_dot_product_attention(%query, %key, %value, "
+     << (mask == AttnMask::kExplicit ? "%attn_mask" : "%none") << ", %dropout_p, %is_causal, "
+     << (explicit_scale ? "%scale" : "%none") << ", %enable_gqa)\n";
+  ir << "  return (%out)";
+  return ir.str();
+}
+
+void expectUnpackedTo(AttnMask mask, bool explicit_scale, bool gqa, const std::string& target_graph) {
+  auto sg = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(sdpaGraph(mask, explicit_scale, gqa), sg.get());
+  torch_tensorrt::core::lowering::passes::UnpackScaledDotProductAttention(sg);
+
+  for (auto n : sg->nodes()) {
+    EXPECT_NE(n->kind(), c10::Symbol::fromQualString("aten::scaled_dot_product_attention"))
+        << "Not unpacked for mask " << static_cast<int>(mask) << ", explicit_scale " << explicit_scale << ", gqa "
+        << gqa;
+  }
+
+  auto tg = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(target_graph, tg.get());
+  EXPECT_FALSE(torch::jit::findPatternMatches(*tg, *sg).empty())
+      << "Unexpected decomposition for mask " << static_cast<int>(mask) << ", explicit_scale " << explicit_scale
+      << ", gqa " << gqa << ":\n"
+      << *sg;
+}
+} // namespace
+
+TEST(LoweringPasses, UnpackScaledDotProductAttentionUnmaskedLowersCorrectly) {
+  expectUnpackedTo(
+      AttnMask::kNone,
+      /*explicit_scale=*/false,
+      /*gqa=*/false,
+      R"IR(
+      graph(%query : Tensor, %key : Tensor, %value : Tensor):
+        %none : NoneType = prim::Constant()
+        %minus_1 : int = prim::Constant[value=-1]()
+        %minus_2 : int = prim::Constant[value=-2]()
+        %key_t : Tensor = aten::transpose(%key, %minus_2, %minus_1)
+        %scores : Tensor = aten::matmul(%query, %key_t)
+        %head_dim : int = aten::size(%query, %minus_1)
+        %head_dim_t : Tensor = prim::NumToTensor(%head_dim)
+        %sqrt : Tensor = aten::sqrt(%head_dim_t)
+        %scale_factor : Tensor = aten::reciprocal(%sqrt)
+        %scaled : Tensor = aten::mul(%scores, %scale_factor)
+        %probs : Tensor = aten::softmax(%scaled, %minus_1, %none)
+        %out : Tensor = aten::matmul(%probs, %value)
+        return (%out))IR");
+  expectUnpackedTo(
+      AttnMask::kNone,
+      /*explicit_scale=*/false,
+      /*gqa=*/true,
+      R"IR(
+      graph(%query : Tensor, %key : Tensor, %value : Tensor):
+        %none : NoneType = prim::Constant()
+        %minus_1 : int = prim::Constant[value=-1]()
+        %minus_2 : int = prim::Constant[value=-2]()
+        %key_repeated : Tensor = trt::repeat_kv_heads(%key, %query)
+        %value_repeated : Tensor = trt::repeat_kv_heads(%value, %query)
+        %key_t : Tensor = aten::transpose(%key_repeated, %minus_2, %minus_1)
+        %scores : Tensor = aten::matmul(%query, %key_t)
+        %head_dim : int = aten::size(%query, %minus_1)
+        %head_dim_t : Tensor = prim::NumToTensor(%head_dim)
+        %sqrt : Tensor = aten::sqrt(%head_dim_t)
+        %scale_factor : Tensor = aten::reciprocal(%sqrt)
+        %scaled : Tensor = aten::mul(%scores, %scale_factor)
+        %probs : Tensor = aten::softmax(%scaled, %minus_1, %none)
+        %out : Tensor = aten::matmul(%probs, %value_repeated)
+        return (%out))IR");
+  expectUnpackedTo(
+      AttnMask::kNone,
+      /*explicit_scale=*/true,
+      /*gqa=*/false,
+      R"IR(
+      graph(%query : Tensor, %key : Tensor, %value : Tensor, %scale : float):
+        %none : NoneType = prim::Constant()
+        %minus_1 : int = prim::Constant[value=-1]()
+        %minus_2 : int = prim::Constant[value=-2]()
+        %key_t : Tensor = aten::transpose(%key, %minus_2, %minus_1)
+        %scores : Tensor = aten::matmul(%query, %key_t)
+        %scaled : Tensor = aten::mul(%scores, %scale)
+        %probs : Tensor = aten::softmax(%scaled, %minus_1, %none)
+        %out : Tensor = aten::matmul(%probs, %value)
+        return (%out))IR");
+  expectUnpackedTo(
+      AttnMask::kNone,
+      /*explicit_scale=*/true,
+      /*gqa=*/true,
+      R"IR(
+      graph(%query : Tensor, %key : Tensor, %value : Tensor, %scale : float):
+        %none : NoneType = prim::Constant()
+        %minus_1 : int = prim::Constant[value=-1]()
+        %minus_2 : int = prim::Constant[value=-2]()
+        %key_repeated : Tensor = trt::repeat_kv_heads(%key, %query)
+        %value_repeated : Tensor = trt::repeat_kv_heads(%value, %query)
+        %key_t : Tensor = aten::transpose(%key_repeated, %minus_2, %minus_1)
+        %scores : Tensor = aten::matmul(%query, %key_t)
+        %scaled : Tensor = aten::mul(%scores, %scale)
+        %probs : Tensor = aten::softmax(%scaled, %minus_1, %none)
+        %out : Tensor = aten::matmul(%probs, %value_repeated)
+        return (%out))IR");
+}
+
+TEST(LoweringPasses, UnpackScaledDotProductAttentionMaskedLowersCorrectly) {
+  expectUnpackedTo(
+      AttnMask::kExplicit,
+      /*explicit_scale=*/false,
+      /*gqa=*/false,
+      R"IR(
+      graph(%query : Tensor, %key : Tensor, %value : Tensor, %attn_mask : Tensor):
+        %none : NoneType = prim::Constant()
+        %1 : int = prim::Constant[value=1]()
+        %minus_1 : int = prim::Constant[value=-1]()
+        %minus_2 : int = prim::Constant[value=-2]()
+        %key_t : Tensor = aten::transpose(%key, %minus_2, %minus_1)
+        %scores : Tensor = aten::matmul(%query, %key_t)
+        %head_dim : int = aten::size(%query, %minus_1)
+        %head_dim_t : Tensor = prim::NumToTensor(%head_dim)
+        %sqrt : Tensor = aten::sqrt(%head_dim_t)
+        %scale_factor : Tensor = aten::reciprocal(%sqrt)
+        %scaled : Tensor = aten::mul(%scores, %scale_factor)
+        %bias : Tensor = trt::attn_bias_from_attn_mask(%attn_mask, %query)
+        %biased : Tensor = aten::add(%scaled, %bias, %1)
+        %probs : Tensor = aten::softmax(%biased, %minus_1, %none)
+        %out : Tensor = aten::matmul(%probs, %value)
+        return (%out))IR");
+  expectUnpackedTo(
+      AttnMask::kExplicit,
+      /*explicit_scale=*/false,
+      /*gqa=*/true,
+      R"IR(
+      graph(%query : Tensor, %key : Tensor, %value : Tensor, %attn_mask : Tensor):
+        %none : NoneType = prim::Constant()
+        %1 : int = prim::Constant[value=1]()
+        %minus_1 : int = prim::Constant[value=-1]()
+        %minus_2 : int = prim::Constant[value=-2]()
+        %key_repeated : Tensor = trt::repeat_kv_heads(%key, %query)
+        %value_repeated : Tensor = trt::repeat_kv_heads(%value, %query)
+        %key_t : Tensor = aten::transpose(%key_repeated, %minus_2, %minus_1)
+        %scores : Tensor = aten::matmul(%query, %key_t)
+        %head_dim : int = aten::size(%query, %minus_1)
+        %head_dim_t : Tensor = prim::NumToTensor(%head_dim)
+        %sqrt : Tensor = aten::sqrt(%head_dim_t)
+        %scale_factor : Tensor = aten::reciprocal(%sqrt)
+        %scaled : Tensor = aten::mul(%scores, %scale_factor)
+        %bias : Tensor = trt::attn_bias_from_attn_mask(%attn_mask, %query)
+        %biased : Tensor = aten::add(%scaled, %bias, %1)
+        %probs : Tensor = aten::softmax(%biased, %minus_1, %none)
+        %out : Tensor = aten::matmul(%probs, %value_repeated)
+        return (%out))IR");
+  expectUnpackedTo(
+      AttnMask::kExplicit,
+      /*explicit_scale=*/true,
+      /*gqa=*/false,
+      R"IR(
+      graph(%query : Tensor, %key : Tensor, %value : Tensor, %attn_mask : Tensor, %scale : float):
+        %none : NoneType = prim::Constant()
+        %1 : int = prim::Constant[value=1]()
+        %minus_1 : int = prim::Constant[value=-1]()
+        %minus_2 : int = prim::Constant[value=-2]()
+        %key_t : Tensor = aten::transpose(%key, %minus_2, %minus_1)
+        %scores : Tensor = aten::matmul(%query, %key_t)
+        %scaled : Tensor = aten::mul(%scores, %scale)
+        %bias : Tensor = trt::attn_bias_from_attn_mask(%attn_mask, %query)
+        %biased : Tensor = aten::add(%scaled, %bias, %1)
+        %probs : Tensor = aten::softmax(%biased, %minus_1, %none)
+        %out : Tensor = aten::matmul(%probs, %value)
+        return (%out))IR");
+  expectUnpackedTo(
+      AttnMask::kExplicit,
+      /*explicit_scale=*/true,
+      /*gqa=*/true,
+      R"IR(
+      graph(%query : Tensor, %key : Tensor, %value : Tensor, %attn_mask : Tensor, %scale : float):
+        %none : NoneType = prim::Constant()
+        %1 : int = prim::Constant[value=1]()
+        %minus_1 : int = prim::Constant[value=-1]()
+        %minus_2 : int = prim::Constant[value=-2]()
+        %key_repeated : Tensor = trt::repeat_kv_heads(%key, %query)
+        %value_repeated : Tensor = trt::repeat_kv_heads(%value, %query)
+        %key_t : Tensor = aten::transpose(%key_repeated, %minus_2, %minus_1)
+        %scores : Tensor = aten::matmul(%query, %key_t)
+        %scaled : Tensor = aten::mul(%scores, %scale)
+        %bias : Tensor = trt::attn_bias_from_attn_mask(%attn_mask, %query)
+        %biased : Tensor = aten::add(%scaled, %bias, %1)
+        %probs : Tensor = aten::softmax(%biased, %minus_1, %none)
+        %out : Tensor = aten::matmul(%probs, %value_repeated)
+        return (%out))IR");
+}
+
+TEST(LoweringPasses, UnpackScaledDotProductAttentionCausalLowersCorrectly) {
+  expectUnpackedTo(
+      AttnMask::kCausal,
+      /*explicit_scale=*/false,
+      /*gqa=*/false,
+      R"IR(
+      graph(%query : Tensor, %key : Tensor, %value : Tensor):
+        %none : NoneType = prim::Constant()
+        %1 : int = prim::Constant[value=1]()
+        %minus_1 : int = prim::Constant[value=-1]()
+        %minus_2 : int = prim::Constant[value=-2]()
+        %key_t : Tensor = aten::transpose(%key, %minus_2, %minus_1)
+        %scores : Tensor = aten::matmul(%query, %key_t)
+        %head_dim : int = aten::size(%query, %minus_1)
+        %head_dim_t : Tensor = prim::NumToTensor(%head_dim)
+        %sqrt : Tensor = aten::sqrt(%head_dim_t)
+        %scale_factor : Tensor = aten::reciprocal(%sqrt)
+        %scaled : Tensor = aten::mul(%scores, %scale_factor)
+        %bias : Tensor = trt::causal_attn_bias(%query, %key)
+        %biased : Tensor = aten::add(%scaled, %bias, %1)
+        %probs : Tensor = aten::softmax(%biased, %minus_1, %none)
+        %out : Tensor = aten::matmul(%probs, %value)
+        return (%out))IR");
+  expectUnpackedTo(
+      AttnMask::kCausal,
+      /*explicit_scale=*/false,
+      /*gqa=*/true,
+      R"IR(
+      graph(%query : Tensor, %key : Tensor, %value : Tensor):
+        %none : NoneType = prim::Constant()
+        %1 : int = prim::Constant[value=1]()
+        %minus_1 : int = prim::Constant[value=-1]()
+        %minus_2 : int = prim::Constant[value=-2]()
+        %key_repeated : Tensor = trt::repeat_kv_heads(%key, %query)
+        %value_repeated : Tensor = trt::repeat_kv_heads(%value, %query)
+        %key_t : Tensor = aten::transpose(%key_repeated, %minus_2, %minus_1)
+        %scores : Tensor = aten::matmul(%query, %key_t)
+        %head_dim : int = aten::size(%query, %minus_1)
+        %head_dim_t : Tensor = prim::NumToTensor(%head_dim)
+        %sqrt : Tensor = aten::sqrt(%head_dim_t)
+        %scale_factor : Tensor = aten::reciprocal(%sqrt)
+        %scaled : Tensor = aten::mul(%scores, %scale_factor)
+        %bias : Tensor = trt::causal_attn_bias(%query, %key)
+        %biased : Tensor = aten::add(%scaled, %bias, %1)
+        %probs : Tensor = aten::softmax(%biased, %minus_1, %none)
+        %out : Tensor = aten::matmul(%probs, %value_repeated)
+        return (%out))IR");
+  expectUnpackedTo(
+      AttnMask::kCausal,
+      /*explicit_scale=*/true,
+      /*gqa=*/false,
+      R"IR(
+      graph(%query : Tensor, %key : Tensor, %value : Tensor, %scale : float):
+        %none : NoneType = prim::Constant()
+        %1 : int = prim::Constant[value=1]()
+        %minus_1 : int = prim::Constant[value=-1]()
+        %minus_2 : int = prim::Constant[value=-2]()
+        %key_t : Tensor = aten::transpose(%key, %minus_2, %minus_1)
+        %scores : Tensor = aten::matmul(%query, %key_t)
+        %scaled : Tensor = aten::mul(%scores, %scale)
+        %bias : Tensor = trt::causal_attn_bias(%query, %key)
+        %biased : Tensor = aten::add(%scaled, %bias, %1)
+        %probs : Tensor = aten::softmax(%biased, %minus_1, %none)
+        %out : Tensor = aten::matmul(%probs, %value)
+        return (%out))IR");
+  expectUnpackedTo(
+      AttnMask::kCausal,
+      /*explicit_scale=*/true,
+      /*gqa=*/true,
+      R"IR(
+      graph(%query : Tensor, %key : Tensor, %value : Tensor, %scale : float):
+        %none : NoneType = prim::Constant()
+        %1 : int = prim::Constant[value=1]()
+        %minus_1 : int = prim::Constant[value=-1]()
+        %minus_2 : int = prim::Constant[value=-2]()
+        %key_repeated : Tensor = trt::repeat_kv_heads(%key, %query)
+        %value_repeated : Tensor = trt::repeat_kv_heads(%value, %query)
+        %key_t : Tensor = aten::transpose(%key_repeated, %minus_2, %minus_1)
+        %scores : Tensor = aten::matmul(%query, %key_t)
+        %scaled : Tensor = aten::mul(%scores, %scale)
+        %bias : Tensor = trt::causal_attn_bias(%query, %key)
+        %biased : Tensor = aten::add(%scaled, %bias, %1)
+        %probs : Tensor = aten::softmax(%biased, %minus_1, %none)
+        %out : Tensor = aten::matmul(%probs, %value_repeated)
+        return (%out))IR");
+}
+
+TEST(LoweringPasses, UnpackScaledDotProductAttentionKeepsMaskWithIsCausal) {
+  // PyTorch rejects an explicit mask together with is_causal = True, the node is left for it to report
+  const auto graph = R"IR(
+      graph(%query : Tensor, %key : Tensor, %value : Tensor, %attn_mask : Tensor):
+        %none : NoneType = prim::Constant()
+        %dropout_p : float = prim::Constant[value=0.]()
+        %true : bool = prim::Constant[value=1]()
+        %false : bool = prim::Constant[value=0]()
+        %out : Tensor = aten::scaled_dot_product_attention(%query, %key, %value, %attn_mask, %dropout_p, %true, %none, %false)
+        return (%out))IR";
+
+  auto sg = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, sg.get());
+  torch_tensorrt::core::lowering::passes::UnpackScaledDotProductAttention(sg);
+
+  int sdpa_nodes = 0;
+  for (auto n : sg->nodes()) {
+    sdpa_nodes += n->kind() == c10::Symbol::fromQualString("aten::scaled_dot_product_attention");
+  }
+  ASSERT_EQ(sdpa_nodes, 1);
+}
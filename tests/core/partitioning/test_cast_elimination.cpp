@@ -0,0 +1,149 @@
+#include <string>
+#include "core/partitioning/partitioning.h"
+#include "gtest/gtest.h"
+#include "torch/csrc/jit/api/function_impl.h"
+#include "torch/csrc/jit/ir/irparser.h"
+#include "torch/script.h"
+
+namespace {
+int countCasts(torch::jit::Block* b) {
+  int count = 0;
+  for (auto n : b->nodes()) {
+    count += n->kind() == torch::jit::aten::to;
+    for (auto sub_b : n->blocks()) {
+      count += countCasts(sub_b);
+    }
+  }
+  return count;
+}
+
+std::vector<torch::jit::IValue> cloneInputs(const std::vector<torch::jit::IValue>& inputs) {
+  std::vector<torch::jit::IValue> clones;
+  for (auto& i : inputs) {
+    clones.push_back(i.isTensor() ? torch::jit::IValue(i.toTensor().clone()) : i);
+  }
+  return clones;
+}
+
+// Runs the pass and checks that the graph still computes the same results on the CPU
+int eliminateAndCompare(const std::string& ir, std::vector<torch::jit::IValue> inputs) {
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(ir, g.get());
+  auto before = torch::jit::GraphFunction("before", g->copy(), nullptr);
+
+  auto casts = countCasts(g->block());
+  auto removed = torch_tensorrt::core::partitioning::EliminateRedundantCasts(g);
+  EXPECT_EQ(countCasts(g->block()), casts - removed);
+  g->lint();
+
+  auto after = torch::jit::GraphFunction("after", g, nullptr);
+  auto expected = before(cloneInputs(inputs)).toTensor();
+  auto actual = after(cloneInputs(inputs)).toTensor();
+  EXPECT_EQ(expected.scalar_type(), actual.scalar_type());
+  EXPECT_TRUE(torch::equal(expected, actual));
+  return removed;
+}
+
+const std::string kConstants = R"IR(
+        %one : int = prim::Constant[value=1]()
+        %int : int = prim::Constant[value=3]()
+        %long : int = prim::Constant[value=4]()
+        %false : bool = prim::Constant[value=0]()
+        %none : NoneType = prim::Constant()
+        %cpu : Device = prim::Constant[value="cpu"]())IR";
+} // namespace
+
+TEST(Partitioning, EliminateWideningRoundTripCasts) {
+  // int32 -> int64 -> int32 as left behind by a Torch segment producing an int64 output next to one consuming it
+  const auto graph = "graph(%x : Tensor):" + kConstants + R"IR(
+        %a : Tensor = aten::to(%x, %cpu, %int, %false, %false, %none)
+        %b : Tensor = aten::to(%a, %cpu, %long, %false, %false, %none)
+        %c : Tensor = aten::to(%b, %cpu, %int, %false, %false, %none)
+        %d : Tensor = aten::add(%a, %c, %one)
+        return (%d))IR";
+
+  ASSERT_EQ(eliminateAndCompare(graph, {at::randint(-100, 100, {4, 4}, at::kLong)}), 2);
+}
+
+TEST(Partitioning, KeepNarrowingRoundTripCasts) {
+  // int64 -> int32 -> int64 truncates, so both casts have to stay
+  const auto graph = "graph(%x : Tensor):" + kConstants + R"IR(
+        %a : Tensor = aten::to(%x, %cpu, %int, %false, %false, %none)
+        %b : Tensor = aten::to(%a, %cpu, %long, %false, %false, %none)
+        %c : Tensor = aten::add(%x, %b, %one)
+        return (%c))IR";
+
+  ASSERT_EQ(eliminateAndCompare(graph, {at::full({4}, int64_t(1) << 40, at::kLong)}), 0);
+}
+
+TEST(Partitioning, KeepWideningCastsOfFloats) {
+  // float -> int64 -> int32 is only equivalent to float -> int32 for values int32 can hold
+  const auto graph = "graph(%x : Tensor):" + kConstants + R"IR(
+        %a : Tensor = aten::to(%x, %cpu, %long, %false, %false, %none)
+        %b : Tensor = aten::to(%a, %cpu, %int, %false, %false, %none)
+        return (%b))IR";
+  ASSERT_EQ(eliminateAndCompare(graph, {at::full({4}, 5e9, at::kFloat)}), 0);
+
+  const auto typed = "graph(%x : Float(4, strides=[1], requires_grad=0, device=cpu)):" + kConstants + R"IR(
+        %a : Tensor = aten::to(%x, %cpu, %long, %false, %false, %none)
+        %b : Tensor = aten::to(%a, %cpu, %int, %false, %false, %none)
+        return (%b))IR";
+  ASSERT_EQ(eliminateAndCompare(typed, {at::full({4}, 5e9, at::kFloat)}), 0);
+
+  const auto integral = "graph(%x : Short(4, strides=[1], requires_grad=0, device=cpu)):" + kConstants + R"IR(
+        %a : Tensor = aten::to(%x, %cpu, %long, %false, %false, %none)
+        %b : Tensor = aten::to(%a, %cpu, %int, %false, %false, %none)
+        return (%b))IR";
+  ASSERT_EQ(eliminateAndCompare(integral, {at::randint(-100, 100, {4}, at::kShort)}), 1);
+}
+
+TEST(Partitioning, KeepCastAfterDeviceMove) {
+  // Without a device argument the outer cast relies on the inner one having moved the tensor
+  const auto graph = "graph(%x : Tensor):" + kConstants + R"IR(
+        %a : Tensor = aten::to(%x, %cpu, %long, %false, %false, %none)
+        %b : Tensor = aten::to(%a, %int, %false, %false, %none)
+        return (%b))IR";
+
+  ASSERT_EQ(eliminateAndCompare(graph, {at::randint(-100, 100, {4}, at::kInt)}), 0);
+}
+
+TEST(Partitioning, EliminateDominatedDuplicateCasts) {
+  const auto graph = "graph(%x : Tensor, %cond : bool):" + kConstants + R"IR(
+        %a : Tensor = aten::to(%x, %cpu, %int, %false, %false, %none)
+        %r : Tensor = prim::If(%cond)
+          block0():
+            %b : Tensor = aten::to(%x, %cpu, %int, %false, %false, %none)
+            %c : Tensor = aten::add(%a, %b, %one)
+            -> (%c)
+          block1():
+            %d : Tensor = aten::to(%x, %cpu, %long, %false, %false, %none)
+            -> (%d)
+        %e : Tensor = aten::to(%x, %cpu, %long, %false, %false, %none)
+        %f : Tensor = aten::add(%r, %e, %one)
+        return (%f))IR";
+
+  // Only the cast in the first branch always runs after an identical one
+  auto x = at::randint(-100, 100, {4}, at::kLong);
+  ASSERT_EQ(eliminateAndCompare(graph, {x, true}), 1);
+  ASSERT_EQ(eliminateAndCompare(graph, {x, false}), 1);
+}
+
+TEST(Partitioning, KeepDuplicateCastsOfMutatedTensors) {
+  const auto graph = "graph(%x : Tensor):" + kConstants + R"IR(
+        %a : Tensor = aten::to(%x, %cpu, %int, %false, %false, %none)
+        %b : Tensor = aten::add_(%x, %x, %one)
+        %c : Tensor = aten::to(%x, %cpu, %int, %false, %false, %none)
+        %d : Tensor = aten::add(%a, %c, %one)
+        return (%d))IR";
+
+  ASSERT_EQ(eliminateAndCompare(graph, {at::randint(-100, 100, {4}, at::kLong)}), 0);
+}
+
+TEST(Partitioning, EliminateUnusedCasts) {
+  const auto graph = "graph(%x : Tensor):" + kConstants + R"IR(
+        %a : Tensor = aten::to(%x, %cpu, %int, %false, %false, %none)
+        %b : Tensor = aten::to(%a, %cpu, %long, %false, %false, %none)
+        return (%x))IR";
+
+  ASSERT_EQ(eliminateAndCompare(graph, {at::randint(-100, 100, {4}, at::kLong)}), 2);
+}
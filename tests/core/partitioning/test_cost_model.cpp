@@ -0,0 +1,179 @@
+#include <string>
+#include "core/partitioning/partitioning.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+#include "torch/script.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace partitioning {
+namespace tests {
+
+namespace {
+const auto kConv = c10::Symbol::fromQualString("aten::_convolution");
+const auto kRelu = c10::Symbol::fromQualString("aten::relu");
+const auto kAdd = c10::Symbol::fromQualString("aten::add");
+const auto kUnsupported = c10::Symbol::fromQualString("aten::log_sigmoid");
+
+CostGraph::Segment makeSegment(
+    SegmentedBlock::SegmentedBlockTarget target,
+    std::vector<c10::Symbol> node_kinds,
+    bool pinned = false) {
+  CostGraph::Segment s;
+  s.target = target;
+  s.node_kinds = std::move(node_kinds);
+  s.pinned = pinned;
+  return s;
+}
+
+BoundaryTensor makeTensor(std::vector<int64_t> shape, at::ScalarType dtype = at::kFloat, bool requires_cast = false) {
+  BoundaryTensor t;
+  t.shape = std::move(shape);
+  t.dtype = dtype;
+  t.requires_cast = requires_cast;
+  return t;
+}
+
+// Torch -> TRT -> Torch with the TensorRT segment in the middle exchanging the given tensor with both neighbours
+CostGraph makeSandwich(std::vector<c10::Symbol> trt_nodes, BoundaryTensor boundary, bool pinned = false) {
+  CostGraph graph;
+  graph.segments.push_back(makeSegment(SegmentedBlock::kTorch, {kUnsupported}));
+  graph.segments.push_back(makeSegment(SegmentedBlock::kTensorRT, std::move(trt_nodes), pinned));
+  graph.segments.push_back(makeSegment(SegmentedBlock::kTorch, {kUnsupported}));
+  graph.edges.push_back({0, 1, boundary});
+  graph.edges.push_back({1, 2, boundary});
+  return graph;
+}
+
+// Model where boundaries are free, so only node costs matter
+class FreeBoundaryCostModel : public DefaultCostModel {
+ public:
+  double transferCost(const BoundaryTensor& t) const override {
+    return 0.0;
+  }
+  double castCost(const BoundaryTensor& t) const override {
+    return 0.0;
+  }
+  double engineLaunchCost() const override {
+    return 0.0;
+  }
+};
+} // namespace
+
+TEST(Partitioning, CostModelPricesBoundaryByBytes) {
+  DefaultCostModel model;
+  auto small = makeTensor({1, 16});
+  auto large = makeTensor({1, 64, 224, 224});
+  ASSERT_EQ(large.bytes(), 1 * 64 * 224 * 224 * 4);
+  ASSERT_LT(model.transferCost(small), model.transferCost(large));
+  ASSERT_EQ(makeTensor({1, 64, 224, 224}, at::kHalf).bytes() * 2, large.bytes());
+}
+
+TEST(Partitioning, CostModelMovesCheapSegmentWithLargeBoundariesToTorch) {
+  auto graph = makeSandwich({kRelu, kAdd}, makeTensor({8, 64, 224, 224}));
+  DefaultCostModel model;
+  auto decisions = planCostModelFallback(graph, model);
+  ASSERT_EQ(decisions.size(), 1);
+  ASSERT_EQ(decisions[0].segment_id, 1);
+  ASSERT_EQ(decisions[0].num_nodes, 2);
+  ASSERT_LT(decisions[0].cost_after, decisions[0].cost_before);
+}
+
+TEST(Partitioning, CostModelKeepsComputeHeavySegmentInTensorRT) {
+  auto graph = makeSandwich({kConv, kRelu, kConv, kRelu, kConv}, makeTensor({1, 64, 56, 56}));
+  DefaultCostModel model;
+  ASSERT_TRUE(planCostModelFallback(graph, model).empty());
+}
+
+TEST(Partitioning, CostModelAccountsForCasts) {
+  // Same segment and boundary size, but the Long boundary needs a cast each way when crossing into TensorRT
+  DefaultCostModel::Params params;
+  params.torch_light_node_us = 1.0;
+  params.trt_light_node_us = 0.0;
+  params.engine_launch_us = 0.0;
+  params.boundary_overhead_us = 0.0;
+  params.kernel_launch_us = 10.0;
+  DefaultCostModel model(params);
+
+  auto plain = makeSandwich({kAdd, kAdd, kAdd}, makeTensor({1, 8}, at::kLong));
+  ASSERT_TRUE(planCostModelFallback(plain, model).empty());
+
+  auto cast = makeSandwich({kAdd, kAdd, kAdd}, makeTensor({1, 8}, at::kLong, true));
+  ASSERT_EQ(planCostModelFallback(cast, model).size(), 1);
+}
+
+TEST(Partitioning, CostModelNeverMovesPinnedSegments) {
+  auto graph = makeSandwich({kRelu}, makeTensor({8, 64, 224, 224}), /*pinned=*/true);
+  DefaultCostModel model;
+  ASSERT_TRUE(planCostModelFallback(graph, model).empty());
+}
+
+TEST(Partitioning, CostModelWeighsBoundariesWithOtherEngines) {
+  // TRT -> TRT -> Torch: moving the middle segment only turns its engine to engine boundary into an engine to torch one
+  CostGraph graph;
+  graph.segments.push_back(makeSegment(SegmentedBlock::kTensorRT, {kConv, kConv, kConv}));
+  graph.segments.push_back(makeSegment(SegmentedBlock::kTensorRT, {kConv}));
+  graph.segments.push_back(makeSegment(SegmentedBlock::kTorch, {kUnsupported}));
+  auto boundary = makeTensor({1, 64, 56, 56});
+  graph.edges.push_back({0, 1, boundary});
+  graph.edges.push_back({1, 2, boundary});
+  DefaultCostModel model;
+  ASSERT_TRUE(planCostModelFallback(graph, model).empty());
+}
+
+TEST(Partitioning, CostModelIsPluggable) {
+  auto graph = makeSandwich({kRelu, kAdd}, makeTensor({8, 64, 224, 224}));
+  FreeBoundaryCostModel model;
+  ASSERT_TRUE(planCostModelFallback(graph, model).empty());
+}
+
+TEST(Partitioning, CostModelFallbackSurvivesResegmentation) {
+  const auto graph = R"IR(
+        graph(%0 : Tensor,
+              %w1 : Float(32, 3, 3, 3, strides=[27, 9, 3, 1]),
+              %b1 : Float(32),
+              %w2 : Float(16, 32, 3, 3, strides=[288, 9, 3, 1]),
+              %b2 : Float(16),
+              %w3 : Float(8, 16, 3, 3, strides=[144, 9, 3, 1]),
+              %b3 : Float(8)):
+          %2 : int[] = prim::Constant[value=[1, 1]]()
+          %3 : int = prim::Constant[value=1]()
+          %10 : bool = prim::Constant[value=0]()
+          %11 : int[] = prim::Constant[value=[0, 0]]()
+          %12: Tensor = aten::_convolution(%0, %w1, %b1, %2, %2, %2, %10, %11, %3, %10, %10, %10, %10)
+          %13 : Tensor = aten::relu(%12)
+          %14 : Tensor = aten::_convolution(%13, %w2, %b2, %2, %2, %2, %10, %11, %3, %10, %10, %10, %10)
+          %15 : Tensor = aten::log_sigmoid(%14)
+          %16 : Tensor = aten::_convolution(%15, %w3, %b3, %2, %2, %2, %10, %11, %3, %10, %10, %10, %10)
+          return (%16))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+
+  PartitioningInfo partitioning_info;
+  partitioning_info.enabled = true;
+  PartitioningCtx ctx(g->block(), partitioning_info);
+  segmentGraph(&ctx, g->block());
+  auto& segments = ctx.partitioned_blocks[g->block()];
+  ASSERT_EQ(segments.size(), 3);
+  ASSERT_EQ(segments[2].target(), SegmentedBlock::kTensorRT);
+
+  // Move the trailing TensorRT segment to torch as the cost model would and segment the block again
+  for (auto n : segments[2].raw_nodes()) {
+    ctx.setNodeExecutorDecision(n, NodeExecutorDecision::kCOST_MODEL_FALLBACK);
+  }
+  ctx.partitioned_blocks.erase(g->block());
+  segmentGraph(&ctx, g->block());
+
+  auto& resegmented = ctx.partitioned_blocks[g->block()];
+  ASSERT_EQ(resegmented.size(), 2);
+  ASSERT_EQ(resegmented[0].target(), SegmentedBlock::kTensorRT);
+  ASSERT_EQ(resegmented[1].target(), SegmentedBlock::kTorch);
+  ASSERT_EQ(resegmented[1].raw_nodes().size(), 2);
+}
+
+} // namespace tests
+} // namespace partitioning
+} // namespace core
+} // namespace torch_tensorrt
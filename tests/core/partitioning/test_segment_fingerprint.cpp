@@ -0,0 +1,159 @@
+#include <string>
+#include "core/partitioning/partitioning.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+#include "torch/script.h"
+
+namespace torch_tensorrt {
+namespace core {
+namespace partitioning {
+namespace tests {
+
+namespace {
+SegmentedBlock parseSegment(const std::string& source) {
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(source, g.get());
+  return SegmentedBlock(SegmentedBlock::kTensorRT, g);
+}
+
+// Segment computing relu(x @ w) with w embedded as a constant, as weights are after lowering
+SegmentedBlock weightSegment(const at::Tensor& w) {
+  auto g = std::make_shared<torch::jit::Graph>();
+  auto x = g->addInput("x");
+  auto weight = g->insertConstant(w);
+  auto mm = g->insertNode(g->create(c10::Symbol::fromQualString("aten::matmul"), {x, weight}));
+  auto relu = g->insertNode(g->create(c10::Symbol::fromQualString("aten::relu"), {mm->output()}));
+  g->registerOutput(relu->output());
+  return SegmentedBlock(SegmentedBlock::kTensorRT, g);
+}
+
+const std::vector<ir::Input> kSpecs = {ir::Input({4, 16})};
+} // namespace
+
+TEST(Partitioning, FingerprintIgnoresDebugNames) {
+  auto a = parseSegment(R"IR(
+      graph(%x : Tensor, %y : Tensor):
+        %1 : int = prim::Constant[value=1]()
+        %2 : Tensor = aten::add(%x, %y, %1)
+        %3 : Tensor = aten::relu(%2)
+        return (%3))IR");
+  auto b = parseSegment(R"IR(
+      graph(%input.1 : Tensor, %input.2 : Tensor):
+        %alpha : int = prim::Constant[value=1]()
+        %sum.7 : Tensor = aten::add(%input.1, %input.2, %alpha)
+        %out.3 : Tensor = aten::relu(%sum.7)
+        return (%out.3))IR");
+  ASSERT_EQ(fingerprintSegment(a, kSpecs), fingerprintSegment(b, kSpecs));
+}
+
+TEST(Partitioning, FingerprintDistinguishesOpsAndWiring) {
+  const auto relu = R"IR(
+      graph(%x : Tensor, %y : Tensor):
+        %1 : int = prim::Constant[value=1]()
+        %2 : Tensor = aten::sub(%x, %y, %1)
+        %3 : Tensor = aten::relu(%2)
+        return (%3))IR";
+  const auto sigmoid = R"IR(
+      graph(%x : Tensor, %y : Tensor):
+        %1 : int = prim::Constant[value=1]()
+        %2 : Tensor = aten::sub(%x, %y, %1)
+        %3 : Tensor = aten::sigmoid(%2)
+        return (%3))IR";
+  const auto swapped = R"IR(
+      graph(%x : Tensor, %y : Tensor):
+        %1 : int = prim::Constant[value=1]()
+        %2 : Tensor = aten::sub(%y, %x, %1)
+        %3 : Tensor = aten::relu(%2)
+        return (%3))IR";
+  const auto alpha = R"IR(
+      graph(%x : Tensor, %y : Tensor):
+        %1 : int = prim::Constant[value=2]()
+        %2 : Tensor = aten::sub(%x, %y, %1)
+        %3 : Tensor = aten::relu(%2)
+        return (%3))IR";
+  auto base = parseSegment(relu);
+  auto fp = fingerprintSegment(base, kSpecs);
+  auto other_op = parseSegment(sigmoid);
+  auto other_wiring = parseSegment(swapped);
+  auto other_constant = parseSegment(alpha);
+  ASSERT_NE(fp, fingerprintSegment(other_op, kSpecs));
+  ASSERT_NE(fp, fingerprintSegment(other_wiring, kSpecs));
+  ASSERT_NE(fp, fingerprintSegment(other_constant, kSpecs));
+}
+
+TEST(Partitioning, FingerprintDistinguishesInputSpecs) {
+  auto seg = weightSegment(at::ones({16, 8}));
+  ASSERT_NE(fingerprintSegment(seg, {ir::Input({4, 16})}), fingerprintSegment(seg, {ir::Input({8, 16})}));
+  ASSERT_NE(
+      fingerprintSegment(seg, {ir::Input({4, 16})}),
+      fingerprintSegment(seg, {ir::Input({1, 16}, {4, 16}, {8, 16})}));
+}
+
+TEST(Partitioning, FingerprintHashesWeightContents) {
+  auto ones = weightSegment(at::ones({16, 8}));
+  auto ones_again = weightSegment(at::ones({16, 8}));
+  auto zeros = weightSegment(at::zeros({16, 8}));
+  ASSERT_EQ(fingerprintSegment(ones, kSpecs), fingerprintSegment(ones_again, kSpecs));
+  ASSERT_NE(fingerprintSegment(ones, kSpecs), fingerprintSegment(zeros, kSpecs));
+}
+
+TEST(Partitioning, FingerprintHashesNonContiguousWeightsByValue) {
+  auto w = at::randn({8, 16});
+  auto transposed = weightSegment(w.t());
+  auto copied = weightSegment(w.t().contiguous());
+  ASSERT_EQ(fingerprintSegment(transposed, kSpecs), fingerprintSegment(copied, kSpecs));
+  // Tail bytes past the last full word still count
+  ASSERT_NE(
+      fingerprintSegment(weightSegment(at::tensor({1, 2, 3}, at::kByte)), kSpecs),
+      fingerprintSegment(weightSegment(at::tensor({1, 2, 4}, at::kByte)), kSpecs));
+}
+
+TEST(Partitioning, FingerprintCollectsConstantsToConfirmMatches) {
+  auto w = at::randn({16, 8});
+  auto a = weightSegment(w);
+  auto b = weightSegment(w.clone());
+  std::vector<at::Tensor> a_constants, b_constants;
+  ASSERT_EQ(fingerprintSegment(a, kSpecs, &a_constants), fingerprintSegment(b, kSpecs, &b_constants));
+  ASSERT_EQ(a_constants.size(), 1);
+  ASSERT_TRUE(sameSegmentConstants(a_constants, b_constants));
+
+  // Stands in for a hash collision, the fingerprint alone would have matched these
+  auto changed = w.clone();
+  changed[3][5] = changed[3][5] + 1;
+  ASSERT_FALSE(sameSegmentConstants(a_constants, {changed}));
+  ASSERT_FALSE(sameSegmentConstants(a_constants, {w.to(at::kDouble)}));
+  ASSERT_FALSE(sameSegmentConstants(a_constants, {}));
+}
+
+TEST(Partitioning, FingerprintMatchesRepeatedBlocksAfterSegmentation) {
+  // Two identical layers separated by an op that runs in torch
+  const auto graph = R"IR(
+        graph(%x : Tensor):
+          %1 : int = prim::Constant[value=1]()
+          %2 : Tensor = aten::add(%x, %x, %1)
+          %3 : Tensor = aten::relu(%2)
+          %4 : Tensor = aten::log_sigmoid(%3)
+          %5 : Tensor = aten::add(%4, %4, %1)
+          %6 : Tensor = aten::relu(%5)
+          return (%6))IR";
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(graph, g.get());
+
+  PartitioningInfo partitioning_info;
+  partitioning_info.enabled = true;
+  partitioning_info.forced_fallback_operators = {"aten::log_sigmoid"};
+  PartitioningCtx ctx(g->block(), partitioning_info);
+  segmentGraph(&ctx, g->block());
+  auto& segments = ctx.partitioned_blocks[g->block()];
+  ASSERT_EQ(segments.size(), 3);
+  ASSERT_EQ(segments[0].target(), SegmentedBlock::kTensorRT);
+  ASSERT_EQ(segments[2].target(), SegmentedBlock::kTensorRT);
+  ASSERT_EQ(fingerprintSegment(segments[0], kSpecs), fingerprintSegment(segments[2], kSpecs));
+}
+
+} // namespace tests
+} // namespace partitioning
+} // namespace core
+} // namespace torch_tensorrt
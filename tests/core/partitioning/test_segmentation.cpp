@@ -1,4 +1,5 @@
 #include <string>
+#include "core/lowering/passes/passes.h"
 #include "core/partitioning/partitioning.h"
 #include "gtest/gtest.h"
 #include "tests/util/util.h"
@@ -331,6 +332,32 @@ TEST(Partitioning, SegmentModelWithDependencyAwareness) {
       checkSegmentedBlockNodesMapping(ctx.partitioned_blocks.begin()->second, g, {{0, 2, 4}, {1, 3, 5}, {6, 7}}));
 }
 
+TEST(Partitioning, SegmentUnpackedCausalGQAAttentionIntoSingleEngine) {
+  // The causal bias and the repeated key / value heads are built inside the network, so nothing falls back to torch
+  for (auto scale : {"%none", "%scale"}) {
+    const auto graph = std::string(R"IR(
+        graph(%query : Tensor, %key : Tensor, %value : Tensor):
+          %none : NoneType = prim::Constant()
+          %dropout_p : float = prim::Constant[value=0.]()
+          %scale : float = prim::Constant[value=0.125]()
+          %true : bool = prim::Constant[value=1]()
+          %out : Tensor = aten::scaled_dot_product_attention(%query, %key, %value, %none, %dropout_p, %true, )IR") +
+        scale + R"IR(, %true)
+          return (%out))IR";
+
+    auto g = std::make_shared<torch::jit::Graph>();
+    torch::jit::parseIR(graph, g.get());
+    lowering::passes::UnpackScaledDotProductAttention(g);
+
+    PartitioningInfo partitioning_info;
+    partitioning_info.enabled = true;
+    PartitioningCtx ctx(g->block(), partitioning_info);
+    segmentGraph(&ctx, g->block());
+    ASSERT_TRUE(checkSegmentedBlockNumber(ctx.partitioned_blocks.begin()->second, SegmentedBlock::kTensorRT, 1));
+    ASSERT_TRUE(checkSegmentedBlockNumber(ctx.partitioned_blocks.begin()->second, SegmentedBlock::kTorch, 0));
+  }
+}
+
 } // namespace tests
 } // namespace partitioning
 } // namespace core
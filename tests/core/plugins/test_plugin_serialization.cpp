@@ -0,0 +1,126 @@
+#include <sstream>
+#include <string>
+#include "core/plugins/impl/interpolate_plugin.h"
+#include "core/plugins/impl/normalize_plugin.h"
+#include "core/plugins/impl/serialization.h"
+#include "gtest/gtest.h"
+#include "torch/torch.h"
+
+using torch_tensorrt::core::plugins::impl::InterpolatePlugin;
+using torch_tensorrt::core::plugins::impl::NormalizePlugin;
+namespace serialization = torch_tensorrt::core::plugins::impl::serialization;
+
+namespace {
+template <typename Plugin>
+std::string serialize(const Plugin& plugin) {
+  std::string data(plugin.getSerializationSize(), '\0');
+  plugin.serialize(&data[0]);
+  return data;
+}
+} // namespace
+
+TEST(Plugins, SerializationPrimitivesRoundTrip) {
+  std::vector<int64_t> ints = {1, -2, 3};
+  std::vector<double> doubles = {0.5, 2.0};
+  std::string str = "bilinear";
+  bool flag = true;
+
+  std::string data(
+      serialization::header_size() + serialization::serialized_size(ints) + serialization::serialized_size(doubles) +
+          serialization::serialized_size(str) + serialization::serialized_size(flag),
+      '\0');
+  char* cursor = &data[0];
+  serialization::write_header(cursor);
+  serialization::write(cursor, ints);
+  serialization::write(cursor, doubles);
+  serialization::write(cursor, str);
+  serialization::write(cursor, flag);
+  ASSERT_EQ(cursor, data.data() + data.size());
+
+  std::vector<int64_t> ints_out;
+  std::vector<double> doubles_out;
+  std::string str_out;
+  bool flag_out = false;
+  serialization::Reader reader(data.data(), data.size());
+  ASSERT_TRUE(reader.read_header());
+  reader.read(ints_out);
+  reader.read(doubles_out);
+  reader.read(str_out);
+  reader.read(flag_out);
+  ASSERT_TRUE(reader.ok());
+  ASSERT_TRUE(reader.exhausted());
+  ASSERT_EQ(ints, ints_out);
+  ASSERT_EQ(doubles, doubles_out);
+  ASSERT_EQ(str, str_out);
+  ASSERT_EQ(flag, flag_out);
+}
+
+TEST(Plugins, SerializationReaderRejectsTruncatedData) {
+  std::vector<int32_t> values = {1, 2, 3, 4};
+  std::string data(serialization::header_size() + serialization::serialized_size(values), '\0');
+  char* cursor = &data[0];
+  serialization::write_header(cursor);
+  serialization::write(cursor, values);
+
+  std::vector<int32_t> out;
+  serialization::Reader reader(data.data(), data.size() - 1);
+  reader.read_header();
+  ASSERT_FALSE(reader.read(out));
+  ASSERT_FALSE(reader.ok());
+}
+
+TEST(Plugins, InterpolatePluginSerializationRoundTrip) {
+  InterpolatePlugin plugin({1, 3, 8, 8}, {1, 3, 16, 16}, {16, 16}, {}, "bilinear", true, false);
+  auto data = serialize(plugin);
+
+  InterpolatePlugin restored(data.data(), data.size());
+  ASSERT_EQ(restored.getInputShape(), std::vector<int64_t>({1, 3, 8, 8}));
+  ASSERT_EQ(restored.getOutputShape(), std::vector<int64_t>({1, 3, 16, 16}));
+  ASSERT_EQ(restored.getOutputSize(), std::vector<int64_t>({16, 16}));
+  ASSERT_EQ(serialize(restored), data);
+}
+
+TEST(Plugins, InterpolatePluginComputesOutputShapeFromScales) {
+  InterpolatePlugin plugin({2, 4, 5, 7}, {}, {}, {2.5, 1.5}, "bilinear", true, true);
+  ASSERT_EQ(plugin.getOutputShape(), std::vector<int64_t>({2, 4, 12, 10}));
+
+  auto data = serialize(plugin);
+  InterpolatePlugin restored(data.data(), data.size());
+  ASSERT_EQ(restored.getOutputShape(), plugin.getOutputShape());
+  ASSERT_EQ(serialize(restored), data);
+}
+
+TEST(Plugins, InterpolatePluginReadsLegacyArchives) {
+  torch::serialize::OutputArchive output_archive;
+  output_archive.write("in_shape", torch::IValue(std::vector<int64_t>({1, 3, 8})));
+  output_archive.write("out_shape", torch::IValue(std::vector<int64_t>({1, 3, 4})));
+  output_archive.write("size", torch::IValue(std::vector<int64_t>({4})));
+  output_archive.write("scales", torch::IValue(std::vector<double>()));
+  output_archive.write("mode", torch::IValue(std::string("adaptive_avg_pool1d")));
+  output_archive.write("align_corners", torch::IValue(false));
+  output_archive.write("use_scales", torch::IValue(false));
+  std::ostringstream data_str;
+  output_archive.save_to(data_str);
+  auto legacy = data_str.str();
+
+  InterpolatePlugin restored(legacy.data(), legacy.size());
+  ASSERT_EQ(restored.getOutputShape(), std::vector<int64_t>({1, 3, 4}));
+  ASSERT_EQ(restored.getOutputSize(), std::vector<int64_t>({4}));
+  // Re-serializing moves the plugin to the compact format
+  ASSERT_LT(restored.getSerializationSize(), legacy.size());
+}
+
+TEST(Plugins, NormalizePluginSerializationRoundTrip) {
+  NormalizePlugin plugin(2, {1, 2}, 1);
+  auto data = serialize(plugin);
+  ASSERT_EQ(data.size(), plugin.getSerializationSize());
+
+  NormalizePlugin restored(data.data(), data.size());
+  ASSERT_EQ(serialize(restored), data);
+}
+
+TEST(Plugins, NormalizePluginRejectsMalformedData) {
+  NormalizePlugin plugin(2, {1, 2}, 1);
+  auto data = serialize(plugin);
+  ASSERT_ANY_THROW(NormalizePlugin(data.data(), data.size() - 2));
+}
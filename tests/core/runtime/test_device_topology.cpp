@@ -0,0 +1,154 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "core/runtime/runtime.h"
+#include "gtest/gtest.h"
+
+namespace runtime = torch_tensorrt::core::runtime;
+
+namespace {
+// CUDA stand in with a fixed set of devices, counting the expensive queries
+class FakeDeviceQuery : public runtime::DeviceQuery {
+ public:
+  explicit FakeDeviceQuery(std::vector<runtime::DeviceProperties> devices) : devices_(std::move(devices)) {}
+
+  int64_t device_count() override {
+    return devices_.size();
+  }
+  runtime::DeviceProperties properties(int64_t device_id) override {
+    property_queries++;
+    return devices_.at(device_id);
+  }
+  int64_t current_device() override {
+    return current_;
+  }
+  bool set_device(int64_t device_id) override {
+    if (device_id < 0 || device_id >= static_cast<int64_t>(devices_.size())) {
+      return false;
+    }
+    current_ = device_id;
+    return true;
+  }
+
+  std::atomic<int> property_queries = {0};
+
+ private:
+  std::vector<runtime::DeviceProperties> devices_;
+  // Like CUDA, the current device is per thread
+  static thread_local int64_t current_;
+};
+thread_local int64_t FakeDeviceQuery::current_ = 0;
+
+runtime::DeviceProperties props(int64_t major, int64_t minor, std::string name) {
+  runtime::DeviceProperties p;
+  p.major = major;
+  p.minor = minor;
+  p.name = std::move(name);
+  return p;
+}
+
+class DeviceTopology : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    query = std::make_shared<FakeDeviceQuery>(std::vector<runtime::DeviceProperties>{
+        props(8, 6, "NVIDIA A10"), props(8, 0, "NVIDIA A100"), props(8, 6, "NVIDIA A10"), props(8, 7, "Orin")});
+    runtime::set_device_query(query);
+    query->set_device(0);
+  }
+
+  std::shared_ptr<FakeDeviceQuery> query;
+};
+} // namespace
+
+TEST_F(DeviceTopology, SnapshotIsTakenOnce) {
+  for (int i = 0; i < 100; i++) {
+    auto device = runtime::RTDevice(i % 4, nvinfer1::DeviceType::kGPU);
+    ASSERT_EQ(device.id, i % 4);
+    runtime::get_current_device();
+  }
+  runtime::multi_gpu_device_check();
+  ASSERT_EQ(runtime::get_available_device_list().get_devices().size(), 4);
+  ASSERT_EQ(query->property_queries, 4);
+}
+
+TEST_F(DeviceTopology, CurrentDeviceFollowsSetDevice) {
+  ASSERT_EQ(runtime::get_current_device().device_name, "NVIDIA A10");
+  auto a100 = runtime::RTDevice(1, nvinfer1::DeviceType::kGPU);
+  runtime::set_rt_device(a100);
+  ASSERT_EQ(runtime::get_current_device().id, 1);
+  ASSERT_EQ(runtime::get_current_device().major, 8);
+  ASSERT_EQ(runtime::get_current_device().minor, 0);
+}
+
+TEST_F(DeviceTopology, CurrentDeviceIsPerThread) {
+  std::vector<int64_t> seen(4, -1);
+  std::vector<std::thread> threads;
+  for (int64_t t = 0; t < 4; t++) {
+    threads.emplace_back([&seen, t, this]() {
+      query->set_device(t);
+      for (int i = 0; i < 1000; i++) {
+        seen[t] = runtime::get_current_device().id;
+        if (seen[t] != t) {
+          return;
+        }
+      }
+    });
+  }
+  for (auto& th : threads) {
+    th.join();
+  }
+  ASSERT_EQ(seen, std::vector<int64_t>({0, 1, 2, 3}));
+}
+
+TEST_F(DeviceTopology, CompatibilityUsesSMVersion) {
+  auto a10_target = runtime::RTDevice(0, nvinfer1::DeviceType::kGPU);
+  auto same_sm = runtime::find_compatible_devices(a10_target, /*hardware_compatible=*/false);
+  ASSERT_EQ(same_sm.size(), 2);
+  ASSERT_EQ(same_sm[0].minor, 6);
+  ASSERT_EQ(same_sm[1].minor, 6);
+
+  // Hardware compatible engines run on any Ampere or newer GPU
+  ASSERT_EQ(runtime::find_compatible_devices(a10_target, /*hardware_compatible=*/true).size(), 4);
+
+  runtime::RTDevice dla_target;
+  dla_target.id = 0;
+  dla_target.device_type = nvinfer1::DeviceType::kDLA;
+  dla_target.device_name = "Orin";
+  auto dla = runtime::find_compatible_devices(dla_target, false);
+  ASSERT_EQ(dla.size(), 1);
+  ASSERT_EQ(dla[0].id, 3);
+}
+
+TEST_F(DeviceTopology, MostCompatiblePrefersCurrentThenTargetDevice) {
+  auto target = runtime::RTDevice(2, nvinfer1::DeviceType::kGPU);
+
+  // Device 0 and 2 both match, 0 is current
+  auto selected = runtime::get_most_compatible_device(target);
+  ASSERT_TRUE(selected);
+  ASSERT_EQ(selected->id, 0);
+
+  // Current device does not match, so the device the engine was built for wins
+  query->set_device(1);
+  selected = runtime::get_most_compatible_device(target);
+  ASSERT_TRUE(selected);
+  ASSERT_EQ(selected->id, 2);
+
+  // An explicitly passed current device takes precedence over the thread's
+  selected = runtime::get_most_compatible_device(target, runtime::RTDevice(0, nvinfer1::DeviceType::kGPU));
+  ASSERT_EQ(selected->id, 0);
+}
+
+TEST_F(DeviceTopology, ReplacingTheQueryTakesANewSnapshot) {
+  ASSERT_EQ(runtime::get_current_device().device_name, "NVIDIA A10");
+  auto single = std::make_shared<FakeDeviceQuery>(std::vector<runtime::DeviceProperties>{props(9, 0, "NVIDIA H100")});
+  runtime::set_device_query(single);
+  single->set_device(0);
+  ASSERT_EQ(runtime::get_available_device_list().get_devices().size(), 1);
+  ASSERT_EQ(runtime::get_current_device().device_name, "NVIDIA H100");
+}
+
+TEST_F(DeviceTopology, UnknownCurrentDeviceIsAnError) {
+  auto empty = std::make_shared<FakeDeviceQuery>(std::vector<runtime::DeviceProperties>{});
+  runtime::set_device_query(empty);
+  ASSERT_ANY_THROW(runtime::get_current_device());
+}
@@ -0,0 +1,135 @@
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "core/runtime/runtime.h"
+#include "gtest/gtest.h"
+
+namespace runtime = torch_tensorrt::core::runtime;
+
+namespace {
+// Stands in for TensorRT deserialization: counts calls and how many ran at the same time
+struct StubRuntime {
+  std::atomic<int> calls = {0};
+  std::atomic<int> active = {0};
+  std::atomic<int> max_active = {0};
+  std::mutex order_mu;
+  std::vector<int> order;
+
+  std::function<void()> deserializer(int id, int sleep_ms = 0) {
+    return [this, id, sleep_ms]() {
+      auto now_active = ++active;
+      int prev = max_active.load();
+      while (now_active > prev && !max_active.compare_exchange_weak(prev, now_active)) {
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(sleep_ms));
+      {
+        std::lock_guard<std::mutex> lock(order_mu);
+        order.push_back(id);
+      }
+      calls++;
+      active--;
+    };
+  }
+};
+} // namespace
+
+TEST(Runtime, EngineLoadModeDefaultsToEager) {
+  ASSERT_EQ(runtime::get_engine_load_mode(), runtime::EngineLoadMode::kEAGER);
+  runtime::set_engine_load_mode(runtime::EngineLoadMode::kLAZY);
+  ASSERT_EQ(runtime::get_engine_load_mode(), runtime::EngineLoadMode::kLAZY);
+  runtime::set_engine_load_mode(runtime::EngineLoadMode::kEAGER);
+}
+
+TEST(Runtime, DeferredLoadRunsOnceUnderContention) {
+  StubRuntime stub;
+  runtime::DeferredLoad load(stub.deserializer(0, 20));
+  ASSERT_FALSE(load.done());
+
+  std::vector<std::thread> callers;
+  for (int i = 0; i < 8; i++) {
+    callers.emplace_back([&load]() {
+      load.get();
+      // Nobody may return before the load has completed
+      ASSERT_TRUE(load.done());
+    });
+  }
+  for (auto& t : callers) {
+    t.join();
+  }
+  ASSERT_EQ(stub.calls, 1);
+  ASSERT_EQ(stub.max_active, 1);
+}
+
+TEST(Runtime, DeferredLoadReportsFailureToEveryCaller) {
+  int attempts = 0;
+  runtime::DeferredLoad load([&attempts]() {
+    attempts++;
+    throw std::runtime_error("corrupt engine");
+  });
+  ASSERT_THROW(load.get(), std::runtime_error);
+  ASSERT_THROW(load.get(), std::runtime_error);
+  ASSERT_FALSE(load.done());
+  ASSERT_EQ(attempts, 1);
+}
+
+TEST(Runtime, EngineLoadPoolRunsInSubmissionOrder) {
+  StubRuntime stub;
+  std::vector<std::unique_ptr<runtime::DeferredLoad>> engines;
+  for (int i = 0; i < 6; i++) {
+    engines.push_back(std::make_unique<runtime::DeferredLoad>(stub.deserializer(i)));
+  }
+
+  runtime::EngineLoadPool pool(1);
+  for (auto& e : engines) {
+    auto engine = e.get();
+    pool.submit([engine]() { engine->get(/*from_background=*/true); });
+  }
+  pool.wait_idle();
+  ASSERT_EQ(stub.order, std::vector<int>({0, 1, 2, 3, 4, 5}));
+}
+
+TEST(Runtime, FirstUseJumpsTheBackgroundQueue) {
+  StubRuntime stub;
+  runtime::DeferredLoad slow(stub.deserializer(0, 50));
+  runtime::DeferredLoad queued(stub.deserializer(1));
+
+  runtime::EngineLoadPool pool(1);
+  pool.submit([&slow]() { slow.get(true); });
+  pool.submit([&queued]() { queued.get(true); });
+
+  // The single worker is busy with the first engine, the second is loaded by the caller that needs it
+  queued.get();
+  ASSERT_TRUE(queued.done());
+  pool.wait_idle();
+  ASSERT_EQ(stub.calls, 2);
+  ASSERT_EQ(stub.order, std::vector<int>({1, 0}));
+}
+
+TEST(Runtime, EngineLoadMetricsCountDeferredEngines) {
+  runtime::reset_engine_load_metrics();
+  StubRuntime stub;
+  runtime::DeferredLoad foreground(stub.deserializer(0, 5));
+  runtime::DeferredLoad background(stub.deserializer(1, 5));
+  runtime::DeferredLoad unused(stub.deserializer(2));
+
+  {
+    runtime::EngineLoadPool pool(2);
+    pool.submit([&background]() { background.get(true); });
+    foreground.get();
+    pool.wait_idle();
+  }
+
+  auto metrics = runtime::get_engine_load_metrics();
+  ASSERT_EQ(metrics.deferred, 3);
+  ASSERT_EQ(metrics.loaded, 2);
+  ASSERT_EQ(metrics.loaded_in_background, 1);
+  ASSERT_EQ(metrics.failed, 0);
+  ASSERT_GE(metrics.load_ms_max, 5.0);
+  ASSERT_GE(metrics.load_ms_total, metrics.load_ms_max);
+  ASSERT_GE(metrics.wait_ms_total, 5.0);
+}
@@ -0,0 +1,128 @@
+#include "core/runtime/ShapeHistogram.h"
+#include "gtest/gtest.h"
+
+using torch_tensorrt::core::runtime::ShapeHistogram;
+
+namespace {
+ShapeHistogram::InputShapes batch(int64_t n, int64_t seq = 16) {
+  return {{n, seq}, {n}};
+}
+} // namespace
+
+TEST(ShapeHistogram, CountsDistinctShapes) {
+  ShapeHistogram histogram;
+  histogram.record(batch(1));
+  histogram.record(batch(1));
+  histogram.record(batch(4), 3);
+
+  auto entries = histogram.entries();
+  ASSERT_EQ(entries.size(), 2);
+  ASSERT_EQ(entries[batch(1)], 2);
+  ASSERT_EQ(entries[batch(4)], 3);
+  ASSERT_EQ(histogram.total(), 5);
+  ASSERT_EQ(histogram.dropped(), 0);
+
+  histogram.reset();
+  ASSERT_TRUE(histogram.entries().empty());
+  ASSERT_EQ(histogram.total(), 0);
+}
+
+TEST(ShapeHistogram, DropsShapesBeyondCapacity) {
+  ShapeHistogram histogram(/*max_entries=*/2);
+  histogram.record(batch(1));
+  histogram.record(batch(2));
+  histogram.record(batch(3));
+  // Known shapes are still counted once the histogram is full
+  histogram.record(batch(1));
+
+  ASSERT_EQ(histogram.entries().size(), 2);
+  ASSERT_EQ(histogram.entries()[batch(1)], 2);
+  ASSERT_EQ(histogram.total(), 4);
+  ASSERT_EQ(histogram.dropped(), 1);
+}
+
+TEST(ShapeHistogram, SerializationRoundTrips) {
+  ShapeHistogram histogram(/*max_entries=*/2);
+  histogram.set_input_names({"input_0", "input_1"});
+  histogram.set_input_dtypes({"Float", "Int"});
+  histogram.record(batch(1), 7);
+  histogram.record({{2, 0}, {}});
+  histogram.record(batch(3));
+
+  auto loaded = ShapeHistogram::deserialize(histogram.serialize());
+  ASSERT_EQ(loaded.entries(), histogram.entries());
+  ASSERT_EQ(loaded.total(), histogram.total());
+  ASSERT_EQ(loaded.dropped(), 1);
+  ASSERT_EQ(loaded.input_names(), histogram.input_names());
+  ASSERT_EQ(loaded.input_dtypes(), histogram.input_dtypes());
+  ASSERT_EQ(loaded.serialize(), histogram.serialize());
+
+  EXPECT_THROW(ShapeHistogram::deserialize("1 (1,2)\n"), std::exception);
+}
+
+TEST(ShapeHistogram, MergeAddsCounts) {
+  ShapeHistogram a, b;
+  a.record(batch(1), 2);
+  b.record(batch(1));
+  b.record(batch(2));
+  b.set_input_names({"x", "y"});
+  a.merge(b);
+
+  ASSERT_EQ(a.entries()[batch(1)], 3);
+  ASSERT_EQ(a.entries()[batch(2)], 1);
+  ASSERT_EQ(a.total(), 4);
+  ASSERT_EQ(a.input_names(), b.input_names());
+}
+
+TEST(ShapeHistogram, SingleProfileCoversEveryShape) {
+  ShapeHistogram histogram;
+  histogram.record(batch(1, 32), 5);
+  histogram.record(batch(8, 128), 20);
+  histogram.record(batch(4, 512), 1);
+
+  auto profiles = histogram.recommend_profiles();
+  ASSERT_EQ(profiles.size(), 1);
+  ASSERT_EQ(profiles[0].calls, 26);
+  auto& tokens = profiles[0].inputs[0];
+  ASSERT_EQ(tokens.min, std::vector<int64_t>({1, 32}));
+  ASSERT_EQ(tokens.max, std::vector<int64_t>({8, 512}));
+  // The most frequent shape, not the midpoint
+  ASSERT_EQ(tokens.opt, std::vector<int64_t>({8, 128}));
+  auto& lengths = profiles[0].inputs[1];
+  ASSERT_EQ(lengths.min, std::vector<int64_t>({1}));
+  ASSERT_EQ(lengths.opt, std::vector<int64_t>({8}));
+  ASSERT_EQ(lengths.max, std::vector<int64_t>({8}));
+}
+
+TEST(ShapeHistogram, BucketsSplitTrafficBySize) {
+  ShapeHistogram histogram;
+  histogram.record(batch(1), 50);
+  histogram.record(batch(2), 10);
+  histogram.record(batch(8), 30);
+  histogram.record(batch(16), 10);
+
+  auto profiles = histogram.recommend_profiles(2);
+  ASSERT_EQ(profiles.size(), 2);
+  ASSERT_EQ(profiles[0].calls, 50);
+  ASSERT_EQ(profiles[0].inputs[0].min, std::vector<int64_t>({1, 16}));
+  ASSERT_EQ(profiles[0].inputs[0].max, std::vector<int64_t>({1, 16}));
+  ASSERT_EQ(profiles[1].calls, 50);
+  ASSERT_EQ(profiles[1].inputs[0].min, std::vector<int64_t>({2, 16}));
+  ASSERT_EQ(profiles[1].inputs[0].opt, std::vector<int64_t>({8, 16}));
+  ASSERT_EQ(profiles[1].inputs[0].max, std::vector<int64_t>({16, 16}));
+
+  // Never more buckets than distinct shapes, and every bucket gets at least one
+  auto many = histogram.recommend_profiles(10);
+  ASSERT_EQ(many.size(), 4);
+  for (auto& p : many) {
+    ASSERT_EQ(p.inputs[0].min, p.inputs[0].max);
+  }
+}
+
+TEST(ShapeHistogram, RejectsInconsistentRanks) {
+  ShapeHistogram histogram;
+  histogram.record({{1, 16}});
+  histogram.record({{1, 16, 3}});
+  EXPECT_THROW(histogram.recommend_profiles(), std::exception);
+  EXPECT_THROW(ShapeHistogram().recommend_profiles(), std::exception);
+}
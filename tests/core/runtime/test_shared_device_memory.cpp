@@ -0,0 +1,107 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include "ATen/cuda/Sleep.h"
+#include "c10/cuda/CUDAGuard.h"
+#include "core/runtime/runtime.h"
+#include "gtest/gtest.h"
+#include "torch/torch.h"
+
+namespace runtime = torch_tensorrt::core::runtime;
+
+namespace {
+at::Tensor asTensor(const runtime::SharedDeviceMemory::Lease& lease) {
+  return at::from_blob(lease.data(), {lease.size()}, at::TensorOptions().dtype(at::kByte).device(at::kCUDA, 0));
+}
+} // namespace
+
+TEST(Runtime, SharedDeviceMemoryIsSizedToLargestEngine) {
+  runtime::SharedDeviceMemory memory;
+  memory.register_engine(0, 1 << 20);
+  memory.register_engine(0, 4 << 20);
+  memory.register_engine(0, 2 << 20);
+
+  auto caller = c10::cuda::getStreamFromPool(false, 0);
+  void* first;
+  {
+    auto lease = memory.acquire(0, caller, c10::cuda::getStreamFromPool(false, 0), 1 << 20);
+    ASSERT_EQ(lease.size(), 4 << 20);
+    first = lease.data();
+  }
+  {
+    // A different engine stream called from the same caller stream reuses the buffer
+    auto lease = memory.acquire(0, caller, c10::cuda::getStreamFromPool(false, 0), 2 << 20);
+    ASSERT_EQ(lease.data(), first);
+  }
+  ASSERT_EQ(memory.allocated_bytes(), 4 << 20);
+}
+
+TEST(Runtime, SharedDeviceMemoryKeepsCallerStreamsApart) {
+  runtime::SharedDeviceMemory memory;
+  memory.register_engine(0, 1 << 20);
+  auto caller_a = c10::cuda::getStreamFromPool(false, 0);
+  auto caller_b = c10::cuda::getStreamFromPool(true, 0);
+  ASSERT_NE(caller_a.id(), caller_b.id());
+
+  auto lease_a = memory.acquire(0, caller_a, caller_a, 1 << 20);
+  // Would block forever if both caller streams shared one buffer
+  auto lease_b = memory.acquire(0, caller_b, caller_b, 1 << 20);
+  ASSERT_NE(lease_a.data(), lease_b.data());
+}
+
+TEST(Runtime, SharedDeviceMemoryLeaseIsExclusive) {
+  runtime::SharedDeviceMemory memory;
+  memory.register_engine(0, 1024);
+  auto caller = c10::cuda::getStreamFromPool(false, 0);
+
+  std::atomic<bool> acquired = {false};
+  std::thread other;
+  {
+    auto lease = memory.acquire(0, caller, caller, 1024);
+    other = std::thread([&]() {
+      c10::cuda::CUDAGuard device_guard(0);
+      auto other_lease = memory.acquire(0, caller, caller, 1024);
+      acquired = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ASSERT_FALSE(acquired);
+  }
+  other.join();
+  ASSERT_TRUE(acquired);
+}
+
+TEST(Runtime, SharedDeviceMemoryOrdersUsersOnTheGPU) {
+  runtime::SharedDeviceMemory memory;
+  memory.register_engine(0, 1 << 20);
+  auto caller = c10::cuda::getStreamFromPool(false, 0);
+  auto engine_a = c10::cuda::getStreamFromPool(false, 0);
+  auto engine_b = c10::cuda::getStreamFromPool(false, 0);
+  at::Tensor seen;
+
+  {
+    auto lease = memory.acquire(0, caller, engine_a, 1 << 20);
+    c10::cuda::CUDAStreamGuard stream_guard(engine_a);
+    // Slow writer: without ordering the reader below would run before the fill
+    at::cuda::sleep(100000000);
+    asTensor(lease).fill_(7);
+  }
+  {
+    auto lease = memory.acquire(0, caller, engine_b, 1 << 20);
+    c10::cuda::CUDAStreamGuard stream_guard(engine_b);
+    seen = asTensor(lease).clone();
+  }
+  torch::cuda::synchronize();
+  ASSERT_TRUE(seen.eq(7).all().item<bool>());
+}
+
+TEST(Runtime, SharedDeviceMemoryCanBeReleased) {
+  runtime::SharedDeviceMemory memory;
+  memory.register_engine(0, 1 << 20);
+  auto caller = c10::cuda::getStreamFromPool(false, 0);
+  { auto lease = memory.acquire(0, caller, caller, 1 << 20); }
+  ASSERT_EQ(memory.allocated_bytes(), 1 << 20);
+  memory.release();
+  ASSERT_EQ(memory.allocated_bytes(), 0);
+  { auto lease = memory.acquire(0, caller, caller, 1 << 20); }
+  ASSERT_EQ(memory.allocated_bytes(), 1 << 20);
+}
@@ -1,3 +1,4 @@
+#include "core/runtime/runtime.h"
 #include "cpp_api_test.h"
 
 std::vector<torch_tensorrt::Input> toInputRangesDynamic(std::vector<std::vector<int64_t>> opts) {
@@ -77,6 +78,34 @@ TEST_P(CppAPITests, SerializedDynamicModuleIsStillCorrect) {
   }
 }
 
+TEST_P(CppAPITests, DeferredEngineLoadingIsStillCorrect) {
+  namespace runtime = torch_tensorrt::core::runtime;
+  std::vector<torch::jit::IValue> inputs_ivalues;
+  for (uint64_t i = 0; i < input_shapes.size(); i++) {
+    inputs_ivalues.push_back(at::randint(5, input_shapes[i], {at::kCUDA}).to(input_types[i]));
+  }
+
+  auto trt_mod = torch_tensorrt::ts::compile(mod, input_shapes);
+  auto expected = torch_tensorrt::tests::util::RunModuleForward(trt_mod, inputs_ivalues).toTensor();
+  trt_mod.save("test_deferred_loading_mod.ts");
+
+  for (auto mode : {runtime::EngineLoadMode::kLAZY, runtime::EngineLoadMode::kBACKGROUND}) {
+    runtime::set_engine_load_mode(mode);
+    runtime::reset_engine_load_metrics();
+    auto loaded_mod = torch::jit::load("test_deferred_loading_mod.ts");
+    auto metrics = runtime::get_engine_load_metrics();
+    ASSERT_GT(metrics.deferred, 0);
+
+    auto result = torch_tensorrt::tests::util::RunModuleForward(loaded_mod, inputs_ivalues).toTensor();
+    ASSERT_TRUE(torch_tensorrt::tests::util::cosineSimEqual(result, expected.reshape_as(result)));
+    runtime::EngineLoadPool::global().wait_idle();
+    metrics = runtime::get_engine_load_metrics();
+    ASSERT_EQ(metrics.loaded, metrics.deferred);
+    ASSERT_EQ(metrics.failed, 0);
+  }
+  runtime::set_engine_load_mode(runtime::EngineLoadMode::kEAGER);
+}
+
 INSTANTIATE_TEST_SUITE_P(
     CompiledModuleForwardIsCloseSuite,
     CppAPITests,
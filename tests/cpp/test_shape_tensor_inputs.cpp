@@ -0,0 +1,123 @@
+#include <torch/torch.h>
+#include <string>
+#include "NvInfer.h"
+#include "core/compiler.h"
+#include "core/runtime/runtime.h"
+#include "core/util/logging/TorchTRTLogger.h"
+#include "core/util/trt_util.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/csrc/jit/ir/irparser.h"
+
+namespace {
+// TorchScript reference, reshapes %x to the two values held by %shape
+const auto reshape_graph = R"IR(
+    graph(%x : Tensor, %shape : Tensor):
+          %0 : int = prim::Constant[value=0]()
+          %1 : int = prim::Constant[value=1]()
+          %d0.t : Tensor = aten::select(%shape, %0, %0)
+          %d1.t : Tensor = aten::select(%shape, %0, %1)
+          %d0 : int = aten::Int(%d0.t)
+          %d1 : int = aten::Int(%d1.t)
+          %size : int[] = prim::ListConstruct(%d0, %d1)
+          %y : Tensor = aten::reshape(%x, %size)
+          return (%y))IR";
+
+// Engine with the same computation where input_1 is a shape tensor of shape_type, so its values are read from host
+// memory by TensorRT when the engine is run
+std::string build_reshape_engine(nvinfer1::DataType shape_type) {
+  auto builder = nvinfer1::make_trt(nvinfer1::createInferBuilder(torch_tensorrt::core::util::logging::get_logger()));
+  auto net = nvinfer1::make_trt(
+      builder->createNetworkV2(1U << static_cast<uint32_t>(nvinfer1::NetworkDefinitionCreationFlag::kEXPLICIT_BATCH)));
+  auto x = net->addInput("input_0", nvinfer1::DataType::kFLOAT, nvinfer1::Dims{1, {-1}});
+  auto shape = net->addInput("input_1", shape_type, nvinfer1::Dims{1, {2}});
+  auto reshape = net->addShuffle(*x);
+  reshape->setInput(1, *shape);
+  reshape->getOutput(0)->setName("output_0");
+  net->markOutput(*reshape->getOutput(0));
+
+  auto cfg = nvinfer1::make_trt(builder->createBuilderConfig());
+  auto profile = builder->createOptimizationProfile();
+  profile->setDimensions("input_0", nvinfer1::OptProfileSelector::kMIN, nvinfer1::Dims{1, {1}});
+  profile->setDimensions("input_0", nvinfer1::OptProfileSelector::kOPT, nvinfer1::Dims{1, {24}});
+  profile->setDimensions("input_0", nvinfer1::OptProfileSelector::kMAX, nvinfer1::Dims{1, {64}});
+  int32_t min_shape[] = {1, 1};
+  int32_t opt_shape[] = {4, 6};
+  int32_t max_shape[] = {8, 8};
+  profile->setShapeValues("input_1", nvinfer1::OptProfileSelector::kMIN, min_shape, 2);
+  profile->setShapeValues("input_1", nvinfer1::OptProfileSelector::kOPT, opt_shape, 2);
+  profile->setShapeValues("input_1", nvinfer1::OptProfileSelector::kMAX, max_shape, 2);
+  cfg->addOptimizationProfile(profile);
+
+  auto serialized = nvinfer1::make_trt(builder->buildSerializedNetwork(*net, *cfg));
+  return std::string(static_cast<const char*>(serialized->data()), serialized->size());
+}
+
+void expect_matches_torchscript(std::string& engine, const at::Tensor& x, const at::Tensor& shape) {
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(reshape_graph, g.get());
+  auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+  auto jit_results = torch_tensorrt::tests::util::RunGraph(g, params, {x, shape});
+
+  auto trt_results = torch_tensorrt::tests::util::RunEngine(engine, {x, shape});
+
+  ASSERT_TRUE(torch_tensorrt::tests::util::exactlyEqual(jit_results[0], trt_results[0]));
+}
+} // namespace
+
+TEST(Runtime, ShapeTensorInputFromHostInt64) {
+  // Contiguous host int64 values are handed to TensorRT without staging
+  auto engine = build_reshape_engine(nvinfer1::DataType::kINT64);
+  auto x = at::randn({24}, {at::kCUDA});
+  expect_matches_torchscript(engine, x, at::tensor({4, 6}, at::kLong));
+}
+
+TEST(Runtime, ShapeTensorInputFromNonContiguousHostInt64) {
+  auto engine = build_reshape_engine(nvinfer1::DataType::kINT64);
+  auto x = at::randn({24}, {at::kCUDA});
+  auto shape = at::tensor({3, 0, 8, 0}, at::kLong).slice(0, 0, 4, 2);
+  ASSERT_FALSE(shape.is_contiguous());
+  expect_matches_torchscript(engine, x, shape);
+}
+
+TEST(Runtime, ShapeTensorInputFromHostInt32) {
+  // Values stay in the int32 of the binding
+  auto engine = build_reshape_engine(nvinfer1::DataType::kINT32);
+  auto x = at::randn({24}, {at::kCUDA});
+  expect_matches_torchscript(engine, x, at::tensor({6, 4}, at::kInt));
+  expect_matches_torchscript(engine, x, at::tensor({2, 0, 12, 0}, at::kInt).slice(0, 0, 4, 2));
+}
+
+TEST(Runtime, ShapeTensorInputFromDevice) {
+  // Device values are copied into the pinned staging buffer before enqueue
+  auto engine = build_reshape_engine(nvinfer1::DataType::kINT64);
+  auto x = at::randn({24}, {at::kCUDA});
+  expect_matches_torchscript(engine, x, at::tensor({8, 3}, at::kLong).to(at::kCUDA));
+}
+
+TEST(Runtime, ShapeTensorInputStagingBufferIsRefreshedEveryCall) {
+  // The staging buffer of an engine is reused across calls and sources, values must never be stale
+  auto engine = build_reshape_engine(nvinfer1::DataType::kINT64);
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(reshape_graph, g.get());
+  auto engine_ptr = c10::make_intrusive<torch_tensorrt::core::runtime::TRTEngine>(
+      "test_engine",
+      engine,
+      torch_tensorrt::core::runtime::RTDevice(0, nvinfer1::DeviceType::kGPU),
+      std::vector<std::string>(),
+      std::vector<std::string>());
+
+  std::vector<at::Tensor> shapes = {
+      at::tensor({4, 6}, at::kLong).to(at::kCUDA),
+      at::tensor({2, 0, 5, 0}, at::kLong).slice(0, 0, 4, 2),
+      at::tensor({5, 2}, at::kLong).to(at::kCUDA),
+      at::tensor({1, 7}, at::kLong),
+      at::tensor({7, 0, 1, 0}, at::kLong).slice(0, 0, 4, 2)};
+  for (auto& shape : shapes) {
+    auto x = at::randn({shape[0].item<int64_t>() * shape[1].item<int64_t>()}, {at::kCUDA});
+    auto params = torch_tensorrt::core::ir::get_static_params(g->inputs(), {});
+    auto jit_results = torch_tensorrt::tests::util::RunGraph(g, params, {x, shape});
+    auto trt_results = torch_tensorrt::core::runtime::execute_engine({x, shape}, engine_ptr);
+    ASSERT_TRUE(torch_tensorrt::tests::util::exactlyEqual(jit_results[0], trt_results[0]));
+  }
+}
@@ -0,0 +1,66 @@
+#include <string>
+#include <thread>
+#include "c10/cuda/CUDAGuard.h"
+#include "core/runtime/runtime.h"
+#include "gtest/gtest.h"
+#include "tests/util/util.h"
+#include "torch/script.h"
+#include "torch_tensorrt/torch_tensorrt.h"
+
+namespace runtime = torch_tensorrt::core::runtime;
+
+namespace {
+// Splits ResNet18 into several engines by running every add in torch
+torch::jit::Module compileHybridResNet(torch::jit::Module& mod) {
+  std::vector<torch_tensorrt::Input> inputs = {torch_tensorrt::Input(std::vector<int64_t>{1, 3, 224, 224})};
+  torch_tensorrt::ts::CompileSpec cfg(inputs);
+  cfg.torch_executed_ops.push_back("aten::add");
+  return torch_tensorrt::ts::compile(mod, cfg);
+}
+} // namespace
+
+TEST(CppAPITests, SharedDeviceMemoryHybridModuleIsCorrect) {
+  torch::jit::Module mod;
+  try {
+    mod = torch::jit::load("tests/modules/resnet18_scripted.jit.pt");
+  } catch (const c10::Error& e) {
+    std::cerr << "error loading the model\n";
+    ASSERT_TRUE(false);
+  }
+  mod.eval();
+  mod.to(torch::kCUDA);
+
+  runtime::set_shared_device_memory_mode(true);
+  runtime::SharedDeviceMemory::global().release();
+  auto trt_mod = compileHybridResNet(mod);
+  runtime::set_shared_device_memory_mode(false);
+
+  auto in = at::randint(5, {1, 3, 224, 224}, {at::kCUDA});
+  auto jit_results = mod.forward({in.clone()}).toTensor();
+  auto trt_results = trt_mod.forward({in.clone()}).toTensor();
+  ASSERT_TRUE(torch_tensorrt::tests::util::cosineSimEqual(jit_results, trt_results));
+  // Every engine ran from the default stream, so they all used the one buffer
+  ASSERT_GT(runtime::SharedDeviceMemory::global().allocated_bytes(), 0);
+
+  // Concurrent callers, some on their own streams and some sharing the default stream
+  int num_threads = 8;
+  std::vector<at::Tensor> trt_out(num_threads);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < num_threads; i++) {
+    threads.emplace_back([&, i]() {
+      c10::cuda::CUDAGuard device_guard(0);
+      auto stream = i % 2 ? c10::cuda::getStreamFromPool(false, 0) : c10::cuda::getDefaultCUDAStream(0);
+      c10::cuda::CUDAStreamGuard stream_guard(stream);
+      for (int iter = 0; iter < 5; iter++) {
+        trt_out[i] = trt_mod.forward({in.clone()}).toTensor();
+      }
+      stream.synchronize();
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  for (int i = 0; i < num_threads; i++) {
+    ASSERT_TRUE(torch_tensorrt::tests::util::cosineSimEqual(jit_results, trt_out[i]));
+  }
+}
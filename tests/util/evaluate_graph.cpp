@@ -23,6 +23,10 @@ std::vector<torch::jit::IValue> EvaluateGraph(const torch::jit::Block* b, std::v
   }
   LOG_DEBUG("Checking nodes");
   for (const auto n : b->nodes()) {
+    if (n->kind() == torch::jit::prim::Loop) {
+      core::conversion::EvaluateLoopBlock(ctx, n);
+      continue;
+    }
     TORCHTRT_CHECK(
         core::conversion::evaluators::shouldEvalAtConversionTime(n),
         "Test graph contains non evaluatable nodes: " << *n);
@@ -11,6 +11,7 @@
 #include "torch/custom_class.h"
 
 #include <math.h>
+#include <memory>
 #include <vector>
 
 namespace torch_tensorrt {
@@ -90,6 +91,21 @@ std::vector<at::Tensor> RunGraphEngine(
   return RunEngine(eng, inputs);
 }
 
+std::unique_ptr<core::conversion::ConversionCtx> ConvertGraphToNetwork(
+    std::shared_ptr<torch::jit::Graph>& g,
+    core::ir::StaticParams& named_params,
+    std::vector<at::Tensor> inputs,
+    nvinfer1::DataType op_precision) {
+  auto var_ins = get_var_inputs(g->inputs(), named_params);
+  auto in = core::ir::pair_input_vals_with_specs(var_ins, toInputs(inputs));
+  auto info = core::conversion::ConversionInfo();
+  info.inputs = std::move(in);
+  info.engine_settings.enabled_precisions.insert(op_precision);
+  auto ctx = std::make_unique<core::conversion::ConversionCtx>(info.engine_settings);
+  core::conversion::ConvertBlockToNetDef(ctx.get(), g->block(), info, named_params);
+  return ctx;
+}
+
 std::vector<at::Tensor> RunGraphEngineDynamic(
     std::shared_ptr<torch::jit::Graph>& g,
     core::ir::StaticParams& named_params,
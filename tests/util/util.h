@@ -1,9 +1,11 @@
 #pragma once
 
 #include <ATen/ATen.h>
+#include <memory>
 #include <string>
 #include <vector>
 #include "ATen/Tensor.h"
+#include "core/conversion/conversionctx/ConversionCtx.h"
 #include "core/ir/ir.h"
 #include "core/util/prelude.h"
 #include "torch/csrc/jit/ir/irparser.h"
@@ -51,6 +53,14 @@ std::vector<at::Tensor> RunGraphEngine(
     std::vector<at::Tensor> inputs,
     nvinfer1::DataType dtype = nvinfer1::DataType::kFLOAT);
 
+// Converts an arbitrary JIT graph to a TensorRT network without building an engine and returns the conversion context
+// holding it, so the layers and the weights kept for them can be inspected
+std::unique_ptr<core::conversion::ConversionCtx> ConvertGraphToNetwork(
+    std::shared_ptr<torch::jit::Graph>& g,
+    core::ir::StaticParams& named_params,
+    std::vector<at::Tensor> inputs,
+    nvinfer1::DataType dtype = nvinfer1::DataType::kFLOAT);
+
 // Runs an arbitrary JIT graph with dynamic input sizes by converting it to
 // TensorRT and running inference and returns results
 std::vector<at::Tensor> RunGraphEngineDynamic(
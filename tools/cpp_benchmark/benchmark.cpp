@@ -0,0 +1,256 @@
+#include "benchmark.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <iomanip>
+#include <limits>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#include "timer.h"
+
+namespace benchmark {
+
+std::vector<std::vector<int64_t>> parse_shape_variants(const std::string& spec) {
+  std::vector<std::vector<int64_t>> variants;
+  std::istringstream spec_stream(spec);
+  std::string shape_str;
+  while (std::getline(spec_stream, shape_str, ';')) {
+    std::replace_if(
+        shape_str.begin(), shape_str.end(), [](char c) { return c == '(' || c == ')' || c == ','; }, ' ');
+    std::istringstream shape_stream(shape_str);
+    std::vector<int64_t> shape;
+    std::string dim;
+    while (shape_stream >> dim) {
+      size_t consumed = 0;
+      auto d = std::stoll(dim, &consumed);
+      if (consumed != dim.size() || d <= 0) {
+        throw std::invalid_argument("Invalid dimension '" + dim + "' in input spec " + spec);
+      }
+      shape.push_back(d);
+    }
+    if (shape.empty()) {
+      throw std::invalid_argument("Empty shape in input spec " + spec);
+    }
+    variants.push_back(std::move(shape));
+  }
+  if (variants.empty()) {
+    throw std::invalid_argument("Input spec " + spec + " does not contain any shapes");
+  }
+  return variants;
+}
+
+double percentile(const std::vector<double>& sorted, double p) {
+  if (sorted.empty()) {
+    return 0.0;
+  }
+  auto rank = static_cast<size_t>(std::ceil((p / 100.0) * sorted.size()));
+  rank = std::min(std::max<size_t>(rank, 1), sorted.size());
+  return sorted[rank - 1];
+}
+
+LatencyStats compute_latency_stats(std::vector<double> latencies_ms) {
+  LatencyStats stats;
+  if (latencies_ms.empty()) {
+    return stats;
+  }
+  std::sort(latencies_ms.begin(), latencies_ms.end());
+
+  stats.count = latencies_ms.size();
+  stats.mean_ms = std::accumulate(latencies_ms.begin(), latencies_ms.end(), 0.0) / stats.count;
+  double sq_sum = 0.0;
+  for (auto l : latencies_ms) {
+    sq_sum += (l - stats.mean_ms) * (l - stats.mean_ms);
+  }
+  stats.stddev_ms = std::sqrt(sq_sum / stats.count);
+  stats.min_ms = latencies_ms.front();
+  stats.p50_ms = percentile(latencies_ms, 50);
+  stats.p90_ms = percentile(latencies_ms, 90);
+  stats.p99_ms = percentile(latencies_ms, 99);
+  stats.max_ms = latencies_ms.back();
+  return stats;
+}
+
+BenchmarkResult run_benchmark(const std::string& name, const InferenceFn& fn, const BenchmarkConfig& config) {
+  if (config.concurrency == 0) {
+    throw std::invalid_argument("Benchmark concurrency must be at least 1");
+  }
+  if (config.min_iters == 0 && config.min_duration_s <= 0.0) {
+    throw std::invalid_argument("Benchmark needs either a minimum iteration count or a minimum duration");
+  }
+
+  for (uint64_t i = 0; i < config.warmup_iters; i++) {
+    fn(0, i);
+  }
+
+  using clock = std::chrono::steady_clock;
+  std::atomic<uint64_t> next_iter{0};
+  std::atomic<bool> go{false};
+  std::atomic<bool> failed{false};
+  std::vector<std::vector<double>> per_thread_latencies(config.concurrency);
+  // An exception escaping a std::thread terminates the process, so failures are captured and rethrown once all
+  // callers have stopped
+  std::vector<std::exception_ptr> per_thread_errors(config.concurrency);
+  clock::time_point start;
+
+  auto worker = [&](uint64_t thread_id) {
+    auto& latencies = per_thread_latencies[thread_id];
+    auto timer = timers::PreciseCPUTimer();
+    while (!go.load(std::memory_order_acquire)) {
+      std::this_thread::yield();
+    }
+    try {
+      while (!failed.load(std::memory_order_relaxed)) {
+        auto iter = next_iter.fetch_add(1, std::memory_order_relaxed);
+        if (iter >= config.min_iters) {
+          std::chrono::duration<double> elapsed = clock::now() - start;
+          if (elapsed.count() >= config.min_duration_s) {
+            break;
+          }
+        }
+        timer.start();
+        fn(thread_id, iter);
+        timer.stop();
+        latencies.push_back(timer.milliseconds());
+        timer.reset();
+      }
+    } catch (...) {
+      per_thread_errors[thread_id] = std::current_exception();
+      failed.store(true, std::memory_order_relaxed);
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(config.concurrency - 1);
+  for (uint64_t t = 1; t < config.concurrency; t++) {
+    threads.emplace_back(worker, t);
+  }
+  start = clock::now();
+  go.store(true, std::memory_order_release);
+  worker(0);
+  for (auto& t : threads) {
+    t.join();
+  }
+  std::chrono::duration<double> wall_time = clock::now() - start;
+
+  for (uint64_t t = 0; t < config.concurrency; t++) {
+    if (!per_thread_errors[t]) {
+      continue;
+    }
+    try {
+      std::rethrow_exception(per_thread_errors[t]);
+    } catch (const std::exception& e) {
+      throw std::runtime_error("Benchmark " + name + " failed in caller thread " + std::to_string(t) + ": " + e.what());
+    } catch (...) {
+      throw std::runtime_error("Benchmark " + name + " failed in caller thread " + std::to_string(t));
+    }
+  }
+
+  std::vector<double> latencies;
+  for (auto& l : per_thread_latencies) {
+    latencies.insert(latencies.end(), l.begin(), l.end());
+  }
+
+  BenchmarkResult result;
+  result.name = name;
+  result.config = config;
+  result.iterations = latencies.size();
+  result.latency = compute_latency_stats(std::move(latencies));
+  result.wall_time_s = wall_time.count();
+  if (result.wall_time_s > 0) {
+    result.throughput_qps = result.iterations / result.wall_time_s;
+    result.throughput_samples_per_s = result.throughput_qps * config.batch_size;
+  }
+  return result;
+}
+
+void print_report(std::ostream& os, const BenchmarkResult& result) {
+  auto& l = result.latency;
+  os << "[" << result.name << "]: batch_size: " << result.config.batch_size
+     << ", concurrency: " << result.config.concurrency << "\n"
+     << "    Iterations: " << result.iterations << " in " << result.wall_time_s << " s\n"
+     << "    Latency (ms): mean " << l.mean_ms << ", stddev " << l.stddev_ms << ", min " << l.min_ms << ", p50 "
+     << l.p50_ms << ", p90 " << l.p90_ms << ", p99 " << l.p99_ms << ", max " << l.max_ms << "\n"
+     << "    Throughput: " << result.throughput_qps << " qps, " << result.throughput_samples_per_s << " samples/s\n"
+     << "(excluding " << result.config.warmup_iters << " warmup runs)" << std::endl;
+}
+
+namespace {
+std::string escape(const std::string& s) {
+  std::ostringstream ss;
+  for (auto c : s) {
+    switch (c) {
+      case '"':
+        ss << "\\\"";
+        break;
+      case '\\':
+        ss << "\\\\";
+        break;
+      case '\n':
+        ss << "\\n";
+        break;
+      case '\t':
+        ss << "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          ss << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec;
+        } else {
+          ss << c;
+        }
+    }
+  }
+  return ss.str();
+}
+
+// JSON has no representation for inf / nan
+double finite(double v) {
+  return std::isfinite(v) ? v : 0.0;
+}
+} // namespace
+
+std::string to_json(const std::vector<BenchmarkResult>& results, const std::map<std::string, std::string>& metadata) {
+  std::ostringstream ss;
+  ss << std::setprecision(std::numeric_limits<double>::max_digits10);
+  ss << "{\n  \"metadata\": {";
+  bool first = true;
+  for (auto& kv : metadata) {
+    ss << (first ? "\n" : ",\n") << "    \"" << escape(kv.first) << "\": \"" << escape(kv.second) << "\"";
+    first = false;
+  }
+  ss << (metadata.empty() ? "},\n" : "\n  },\n");
+  ss << "  \"benchmarks\": [";
+  for (size_t i = 0; i < results.size(); i++) {
+    auto& r = results[i];
+    auto& l = r.latency;
+    ss << (i == 0 ? "\n" : ",\n");
+    ss << "    {\n"
+       << "      \"name\": \"" << escape(r.name) << "\",\n"
+       << "      \"batch_size\": " << r.config.batch_size << ",\n"
+       << "      \"concurrency\": " << r.config.concurrency << ",\n"
+       << "      \"warmup_iters\": " << r.config.warmup_iters << ",\n"
+       << "      \"iterations\": " << r.iterations << ",\n"
+       << "      \"wall_time_s\": " << finite(r.wall_time_s) << ",\n"
+       << "      \"throughput_qps\": " << finite(r.throughput_qps) << ",\n"
+       << "      \"throughput_samples_per_s\": " << finite(r.throughput_samples_per_s) << ",\n"
+       << "      \"latency_ms\": {\n"
+       << "        \"mean\": " << finite(l.mean_ms) << ",\n"
+       << "        \"stddev\": " << finite(l.stddev_ms) << ",\n"
+       << "        \"min\": " << finite(l.min_ms) << ",\n"
+       << "        \"p50\": " << finite(l.p50_ms) << ",\n"
+       << "        \"p90\": " << finite(l.p90_ms) << ",\n"
+       << "        \"p99\": " << finite(l.p99_ms) << ",\n"
+       << "        \"max\": " << finite(l.max_ms) << "\n"
+       << "      }\n"
+       << "    }";
+  }
+  ss << (results.empty() ? "]\n}\n" : "\n  ]\n}\n");
+  return ss.str();
+}
+
+} // namespace benchmark
@@ -0,0 +1,64 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace benchmark {
+
+struct BenchmarkConfig {
+  // Untimed iterations run on a single thread before measurement starts
+  uint64_t warmup_iters = 20;
+  // Measurement runs until at least min_iters iterations have completed and min_duration_s has elapsed
+  uint64_t min_iters = 100;
+  double min_duration_s = 0.0;
+  // Number of caller threads issuing inferences concurrently
+  uint64_t concurrency = 1;
+  // Samples processed per inference, used to derive sample throughput
+  uint64_t batch_size = 1;
+};
+
+// Performs one complete (synchronized) inference. thread_id is in [0, concurrency) and iteration is the
+// global index of the inference, which callers can use to cycle through pre-generated input sets.
+using InferenceFn = std::function<void(uint64_t thread_id, uint64_t iteration)>;
+
+struct LatencyStats {
+  uint64_t count = 0;
+  double mean_ms = 0.0;
+  double stddev_ms = 0.0;
+  double min_ms = 0.0;
+  double p50_ms = 0.0;
+  double p90_ms = 0.0;
+  double p99_ms = 0.0;
+  double max_ms = 0.0;
+};
+
+struct BenchmarkResult {
+  std::string name;
+  BenchmarkConfig config;
+  LatencyStats latency;
+  uint64_t iterations = 0;
+  double wall_time_s = 0.0;
+  double throughput_qps = 0.0;
+  double throughput_samples_per_s = 0.0;
+};
+
+// Parses an input spec of one or more shapes separated by ';', e.g. "(1 3 224 224)" or "(1,3,224,224);(8,3,224,224)".
+// Multiple shapes describe a dynamic input whose shape variants are cycled through during the benchmark.
+std::vector<std::vector<int64_t>> parse_shape_variants(const std::string& spec);
+
+// Nearest-rank percentile over an ascending sorted sample, p in [0, 100]
+double percentile(const std::vector<double>& sorted, double p);
+
+LatencyStats compute_latency_stats(std::vector<double> latencies_ms);
+
+// Throws std::runtime_error naming the caller thread if fn throws in any of them, after all callers have stopped
+BenchmarkResult run_benchmark(const std::string& name, const InferenceFn& fn, const BenchmarkConfig& config);
+
+void print_report(std::ostream& os, const BenchmarkResult& result);
+
+std::string to_json(const std::vector<BenchmarkResult>& results, const std::map<std::string, std::string>& metadata = {});
+
+} // namespace benchmark
@@ -0,0 +1,88 @@
+#include "third_party/args/args.hpp"
+#include "torch/csrc/jit/ir/irparser.h"
+#include "torch/script.h"
+
+#include "benchmark.h"
+#include "core/conversion/evaluators/evaluators.h"
+
+#include <iostream>
+#include <memory>
+#include <sstream>
+
+namespace {
+
+// Shape-math style graph: long chains of scalar ops over a few schemas, interleaved with tensor ops that have no
+// evaluator for their schema so both outcomes of the lookup are exercised
+std::string shape_math_graph(uint64_t num_nodes) {
+  std::stringstream ir;
+  ir << "graph(%x : Tensor, %a : int):\n";
+  ir << "  %one : int = prim::Constant[value=1]()\n";
+  ir << "  %two : int = prim::Constant[value=2]()\n";
+  std::string cur = "%a";
+  for (uint64_t i = 0; i < num_nodes; i++) {
+    auto s = std::to_string(i);
+    switch (i % 4) {
+      case 0:
+        ir << "  %v" << s << " : int = aten::add(" << cur << ", %one)\n";
+        break;
+      case 1:
+        ir << "  %v" << s << " : int = aten::mul(" << cur << ", %two)\n";
+        break;
+      case 2:
+        ir << "  %v" << s << " : int = aten::floordiv(" << cur << ", %two)\n";
+        break;
+      default:
+        ir << "  %t" << s << " : Tensor = aten::add(%x, %x, " << cur << ")\n";
+        continue;
+    }
+    cur = "%v" + s;
+  }
+  ir << "  return (" << cur << ")";
+  return ir.str();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  args::ArgumentParser parser("Benchmarks evaluator lookup over a graph of shape computations", "");
+  args::HelpFlag help(parser, "help", "Display this help menu", {'h', "help"});
+  args::ValueFlag<uint64_t> nodes(parser, "nodes", "Number of nodes in the graph (default 20000)", {"nodes"}, 20000);
+  args::ValueFlag<uint64_t> warmup(parser, "warmup", "Number of untimed warmup iterations (default 5)", {"warmup"}, 5);
+  args::ValueFlag<uint64_t> iterations(
+      parser, "iterations", "Minimum number of timed iterations (default 50)", {"iterations"}, 50);
+
+  try {
+    parser.ParseCLI(argc, argv);
+  } catch (args::Help const&) {
+    std::cout << parser;
+    return 0;
+  } catch (args::ParseError const& e) {
+    std::cerr << e.what() << std::endl << std::endl << parser;
+    return 1;
+  }
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(shape_math_graph(args::get(nodes)), g.get());
+  std::vector<const torch::jit::Node*> graph_nodes(g->nodes().begin(), g->nodes().end());
+
+  benchmark::BenchmarkConfig config;
+  config.warmup_iters = args::get(warmup);
+  config.min_iters = args::get(iterations);
+  config.batch_size = graph_nodes.size();
+
+  namespace evaluators = torch_tensorrt::core::conversion::evaluators;
+  uint64_t evaluatable = 0;
+  auto fn = [&](uint64_t, uint64_t) {
+    // Mirrors conversion, which checks whether a node can be evaluated before fetching its evaluator
+    evaluatable = 0;
+    for (auto n : graph_nodes) {
+      if (evaluators::shouldEvalAtConversionTime(n)) {
+        evaluatable += evaluators::getEvaluator(n) ? 1 : 0;
+      }
+    }
+  };
+  auto result = benchmark::run_benchmark("Evaluator lookup", fn, config);
+  benchmark::print_report(std::cout, result);
+  std::cout << "Evaluatable nodes: " << evaluatable << " / " << graph_nodes.size() << std::endl;
+  return 0;
+}
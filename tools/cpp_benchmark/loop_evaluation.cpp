@@ -0,0 +1,94 @@
+#include "third_party/args/args.hpp"
+#include "torch/csrc/jit/ir/irparser.h"
+#include "torch/script.h"
+
+#include "benchmark.h"
+#include "core/conversion/conversion.h"
+#include "core/conversion/conversionctx/ConversionCtx.h"
+
+#include <iostream>
+#include <memory>
+#include <sstream>
+
+namespace {
+
+// A shape-computation style loop: every trip runs a chain of scalar evaluators over two loop-carried ints
+std::string loop_graph(uint64_t body_chains) {
+  std::stringstream ir;
+  ir << "graph(%n : int, %a0 : int, %b0 : int):\n";
+  ir << "  %true : bool = prim::Constant[value=1]()\n";
+  ir << "  %three : int = prim::Constant[value=3]()\n";
+  ir << "  %mod : int = prim::Constant[value=1000003]()\n";
+  ir << "  %a : int, %b : int = prim::Loop(%n, %true, %a0, %b0)\n";
+  ir << "    block0(%i : int, %a_in : int, %b_in : int):\n";
+  std::string cur = "%a_in";
+  for (uint64_t c = 0; c < body_chains; c++) {
+    auto s = std::to_string(c);
+    ir << "      %x" << s << " : int = aten::mul(" << cur << ", %three)\n";
+    ir << "      %q" << s << " : int = aten::floordiv(%x" << s << ", %mod)\n";
+    ir << "      %m" << s << " : int = aten::mul(%q" << s << ", %mod)\n";
+    ir << "      %r" << s << " : int = aten::sub(%x" << s << ", %m" << s << ")\n";
+    ir << "      %y" << s << " : int = aten::add(%r" << s << ", %i)\n";
+    cur = "%y" + s;
+  }
+  ir << "      %b_out : int = aten::add(%b_in, " << cur << ")\n";
+  ir << "      -> (%true, " << cur << ", %b_out)\n";
+  ir << "  return (%a, %b)";
+  return ir.str();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  args::ArgumentParser parser("Benchmarks conversion time evaluation of a large prim::Loop", "");
+  args::HelpFlag help(parser, "help", "Display this help menu", {'h', "help"});
+  args::ValueFlag<int64_t> trips(parser, "trips", "Trip count of the loop (default 10000)", {"trips"}, 10000);
+  args::ValueFlag<uint64_t> chains(
+      parser, "chains", "Number of 5 evaluator chains in the loop body (default 4)", {"chains"}, 4);
+  args::ValueFlag<uint64_t> warmup(parser, "warmup", "Number of untimed warmup iterations (default 5)", {"warmup"}, 5);
+  args::ValueFlag<uint64_t> iterations(
+      parser, "iterations", "Minimum number of timed iterations (default 50)", {"iterations"}, 50);
+
+  try {
+    parser.ParseCLI(argc, argv);
+  } catch (args::Help const&) {
+    std::cout << parser;
+    return 0;
+  } catch (args::ParseError const& e) {
+    std::cerr << e.what() << std::endl << std::endl << parser;
+    return 1;
+  }
+
+  auto g = std::make_shared<torch::jit::Graph>();
+  torch::jit::parseIR(loop_graph(args::get(chains)), g.get());
+
+  torch::jit::Node* loop = nullptr;
+  for (auto n : g->nodes()) {
+    if (n->kind() == torch::jit::prim::Loop) {
+      loop = n;
+    }
+  }
+
+  // The context (and its builder) is created once so only the loop evaluation itself is timed
+  torch_tensorrt::core::conversion::ConversionCtx ctx(torch_tensorrt::core::conversion::BuilderSettings{});
+  ctx.AssociateValueAndIValue(g->inputs()[0], args::get(trips));
+  ctx.AssociateValueAndIValue(g->inputs()[1], 1);
+  ctx.AssociateValueAndIValue(g->inputs()[2], 0);
+  for (auto n : g->nodes()) {
+    if (n->kind() == torch::jit::prim::Constant) {
+      ctx.AssociateValueAndIValue(n->output(), torch::jit::toIValue(n->output()).value());
+    }
+  }
+
+  benchmark::BenchmarkConfig config;
+  config.warmup_iters = args::get(warmup);
+  config.min_iters = args::get(iterations);
+  config.batch_size = static_cast<uint64_t>(args::get(trips));
+
+  auto fn = [&](uint64_t, uint64_t) { torch_tensorrt::core::conversion::EvaluateLoopBlock(&ctx, loop); };
+  auto result = benchmark::run_benchmark("prim::Loop evaluation", fn, config);
+  benchmark::print_report(std::cout, result);
+  std::cout << "Loop result: (" << ctx.evaluated_value_map[loop->outputs()[0]] << ", "
+            << ctx.evaluated_value_map[loop->outputs()[1]] << ")" << std::endl;
+  return 0;
+}
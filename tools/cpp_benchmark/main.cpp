@@ -1,158 +1,245 @@
 #include "ATen/Context.h"
-#include "c10/cuda/CUDACachingAllocator.h"
+#include "c10/cuda/CUDAGuard.h"
+#include "c10/cuda/CUDAStream.h"
 #include "cuda_runtime_api.h"
+#include "third_party/args/args.hpp"
 #include "torch/script.h"
 
-#include "timer.h"
+#include "benchmark.h"
 #include "torch_tensorrt/torch_tensorrt.h"
 
+#include <fstream>
 #include <iostream>
 #include <memory>
 #include <sstream>
 
-#define NUM_WARMUP_RUNS 20
-#define NUM_RUNS 100
+namespace {
 
-bool checkRtol(const at::Tensor& diff, const std::vector<at::Tensor> inputs) {
-  double maxValue = 0.0;
-  for (auto& tensor : inputs) {
-    maxValue = fmax(tensor.abs().max().item<float>(), maxValue);
+// One set of module inputs per shape variant, generated up front so no allocation happens in the timed region
+using InputSets = std::vector<std::vector<torch::jit::IValue>>;
+
+InputSets make_input_sets(const std::vector<std::vector<std::vector<int64_t>>>& input_variants, bool half) {
+  size_t num_sets = 1;
+  for (auto& variants : input_variants) {
+    num_sets = std::max(num_sets, variants.size());
+  }
+  InputSets sets(num_sets);
+  for (size_t s = 0; s < num_sets; s++) {
+    for (auto& variants : input_variants) {
+      // Inputs with fewer variants than others keep cycling through their own shapes
+      auto in = at::rand(variants[s % variants.size()], {at::kCUDA});
+      if (half) {
+        in = in.to(torch::kHalf);
+      }
+      sets[s].push_back(in);
+    }
   }
-  std::cout << "Max Difference: " << diff.abs().max().item<float>() << std::endl;
-  return diff.abs().max().item<float>() <= 2e-6 * maxValue;
+  cudaDeviceSynchronize();
+  return sets;
 }
 
-bool almostEqual(const at::Tensor& a, const at::Tensor& b) {
-  return checkRtol(a - b, {a, b});
+std::vector<benchmark::BenchmarkResult> benchmark_module(
+    const std::string& name,
+    torch::jit::Module& mod,
+    const InputSets& input_sets,
+    benchmark::BenchmarkConfig config,
+    const std::vector<uint64_t>& concurrency_levels) {
+  std::vector<benchmark::BenchmarkResult> results;
+  for (auto concurrency : concurrency_levels) {
+    config.concurrency = concurrency;
+    // Each caller thread drives its own stream so concurrent requests can overlap on the device
+    std::vector<c10::cuda::CUDAStream> streams;
+    for (uint64_t t = 0; t < concurrency; t++) {
+      streams.push_back(c10::cuda::getStreamFromPool());
+    }
+
+    auto fn = [&](uint64_t thread_id, uint64_t iteration) {
+      c10::cuda::CUDAStreamGuard stream_guard(streams[thread_id]);
+      const auto& inputs = input_sets[iteration % input_sets.size()];
+      mod.forward(inputs);
+      streams[thread_id].synchronize();
+    };
+
+    auto result = benchmark::run_benchmark(name, fn, config);
+    benchmark::print_report(std::cout, result);
+    results.push_back(result);
+  }
+  return results;
 }
 
-void print_avg_std_dev(std::string type, std::vector<float>& runtimes, uint64_t batch_size) {
-  float avg_runtime = std::accumulate(runtimes.begin(), runtimes.end(), 0.0) / runtimes.size();
-  float fps = (1000.f / avg_runtime) * batch_size;
-  std::cout << "[" << type << "]: batch_size: " << batch_size << "\n    Average latency: " << avg_runtime
-            << " ms\n    Average FPS: " << fps << " fps" << std::endl;
-
-  std::vector<float> rt_diff(runtimes.size());
-  std::transform(runtimes.begin(), runtimes.end(), rt_diff.begin(), [avg_runtime](float x) { return x - avg_runtime; });
-  float rt_sq_sum = std::inner_product(rt_diff.begin(), rt_diff.end(), rt_diff.begin(), 0.0);
-  float rt_std_dev = std::sqrt(rt_sq_sum / runtimes.size());
-
-  std::vector<float> fps_diff(runtimes.size());
-  std::transform(runtimes.begin(), runtimes.end(), fps_diff.begin(), [fps, batch_size](float x) {
-    return ((1000.f / x) * batch_size) - fps;
-  });
-  float fps_sq_sum = std::inner_product(fps_diff.begin(), fps_diff.end(), fps_diff.begin(), 0.0);
-  float fps_std_dev = std::sqrt(fps_sq_sum / runtimes.size());
-  std::cout << "    Latency Standard Deviation: " << rt_std_dev << "\n    FPS Standard Deviation: " << fps_std_dev
-            << "\n(excluding initial warmup runs)" << std::endl;
+std::vector<uint64_t> parse_concurrency_levels(const std::string& levels) {
+  std::vector<uint64_t> parsed;
+  std::istringstream ss(levels);
+  std::string level;
+  while (std::getline(ss, level, ',')) {
+    auto l = std::stoull(level);
+    if (l == 0) {
+      throw std::invalid_argument("Concurrency levels must be at least 1");
+    }
+    parsed.push_back(l);
+  }
+  return parsed;
 }
 
-std::vector<float> benchmark_module(torch::jit::script::Module& mod, std::vector<int64_t> shape) {
-  auto execution_timer = timers::PreciseCPUTimer();
-  std::vector<float> execution_runtimes;
-
-  for (uint64_t i = 0; i < NUM_WARMUP_RUNS; i++) {
-    std::vector<torch::jit::IValue> inputs_ivalues;
-    auto in = at::rand(shape, {at::kCUDA});
-#ifdef HALF
-    in = in.to(torch::kHalf);
-#endif
-    inputs_ivalues.push_back(in.clone());
-
-    cudaDeviceSynchronize();
-    mod.forward(inputs_ivalues);
-    cudaDeviceSynchronize();
+} // namespace
+
+int main(int argc, char** argv) {
+  args::ArgumentParser parser(
+      "Benchmarks TorchScript modules through JIT and / or Torch-TensorRT, reporting latency percentiles and throughput",
+      "");
+  args::HelpFlag help(parser, "help", "Display this help menu", {'h', "help"});
+  args::Flag jit(parser, "jit", "Benchmark the module in TorchScript", {"jit"});
+  args::Flag trt(parser, "trt", "Benchmark the module compiled with Torch-TensorRT (default if --jit is not set)", {"trt"});
+  args::Flag half(parser, "fp16", "Run with FP16 inputs and enable FP16 kernels in TensorRT", {"fp16", "half"});
+  args::ValueFlag<std::string> save_engine(
+      parser, "save-engine", "Also save the TensorRT engine for the module to this path", {"save-engine"});
+  args::ValueFlag<uint64_t> warmup(
+      parser, "warmup", "Number of untimed warmup iterations (default 20)", {"warmup"}, 20);
+  args::ValueFlag<uint64_t> iterations(
+      parser, "iterations", "Minimum number of timed iterations (default 100)", {"iterations"}, 100);
+  args::ValueFlag<double> duration(
+      parser, "duration", "Minimum duration of the timed region in seconds (default 0)", {"duration"}, 0.0);
+  args::ValueFlag<std::string> concurrency(
+      parser,
+      "concurrency",
+      "Comma separated number of caller threads to benchmark with, e.g. \"1,2,4\" (default 1)",
+      {"concurrency"},
+      "1");
+  args::ValueFlag<std::string> json_path(
+      parser, "json", "Write results as JSON to this path for regression tracking", {"json"});
+
+  args::Positional<std::string> module_path(parser, "module_path", "Path to the TorchScript module");
+  args::PositionalList<std::string> input_specs(
+      parser,
+      "input_specs",
+      "One spec per module input, e.g. \"(32 3 224 224)\". Dynamic inputs list several shapes separated by ';', "
+      "e.g. \"(1 3 224 224);(32 3 224 224)\", which are cycled through during the benchmark");
+
+  try {
+    parser.ParseCLI(argc, argv);
+  } catch (args::Help const&) {
+    std::cout << parser;
+    return 0;
+  } catch (args::ParseError const& e) {
+    std::cerr << e.what() << std::endl << std::endl << parser;
+    return 1;
   }
 
-  for (uint64_t i = 0; i < NUM_RUNS; i++) {
-    std::vector<torch::jit::IValue> inputs_ivalues;
-    auto in = at::rand(shape, {at::kCUDA});
-#ifdef HALF
-    in = in.to(torch::kHalf);
-#endif
-    inputs_ivalues.push_back(in.clone());
-    cudaDeviceSynchronize();
-
-    execution_timer.start();
-    mod.forward(inputs_ivalues);
-    cudaDeviceSynchronize();
-    execution_timer.stop();
-
-    auto time = execution_timer.milliseconds();
-    execution_timer.reset();
-    execution_runtimes.push_back(time);
-
-    c10::cuda::CUDACachingAllocator::emptyCache();
+  if (!module_path || !input_specs) {
+    std::cerr << "A module path and at least one input spec are required" << std::endl << std::endl << parser;
+    return 1;
   }
-  return execution_runtimes;
-}
 
-int main(int argc, const char* argv[]) {
-  if (argc < 3) {
-    std::cerr << "usage: benchmark <path-to-exported-script-module> <input-size>\n" << std::endl;
-    return -1;
+  std::vector<std::vector<std::vector<int64_t>>> input_variants;
+  std::vector<uint64_t> concurrency_levels;
+  try {
+    for (auto& spec : args::get(input_specs)) {
+      input_variants.push_back(benchmark::parse_shape_variants(spec));
+    }
+    concurrency_levels = parse_concurrency_levels(args::get(concurrency));
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    return 1;
   }
 
   torch::jit::Module mod;
   try {
     // Deserialize the ScriptModule from a file using torch::jit::load().
-    mod = torch::jit::load(argv[1]);
+    mod = torch::jit::load(args::get(module_path));
   } catch (const c10::Error& e) {
     std::cerr << "error loading the model\n";
     return -1;
   }
 
   mod.to(at::kCUDA);
-
-  std::vector<std::vector<int64_t>> dims;
-  for (int i = 2; i < argc; i++) {
-    auto arg = std::string(argv[i]);
-    arg = arg.substr(1, arg.size() - 1);
-    std::istringstream iss(arg);
-    std::vector<int64_t> v;
-    int64_t n;
-    while (iss >> n) {
-      v.push_back(n);
-    }
-    dims.push_back(v);
-  }
-
   at::globalContext().setBenchmarkCuDNN(true);
 
-#ifdef TRT
-  auto compile_spec = torch_tensorrt::ts::CompileSpec(dims);
-
-#ifdef HALF
-  compile_spec.enabled_precisions.insert(torch::kF16);
-#endif
+  benchmark::BenchmarkConfig config;
+  config.warmup_iters = args::get(warmup);
+  config.min_iters = args::get(iterations);
+  config.min_duration_s = args::get(duration);
+  config.batch_size = input_variants[0][0][0];
+
+  auto input_sets = make_input_sets(input_variants, half);
+  std::vector<benchmark::BenchmarkResult> results;
+
+  if (trt || !jit) {
+    std::vector<torch_tensorrt::Input> compile_inputs;
+    for (auto& variants : input_variants) {
+      if (variants.size() == 1) {
+        compile_inputs.push_back(torch_tensorrt::Input(variants[0]));
+        continue;
+      }
+      // Dynamic inputs are compiled for the elementwise range covered by their variants, optimized for the first
+      auto min_shape = variants[0];
+      auto max_shape = variants[0];
+      for (auto& v : variants) {
+        if (v.size() != min_shape.size()) {
+          std::cerr << "All shape variants of an input must have the same rank" << std::endl;
+          return 1;
+        }
+        for (size_t d = 0; d < v.size(); d++) {
+          min_shape[d] = std::min(min_shape[d], v[d]);
+          max_shape[d] = std::max(max_shape[d], v[d]);
+        }
+      }
+      compile_inputs.push_back(torch_tensorrt::Input(min_shape, variants[0], max_shape));
+    }
 
-  auto trt_mod = torch_tensorrt::ts::compile(mod, compile_spec);
+    auto compile_spec = torch_tensorrt::ts::CompileSpec(compile_inputs);
+    if (half) {
+      compile_spec.enabled_precisions.insert(torch::kF16);
+    }
 
-#ifdef SAVE_ENGINE
-  std::cout << "Compiling graph to save as TRT engine (/tmp/engine_converted_from_jit.trt)" << std::endl;
-  auto engine = torch_tensorrt::ts::convert_method_to_trt_engine(mod, "forward", compile_spec);
-  std::ofstream out("/tmp/engine_converted_from_jit.trt");
-  out << engine;
-  out.close();
-#endif
+    if (save_engine) {
+      auto engine_path = args::get(save_engine);
+      std::cout << "Compiling graph to save as TRT engine (" << engine_path << ")" << std::endl;
+      auto engine = torch_tensorrt::ts::convert_method_to_trt_engine(mod, "forward", compile_spec);
+      std::ofstream out(engine_path, std::ios::binary);
+      out << engine;
+      out.close();
+    }
 
-  auto trt_runtimes = benchmark_module(trt_mod, dims[0]);
-  print_avg_std_dev("JIT/TRT", trt_runtimes, dims[0][0]);
-#endif
+    auto trt_mod = torch_tensorrt::ts::compile(mod, compile_spec);
+    try {
+      auto trt_results = benchmark_module("JIT/TRT", trt_mod, input_sets, config, concurrency_levels);
+      results.insert(results.end(), trt_results.begin(), trt_results.end());
+    } catch (const std::exception& e) {
+      std::cerr << e.what() << std::endl;
+      return 1;
+    }
+  }
 
-#ifdef HALF
-  mod.to(torch::kHalf);
-  for (auto layer : mod.named_modules()) {
-    if (layer.name.find(".bn") != std::string::npos) {
-      layer.value.to(torch::kFloat);
+  if (jit) {
+    if (half) {
+      mod.to(torch::kHalf);
+      for (auto layer : mod.named_modules()) {
+        if (layer.name.find(".bn") != std::string::npos) {
+          layer.value.to(torch::kFloat);
+        }
+      }
+    }
+    try {
+      auto jit_results = benchmark_module("JIT", mod, input_sets, config, concurrency_levels);
+      results.insert(results.end(), jit_results.begin(), jit_results.end());
+    } catch (const std::exception& e) {
+      std::cerr << e.what() << std::endl;
+      return 1;
     }
   }
-#endif
 
-#ifdef JIT
-  auto jit_runtimes = benchmark_module(mod, dims[0]);
-  print_avg_std_dev("JIT", jit_runtimes, dims[0][0]);
-#endif
+  if (json_path) {
+    std::ostringstream specs;
+    for (auto& spec : args::get(input_specs)) {
+      specs << spec << " ";
+    }
+    std::ofstream out(args::get(json_path));
+    out << benchmark::to_json(
+        results,
+        {{"module", args::get(module_path)}, {"inputs", specs.str()}, {"precision", half ? "fp16" : "fp32"}});
+    out.close();
+    std::cout << "Results written to " << args::get(json_path) << std::endl;
+  }
 
   std::cout << "ok\n";
 }
@@ -0,0 +1,158 @@
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <thread>
+
+#include "benchmark.h"
+#include "gtest/gtest.h"
+
+namespace {
+// Stands in for a module forward call, takes a fixed amount of wall time and records who called it
+struct StubModule {
+  explicit StubModule(std::chrono::microseconds latency) : latency(latency) {}
+
+  void forward(uint64_t thread_id, uint64_t iteration) {
+    std::this_thread::sleep_for(latency);
+    calls++;
+    std::lock_guard<std::mutex> lock(mu);
+    threads_seen.insert(thread_id);
+    iterations_seen.insert(iteration);
+  }
+
+  std::chrono::microseconds latency;
+  std::atomic<uint64_t> calls{0};
+  std::mutex mu;
+  std::set<uint64_t> threads_seen;
+  std::set<uint64_t> iterations_seen;
+};
+} // namespace
+
+TEST(CppBenchmark, PercentilesUseNearestRank) {
+  std::vector<double> sorted;
+  for (int i = 1; i <= 100; i++) {
+    sorted.push_back(i);
+  }
+  ASSERT_DOUBLE_EQ(benchmark::percentile(sorted, 50), 50);
+  ASSERT_DOUBLE_EQ(benchmark::percentile(sorted, 90), 90);
+  ASSERT_DOUBLE_EQ(benchmark::percentile(sorted, 99), 99);
+  ASSERT_DOUBLE_EQ(benchmark::percentile(sorted, 100), 100);
+  ASSERT_DOUBLE_EQ(benchmark::percentile(sorted, 0), 1);
+  ASSERT_DOUBLE_EQ(benchmark::percentile({}, 50), 0);
+}
+
+TEST(CppBenchmark, LatencyStatsAreComputedOverUnsortedSamples) {
+  auto stats = benchmark::compute_latency_stats({4.0, 1.0, 3.0, 2.0});
+  ASSERT_EQ(stats.count, 4);
+  ASSERT_DOUBLE_EQ(stats.mean_ms, 2.5);
+  ASSERT_NEAR(stats.stddev_ms, 1.118034, 1e-6);
+  ASSERT_DOUBLE_EQ(stats.min_ms, 1.0);
+  ASSERT_DOUBLE_EQ(stats.p50_ms, 2.0);
+  ASSERT_DOUBLE_EQ(stats.p99_ms, 4.0);
+  ASSERT_DOUBLE_EQ(stats.max_ms, 4.0);
+}
+
+TEST(CppBenchmark, ParsesStaticAndDynamicInputSpecs) {
+  auto single = benchmark::parse_shape_variants("(32 3 224 224)");
+  ASSERT_EQ(single, std::vector<std::vector<int64_t>>({{32, 3, 224, 224}}));
+
+  auto dynamic = benchmark::parse_shape_variants("(1,3,224,224);(8, 3, 224, 224)");
+  ASSERT_EQ(dynamic, std::vector<std::vector<int64_t>>({{1, 3, 224, 224}, {8, 3, 224, 224}}));
+
+  ASSERT_THROW(benchmark::parse_shape_variants("(1 x 3)"), std::invalid_argument);
+  ASSERT_THROW(benchmark::parse_shape_variants("()"), std::invalid_argument);
+}
+
+TEST(CppBenchmark, RunsWarmupAndMinimumIterations) {
+  StubModule mod(std::chrono::microseconds(100));
+  benchmark::BenchmarkConfig config;
+  config.warmup_iters = 3;
+  config.min_iters = 10;
+  config.batch_size = 4;
+
+  auto result = benchmark::run_benchmark(
+      "stub", [&](uint64_t t, uint64_t i) { mod.forward(t, i); }, config);
+
+  ASSERT_EQ(result.iterations, 10);
+  ASSERT_EQ(result.latency.count, 10);
+  ASSERT_EQ(mod.calls.load(), 13);
+  ASSERT_GE(result.latency.min_ms, 0.1);
+  ASSERT_LE(result.latency.p50_ms, result.latency.p99_ms);
+  ASSERT_LE(result.latency.p99_ms, result.latency.max_ms);
+  ASSERT_NEAR(result.throughput_samples_per_s, result.throughput_qps * 4, 1e-6);
+}
+
+TEST(CppBenchmark, RunsForMinimumDuration) {
+  StubModule mod(std::chrono::microseconds(500));
+  benchmark::BenchmarkConfig config;
+  config.warmup_iters = 0;
+  config.min_iters = 1;
+  config.min_duration_s = 0.05;
+
+  auto result = benchmark::run_benchmark(
+      "stub", [&](uint64_t t, uint64_t i) { mod.forward(t, i); }, config);
+
+  ASSERT_GE(result.wall_time_s, 0.05);
+  ASSERT_GT(result.iterations, 1);
+}
+
+TEST(CppBenchmark, DistributesWorkAcrossCallerThreads) {
+  StubModule mod(std::chrono::microseconds(1000));
+  benchmark::BenchmarkConfig config;
+  config.warmup_iters = 0;
+  config.min_iters = 40;
+  config.concurrency = 4;
+
+  auto result = benchmark::run_benchmark(
+      "stub", [&](uint64_t t, uint64_t i) { mod.forward(t, i); }, config);
+
+  ASSERT_EQ(result.iterations, 40);
+  ASSERT_EQ(mod.threads_seen, std::set<uint64_t>({0, 1, 2, 3}));
+  // Every iteration index is handed out exactly once
+  ASSERT_EQ(mod.iterations_seen.size(), 40);
+  ASSERT_EQ(*mod.iterations_seen.rbegin(), 39);
+  // Four callers sleeping 1ms each should sustain well above the serial rate of 1000 qps
+  ASSERT_GT(result.throughput_qps, 1500);
+}
+
+TEST(CppBenchmark, RejectsInvalidConfigs) {
+  benchmark::BenchmarkConfig config;
+  config.concurrency = 0;
+  ASSERT_THROW(benchmark::run_benchmark("stub", [](uint64_t, uint64_t) {}, config), std::invalid_argument);
+}
+
+TEST(CppBenchmark, ReportsCallerThreadFailures) {
+  benchmark::BenchmarkConfig config;
+  config.warmup_iters = 0;
+  config.min_iters = 100;
+  config.concurrency = 4;
+
+  auto fn = [](uint64_t, uint64_t iteration) {
+    if (iteration == 10) {
+      throw std::runtime_error("inference failed");
+    }
+  };
+  try {
+    benchmark::run_benchmark("stub", fn, config);
+    FAIL() << "Expected the failure of a caller thread to be reported";
+  } catch (const std::runtime_error& e) {
+    ASSERT_NE(std::string(e.what()).find("inference failed"), std::string::npos);
+  }
+}
+
+TEST(CppBenchmark, SerializesResultsAsJson) {
+  benchmark::BenchmarkResult result;
+  result.name = "JIT/\"TRT\"";
+  result.config.batch_size = 8;
+  result.config.concurrency = 2;
+  result.iterations = 100;
+  result.latency.p99_ms = 1.5;
+
+  auto json = benchmark::to_json({result}, {{"module", "resnet50.jit.pt"}});
+  ASSERT_NE(json.find("\"name\": \"JIT/\\\"TRT\\\"\""), std::string::npos);
+  ASSERT_NE(json.find("\"module\": \"resnet50.jit.pt\""), std::string::npos);
+  ASSERT_NE(json.find("\"concurrency\": 2"), std::string::npos);
+  ASSERT_NE(json.find("\"p99\": 1.5"), std::string::npos);
+
+  ASSERT_EQ(benchmark::to_json({}), "{\n  \"metadata\": {},\n  \"benchmarks\": []\n}\n");
+}